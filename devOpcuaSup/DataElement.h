@@ -60,6 +60,8 @@ public:
                                  RecordConnector *pconnector,
                                  const std::list<std::string> &elementPath);
 
+    static const bool jsonSupported; /**< JSON encoding (link option json=y) available in the specific implementation */
+
     /**
      * @brief Get the type of element (inside a structure).
      *
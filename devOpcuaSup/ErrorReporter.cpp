@@ -0,0 +1,170 @@
+/*************************************************************************\
+* Copyright (c) 2026 ITER Organization.
+* This module is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Author: Dirk Zimoch <dirk.zimoch@psi.ch>
+ */
+
+#include <string>
+#include <vector>
+
+#include <errlog.h>
+#include <epicsTime.h>
+#include <epicsThread.h>
+#include <epicsAtomic.h>
+#include <dbCommon.h>
+
+#include "devOpcua.h"
+#include "iocshVariables.h"
+#include "ErrorReporter.h"
+
+namespace DevOpcua {
+
+const char *
+errorClassString (const ErrorClass cls)
+{
+    switch (cls) {
+    case ErrorClass::incomingQueueEmpty:  return "incoming data queue empty";
+    case ErrorClass::incomingOutOfBounds: return "incoming data out-of-bounds";
+    case ErrorClass::incomingType:        return "incoming data type mismatch";
+    case ErrorClass::incomingEncoding:    return "incoming data encoding failed";
+    case ErrorClass::outgoingConversion:  return "outgoing data conversion failed";
+    case ErrorClass::nodeIdUnknown:       return "BadNodeIdUnknown";
+    case ErrorClass::readService:         return "read service failed";
+    case ErrorClass::writeService:        return "write service failed";
+    }
+    return "unknown";
+}
+
+ErrorReporter::ErrorReporter ()
+    : total(0)
+{}
+
+bool
+ErrorReporter::allow (const ErrorClass cls, const void *source, const char *name,
+                      const double now, const double interval, const unsigned int burst)
+{
+    Guard G(lock);
+    auto it = entries.find(std::make_pair(cls, source));
+    if (it == entries.end())
+        it = entries.emplace(std::make_pair(cls, source), Entry{name, now, 0, 0}).first;
+    Entry &e = it->second;
+    if (now - e.windowStart >= interval) {
+        e.windowStart = now;
+        e.inWindow = 0;
+    }
+    if (e.inWindow < burst) {
+        e.inWindow++;
+        return true;
+    }
+    e.suppressed++;
+    total++;
+    return false;
+}
+
+unsigned long
+ErrorReporter::summarize (const double now, const double interval, std::vector<std::string> &lines)
+{
+    unsigned long n = 0;
+    Guard G(lock);
+    for (auto it = entries.begin(); it != entries.end(); ) {
+        Entry &e = it->second;
+        if (e.suppressed) {
+            lines.push_back(e.name + " : " + std::to_string(e.suppressed) + " more '"
+                            + errorClassString(it->first.first) + "' messages suppressed");
+            n += e.suppressed;
+            e.suppressed = 0;
+        } else if (now - e.windowStart > 2 * interval) {
+            it = entries.erase(it);
+            continue;
+        }
+        ++it;
+    }
+    return n;
+}
+
+unsigned long
+ErrorReporter::suppressed () const
+{
+    Guard G(lock);
+    return total;
+}
+
+size_t
+ErrorReporter::size () const
+{
+    Guard G(lock);
+    return entries.size();
+}
+
+namespace {
+
+ErrorReporter &
+globalReporter ()
+{
+    static ErrorReporter reporter;
+    return reporter;
+}
+
+double
+secondsNow ()
+{
+    return epicsTime::getCurrent() - epicsTime();
+}
+
+// Rate limiting window, at least one second (the summary thread sleeps for one window)
+double
+reportInterval ()
+{
+    const double interval = opcua_ErrorReportInterval;
+    return interval < 1.0 ? 1.0 : interval;
+}
+
+// Prints the summaries of suppressed messages, started with the first suppressed message
+void
+summaryThread (void *)
+{
+    while (true) {
+        const double interval = reportInterval();
+        epicsThreadSleep(interval);
+        std::vector<std::string> lines;
+        globalReporter().summarize(secondsNow(), interval, lines);
+        for (const auto &line : lines)
+            errlogPrintf("%s\n", line.c_str());
+    }
+}
+
+int summaryStarted = 0;
+
+bool
+allowGlobal (const ErrorClass cls, const void *source, const char *name)
+{
+    if (opcua_ErrorReportInterval <= 0.0)
+        return true;
+    const unsigned int burst = opcua_ErrorReportBurst > 0 ? static_cast<unsigned int>(opcua_ErrorReportBurst) : 0;
+    if (globalReporter().allow(cls, source, name, secondsNow(), reportInterval(), burst))
+        return true;
+    if (!epicsAtomicGetIntT(&summaryStarted) && epicsAtomicCmpAndSwapIntT(&summaryStarted, 0, 1) == 0)
+        epicsThreadCreate("OPCerrors", epicsThreadPriorityLow,
+                          epicsThreadGetStackSize(epicsThreadStackSmall), summaryThread, nullptr);
+    return false;
+}
+
+} // namespace
+
+bool
+reportError (const ErrorClass cls, const dbCommon *prec)
+{
+    return allowGlobal(cls, prec, prec->name);
+}
+
+bool
+reportError (const ErrorClass cls, const void *source, const std::string &name)
+{
+    return allowGlobal(cls, source, name.c_str());
+}
+
+} // namespace DevOpcua
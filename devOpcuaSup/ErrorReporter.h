@@ -0,0 +1,140 @@
+/*************************************************************************\
+* Copyright (c) 2026 ITER Organization.
+* This module is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Author: Dirk Zimoch <dirk.zimoch@psi.ch>
+ */
+
+#ifndef DEVOPCUA_ERRORREPORTER_H
+#define DEVOPCUA_ERRORREPORTER_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <utility>
+
+#include <epicsMutex.h>
+
+struct dbCommon;
+
+namespace DevOpcua {
+
+/**
+ * @brief Classes of error messages on the data paths (per update or per request).
+ */
+enum class ErrorClass {
+    incomingQueueEmpty,     /**< record processed without an update */
+    incomingOutOfBounds,    /**< incoming value does not fit the EPICS type */
+    incomingType,           /**< incoming data type does not match the record */
+    incomingEncoding,       /**< incoming data can not be encoded (json=y) */
+    outgoingConversion,     /**< outgoing value can not be converted */
+    nodeIdUnknown,          /**< server does not know the node */
+    readService,            /**< read service call failed */
+    writeService,           /**< write service call failed */
+};
+
+/**
+ * @brief Name of an error class (used in the summaries).
+ */
+const char *errorClassString(const ErrorClass cls);
+
+/**
+ * @brief Rate limiter for error messages.
+ *
+ * Counts the messages per error class and source (e.g. a record or a session).
+ * In every interval, the first 'burst' messages of a class and source are allowed,
+ * the others are suppressed and counted. The suppressed counts are collected
+ * by summarize(), which is called periodically.
+ *
+ * The caller checks allow() before formatting the message, so a suppressed
+ * message costs a map lookup.
+ */
+class ErrorReporter
+{
+public:
+    ErrorReporter();
+
+    /**
+     * @brief Check if a message may be printed.
+     *
+     * @param cls  error class
+     * @param source  source of the message (key, e.g. record or session)
+     * @param name  name of the source (copied when the source is first seen)
+     * @param now  current time [s]
+     * @param interval  length of the rate limiting window [s]
+     * @param burst  number of messages allowed per window
+     *
+     * @return  true if the message may be printed
+     */
+    bool allow(const ErrorClass cls, const void *source, const char *name,
+               const double now, const double interval, const unsigned int burst);
+
+    /**
+     * @brief Collect the summaries of suppressed messages.
+     *
+     * Returns one line per class and source with suppressed messages
+     * and resets their counts. Forgets the sources that were quiet for
+     * more than two intervals.
+     *
+     * @param now  current time [s]
+     * @param interval  length of the rate limiting window [s]
+     * @param[out] lines  summary lines (appended)
+     *
+     * @return  number of suppressed messages in the summaries
+     */
+    unsigned long summarize(const double now, const double interval, std::vector<std::string> &lines);
+
+    /**
+     * @brief Total number of suppressed messages.
+     */
+    unsigned long suppressed() const;
+
+    /**
+     * @brief Number of class/source pairs being tracked.
+     */
+    size_t size() const;
+
+private:
+    struct Entry {
+        std::string name;
+        double windowStart;         /**< start of the current window [s] */
+        unsigned int inWindow;      /**< messages in the current window */
+        unsigned long suppressed;   /**< suppressed messages since the last summary */
+    };
+
+    mutable epicsMutex lock;
+    std::map<std::pair<ErrorClass, const void *>, Entry> entries;
+    unsigned long total;            /**< suppressed messages since start */
+};
+
+/**
+ * @brief Check if a data path error message of a record may be printed.
+ *
+ * Uses the global reporter with the limits set by the iocsh variables
+ * opcua_ErrorReportInterval and opcua_ErrorReportBurst.
+ * Summaries of suppressed messages are printed periodically.
+ *
+ * @param cls  error class
+ * @param prec  record
+ *
+ * @return  true if the message may be printed
+ */
+bool reportError(const ErrorClass cls, const dbCommon *prec);
+
+/**
+ * @brief Check if a data path error message of a session (or other source) may be printed.
+ *
+ * @param cls  error class
+ * @param source  source of the message (key)
+ * @param name  name of the source
+ *
+ * @return  true if the message may be printed
+ */
+bool reportError(const ErrorClass cls, const void *source, const std::string &name);
+
+} // namespace DevOpcua
+
+#endif // DEVOPCUA_ERRORREPORTER_H
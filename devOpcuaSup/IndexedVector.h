@@ -0,0 +1,114 @@
+/*************************************************************************\
+* Copyright (c) 2026 ITER Organization.
+* This module is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Author: Dirk Zimoch <dirk.zimoch@psi.ch>
+ */
+
+#ifndef DEVOPCUA_INDEXEDVECTOR_H
+#define DEVOPCUA_INDEXEDVECTOR_H
+
+#include <vector>
+#include <unordered_map>
+
+namespace DevOpcua {
+
+/**
+ * @brief A vector of object pointers with O(1) lookup and removal.
+ *
+ * Keeps the pointers in a contiguous vector (for fast iteration and for
+ * building the arrays of service requests) plus an index that maps each
+ * pointer to its position.
+ * Removal moves the last element into the freed slot, i.e. the order of
+ * the elements is not preserved.
+ *
+ * Duplicates are not allowed: insert() of a contained pointer is a no-op.
+ *
+ * Not thread-safe: the owner has to provide locking.
+ */
+
+template<typename T>
+class IndexedVector
+{
+public:
+    /**
+     * @brief Add an object.
+     *
+     * @param object  pointer to add
+     * @return  true if added, false if already contained
+     */
+    bool
+    insert(T *object)
+    {
+        if (!index.emplace(object, elements.size()).second)
+            return false;
+        elements.push_back(object);
+        return true;
+    }
+
+    /**
+     * @brief Remove an object.
+     *
+     * @param object  pointer to remove
+     * @return  true if removed, false if not contained
+     */
+    bool
+    erase(const T *object)
+    {
+        auto it = index.find(object);
+        if (it == index.end())
+            return false;
+        size_t pos = it->second;
+        index.erase(it);
+        if (pos != elements.size() - 1) {
+            elements[pos] = elements.back();
+            index[elements[pos]] = pos;
+        }
+        elements.pop_back();
+        return true;
+    }
+
+    /**
+     * @brief Check for the presence of an object.
+     *
+     * @param object  pointer to check
+     * @return  true if contained
+     */
+    bool
+    contains(const T *object) const
+    {
+        return (index.find(object) != index.end());
+    }
+
+    /**
+     * @brief Access the underlying vector (e.g. to take a snapshot).
+     */
+    const std::vector<T *> &vector() const { return elements; }
+
+    void
+    clear()
+    {
+        elements.clear();
+        index.clear();
+    }
+
+    // STL standards: size(), empty(), operator[] and iterators
+    size_t size() const noexcept { return elements.size(); }
+    bool empty() const noexcept { return elements.empty(); }
+    T *operator[](size_t pos) const { return elements[pos]; }
+
+    typedef typename std::vector<T *>::const_iterator const_iterator;
+    const_iterator begin() const { return elements.begin(); }
+    const_iterator end() const { return elements.end(); }
+
+private:
+    std::vector<T *> elements;
+    std::unordered_map<const T *, size_t> index;
+};
+
+} // namespace DevOpcua
+
+#endif // DEVOPCUA_INDEXEDVECTOR_H
@@ -13,6 +13,11 @@
 #ifndef DEVOPCUA_ITEM_H
 #define DEVOPCUA_ITEM_H
 
+#include <string>
+#include <vector>
+#include <utility>
+#include <atomic>
+
 #include <epicsTypes.h>
 #include <epicsTime.h>
 
@@ -34,6 +39,39 @@ connectionStatusString (const ConnectionStatus status) {
     return "Illegal Value";
 }
 
+/**
+ * @brief Node metadata (properties and attributes) of an OPC UA item.
+ *
+ * Collected from the server when the session connects (link option meta=y)
+ * and applied to the fields of the connected record.
+ */
+struct ItemMetadata {
+    bool hasRange = false;              /**< EURange property found */
+    double rangeLow = 0.0;              /**< EURange low limit */
+    double rangeHigh = 0.0;             /**< EURange high limit */
+    bool hasUnits = false;              /**< EngineeringUnits property found */
+    std::string units;                  /**< EngineeringUnits display name */
+    std::vector<std::pair<epicsInt64, std::string>> enumChoices; /**< EnumStrings or EnumValues (value, name) */
+    bool hasDescription = false;        /**< Description attribute found */
+    std::string description;            /**< Description attribute text */
+};
+
+/**
+ * @brief Statistics of an OPC UA item (for opcuaItem records).
+ *
+ * Collected from counters and time stamps that the item keeps anyway,
+ * i.e. reading them does not involve the server.
+ */
+struct ItemStatistics {
+    double updateRate = 0.0;            /**< incoming data updates per second */
+    epicsTimeStamp sourceTime = {0, 0}; /**< source time stamp of the last update */
+    epicsUInt32 queueHighWater = 0;     /**< high-water mark of the client side update queues */
+    double samplingInterval = 0.0;      /**< server-revised sampling interval [ms] */
+    epicsUInt32 queueSize = 0;          /**< server-revised queue size */
+    double readRoundTrip = 0.0;         /**< round trip time of the last read service [ms] */
+    double writeRoundTrip = 0.0;        /**< round trip time of the last write service [ms] */
+};
+
 struct linkInfo;
 class RecordConnector;
 
@@ -115,6 +153,69 @@ public:
      */
     virtual bool isMonitored() const = 0;
 
+    /**
+     * @brief Get the counters of updates lost on the way to the records.
+     *
+     * @param[out] serverOverflows  values received with the Overflow InfoBit set
+     *                              (monitored item queue overflow on the server)
+     * @param[out] clientDrops  updates discarded by the client side update queues
+     */
+    virtual void getOverflowCounts(epicsUInt32 *serverOverflows, epicsUInt32 *clientDrops) const
+    {
+        *serverOverflows = 0;
+        *clientDrops = 0;
+    }
+
+    /**
+     * @brief Get the statistics of the item.
+     *
+     * @param[out] stats  item statistics (left at defaults if not supported)
+     */
+    virtual void getStatistics(ItemStatistics &stats) const {}
+
+    /**
+     * @brief Reset the maxima of the item statistics (queue high-water mark).
+     */
+    virtual void resetStatistics() {}
+
+    /**
+     * @brief Attach the item to its session and subscription (runtime link change).
+     *
+     * Items created at runtime are only announced to the client library
+     * after the record connector and data element tree have been set up.
+     * Items created during IOC initialization are attached by their constructor.
+     */
+    virtual void attach() {}
+
+    /**
+     * @brief Detach the item from its session and subscription (runtime link change).
+     *
+     * The item stops receiving data; the server side (monitored item,
+     * registered node) is cleaned up asynchronously by the session.
+     * The item must not be deleted while references are held (see addReference()).
+     *
+     * @return true if detached, false if not supported by the implementation
+     */
+    virtual bool detach() { return false; }
+
+    /**
+     * @brief Take a reference to the item.
+     *
+     * Queued requests, outstanding service calls, queued notifications and
+     * record processing callbacks hold a reference to their item.
+     * The record connector holds one reference, which is released when the
+     * connector is retired (runtime link change).
+     */
+    void addReference() { references++; }
+
+    /**
+     * @brief Release a reference taken with addReference().
+     *
+     * Releasing the last reference schedules the deletion of the item
+     * and its record connector. The caller must not use the item afterwards.
+     */
+    void releaseReference();
+
     const linkInfo &linkinfo;           /**< configuration of the item as parsed from the EPICS record */
     RecordConnector *recConnector;      /**< pointer to the relevant recordConnector */
 
@@ -127,7 +228,11 @@ protected:
     Item(const linkInfo &info)
         : linkinfo(info)
         , recConnector(nullptr)
+        , references(1)
     {}
+
+private:
+    std::atomic<unsigned int> references; /**< see addReference() */
 };
 
 } // namespace DevOpcua
@@ -0,0 +1,124 @@
+/*************************************************************************\
+* Copyright (c) 2026 ITER Organization.
+* This module is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Author: Dirk Zimoch <dirk.zimoch@psi.ch>
+ *
+ *  based on the Subscription interface by Ralph Lange <ralph.lange@gmx.de>
+ */
+
+#ifndef DEVOPCUA_PUBSUBREADER_H
+#define DEVOPCUA_PUBSUBREADER_H
+
+#include <iostream>
+#include <string>
+#include <set>
+
+#include <epicsTypes.h>
+#include <shareLib.h>
+
+namespace DevOpcua {
+
+/**
+ * @brief The PubSubReader interface for an OPC UA PubSub subscriber.
+ *
+ * A PubSubReader receives UADP NetworkMessages (UDP multicast or unicast)
+ * and decodes the DataSetMessages of one DataSetWriter, using a DataSetMetaData
+ * (list of field names and types) that is configured in the IOC shell.
+ *
+ * Records link to a field of the DataSet by using the reader name
+ * and the 'field' link option.
+ */
+class epicsShareClass PubSubReader
+{
+public:
+    virtual ~PubSubReader();
+
+    /**
+     * @brief Factory method to dynamically create a PubSubReader of the specific implementation.
+     *
+     * @param name  name of the new reader
+     * @param url  UADP transport URL (opc.udp://address:port)
+     *
+     * @return  pointer to the new reader, nullptr if not supported or on error
+     */
+    static PubSubReader *createPubSubReader(const std::string &name,
+                                            const std::string &url);
+
+    /**
+     * @brief Print configuration and status on stdout.
+     *
+     * The verbosity level controls the amount of information:
+     * 0 = one line
+     * 1 = reader line, then one line per field
+     * 2 = reader line, then one line per field and one line per item
+     *
+     * @param level  verbosity level
+     */
+    virtual void show(int level) const = 0;
+
+    /**
+     * @brief Set an option for the reader.
+     *
+     * @param name  option name
+     * @param value  value
+     */
+    virtual void setOption(const std::string &name, const std::string &value) = 0;
+
+    /**
+     * @brief Append a field to the DataSetMetaData of the reader.
+     *
+     * @param name  field name
+     * @param type  OPC UA built-in type name of the field (e.g. "Double")
+     *
+     * @return  true on success, false if the type name is unknown
+     */
+    virtual bool addField(const std::string &name, const std::string &type) = 0;
+
+    /**
+     * @brief Print configuration and status of all readers on stdout.
+     *
+     * @param level  verbosity level
+     */
+    static void showAll(int level);
+
+    /**
+     * @brief Find a reader by name.
+     *
+     * @param name  reader name to search for
+     *
+     * @return  pointer to reader, nullptr if not found
+     */
+    static PubSubReader *find(const std::string &name);
+
+    /**
+     * @brief Find readers with names matching a glob pattern.
+     *
+     * @param pattern  reader name pattern to match
+     *
+     * @return  set of reader pointers
+     */
+    static std::set<PubSubReader *> glob(const std::string &pattern);
+
+    static const char optionUsage[]; /**< option info for the specific implementation */
+
+    const std::string name; /**< reader name */
+    int debug;              /**< debug verbosity level */
+
+protected:
+    /**
+     * @brief Constructor for PubSubReader, to be used by derived classes.
+     *
+     * @param name  name of the new reader
+     */
+    PubSubReader(const std::string &name)
+        : name(name)
+        , debug(0) {}
+};
+
+} // namespace DevOpcua
+
+#endif // DEVOPCUA_PUBSUBREADER_H
@@ -12,6 +12,7 @@
 
 #include <cstddef>
 #include <iostream>
+#include <vector>
 #include <stdexcept>
 #include <string.h>
 
@@ -76,13 +77,9 @@ long reProcess (dbCommon *prec)
     return status;
 }
 
-void processCallback (epicsCallback *pcallback, const ProcessReason reason)
+// Process (or re-process) a record for the specified reason
+static void processRecord (dbCommon *prec, const ProcessReason reason)
 {
-    void *pUsr;
-    dbCommon *prec;
-
-    callbackGetUser(pUsr, pcallback);
-    prec = static_cast<dbCommon *>(pUsr);
     if (!prec || !prec->dpvt) return;
 
     RecordConnector *pvt = static_cast<RecordConnector*>(prec->dpvt);
@@ -97,6 +94,30 @@ void processCallback (epicsCallback *pcallback, const ProcessReason reason)
     dbScanUnlock(prec);
 }
 
+void processCallback (epicsCallback *pcallback, const ProcessReason reason)
+{
+    void *pUsr;
+
+    callbackGetUser(pUsr, pcallback);
+    static_cast<RecordConnector *>(pUsr)->processRequested(reason);
+}
+
+void processItemCallback (epicsCallback *pcallback)
+{
+    void *pUsr;
+
+    callbackGetUser(pUsr, pcallback);
+    static_cast<RecordConnector *>(pUsr)->processQueuedRecords();
+}
+
+void processMetadataCallback (epicsCallback *pcallback)
+{
+    void *pUsr;
+
+    callbackGetUser(pUsr, pcallback);
+    static_cast<RecordConnector *>(pUsr)->applyQueuedMetadata();
+}
+
 void processIncomingDataCallback (epicsCallback *pcallback)
 {
     processCallback(pcallback, ProcessReason::incomingData);
@@ -141,29 +162,41 @@ RecordConnector::RecordConnector (dbCommon *prec)
     : pitem(nullptr)
     , reason(ProcessReason::none)
     , prec(prec)
+    , itemProcScheduled(false)
+    , metadataQueued(false)
 {
     scanIoInit(&ioscanpvt);
     callbackSetCallback(DevOpcua::processIncomingDataCallback, &incomingDataCallback);
-    callbackSetUser(prec, &incomingDataCallback);
+    callbackSetUser(this, &incomingDataCallback);
     callbackSetCallback(DevOpcua::processReadCompleteCallback, &readCompleteCallback);
-    callbackSetUser(prec, &readCompleteCallback);
+    callbackSetUser(this, &readCompleteCallback);
     callbackSetCallback(DevOpcua::processWriteCompleteCallback, &writeCompleteCallback);
-    callbackSetUser(prec, &writeCompleteCallback);
+    callbackSetUser(this, &writeCompleteCallback);
     callbackSetCallback(DevOpcua::processConnectionLossCallback, &connectionLossCallback);
-    callbackSetUser(prec, &connectionLossCallback);
+    callbackSetUser(this, &connectionLossCallback);
     callbackSetCallback(DevOpcua::processReadFailureCallback, &readFailureCallback);
-    callbackSetUser(prec, &readFailureCallback);
+    callbackSetUser(this, &readFailureCallback);
     callbackSetCallback(DevOpcua::processWriteFailureCallback, &writeFailureCallback);
-    callbackSetUser(prec, &writeFailureCallback);
+    callbackSetUser(this, &writeFailureCallback);
     callbackSetCallback(DevOpcua::processReadRequestCallback, &readRequestCallback);
-    callbackSetUser(prec, &readRequestCallback);
+    callbackSetUser(this, &readRequestCallback);
     callbackSetCallback(DevOpcua::processWriteRequestCallback, &writeRequestCallback);
-    callbackSetUser(prec, &writeRequestCallback);
+    callbackSetUser(this, &writeRequestCallback);
+    callbackSetCallback(DevOpcua::processItemCallback, &itemProcCallback);
+    callbackSetUser(this, &itemProcCallback);
+    callbackSetCallback(DevOpcua::processMetadataCallback, &metadataCallback);
+    callbackSetUser(this, &metadataCallback);
 }
 
 void
 RecordConnector::requestRecordProcessing (const ProcessReason reason)
 {
+    // Updates from the server are processed item-wise if configured on the opcuaItemRecord
+    if (pitem && pitem->recConnector && pitem->recConnector->plinkinfo->itemProcessing
+            && reason != ProcessReason::readRequest && reason != ProcessReason::writeRequest) {
+        pitem->recConnector->queueItemProcessing(this, reason);
+        return;
+    }
     if (debug() > 5)
         std::cout << "Registering record " << getRecordName() << " for processing"
                   << " (" << processReasonString(reason) << ")" << std::endl;
@@ -180,7 +213,184 @@ RecordConnector::requestRecordProcessing (const ProcessReason reason)
     case ProcessReason::writeRequest : callback = &writeRequestCallback; break;
     }
     callbackSetPriority(prec->prio, callback);
-    callbackRequest(callback);
+    pitem->addReference();
+    if (callbackRequest(callback))
+        pitem->releaseReference();
+}
+
+void
+RecordConnector::processRequested (const ProcessReason reason)
+{
+    Item *item = pitem;
+    // A connector retired by a runtime link change does not process the record any more
+    if (prec->dpvt == this)
+        processRecord(prec, reason);
+    item->releaseReference();
+}
+
+void
+RecordConnector::queueItemProcessing (RecordConnector *pcon, const ProcessReason reason)
+{
+    if (pcon->debug() > 5)
+        std::cout << "Registering record " << pcon->getRecordName() << " for processing"
+                  << " (" << processReasonString(reason) << ") with item " << getRecordName()
+                  << std::endl;
+    bool request = false;
+    pcon->pitem->addReference();
+    {
+        Guard G(itemProcLock);
+        itemProcPending.emplace_back(pcon, reason);
+        if (!itemProcScheduled)
+            request = itemProcScheduled = true;
+    }
+    if (request) {
+        callbackSetPriority(prec->prio, &itemProcCallback);
+        pitem->addReference();
+        if (callbackRequest(&itemProcCallback)) {
+            {
+                Guard G(itemProcLock);
+                itemProcScheduled = false;
+            }
+            pitem->releaseReference();
+        }
+    }
+}
+
+void
+RecordConnector::processQueuedRecords ()
+{
+    Item *item = pitem;
+    std::vector<std::pair<RecordConnector *, ProcessReason>> batch;
+    while (true) {
+        {
+            Guard G(itemProcLock);
+            if (itemProcPending.empty()) {
+                itemProcScheduled = false;
+                break;
+            }
+            batch.swap(itemProcPending);
+        }
+        for (auto &it : batch) {
+            // Each queued record holds a reference to its item (see queueItemProcessing)
+            Item *queued = it.first->pitem;
+            if (it.first->prec->dpvt == it.first)
+                processRecord(it.first->prec, it.second);
+            queued->releaseReference();
+        }
+        batch.clear();
+    }
+    item->releaseReference();
+}
+
+// Put a value into a record field (the record must be locked)
+// Returns false if the field does not exist or the put failed
+static bool
+putRecordField (dbCommon *prec, const char *field, const short dbrType, const void *value)
+{
+    DBADDR addr;
+    std::string name(prec->name);
+    name += ".";
+    name += field;
+    if (dbNameToAddr(name.c_str(), &addr))
+        return false;
+    return !dbPut(&addr, dbrType, value, 1);
+}
+
+static bool
+putRecordField (dbCommon *prec, const char *field, const std::string &value)
+{
+    char buffer[MAX_STRING_SIZE];
+    strncpy(buffer, value.c_str(), MAX_STRING_SIZE);
+    buffer[MAX_STRING_SIZE-1] = '\0';
+    return putRecordField(prec, field, DBR_STRING, buffer);
+}
+
+static bool
+putRecordField (dbCommon *prec, const char *field, const double value)
+{
+    return putRecordField(prec, field, DBR_DOUBLE, &value);
+}
+
+// Called by the client thread (holding the client lock): must not take the record lock
+void
+RecordConnector::applyMetadata (const ItemMetadata &meta)
+{
+    bool request = false;
+    {
+        Guard G(metadataLock);
+        queuedMetadata = meta;
+        if (!metadataQueued)
+            request = metadataQueued = true;
+    }
+    if (request) {
+        callbackSetPriority(prec->prio, &metadataCallback);
+        pitem->addReference();
+        if (callbackRequest(&metadataCallback))
+            pitem->releaseReference();
+    }
+}
+
+void
+RecordConnector::applyQueuedMetadata ()
+{
+    static const char *mbbStrings[] = { "ZRST", "ONST", "TWST", "THST", "FRST", "FVST", "SXST", "SVST",
+                                        "EIST", "NIST", "TEST", "ELST", "TVST", "TTST", "FTST", "FFST" };
+    static const char *mbbValues[]  = { "ZRVL", "ONVL", "TWVL", "THVL", "FRVL", "FVVL", "SXVL", "SVVL",
+                                        "EIVL", "NIVL", "TEVL", "ELVL", "TVVL", "TTVL", "FTVL", "FFVL" };
+    static const char *bStrings[]   = { "ZNAM", "ONAM" };
+    const std::string rtype(getRecordType());
+
+    Item *item = pitem;
+    ItemMetadata meta;
+    {
+        Guard G(metadataLock);
+        meta = queuedMetadata;
+        metadataQueued = false;
+    }
+
+    // A connector retired by a runtime link change does not touch the record any more
+    if (prec->dpvt != this) {
+        item->releaseReference();
+        return;
+    }
+
+    dbScanLock(prec);
+    if (meta.hasUnits)
+        putRecordField(prec, "EGU", meta.units);
+    if (meta.hasRange) {
+        putRecordField(prec, "HOPR", meta.rangeHigh);
+        putRecordField(prec, "LOPR", meta.rangeLow);
+    }
+    if (meta.hasDescription && meta.description.length())
+        putRecordField(prec, "DESC", meta.description);
+    if (rtype == "mbbi" || rtype == "mbbo") {
+        size_t i = 0;
+        for (const auto &choice : meta.enumChoices) {
+            if (i >= sizeof(mbbStrings) / sizeof(mbbStrings[0])) {
+                errlogPrintf("%s : server defines %lu enum states - ignoring all beyond %lu\n",
+                             prec->name, static_cast<unsigned long>(meta.enumChoices.size()),
+                             static_cast<unsigned long>(i));
+                break;
+            }
+            putRecordField(prec, mbbValues[i], static_cast<double>(choice.first));
+            putRecordField(prec, mbbStrings[i], choice.second);
+            i++;
+        }
+    } else if (rtype == "bi" || rtype == "bo") {
+        for (const auto &choice : meta.enumChoices)
+            if (choice.first == 0 || choice.first == 1)
+                putRecordField(prec, bStrings[choice.first], choice.second);
+    }
+    dbScanUnlock(prec);
+
+    if (debug())
+        std::cout << prec->name << " : applied server metadata"
+                  << (meta.hasUnits ? " EGU" : "")
+                  << (meta.hasRange ? " HOPR/LOPR" : "")
+                  << (meta.hasDescription ? " DESC" : "")
+                  << (meta.enumChoices.size() ? " states" : "")
+                  << std::endl;
+    item->releaseReference();
 }
 
 RecordConnector *
@@ -244,4 +454,56 @@ RecordConnector::glob(const std::string &pattern)
     return result;
 }
 
+// Retired connectors whose items are no longer referenced, deleted by a callback
+static epicsMutex retiredLock;
+static std::vector<RecordConnector *> retired;
+static epicsCallback retiredCallback;
+
+static void
+deleteRetired (epicsCallback *)
+{
+    std::vector<RecordConnector *> expired;
+    {
+        Guard G(retiredLock);
+        expired.swap(retired);
+    }
+    for (auto it : expired) {
+        // the item references the connector's linkinfo: delete it first
+        if (it->plinkinfo->linkedToItem)
+            delete it->pitem;
+        delete it;
+    }
+}
+
+void
+RecordConnector::retire (RecordConnector *pcon)
+{
+    pcon->pitem->releaseReference();
+}
+
+void
+RecordConnector::deleteLater (RecordConnector *pcon)
+{
+    bool request;
+    {
+        Guard G(retiredLock);
+        retired.push_back(pcon);
+        request = retired.size() == 1;
+    }
+    if (request) {
+        callbackSetCallback(deleteRetired, &retiredCallback);
+        callbackSetPriority(priorityLow, &retiredCallback);
+        callbackRequest(&retiredCallback);
+    }
+}
+
+// Called from any thread: the item must not be touched after the decrement
+void
+Item::releaseReference ()
+{
+    RecordConnector *pcon = recConnector;
+    if (--references == 0)
+        RecordConnector::deleteLater(pcon);
+}
+
 } // namespace DevOpcua
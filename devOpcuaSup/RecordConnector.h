@@ -18,6 +18,8 @@
 #include <cstddef>
 #include <iostream>
 #include <set>
+#include <vector>
+#include <utility>
 
 #include <epicsMutex.h>
 #include <dbCommon.h>
@@ -98,6 +100,55 @@ public:
     void clearDataElement() { pdataelement = nullptr; }
 
     void requestRecordProcessing(const ProcessReason reason);
+
+    /**
+     * @brief Process the record (record processing callback).
+     *
+     * Releases the item reference taken by requestRecordProcessing().
+     *
+     * @param reason  reason for processing
+     */
+    void processRequested(const ProcessReason reason);
+
+    /**
+     * @brief Queue a record of this connector's item for item-level processing.
+     *
+     * Used on the connector of an opcuaItemRecord with link option itemproc=y:
+     * the records of an item update are collected and processed in sequence
+     * by a single callback (using the opcuaItemRecord's priority).
+     * The queued record and the callback hold a reference to their items.
+     *
+     * @param pcon  connector of the record to process
+     * @param reason  reason for processing
+     */
+    void queueItemProcessing(RecordConnector *pcon, const ProcessReason reason);
+
+    /**
+     * @brief Process all queued records (item-level processing callback).
+     *
+     * Records of retired connectors are skipped (see processRequested()).
+     */
+    void processQueuedRecords();
+
+    /**
+     * @brief Apply node metadata to the matching record fields.
+     *
+     * Sets EGU, HOPR/LOPR, DESC and the state strings/values of bi/bo/mbbi/mbbo
+     * records (where present in the metadata and the record type).
+     * The metadata is copied and applied by a callback holding the record lock
+     * (like incoming data), so this can be called from the client thread.
+     *
+     * @param meta  metadata to apply
+     */
+    void applyMetadata(const ItemMetadata &meta);
+
+    /**
+     * @brief Set the record fields from the queued metadata (metadata callback).
+     *
+     * Releases the item reference taken by applyMetadata().
+     * Records of retired connectors are not touched (see processRequested()).
+     */
+    void applyQueuedMetadata();
     void requestOpcuaRead() { pitem->requestRead(); }
     void requestOpcuaWrite() { pitem->requestWrite(); }
 
@@ -139,6 +190,26 @@ public:
      */
     static std::set<RecordConnector *> glob(const std::string &pattern);
 
+    /**
+     * @brief Retire a record connector that was detached from its record (runtime link change).
+     *
+     * Queued callbacks, requests and notifications may still reference the connector
+     * and its item. The connector releases its own reference to the item; the connector
+     * and its item are deleted when the last reference is released (see Item::addReference).
+     *
+     * @param pcon  connector to retire
+     */
+    static void retire(RecordConnector *pcon);
+
+    /**
+     * @brief Delete a retired record connector and its item in a callback thread.
+     *
+     * Called when the last reference to the item has been released.
+     *
+     * @param pcon  connector to delete
+     */
+    static void deleteLater(RecordConnector *pcon);
+
     epicsMutex lock;
     std::unique_ptr<linkInfo> plinkinfo;
     Item *pitem;
@@ -156,6 +227,14 @@ private:
     epicsCallback writeFailureCallback;
     epicsCallback readRequestCallback;
     epicsCallback writeRequestCallback;
+    epicsCallback itemProcCallback;
+    epicsMutex itemProcLock;
+    std::vector<std::pair<RecordConnector *, ProcessReason>> itemProcPending;   /**< records waiting for item-level processing */
+    bool itemProcScheduled;                                                     /**< item-level processing callback requested */
+    epicsCallback metadataCallback;
+    epicsMutex metadataLock;
+    ItemMetadata queuedMetadata;                                                /**< metadata waiting for the metadata callback */
+    bool metadataQueued;                                                        /**< metadata callback requested */
 };
 
 } // namespace DevOpcua
@@ -162,6 +162,18 @@ public:
      */
     virtual void addNamespaceMapping(const unsigned short nsIndex, const std::string &uri) = 0;
 
+    /**
+     * @brief Read all items of a snapshot group in one read service call.
+     *
+     * The items are assigned to snapshot groups by the 'snapshot' link option.
+     * All their records are processed from the same response.
+     *
+     * @param group  name of the snapshot group
+     *
+     * @return  number of items in the read request (0 = none or not supported)
+     */
+    virtual unsigned int readSnapshot(const std::string &group) { return 0; }
+
     /**
      * @brief Factory method to create a session (implementation specific).
      *
@@ -24,6 +24,24 @@ namespace DevOpcua {
 
 class Session;
 
+/**
+ * @brief Counters of lost updates of a subscription, on the server and in the IOC.
+ *
+ * The item counters are summed up over the items of the subscription.
+ * The server counters are taken from the server's SubscriptionDiagnostics
+ * (subscription option diag), if the server provides them.
+ */
+struct SubscriptionCounters {
+    epicsUInt32 itemOverflows = 0;          /**< values with the Overflow InfoBit set */
+    epicsUInt32 clientDrops = 0;            /**< updates discarded by client side update queues */
+    bool hasServerDiagnostics = false;      /**< server counters valid */
+    epicsUInt32 monitoringQueueOverflows = 0; /**< MonitoringQueueOverflowCount */
+    epicsUInt32 discardedMessages = 0;      /**< DiscardedMessageCount */
+    epicsUInt32 latePublishRequests = 0;    /**< LatePublishRequestCount */
+    epicsUInt32 unacknowledgedMessages = 0; /**< UnacknowledgedMessageCount */
+    epicsUInt32 dataChangeNotifications = 0; /**< DataChangeNotificationsCount */
+};
+
 /**
  * @brief The Subscription interface for a UA client created subscription.
  *
@@ -84,6 +102,13 @@ public:
      */
     virtual Session & getSession() const = 0;
 
+    /**
+     * @brief Get the counters of lost updates.
+     *
+     * @param[out] counters  counters of the subscription
+     */
+    virtual void getCounters(SubscriptionCounters &counters) const = 0;
+
     /**
      * @brief Find a subscription by name (implementation specific).
      *
@@ -34,6 +34,8 @@
 
 namespace DevOpcua {
 
+const bool DataElement::jsonSupported = false;
+
 /* Specific implementation of DataElement's "factory" method */
 void
 DataElement::addElementToTree(Item *item,
@@ -94,7 +96,10 @@ DataElementUaSdk::show (const int level, const unsigned int indent) const
         if (pconnector->plinkinfo->timestamp == LinkOptionTimestamp::data)
             std::cout << "@" << pitem->linkinfo.timestampElement;
         std::cout << " bini=" << linkOptionBiniString(pconnector->plinkinfo->bini)
-                  << " monitor=" << (pconnector->plinkinfo->monitor ? "y" : "n") << "\n";
+                  << " monitor=" << (pconnector->plinkinfo->monitor ? "y" : "n");
+        if (unsigned long n = incomingQueue.discarded())
+            std::cout << " dropped=" << n;
+        std::cout << "\n";
     } else {
         std::cout << "node=" << name << " children=" << elements.size()
                   << " mapped=" << (mapped ? "y" : "n") << "\n";
@@ -106,8 +111,23 @@ DataElementUaSdk::show (const int level, const unsigned int indent) const
     }
 }
 
+unsigned long
+DataElementUaSdk::discardedUpdates () const
+{
+    if (isLeaf())
+        return incomingQueue.discarded();
+    unsigned long n = 0;
+    for (auto it : elements) {
+        if (auto pelem = it.lock())
+            n += pelem->discardedUpdates();
+    }
+    return n;
+}
+
 // Getting the timestamp and status information from the Item assumes that only one thread
 // is pushing data into the Item's DataElement structure at any time.
+// The incoming queue of a leaf is lock-free (single producer, single consumer),
+// so no lock is needed for pushing the update.
 void
 DataElementUaSdk::setIncomingData(const UaVariant &value,
                                   ProcessReason reason,
@@ -120,7 +140,6 @@ DataElementUaSdk::setIncomingData(const UaVariant &value,
         if ((pitem->state() == ConnectionStatus::initialRead
              && (reason == ProcessReason::readComplete || reason == ProcessReason::readFailure))
             || (pitem->state() == ConnectionStatus::up)) {
-            Guard(pconnector->lock);
             bool wasFirst = false;
             // Make a copy of the value for this element and put it on the queue
             UpdateUaSdk *u(new UpdateUaSdk(getIncomingTimeStamp(), reason, value, getIncomingReadStatus()));
@@ -223,7 +242,6 @@ void
 DataElementUaSdk::setIncomingEvent (ProcessReason reason)
 {
     if (isLeaf()) {
-        Guard(pconnector->lock);
         bool wasFirst = false;
         // Put the event on the queue
         UpdateUaSdk *u(new UpdateUaSdk(getIncomingTimeStamp(), reason));
@@ -440,7 +458,8 @@ DataElementUaSdk::readScalar (char *value, const size_t num,
     long ret = 0;
 
     if (incomingQueue.empty()) {
-        errlogPrintf("%s: incoming data queue empty\n", prec->name);
+        if (reportError(ErrorClass::incomingQueueEmpty, prec))
+            errlogPrintf("%s: incoming data queue empty\n", prec->name);
         if (nextReason)
             *nextReason = ProcessReason::none;
         return 1;
@@ -539,7 +558,8 @@ DataElementUaSdk::readArray (char *value, const epicsUInt32 len,
     epicsUInt32 elemsWritten = 0;
 
     if (incomingQueue.empty()) {
-        errlogPrintf("%s : incoming data queue empty\n", prec->name);
+        if (reportError(ErrorClass::incomingQueueEmpty, prec))
+            errlogPrintf("%s : incoming data queue empty\n", prec->name);
         *numRead = 0;
         return 1;
     }
@@ -570,12 +590,14 @@ DataElementUaSdk::readArray (char *value, const epicsUInt32 len,
                 // Valid OPC UA value, so try to convert
                 UaVariant &data = upd->getData();
                 if (!data.isArray()) {
-                    errlogPrintf("%s : incoming data is not an array\n", prec->name);
+                    if (reportError(ErrorClass::incomingType, prec))
+                        errlogPrintf("%s : incoming data is not an array\n", prec->name);
                     (void) recGblSetSevr(prec, READ_ALARM, INVALID_ALARM);
                     ret = 1;
                 } else if (data.type() != expectedType) {
-                    errlogPrintf("%s : incoming data type (%s) does not match EPICS array type (%s)\n",
-                                 prec->name, variantTypeString(data.type()), epicsTypeString(value));
+                    if (reportError(ErrorClass::incomingType, prec))
+                        errlogPrintf("%s : incoming data type (%s) does not match EPICS array type (%s)\n",
+                                     prec->name, variantTypeString(data.type()), epicsTypeString(value));
                     (void) recGblSetSevr(prec, READ_ALARM, INVALID_ALARM);
                     ret = 1;
                 } else {
@@ -629,7 +651,8 @@ DataElementUaSdk::readArray<epicsUInt8, UaByteArray> (epicsUInt8 *value, const e
     epicsUInt32 elemsWritten = 0;
 
     if (incomingQueue.empty()) {
-        errlogPrintf("%s : incoming data queue empty\n", prec->name);
+        if (reportError(ErrorClass::incomingQueueEmpty, prec))
+            errlogPrintf("%s : incoming data queue empty\n", prec->name);
         *numRead = 0;
         return 1;
     }
@@ -660,12 +683,14 @@ DataElementUaSdk::readArray<epicsUInt8, UaByteArray> (epicsUInt8 *value, const e
                 // Valid OPC UA value, so try to convert
                 UaVariant &data = upd->getData();
                 if (!data.isArray()) {
-                    errlogPrintf("%s : incoming data is not an array\n", prec->name);
+                    if (reportError(ErrorClass::incomingType, prec))
+                        errlogPrintf("%s : incoming data is not an array\n", prec->name);
                     (void) recGblSetSevr(prec, READ_ALARM, INVALID_ALARM);
                     ret = 1;
                 } else if (data.type() != expectedType) {
-                    errlogPrintf("%s : incoming data type (%s) does not match EPICS array type (%s)\n",
-                                 prec->name, variantTypeString(data.type()), epicsTypeString(*value));
+                    if (reportError(ErrorClass::incomingType, prec))
+                        errlogPrintf("%s : incoming data type (%s) does not match EPICS array type (%s)\n",
+                                     prec->name, variantTypeString(data.type()), epicsTypeString(*value));
                     (void) recGblSetSevr(prec, READ_ALARM, INVALID_ALARM);
                     ret = 1;
                 } else {
@@ -1015,8 +1040,9 @@ DataElementUaSdk::writeScalar (const char *value, const epicsUInt32 len, dbCommo
         break;
     }
     default:
-        errlogPrintf("%s : unsupported conversion for outgoing data\n",
-                     prec->name);
+        if (reportError(ErrorClass::outgoingConversion, prec))
+            errlogPrintf("%s : unsupported conversion for outgoing data\n",
+                         prec->name);
         (void) recGblSetSevr(prec, WRITE_ALARM, INVALID_ALARM);
     }
 
@@ -1046,15 +1072,17 @@ DataElementUaSdk::writeArray (const char **value, const epicsUInt32 len,
     long ret = 0;
 
     if (!incomingData.isArray()) {
-        errlogPrintf("%s : OPC UA data type is not an array\n", prec->name);
+        if (reportError(ErrorClass::outgoingConversion, prec))
+            errlogPrintf("%s : OPC UA data type is not an array\n", prec->name);
         (void) recGblSetSevr(prec, WRITE_ALARM, INVALID_ALARM);
         ret = 1;
     } else if (incomingData.type() != targetType) {
-        errlogPrintf("%s : OPC UA data type (%s) does not match expected type (%s) for EPICS array (%s)\n",
-                     prec->name,
-                     variantTypeString(incomingData.type()),
-                     variantTypeString(targetType),
-                     epicsTypeString(*value));
+        if (reportError(ErrorClass::outgoingConversion, prec))
+            errlogPrintf("%s : OPC UA data type (%s) does not match expected type (%s) for EPICS array (%s)\n",
+                         prec->name,
+                         variantTypeString(incomingData.type()),
+                         variantTypeString(targetType),
+                         epicsTypeString(*value));
         (void) recGblSetSevr(prec, WRITE_ALARM, INVALID_ALARM);
         ret = 1;
     } else {
@@ -1098,15 +1126,17 @@ DataElementUaSdk::writeArray<epicsUInt8, UaByteArray, OpcUa_Byte> (const epicsUI
     long ret = 0;
 
     if (!incomingData.isArray()) {
-        errlogPrintf("%s : OPC UA data type is not an array\n", prec->name);
+        if (reportError(ErrorClass::outgoingConversion, prec))
+            errlogPrintf("%s : OPC UA data type is not an array\n", prec->name);
         (void) recGblSetSevr(prec, WRITE_ALARM, INVALID_ALARM);
         ret = 1;
     } else if (incomingData.type() != targetType) {
-        errlogPrintf("%s : OPC UA data type (%s) does not match expected type (%s) for EPICS array (%s)\n",
-                     prec->name,
-                     variantTypeString(incomingData.type()),
-                     variantTypeString(targetType),
-                     epicsTypeString(*value));
+        if (reportError(ErrorClass::outgoingConversion, prec))
+            errlogPrintf("%s : OPC UA data type (%s) does not match expected type (%s) for EPICS array (%s)\n",
+                         prec->name,
+                         variantTypeString(incomingData.type()),
+                         variantTypeString(targetType),
+                         epicsTypeString(*value));
         (void) recGblSetSevr(prec, WRITE_ALARM, INVALID_ALARM);
         ret = 1;
     } else {
@@ -27,6 +27,7 @@
 #include "RecordConnector.h"
 #include "Update.h"
 #include "UpdateQueue.h"
+#include "ErrorReporter.h"
 #include "ItemUaSdk.h"
 
 namespace DevOpcua {
@@ -225,6 +226,13 @@ public:
      */
     void show(const int level, const unsigned int indent) const override;
 
+    /**
+     * @brief Get the number of updates discarded by client side queue overflows.
+     *
+     * @return  discarded updates of this leaf, or of all leaves below this node
+     */
+    unsigned long discardedUpdates() const;
+
     /**
      * @brief Push an incoming data value into the DataElement.
      *
@@ -758,7 +766,8 @@ private:
         long ret = 0;
 
         if (incomingQueue.empty()) {
-            errlogPrintf("%s: incoming data queue empty\n", prec->name);
+            if (reportError(ErrorClass::incomingQueueEmpty, prec))
+                errlogPrintf("%s: incoming data queue empty\n", prec->name);
             if (nextReason)
                 *nextReason = ProcessReason::none;
             return 1;
@@ -790,9 +799,10 @@ private:
                     // Valid OPC UA value, so try to convert
                     OT v;
                     if (OpcUa_IsNotGood(UaVariant_to(upd->getData(), v))) {
-                        errlogPrintf("%s : incoming data (%s) out-of-bounds\n",
-                                     prec->name,
-                                     upd->getData().toString().toUtf8());
+                        if (reportError(ErrorClass::incomingOutOfBounds, prec))
+                            errlogPrintf("%s : incoming data (%s) out-of-bounds\n",
+                                         prec->name,
+                                         upd->getData().toString().toUtf8());
                         (void) recGblSetSevr(prec, READ_ALARM, INVALID_ALARM);
                     } else {
                         if (OpcUa_IsUncertain(stat)) {
@@ -837,7 +847,8 @@ private:
         epicsUInt32 elemsWritten = 0;
 
         if (incomingQueue.empty()) {
-            errlogPrintf("%s : incoming data queue empty\n", prec->name);
+            if (reportError(ErrorClass::incomingQueueEmpty, prec))
+                errlogPrintf("%s : incoming data queue empty\n", prec->name);
             *numRead = 0;
             return 1;
         }
@@ -868,12 +879,14 @@ private:
                     // Valid OPC UA value, so try to convert
                     UaVariant &data = upd->getData();
                     if (!data.isArray()) {
-                        errlogPrintf("%s : incoming data is not an array\n", prec->name);
+                        if (reportError(ErrorClass::incomingType, prec))
+                            errlogPrintf("%s : incoming data is not an array\n", prec->name);
                         (void) recGblSetSevr(prec, READ_ALARM, INVALID_ALARM);
                         ret = 1;
                     } else if (data.type() != expectedType) {
-                        errlogPrintf("%s : incoming data type (%s) does not match EPICS array type (%s)\n",
-                                     prec->name, variantTypeString(data.type()), epicsTypeString(*value));
+                        if (reportError(ErrorClass::incomingType, prec))
+                            errlogPrintf("%s : incoming data type (%s) does not match EPICS array type (%s)\n",
+                                         prec->name, variantTypeString(data.type()), epicsTypeString(*value));
                         (void) recGblSetSevr(prec, READ_ALARM, INVALID_ALARM);
                         ret = 1;
                     } else {
@@ -1045,8 +1058,9 @@ private:
             break;
         }
         default:
-            errlogPrintf("%s : unsupported conversion for outgoing data\n",
-                         prec->name);
+            if (reportError(ErrorClass::outgoingConversion, prec))
+                errlogPrintf("%s : unsupported conversion for outgoing data\n",
+                             prec->name);
             (void) recGblSetSevr(prec, WRITE_ALARM, INVALID_ALARM);
         }
 
@@ -1073,15 +1087,17 @@ private:
         long ret = 0;
 
         if (!incomingData.isArray()) {
-            errlogPrintf("%s : OPC UA data type is not an array\n", prec->name);
+            if (reportError(ErrorClass::outgoingConversion, prec))
+                errlogPrintf("%s : OPC UA data type is not an array\n", prec->name);
             (void) recGblSetSevr(prec, WRITE_ALARM, INVALID_ALARM);
             ret = 1;
         } else if (incomingData.type() != targetType) {
-            errlogPrintf("%s : OPC UA data type (%s) does not match expected type (%s) for EPICS array (%s)\n",
-                         prec->name,
-                         variantTypeString(incomingData.type()),
-                         variantTypeString(targetType),
-                         epicsTypeString(*value));
+            if (reportError(ErrorClass::outgoingConversion, prec))
+                errlogPrintf("%s : OPC UA data type (%s) does not match expected type (%s) for EPICS array (%s)\n",
+                             prec->name,
+                             variantTypeString(incomingData.type()),
+                             variantTypeString(targetType),
+                             epicsTypeString(*value));
             (void) recGblSetSevr(prec, WRITE_ALARM, INVALID_ALARM);
             ret = 1;
         } else {
@@ -20,6 +20,7 @@
 
 #include "devOpcua.h"
 #include "RecordConnector.h"
+#include "ErrorReporter.h"
 #include "opcuaItemRecord.h"
 #include "ItemUaSdk.h"
 #include "SubscriptionUaSdk.h"
@@ -46,6 +47,7 @@ ItemUaSdk::ItemUaSdk(const linkInfo &info)
     , revisedQueueSize(0)
     , dataTree(this)
     , dataTreeDirty(false)
+    , overflows(0)
     , lastStatus(OpcUa_BadServerNotConnected)
     , lastReason(ProcessReason::connectionLoss)
     , connState(ConnectionStatus::down)
@@ -57,7 +59,14 @@ ItemUaSdk::ItemUaSdk(const linkInfo &info)
     } else {
         session = SessionUaSdk::find(linkinfo.session);
     }
-    session->addItemUaSdk(this);
+    try {
+        session->addItemUaSdk(this);
+    } catch (...) {
+        // write group bound to another session
+        if (subscription)
+            subscription->removeItemUaSdk(this);
+        throw;
+    }
 }
 
 ItemUaSdk::~ItemUaSdk ()
@@ -115,7 +124,16 @@ ItemUaSdk::show (int level) const
               << " output=" << (linkinfo.isOutput ? "y" : "n")
               << " monitor=" << (linkinfo.monitor ? "y" : "n")
               << " registered=" << (registered ? nodeid->toString().toUtf8() : "-") << "("
-              << (linkinfo.registerNode ? "y" : "n") << ")" << std::endl;
+              << (linkinfo.registerNode ? "y" : "n") << ")";
+    if (linkinfo.writeGroup.length())
+        std::cout << " group=" << linkinfo.writeGroup << (linkinfo.groupTrigger ? "(trigger)" : "");
+    if (linkinfo.itemProcessing)
+        std::cout << " itemproc=y";
+    epicsUInt32 serverOverflows, clientDrops;
+    getOverflowCounts(&serverOverflows, &clientDrops);
+    if (serverOverflows || clientDrops)
+        std::cout << " overflows=" << serverOverflows << "(server)/" << clientDrops << "(client)";
+    std::cout << std::endl;
 
     if (level >= 1) {
         if (auto re = dataTree.root().lock()) {
@@ -163,7 +181,8 @@ ItemUaSdk::setIncomingData(const OpcUa_DataValue &value, ProcessReason reason)
         tsData = tsClient;
     }
     setReason(reason);
-    if (getLastStatus() == OpcUa_BadServerNotConnected && value.StatusCode == OpcUa_BadNodeIdUnknown)
+    if (getLastStatus() == OpcUa_BadServerNotConnected && value.StatusCode == OpcUa_BadNodeIdUnknown
+            && reportError(ErrorClass::nodeIdUnknown, session, "OPC UA session " + session->getName()))
         errlogPrintf("OPC UA session %s: item ns=%d;%s%.*d%s : BadNodeIdUnknown\n",
                      session->getName().c_str(),
                      linkinfo.namespaceIndex,
@@ -174,6 +193,11 @@ ItemUaSdk::setIncomingData(const OpcUa_DataValue &value, ProcessReason reason)
 
     setLastStatus(value.StatusCode);
 
+    // The server's monitored item queue overflowed: values were lost before this one
+    // (StatusCode InfoType DataValue 0x400, InfoBit Overflow 0x80)
+    if ((value.StatusCode & 0x480) == 0x480)
+        overflows++;
+
     if (auto pd = dataTree.root().lock()) {
         const std::string *timefrom = nullptr;
         if (linkinfo.timestamp == LinkOptionTimestamp::data && linkinfo.timestampElement.length())
@@ -193,6 +217,15 @@ ItemUaSdk::setIncomingData(const OpcUa_DataValue &value, ProcessReason reason)
     }
 }
 
+void
+ItemUaSdk::getOverflowCounts (epicsUInt32 *serverOverflows, epicsUInt32 *clientDrops) const
+{
+    *serverOverflows = overflows;
+    *clientDrops = 0;
+    if (auto pd = dataTree.root().lock())
+        *clientDrops = static_cast<epicsUInt32>(pd->discardedUpdates());
+}
+
 void
 ItemUaSdk::setIncomingEvent(const ProcessReason reason)
 {
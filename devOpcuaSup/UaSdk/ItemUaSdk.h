@@ -86,6 +86,11 @@ public:
      */
     virtual bool isMonitored() const override { return !!subscription; }
 
+    /**
+     * @brief Get counters of lost updates. See DevOpcua::Item::getOverflowCounts
+     */
+    virtual void getOverflowCounts(epicsUInt32 *serverOverflows, epicsUInt32 *clientDrops) const override;
+
     /**
      * @brief Return OPC UA status code and text.
      * See DevOpcua::Item::getStatus
@@ -229,6 +234,7 @@ private:
     ElementTree<DataElementUaSdk, ItemUaSdk> dataTree; /**< data element tree */
     epicsMutex dataTreeWriteLock;           /**< lock for dirty flag */
     bool dataTreeDirty;                    /**< true if any element has been modified */
+    epicsUInt32 overflows;                 /**< values received with the Overflow InfoBit */
     UaStatusCode lastStatus;               /**< status code of most recent service */
     ProcessReason lastReason;              /**< most recent processing reason */
     ConnectionStatus connState;            /**< Connection state of the item */
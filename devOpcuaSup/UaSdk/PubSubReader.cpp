@@ -0,0 +1,49 @@
+/*************************************************************************\
+* Copyright (c) 2026 ITER Organization.
+* This module is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Author: Dirk Zimoch <dirk.zimoch@psi.ch>
+ */
+
+#include <errlog.h>
+
+#define epicsExportSharedSymbols
+#include "PubSubReader.h"
+
+// The UA SDK client implementation does not support PubSub.
+
+namespace DevOpcua {
+
+PubSubReader::~PubSubReader() {}
+
+PubSubReader *
+PubSubReader::createPubSubReader(const std::string &name,
+                                 const std::string &url)
+{
+    errlogPrintf("OPC UA PubSub is not supported by the UA SDK client implementation\n");
+    return nullptr;
+}
+
+PubSubReader *
+PubSubReader::find (const std::string &name)
+{
+    return nullptr;
+}
+
+std::set<PubSubReader *>
+PubSubReader::glob(const std::string &pattern)
+{
+    return std::set<PubSubReader *>();
+}
+
+void
+PubSubReader::showAll (const int level)
+{}
+
+const char PubSubReader::optionUsage[]
+    = "OPC UA PubSub is not supported by the UA SDK client implementation\n";
+
+} // namespace DevOpcua
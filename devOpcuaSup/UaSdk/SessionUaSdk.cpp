@@ -20,6 +20,7 @@
 #include <utility>
 #include <vector>
 #include <limits>
+#include <stdexcept>
 
 #include <sys/types.h>
 #include <sys/stat.h>
@@ -50,6 +51,7 @@
 #include "RecordConnector.h"
 #include "linkParser.h"
 #include "RequestQueueBatcher.h"
+#include "ErrorReporter.h"
 #include "SessionUaSdk.h"
 #include "SubscriptionUaSdk.h"
 #include "DataElementUaSdk.h"
@@ -63,11 +65,13 @@ static epicsThreadOnceId session_uasdk_ihooks_once = EPICS_THREAD_ONCE_INIT;
 static epicsThreadOnceId session_uasdk_atexit_once = EPICS_THREAD_ONCE_INIT;
 
 Registry<SessionUaSdk> SessionUaSdk::sessions;
+epicsMutex SessionUaSdk::writeGroupsBindLock;
 
 // Cargo structure and batcher for write requests
 struct WriteRequest {
     ItemUaSdk *item;
     OpcUa_WriteValue wvalue;
+    std::vector<std::shared_ptr<WriteRequest>> group;  // write group (item == nullptr): sent in one request
 };
 
 // Cargo structure and batcher for read requests
@@ -424,10 +428,11 @@ SessionUaSdk::processRequests(std::vector<std::shared_ptr<ReadRequest>> &batch)
                                        id);                            // Transaction id
 
         if (status.isBad()) {
-            errlogPrintf(
-                "OPC UA session %s: (requestRead) beginRead service failed with status %s\n",
-                name.c_str(),
-                status.toString().toUtf8());
+            if (reportError(ErrorClass::readService, this, "OPC UA session " + name))
+                errlogPrintf(
+                    "OPC UA session %s: (requestRead) beginRead service failed with status %s\n",
+                    name.c_str(),
+                    status.toString().toUtf8());
             //TODO: create writeFailure events for all items of the batch
             //	    item.setIncomingEvent(ProcessReason::readFailure);
         } else {
@@ -448,6 +453,28 @@ SessionUaSdk::requestWrite (ItemUaSdk &item)
     auto cargo = std::make_shared<WriteRequest>();
     cargo->item = &item;
     item.copyAndClearOutgoingData(cargo->wvalue);
+
+    if (item.linkinfo.writeGroup.length()) {
+        // Hold the write until the group trigger is written
+        Guard G(writeGroupsLock);
+        auto &held = writeGroups[item.linkinfo.writeGroup].held;
+        held.push_back(cargo);
+        if (!item.linkinfo.groupTrigger)
+            return;
+
+        // The group is pushed as a single cargo, so that the batcher does not split it
+        auto group = std::make_shared<WriteRequest>();
+        group->item = nullptr;
+        group->group.swap(held);
+        if (debug >= 5)
+            std::cout << "Session " << name.c_str()
+                      << ": (requestWrite) write group " << item.linkinfo.writeGroup
+                      << " triggered (" << group->group.size() << " nodes)"
+                      << std::endl;
+        writer.pushRequest(group, item.recConnector->getRecordPriority());
+        return;
+    }
+
     writer.pushRequest(cargo, item.recConnector->getRecordPriority());
 }
 
@@ -458,6 +485,21 @@ SessionUaSdk::processRequests(std::vector<std::shared_ptr<WriteRequest>> &batch)
     if (!isConnected())
         return;
 
+    // Each write group goes into a service call of its own
+    std::vector<std::shared_ptr<WriteRequest>> singles;
+    for (auto &c : batch) {
+        if (c->item)
+            singles.push_back(c);
+        else
+            sendWriteRequest(c->group);
+    }
+    if (singles.size())
+        sendWriteRequest(singles);
+}
+
+void
+SessionUaSdk::sendWriteRequest(std::vector<std::shared_ptr<WriteRequest>> &batch)
+{
     UaStatus status;
     UaWriteValues nodesToWrite;
     std::unique_ptr<std::vector<ItemUaSdk *>> itemsToWrite(new std::vector<ItemUaSdk *>);
@@ -481,10 +523,11 @@ SessionUaSdk::processRequests(std::vector<std::shared_ptr<WriteRequest>> &batch)
                                         id);             // Transaction id
 
         if (status.isBad()) {
-            errlogPrintf(
-                "OPC UA session %s: (requestWrite) beginWrite service failed with status %s\n",
-                name.c_str(),
-                status.toString().toUtf8());
+            if (reportError(ErrorClass::writeService, this, "OPC UA session " + name))
+                errlogPrintf(
+                    "OPC UA session %s: (requestWrite) beginWrite service failed with status %s\n",
+                    name.c_str(),
+                    status.toString().toUtf8());
             //TODO: create writeFailure events for all items of the batch
             //	    item.setIncomingEvent(ProcessReason::writeFailure);
         } else {
@@ -981,6 +1024,23 @@ SessionUaSdk::show (const int level) const
 void
 SessionUaSdk::addItemUaSdk (ItemUaSdk *item)
 {
+    const std::string &groupName = item->linkinfo.writeGroup;
+    if (groupName.length()) {
+        // The members of a write group must be on the same session
+        Guard B(writeGroupsBindLock);
+        for (auto &it : sessions) {
+            if (it.second == this)
+                continue;
+            Guard G(it.second->writeGroupsLock);
+            auto group = it.second->writeGroups.find(groupName);
+            if (group != it.second->writeGroups.end() && group->second.members)
+                throw std::runtime_error(SB() << "write group " << groupName
+                                         << " is used on session " << it.first
+                                         << " (members of a group must use the same session)");
+        }
+        Guard G(writeGroupsLock);
+        writeGroups[groupName].members++;
+    }
     items.push_back(item);
 }
 
@@ -988,8 +1048,27 @@ void
 SessionUaSdk::removeItemUaSdk (ItemUaSdk *item)
 {
     auto it = std::find(items.begin(), items.end(), item);
-    if (it != items.end())
-        items.erase(it);
+    if (it == items.end())
+        return;
+    items.erase(it);
+    if (item->linkinfo.writeGroup.length()) {
+        Guard G(writeGroupsLock);
+        auto group = writeGroups.find(item->linkinfo.writeGroup);
+        if (group != writeGroups.end()) {
+            auto &held = group->second.held;
+            for (auto c = held.begin(); c != held.end(); ) {
+                if ((*c)->item == item) {
+                    OpcUa_WriteValue_Clear(&(*c)->wvalue);
+                    c = held.erase(c);
+                } else {
+                    ++c;
+                }
+            }
+            // The last member releases the group (and its binding to this session)
+            if (group->second.members && --group->second.members == 0)
+                writeGroups.erase(group);
+        }
+    }
 }
 
 OpcUa_UInt16
@@ -1009,6 +1088,14 @@ SessionUaSdk::markConnectionLoss()
 {
     reader.clear();
     writer.clear();
+    {
+        Guard G(writeGroupsLock);
+        for (auto &group : writeGroups) {
+            for (auto &c : group.second.held)
+                OpcUa_WriteValue_Clear(&c->wvalue);
+            group.second.held.clear();
+        }
+    }
     for (auto it : items) {
         it->setState(ConnectionStatus::down);
         it->setIncomingEvent(ProcessReason::connectionLoss);
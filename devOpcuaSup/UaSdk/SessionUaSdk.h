@@ -193,13 +193,20 @@ public:
     /**
      * @brief Add an item to the session.
      *
+     * An item of a write group binds the group to this session,
+     * until the last member of the group is removed.
+     *
      * @param item  item to add
+     *
+     * @throws std::runtime_error if the item's write group has members on another session
      */
     void addItemUaSdk(ItemUaSdk *item);
 
     /**
      * @brief Remove an item from the session.
      *
+     * Held writes of the item are dropped.
+     *
      * @param item  item to remove
      */
     void removeItemUaSdk(ItemUaSdk *item);
@@ -255,6 +262,9 @@ public:
     virtual void processRequests(std::vector<std::shared_ptr<WriteRequest>> &batch) override;
     virtual void processRequests(std::vector<std::shared_ptr<ReadRequest>> &batch) override;
 
+    // Send a batch of write requests in one service call
+    void sendWriteRequest(std::vector<std::shared_ptr<WriteRequest>> &batch);
+
     /**
      * @brief Setup ClientSecurityInfo object from PKI store locations and cert files
      */
@@ -325,6 +335,14 @@ private:
     epicsMutex opslock;                                       /**< lock for outstandingOps map */
 
     RequestQueueBatcher<WriteRequest> writer;                 /**< batcher for write requests */
+    /** a write group on this session */
+    struct WriteGroup {
+        unsigned int members = 0;                             /**< items of the group */
+        std::vector<std::shared_ptr<WriteRequest>> held;      /**< writes held until the trigger is written */
+    };
+    std::map<std::string, WriteGroup> writeGroups;            /**< write groups, indexed by group name */
+    epicsMutex writeGroupsLock;                               /**< lock for writeGroups map */
+    static epicsMutex writeGroupsBindLock;                    /**< serializes binding groups to sessions */
     unsigned int writeNodesMax;                               /**< max number of nodes per write request */
     unsigned int writeTimeoutMin;                             /**< timeout after write request batch of 1 node [ms] */
     unsigned int writeTimeoutMax;                             /**< timeout after write request of NodesMax nodes [ms] */
@@ -96,8 +96,13 @@ SubscriptionUaSdk::show (int level) const
               << " enable=" << (puasubscription ? (puasubscription->publishingEnabled() ? "y" : "n") : "?")
               << "(" << (enable ? "Y" : "N") << ")"
               << " debug=" << debug
-              << " items=" << items.size()
-              << std::endl;
+              << " items=" << items.size();
+    SubscriptionCounters counters;
+    getCounters(counters);
+    if (counters.itemOverflows || counters.clientDrops)
+        std::cout << " overflows=" << counters.itemOverflows << "(server)/"
+                  << counters.clientDrops << "(client)";
+    std::cout << std::endl;
 
     if (level >= 1) {
         for (auto &it : items) {
@@ -132,6 +137,18 @@ SubscriptionUaSdk::getSessionUaSdk () const
     return *psessionuasdk;
 }
 
+void
+SubscriptionUaSdk::getCounters (SubscriptionCounters &counters) const
+{
+    counters = SubscriptionCounters();
+    for (auto &it : items) {
+        epicsUInt32 serverOverflows, clientDrops;
+        it->getOverflowCounts(&serverOverflows, &clientDrops);
+        counters.itemOverflows += serverOverflows;
+        counters.clientDrops += clientDrops;
+    }
+}
+
 void
 SubscriptionUaSdk::create ()
 {
@@ -111,6 +111,13 @@ public:
      */
     virtual Session &getSession() const override;
 
+    /**
+     * @brief Get the counters of lost updates. See DevOpcua::Subscription::getCounters
+     *
+     * Server diagnostics are not supported.
+     */
+    virtual void getCounters(SubscriptionCounters &counters) const override;
+
     /**
      * @brief Get the session (implementation) that this subscription
      * is running on.
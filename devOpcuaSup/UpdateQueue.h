@@ -13,9 +13,9 @@
 
 #include <memory>
 #include <utility>
-#include <queue>
+#include <atomic>
 
-#include <epicsMutex.h>
+#include <epicsThread.h>
 
 #include "devOpcua.h"
 
@@ -35,15 +35,44 @@ namespace DevOpcua {
  *
  * The template parameter T is expected to be an instance of the Update class,
  * i.e. it must provide the override(), getOverrides() and getType() methods.
+ *
+ * Concurrency model: every queue has a single producer (the client library thread
+ * delivering data and service results) and a single consumer (record processing).
+ * The queue is a ring of capacity+1 cells with a sequence number per cell
+ * (bounded MPMC ring by D. Vyukov) and takes no locks.
+ * Pushing to and popping from a queue that is not full is wait-free, except that
+ * the consumer may have to spin for the few instructions of a push that is
+ * being published.
+ *
+ * On overflow, the producer first appends the new update (using the spare cell),
+ * then claims and drops the front cell (discard oldest; the overrides are carried
+ * to the next popped update) or claims the back cell and merges the new update
+ * into it (discard newest). Claims are a CAS on the cell's sequence number;
+ * a claim that collides with the consumer is retried after yielding, i.e. the
+ * overflow path is lock-free.
+ *
+ * Occasional pushes from other threads (e.g. write completion events of
+ * suppressed writes) are safe, as producers reserve cells with a CAS.
  */
 template<typename T>
 class UpdateQueue
 {
 public:
     UpdateQueue(const size_t size, const bool discardOldest = true)
-        : maxElements(size)
+        : maxElements(size ? size : 1)
         , discardOldest(discardOldest)
-    {}
+        , slots(maxElements + 1)
+        , cells(new Cell[slots])
+        , head(0)
+        , tail(0)
+        , used(0)
+        , dropped(0)
+        , discards(0)
+        , highWater(0)
+    {
+        for (size_t i = 0; i < slots; i++)
+            cells[i].seq.store(i, std::memory_order_relaxed);
+    }
 
     /**
      * @brief Inserts an update at the end.
@@ -55,21 +84,24 @@ public:
      */
     void pushUpdate(std::shared_ptr<T> update, bool *wasFirst = nullptr)
     {
-        Guard G(lock);
         if (wasFirst) *wasFirst = false;
-        if (updq.size() < maxElements) {
-            if (wasFirst && updq.empty()) *wasFirst = true;
-            updq.push(update);
-        } else {
-            if (discardOldest) {
-                std::shared_ptr<T> drop = updq.front();
-                updq.pop();
-                updq.front()->override(drop->getOverrides());
-                updq.push(update);
-            } else {
-                updq.back()->override(*update);
+        if (!discardOldest) {
+            while (used.load(std::memory_order_acquire) >= maxElements) {
+                if (mergeBack(*update))
+                    return;
             }
         }
+        // Count first, so that the consumer never takes an update it has not been told about
+        size_t prev = used.fetch_add(1, std::memory_order_acq_rel);
+        size_t pos = enqueue(update);
+        if (wasFirst && prev == 0) *wasFirst = true;
+        size_t hw = highWater.load(std::memory_order_relaxed);
+        while (prev >= hw && hw < maxElements
+               && !highWater.compare_exchange_weak(hw, prev < maxElements ? prev + 1 : maxElements,
+                                                   std::memory_order_relaxed))
+            ;
+        if (discardOldest && prev >= maxElements)
+            dropFront(pos);
     }
 
     /**
@@ -78,7 +110,7 @@ public:
      * Removes an update from the front of the underlying
      * queue and returns it.
      *
-     * Calling popUpdate on an empty queue is undefined.
+     * Calling popUpdate on an empty queue returns an empty pointer.
      *
      * @param[out] nextReason  ProcessReason of the next element, `none` if last element
      *
@@ -86,35 +118,47 @@ public:
      */
     std::shared_ptr<T> popUpdate(ProcessReason *nextReason = nullptr)
     {
-        Guard G(lock);
-        std::shared_ptr<T> drop = updq.front();
-        updq.pop();
-        if (nextReason) {
-            if (updq.empty()) *nextReason = ProcessReason::none;
-            else *nextReason = updq.front()->getType();
+        std::shared_ptr<T> upd;
+        for (;;) {
+            size_t pos = head.load(std::memory_order_acquire);
+            if (claim(pos)) {
+                upd = release(pos);
+                break;
+            }
+            if (used.load(std::memory_order_acquire) == 0) {
+                if (nextReason) *nextReason = ProcessReason::none;
+                return upd;
+            }
+            epicsThreadSleep(0.0);
         }
-        return drop;
+        unsigned long n = dropped.exchange(0, std::memory_order_acq_rel);
+        if (n)
+            upd->override(n - 1);
+        size_t remaining = used.fetch_sub(1, std::memory_order_acq_rel) - 1;
+        if (nextReason) *nextReason = remaining ? peekType() : ProcessReason::none;
+        return upd;
     }
 
     /**
      * @brief Checks whether the queue is empty.
      *
-     * Checks if the underlying queue has no elements,
-     * i.e. whether `updq.empty()`.
-     *
      * @return  `true` if the queue is empty, `false` otherwise
      */
-    bool empty() const { return updq.empty(); }
+    bool empty() const { return used.load(std::memory_order_acquire) == 0; }
 
     /**
      * @brief Returns the number of elements.
      *
-     * Returns the number of elements in the underlying queue,
-     * i.e., `updq.size()`.
+     * While an overflowing push is in progress, the queue holds one more
+     * element than its capacity; that is not reported.
      *
      * @return  number of elements in the queue
      */
-    size_t size() const { return updq.size(); }
+    size_t size() const
+    {
+        size_t n = used.load(std::memory_order_acquire);
+        return n > maxElements ? maxElements : n;
+    }
 
     /**
      * @brief Returns the maximum number of elements.
@@ -125,11 +169,142 @@ public:
      */
     size_t capacity() const { return maxElements; }
 
+    /**
+     * @brief Returns the number of updates discarded by overflows.
+     *
+     * Counts every dropped (discard oldest) or merged (discard newest) update
+     * since the queue was created.
+     *
+     * @return  number of discarded updates
+     */
+    unsigned long discarded() const { return discards.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Returns the high-water mark of the queue.
+     *
+     * @return  max. number of elements since creation or the last reset
+     */
+    size_t highWaterMark() const { return highWater.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Resets the high-water mark to the current number of elements.
+     */
+    void resetHighWaterMark() { highWater.store(size(), std::memory_order_relaxed); }
+
 private:
-    size_t maxElements;
-    bool discardOldest;
-    epicsMutex lock;
-    std::queue<std::shared_ptr<T>> updq;
+    // Cell sequence number while a thread owns the cell
+    static const size_t busy = ~static_cast<size_t>(0);
+
+    // A cell at position pos is free if seq == pos, holds an update if seq == pos + 1
+    struct Cell {
+        std::atomic<size_t> seq;
+        std::shared_ptr<T> update;
+    };
+
+    // Reserve the cell at the tail and publish the update
+    size_t enqueue(std::shared_ptr<T> &update)
+    {
+        size_t pos = tail.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell &c = cells[pos % slots];
+            size_t seq = c.seq.load(std::memory_order_acquire);
+            if (seq == pos) {
+                if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    c.update = std::move(update);
+                    c.seq.store(pos + 1, std::memory_order_release);
+                    return pos;
+                }
+            } else if (seq != busy && seq > pos) {
+                // Another producer took this cell
+                pos = tail.load(std::memory_order_relaxed);
+            } else {
+                // Cell still owned by a reader (only while an overflow is resolved)
+                epicsThreadSleep(0.0);
+                pos = tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Take ownership of the cell at position pos (if it holds an update)
+    bool claim(const size_t pos)
+    {
+        size_t seq = pos + 1;
+        return cells[pos % slots].seq.compare_exchange_strong(seq, busy, std::memory_order_acquire);
+    }
+
+    // Move the update out of the claimed front cell and free the cell
+    std::shared_ptr<T> release(const size_t pos)
+    {
+        Cell &c = cells[pos % slots];
+        head.store(pos + 1, std::memory_order_release);
+        std::shared_ptr<T> upd = std::move(c.update);
+        c.seq.store(pos + slots, std::memory_order_release);
+        return upd;
+    }
+
+    // Overflow (discard oldest): drop the front update, but never the one just pushed
+    void dropFront(const size_t own)
+    {
+        while (used.load(std::memory_order_acquire) > maxElements) {
+            size_t pos = head.load(std::memory_order_acquire);
+            if (pos >= own)
+                return;
+            if (claim(pos)) {
+                // Uncount and carry the overrides before the next update can be popped
+                dropped.fetch_add(cells[pos % slots].update->getOverrides() + 1, std::memory_order_acq_rel);
+                used.fetch_sub(1, std::memory_order_acq_rel);
+                discards.fetch_add(1, std::memory_order_relaxed);
+                release(pos);
+                return;
+            }
+            epicsThreadSleep(0.0);
+        }
+    }
+
+    // Overflow (discard newest): merge the update into the back update
+    bool mergeBack(T &update)
+    {
+        size_t pos = tail.load(std::memory_order_acquire);
+        if (pos == 0)
+            return false;
+        pos--;
+        if (!claim(pos)) {
+            epicsThreadSleep(0.0);
+            return false;
+        }
+        Cell &c = cells[pos % slots];
+        c.update->override(update);
+        c.seq.store(pos + 1, std::memory_order_release);
+        discards.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Type of the front update (consumer only)
+    ProcessReason peekType()
+    {
+        for (;;) {
+            size_t pos = head.load(std::memory_order_acquire);
+            if (claim(pos)) {
+                ProcessReason reason = cells[pos % slots].update->getType();
+                cells[pos % slots].seq.store(pos + 1, std::memory_order_release);
+                return reason;
+            }
+            if (used.load(std::memory_order_acquire) == 0)
+                return ProcessReason::none;
+            epicsThreadSleep(0.0);
+        }
+    }
+
+    const size_t maxElements;
+    const bool discardOldest;
+    const size_t slots;
+    std::unique_ptr<Cell[]> cells;
+    std::atomic<size_t> head;              /**< next position to pop (consumer, overflowing producer) */
+    std::atomic<size_t> tail;              /**< next position to push (producers) */
+    std::atomic<size_t> used;              /**< number of updates (counted before publishing) */
+    std::atomic<unsigned long> dropped;    /**< overrides to carry to the next popped update */
+    std::atomic<unsigned long> discards;   /**< updates discarded by overflows (cumulative) */
+    std::atomic<size_t> highWater;         /**< max. number of elements (since reset) */
 };
 
 } // namespace DevOpcua
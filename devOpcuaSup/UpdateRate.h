@@ -0,0 +1,87 @@
+/*************************************************************************\
+* Copyright (c) 2026 ITER Organization.
+* This module is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Author: Dirk Zimoch <dirk.zimoch@psi.ch>
+ */
+
+#ifndef DEVOPCUA_UPDATERATE_H
+#define DEVOPCUA_UPDATERATE_H
+
+#include <epicsMutex.h>
+#include <epicsGuard.h>
+#include <epicsTime.h>
+
+namespace DevOpcua {
+
+/**
+ * @brief Rate of incoming updates, averaged over windows of at least one second.
+ *
+ * Updates are counted by the thread delivering the data, the rate is read
+ * by record processing: all members are guarded by a lock.
+ */
+class UpdateRate
+{
+    typedef epicsGuard<epicsMutex> Guard;
+
+public:
+    /**
+     * @brief Constructor.
+     * @param now  start of the first window
+     */
+    explicit UpdateRate(const epicsTime &now = epicsTime::getCurrent())
+        : updates(0)
+        , start(now)
+        , lastRate(0.0)
+    {}
+
+    /**
+     * @brief Count an update.
+     *
+     * Closes the window and computes its rate if it is at least one second long.
+     *
+     * @param now  time of the update
+     */
+    void count(const epicsTime &now)
+    {
+        Guard G(lock);
+        updates++;
+        const double window = now - start;
+        if (window >= 1.0) {
+            lastRate = updates / window;
+            updates = 0;
+            start = now;
+        }
+    }
+
+    /**
+     * @brief Get the update rate.
+     *
+     * The rate of the last complete window; if the current window is longer
+     * than two seconds (updates have slowed down or stopped), the rate so far
+     * of the current window.
+     *
+     * @param now  current time
+     *
+     * @return  updates per second
+     */
+    double rate(const epicsTime &now) const
+    {
+        Guard G(lock);
+        const double window = now - start;
+        return window >= 2.0 ? updates / window : lastRate;
+    }
+
+private:
+    mutable epicsMutex lock;
+    unsigned long updates;                 /**< updates in the current window */
+    epicsTime start;                       /**< start of the current window */
+    double lastRate;                       /**< updates per second (last window) */
+};
+
+} // namespace DevOpcua
+
+#endif // DEVOPCUA_UPDATERATE_H
@@ -98,9 +98,14 @@ opcua_add_record (dbCommon *prec)
             pcon->pitem = Item::newItem(*pcon->plinkinfo);
             pcon->pitem->recConnector = pcon.get();
         } else {
+            // The element tree of an opcuaItem record can't be modified at runtime
+            if (interruptAccept)
+                throw std::runtime_error("can't connect to an opcuaItem record at runtime");
             pcon->pitem = pcon->plinkinfo->item;
         }
         DataElement::addElementToTree(pcon->pitem, pcon.get(), pcon->plinkinfo->elementPath);
+        if (pcon->plinkinfo->linkedToItem)
+            pcon->pitem->attach();
         prec->dpvt = pcon.release();
         return 0;
     } catch(std::exception& e) {
@@ -109,11 +114,26 @@ opcua_add_record (dbCommon *prec)
     }
 }
 
+// Runtime link change: detach the record, its connector and item are deleted later
 long
 opcua_del_record (dbCommon *prec)
 {
-    //TODO: support changing OPCUA links
-    return -1;
+    if (!prec->dpvt) return 0;
+    RecordConnector *pcon = static_cast<RecordConnector *>(prec->dpvt);
+
+    if (!pcon->plinkinfo->linkedToItem || pcon->plinkinfo->isItemRecord) {
+        errlogPrintf("%s : can't change the link of an opcuaItem record "
+                     "or of a record connected to one at runtime\n", prec->name);
+        return -1;
+    }
+    if (!pcon->pitem->detach()) {
+        errlogPrintf("%s : changing the link at runtime is not supported "
+                     "by the client library or link type\n", prec->name);
+        return -1;
+    }
+    prec->dpvt = nullptr;
+    RecordConnector::retire(pcon);
+    return 0;
 }
 
 dsxt opcua_dsxt = { opcua_add_record, opcua_del_record };
@@ -1194,6 +1214,27 @@ opcua_write_array (REC *prec)
 
 // opcuaItemRecord
 
+// Copy the item statistics into the record (latency only when processing an update)
+template<typename REC>
+void
+setItemStatistics (REC *prec, RecordConnector *pcon)
+{
+    ItemStatistics stats;
+    pcon->pitem->getStatistics(stats);
+    prec->urate = stats.updateRate;
+    prec->cqhwm = stats.queueHighWater;
+    prec->rsmpl = stats.samplingInterval;
+    prec->rqsize = stats.queueSize;
+    prec->rrtt = stats.readRoundTrip;
+    prec->wrtt = stats.writeRoundTrip;
+    if (stats.sourceTime.secPastEpoch
+            && (pcon->reason == ProcessReason::incomingData || pcon->reason == ProcessReason::readComplete)) {
+        prec->lat = (epicsTime::getCurrent() - epicsTime(stats.sourceTime)) * 1e3;
+        if (prec->lat > prec->latmax)
+            prec->latmax = prec->lat;
+    }
+}
+
 template<typename REC>
 long
 opcua_action_item(REC *prec)
@@ -1246,6 +1287,8 @@ opcua_action_item(REC *prec)
             }
         }
         pcon->getStatus(&prec->statcode, prec->stattext, MAX_STRING_SIZE + 1, &prec->time);
+        pcon->pitem->getOverflowCounts(&prec->sovf, &prec->cdrop);
+        setItemStatistics(prec, pcon);
         traceItemActionPrint(pdbc, pcon, ret, action, prec->statcode, prec->stattext);
     }
     CATCH()
@@ -89,6 +89,8 @@ typedef struct linkInfo {
     Item *item;                        /**< pointer to root item (if structure element) */
     std::string session;
     std::string subscription;
+    std::string pubsubReader;          /**< PubSub reader name (instead of session/subscription) */
+    std::string pubsubField;           /**< DataSet field name (PubSub reader links) */
 
     epicsUInt16 namespaceIndex = 0;
     bool identifierIsNumeric = false;
@@ -96,6 +98,13 @@ typedef struct linkInfo {
     std::string identifierString;
 
     bool registerNode = false;
+    bool meta = false;                 /**< import node metadata (EGU, ranges, enums, description) */
+    bool dedup = false;                /**< suppress writes of unchanged values */
+    double dedupMax = 0.0;             /**< force a (suppressed) write after this period [s] (0 = never) */
+    std::string writeGroup;            /**< write group: writes are held until the group trigger writes */
+    bool groupTrigger = false;         /**< writing this item sends all held writes of the group */
+    std::string snapshotGroup;         /**< snapshot group: a read of this item reads all items of the group */
+    bool itemProcessing = false;       /**< process all element records of an item update in one callback */
 
     double samplingInterval;
     epicsUInt32 queueSize;
@@ -107,8 +116,13 @@ typedef struct linkInfo {
     LinkOptionTimestamp timestamp = LinkOptionTimestamp::server;
     std::string timestampElement;
     LinkOptionBini bini = LinkOptionBini::read;
+    epicsUInt32 burst = 0;             /**< pack up to this many queued samples into one array update (0 = off) */
+    bool burstTime = false;            /**< read per-sample time stamps instead of values (burst mode) */
+    bool json = false;                 /**< read the whole value encoded as JSON (lsi, CHAR/UCHAR waveform) */
 
     bool isOutput;
+    bool isStringRecord = false;       /**< input record holding a string (stringin, lsi, CHAR/UCHAR waveform or aai) */
+    bool isDoubleArray = false;        /**< array record with FTVL DOUBLE */
     bool monitor = true;
 } linkInfo;
 
@@ -195,6 +209,23 @@ public:
     bool isItemRecord() const {
         return !(dbFindField(pentry(), "RTYP") || strcmp(dbGetString(pentry()), "opcuaItem"));
     }
+    std::string arrayType() const {
+        if (dbFindField(pentry(), "FTVL"))
+            return "";
+        return dbGetString(pentry());
+    }
+    bool isStringRecord() const {
+        if (dbFindField(pentry(), "RTYP"))
+            return false;
+        const std::string rtyp = dbGetString(pentry());
+        if (rtyp == "stringin" || rtyp == "lsi")
+            return true;
+        if (rtyp == "waveform" || rtyp == "aai") {
+            const std::string ftvl = arrayType();
+            return ftvl == "CHAR" || ftvl == "UCHAR";
+        }
+        return false;
+    }
     const char *info(const char *name, const char *def) const
     {
         if (dbFindInfo(pentry(), name))
@@ -0,0 +1,136 @@
+/*************************************************************************\
+* Copyright (c) 2026 ITER Organization.
+* This module is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Author: Dirk Zimoch <dirk.zimoch@psi.ch>
+ */
+
+/*
+ * Device support for the counters of lost updates of a subscription
+ * (DTYP "OPCUA Subscription", INP "@<subscription> <counter>")
+ */
+
+#include <string>
+#include <sstream>
+
+#include <errlog.h>
+#include <devSup.h>
+#include <recGbl.h>
+#include <alarm.h>
+
+#include <dbCommon.h>
+#include <longinRecord.h>
+#include <aiRecord.h>
+
+#include <epicsExport.h>  // defines epicsExportSharedSymbols
+#include "devOpcua.h"
+#include "Subscription.h"
+
+namespace {
+
+using namespace DevOpcua;
+
+struct CounterInfo {
+    const char *name;
+    epicsUInt32 SubscriptionCounters::*member;
+    bool fromServer;                /**< only valid with server diagnostics */
+};
+
+const CounterInfo counters[] = {
+    { "itemOverflows",            &SubscriptionCounters::itemOverflows,            false },
+    { "clientDrops",              &SubscriptionCounters::clientDrops,              false },
+    { "monitoringQueueOverflows", &SubscriptionCounters::monitoringQueueOverflows, true },
+    { "discardedMessages",        &SubscriptionCounters::discardedMessages,        true },
+    { "latePublishRequests",      &SubscriptionCounters::latePublishRequests,      true },
+    { "unacknowledgedMessages",   &SubscriptionCounters::unacknowledgedMessages,   true },
+    { "dataChangeNotifications",  &SubscriptionCounters::dataChangeNotifications,  true },
+};
+
+struct CounterLink {
+    Subscription *subscription;
+    const CounterInfo *counter;
+};
+
+template<typename REC>
+long
+opcua_init_counter (REC *prec)
+{
+    if (prec->inp.type != INST_IO) {
+        recGblRecordError(S_dev_badInpType, prec, "OPCUA Subscription: INP is not INST_IO");
+        return S_dev_badInpType;
+    }
+    std::istringstream link(prec->inp.value.instio.string);
+    std::string name, counter;
+    link >> name >> counter;
+
+    Subscription *subscription = Subscription::find(name);
+    if (!subscription) {
+        errlogPrintf("%s: subscription '%s' does not exist\n", prec->name, name.c_str());
+        return S_dev_badInpType;
+    }
+    for (auto &it : counters) {
+        if (counter == it.name) {
+            prec->dpvt = new CounterLink{subscription, &it};
+            return 0;
+        }
+    }
+    errlogPrintf("%s: unknown subscription counter '%s'\n", prec->name, counter.c_str());
+    return S_dev_badInpType;
+}
+
+// Returns false (and sets an alarm) if the counter is not available
+template<typename REC>
+bool
+readCounter (REC *prec, epicsUInt32 &value)
+{
+    CounterLink *pl = static_cast<CounterLink *>(prec->dpvt);
+    if (!pl) {
+        (void) recGblSetSevr(prec, UDF_ALARM, INVALID_ALARM);
+        return false;
+    }
+    SubscriptionCounters c;
+    pl->subscription->getCounters(c);
+    if (pl->counter->fromServer && !c.hasServerDiagnostics) {
+        (void) recGblSetSevr(prec, READ_ALARM, INVALID_ALARM);
+        return false;
+    }
+    value = c.*(pl->counter->member);
+    return true;
+}
+
+long
+opcua_read_counter_longin (longinRecord *prec)
+{
+    epicsUInt32 value;
+    if (!readCounter(prec, value))
+        return 1;
+    prec->val = static_cast<epicsInt32>(value);
+    prec->udf = false;
+    return 0;
+}
+
+long
+opcua_read_counter_ai (aiRecord *prec)
+{
+    epicsUInt32 value;
+    if (!readCounter(prec, value))
+        return 2;
+    prec->val = value;
+    prec->udf = false;
+    return 2;
+}
+
+} // namespace
+
+static dset6<longinRecord> devLiOpcuaSubscription =
+{5, nullptr, nullptr, opcua_init_counter<longinRecord>, nullptr, opcua_read_counter_longin, nullptr};
+static dset6<aiRecord> devAiOpcuaSubscription =
+{6, nullptr, nullptr, opcua_init_counter<aiRecord>, nullptr, opcua_read_counter_ai, nullptr};
+
+extern "C" {
+epicsExportAddress(dset, devLiOpcuaSubscription);
+epicsExportAddress(dset, devAiOpcuaSubscription);
+}
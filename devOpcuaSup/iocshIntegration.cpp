@@ -32,6 +32,7 @@
 #include "linkParser.h"
 #include "Session.h"
 #include "Subscription.h"
+#include "PubSubReader.h"
 #include "Registry.h"
 #include "RecordConnector.h"
 
@@ -55,6 +56,10 @@ int opcua_DefaultOutputReadback = 1;             // make outputs bidirectional
 double opcua_ClientQueueSizeFactor = 1.5;        // client queue size factor (* server side size)
 int opcua_MinimumClientQueueSize = 3;            // minimum client queue size
 
+// error reporting
+double opcua_ErrorReportInterval = 10.0;         // [s]
+int opcua_ErrorReportBurst = 3;                  // messages per interval, class and record
+
 extern "C" {
 epicsExportAddress(double, opcua_ConnectTimeout);
 epicsExportAddress(int, opcua_MaxOperationsPerServiceCall);
@@ -66,6 +71,8 @@ epicsExportAddress(int, opcua_DefaultUseServerTime);
 epicsExportAddress(int, opcua_DefaultOutputReadback);
 epicsExportAddress(double, opcua_ClientQueueSizeFactor);
 epicsExportAddress(int, opcua_MinimumClientQueueSize);
+epicsExportAddress(double, opcua_ErrorReportInterval);
+epicsExportAddress(int, opcua_ErrorReportBurst);
 }
 
 } // namespace DevOpcua
@@ -109,6 +116,7 @@ const char opcuaSessionUsage[]
       "of the OPC UA server.\nMust be called before iocInit.\n\n"
       "name       session name (no spaces)\n"
       "URL        URL of the OPC UA server (e.g. opc.tcp://192.168.1.23:4840)\n"
+      "           or local socket (e.g. opc.unix:///run/plc.sock, open62541 < 1.4 only)\n"
       "[options]  list of options in 'key=value' format\n"
       "           (see 'help opcuaOptions' for a list of valid options)\n";
 
@@ -286,12 +294,146 @@ static
     }
 }
 
+static const iocshArg opcuaPubSubReaderArg0 = {"name", iocshArgString};
+static const iocshArg opcuaPubSubReaderArg1 = {"url", iocshArgString};
+static const iocshArg opcuaPubSubReaderArg2 = {"[options]", iocshArgArgv};
+
+static const iocshArg *const opcuaPubSubReaderArg[3] = {&opcuaPubSubReaderArg0,
+                                                        &opcuaPubSubReaderArg1,
+                                                        &opcuaPubSubReaderArg2};
+
+const char opcuaPubSubReaderUsage[]
+    = "Configures a new OPC UA PubSub reader (UADP subscriber), assigning it a name.\n"
+      "Must be called before iocInit. The DataSet fields are defined using opcuaPubSubField.\n\n"
+      "name       PubSub reader name (no spaces)\n"
+      "url        UADP transport URL (e.g. opc.udp://224.0.0.22:4840)\n"
+      "[options]  list of options in 'key=value' format\n"
+      "           (see 'help opcuaOptions' for a list of valid options)\n";
+
+static const iocshFuncDef opcuaPubSubReaderFuncDef = {"opcuaPubSubReader",
+                                                      3,
+                                                      opcuaPubSubReaderArg
+#ifdef IOCSHFUNCDEF_HAS_USAGE
+                                                      ,
+                                                      opcuaPubSubReaderUsage
+#endif
+};
+
+static
+    void opcuaPubSubReaderCallFunc (const iocshArgBuf *args)
+{
+    try {
+        bool ok = true;
+        PubSubReader *r = nullptr;
+
+        if (!args[0].sval) {
+            errlogPrintf("missing argument #1 (PubSub reader name)\n");
+            ok = false;
+        } else if (strchr(args[0].sval, ' ')) {
+            errlogPrintf("invalid argument #1 (PubSub reader name) '%s'\n",
+                         args[0].sval);
+            ok = false;
+        } else if (RegistryKeyNamespace::global.contains(args[0].sval)) {
+            errlogPrintf("PubSub reader name %s already in use\n",
+                         args[0].sval);
+            ok = false;
+        }
+
+        if (!args[1].sval) {
+            errlogPrintf("missing argument #2 (url)\n");
+            ok = false;
+        }
+
+        std::list<std::pair<std::string, std::string>> setopts;
+        for (int i = 1; i < args[2].aval.ac; i++) {
+            auto options = splitString(args[2].aval.av[i], ':');
+            for (auto &opt : options) {
+                if (opt.empty()) continue;
+                auto keyval = splitString(opt, '=');
+                if (keyval.size() != 2) {
+                    errlogPrintf("option '%s' must follow 'key=value' format - ignored\n",
+                                 opt.c_str());
+                } else {
+                    setopts.emplace_back(keyval.front(), keyval.back());
+                }
+            }
+        }
+
+        if (ok) {
+            r = PubSubReader::createPubSubReader(args[0].sval, args[1].sval);
+            if (!r)
+                errlogPrintf("ERROR - no PubSub reader created\n");
+        } else {
+            errlogPrintf("ERROR - no PubSub reader created\n");
+        }
+
+        if (r) {
+            for (auto &keyval : setopts)
+                r->setOption(keyval.first, keyval.second);
+        }
+    }
+    catch(std::exception& e) {
+        std::cerr << "ERROR : " << e.what() << std::endl;
+    }
+}
+
+static const iocshArg opcuaPubSubFieldArg0 = {"reader", iocshArgString};
+static const iocshArg opcuaPubSubFieldArg1 = {"field name", iocshArgString};
+static const iocshArg opcuaPubSubFieldArg2 = {"type", iocshArgString};
+
+static const iocshArg *const opcuaPubSubFieldArg[3] = {&opcuaPubSubFieldArg0,
+                                                       &opcuaPubSubFieldArg1,
+                                                       &opcuaPubSubFieldArg2};
+
+const char opcuaPubSubFieldUsage[]
+    = "Appends a field to the DataSetMetaData of an OPC UA PubSub reader.\n"
+      "Fields must be defined in the order of the DataSet published by the server.\n"
+      "Must be called before iocInit.\n\n"
+      "reader      name of the existing PubSub reader\n"
+      "field name  name of the field (used in the 'field' link option)\n"
+      "type        OPC UA built-in type of the field (e.g. Int32, Double, String)\n";
+
+static const iocshFuncDef opcuaPubSubFieldFuncDef = {"opcuaPubSubField",
+                                                     3,
+                                                     opcuaPubSubFieldArg
+#ifdef IOCSHFUNCDEF_HAS_USAGE
+                                                     ,
+                                                     opcuaPubSubFieldUsage
+#endif
+};
+
+static
+    void opcuaPubSubFieldCallFunc (const iocshArgBuf *args)
+{
+    try {
+        PubSubReader *r = nullptr;
+
+        if (!args[0].sval) {
+            errlogPrintf("missing argument #1 (PubSub reader name)\n");
+        } else if (!(r = PubSubReader::find(args[0].sval))) {
+            errlogPrintf("PubSub reader %s does not exist\n",
+                         args[0].sval);
+        } else if (!args[1].sval) {
+            errlogPrintf("missing argument #2 (field name)\n");
+        } else if (!args[2].sval) {
+            errlogPrintf("missing argument #3 (type)\n");
+        } else if (!r->addField(args[1].sval, args[2].sval)) {
+            errlogPrintf("unknown type '%s' - field %s not added\n",
+                         args[2].sval, args[1].sval);
+        }
+    }
+    catch(std::exception& e) {
+        std::cerr << "ERROR : " << e.what() << std::endl;
+    }
+}
+
 static const iocshArg opcuaOptionsArg0 = {"pattern", iocshArgString};
 static const iocshArg opcuaOptionsArg1 = {"[options]", iocshArgArgv};
 
 static const iocshArg *const opcuaOptionsArg[2] = {&opcuaOptionsArg0, &opcuaOptionsArg1};
 
-static const std::string opcuaOptionsUsage = std::string(Session::optionUsage) + Subscription::optionUsage;
+static const std::string opcuaOptionsUsage = std::string(Session::optionUsage) + Subscription::optionUsage
+                                             + PubSubReader::optionUsage;
 
 static const iocshFuncDef opcuaOptionsFuncDef = {"opcuaOptions",
                                                 2,
@@ -355,6 +497,27 @@ opcuaOptionsCallFunc(const iocshArgBuf *args)
                         }
                     }
                 }
+                if (!foundSomething) {
+                    std::set<PubSubReader *> readers = PubSubReader::glob(args[0].sval);
+                    if (readers.size()) {
+                        foundSomething = true;
+                        for (int i = 1; i < args[1].aval.ac; i++) {
+                            auto options = splitString(args[1].aval.av[i], ':');
+                            for (auto &opt : options) {
+                                if (opt.empty()) continue;
+                                auto keyval = splitString(opt, '=');
+                                if (keyval.size() != 2) {
+                                    errlogPrintf(
+                                        "option '%s' must follow 'key=value' format - ignored\n",
+                                        opt.c_str());
+                                } else {
+                                    for (auto &r : readers)
+                                        r->setOption(keyval.front(), keyval.back());
+                                }
+                            }
+                        }
+                    }
+                }
                 if (!foundSomething)
                     errlogPrintf("No matches for pattern '%s'\n", args[0].sval);
             }
@@ -370,8 +533,8 @@ static const iocshArg opcuaShowArg1 = {"verbosity", iocshArgInt};
 static const iocshArg *const opcuaShowArg[2] = {&opcuaShowArg0, &opcuaShowArg1};
 
 const char opcuaShowUsage[]
-    = "Prints information about sessions, subscriptions, items and their related data elements.\n\n"
-      "pattern    glob pattern (supports * and ?) for session, subscription, record names\n"
+    = "Prints information about sessions, subscriptions, PubSub readers, items and their related data elements.\n\n"
+      "pattern    glob pattern (supports * and ?) for session, subscription, PubSub reader, record names\n"
       "verbosity  amount of printed information (default 0 = sparse)\n";
 
 static const iocshFuncDef opcuaShowFuncDef = {"opcuaShow",
@@ -404,6 +567,14 @@ opcuaShowCallFunc(const iocshArgBuf *args)
                     s->show(args[1].ival);
             }
         }
+        if (!foundSomething) {
+            std::set<PubSubReader *> readers = PubSubReader::glob(args[0].sval);
+            if (readers.size()) {
+                foundSomething = true;
+                for (auto &r : readers)
+                    r->show(args[1].ival);
+            }
+        }
         if (!foundSomething) {
             std::set<RecordConnector *> connectors = RecordConnector::glob(args[0].sval);
             if (connectors.size()) {
@@ -560,6 +731,58 @@ void opcuaMapNamespaceCallFunc (const iocshArgBuf *args)
     }
 }
 
+static const iocshArg opcuaSnapshotArg0 = {"session", iocshArgString};
+static const iocshArg opcuaSnapshotArg1 = {"snapshot group", iocshArgString};
+
+static const iocshArg *const opcuaSnapshotArg[2] = {&opcuaSnapshotArg0, &opcuaSnapshotArg1};
+
+const char opcuaSnapshotUsage[]
+    = "Reads all items of a snapshot group (link option 'snapshot') in one read request.\n"
+      "All records of the group are processed from the same response, with the same "
+      "server time stamp.\n\n"
+      "session         existing session name\n"
+      "snapshot group  name of the snapshot group\n";
+
+static const iocshFuncDef opcuaSnapshotFuncDef = {"opcuaSnapshot",
+                                                  2,
+                                                  opcuaSnapshotArg
+#ifdef IOCSHFUNCDEF_HAS_USAGE
+                                                  ,
+                                                  opcuaSnapshotUsage
+#endif
+};
+
+static
+void opcuaSnapshotCallFunc (const iocshArgBuf *args)
+{
+    try {
+        bool ok = true;
+        Session *s = nullptr;
+
+        if (args[0].sval == nullptr) {
+            errlogPrintf("missing argument #1 (session name)\n");
+            ok = false;
+        } else {
+            s = Session::find(args[0].sval);
+            if (!s) {
+                errlogPrintf("'%s' - no such session\n", args[0].sval);
+                ok = false;
+            }
+        }
+
+        if (args[1].sval == nullptr) {
+            errlogPrintf("missing argument #2 (snapshot group)\n");
+            ok = false;
+        }
+
+        if (ok && !s->readSnapshot(args[1].sval))
+            errlogPrintf("'%s' - no items in snapshot group (or snapshots not supported) of session %s\n",
+                         args[1].sval, args[0].sval);
+    } catch (std::exception &e) {
+        std::cerr << "ERROR : " << e.what() << std::endl;
+    }
+}
+
 static const iocshArg opcuaShowSecurityArg0 = {"session name [\"\"=client]", iocshArgString};
 
 static const iocshArg *const opcuaShowSecurityArg[1] = {&opcuaShowSecurityArg0};
@@ -1084,12 +1307,15 @@ void opcuaIocshRegister ()
 {
     iocshRegister(&opcuaSessionFuncDef, opcuaSessionCallFunc);
     iocshRegister(&opcuaSubscriptionFuncDef, opcuaSubscriptionCallFunc);
+    iocshRegister(&opcuaPubSubReaderFuncDef, opcuaPubSubReaderCallFunc);
+    iocshRegister(&opcuaPubSubFieldFuncDef, opcuaPubSubFieldCallFunc);
     iocshRegister(&opcuaOptionsFuncDef, opcuaOptionsCallFunc);
     iocshRegister(&opcuaShowFuncDef, opcuaShowCallFunc);
 
     iocshRegister(&opcuaConnectFuncDef, opcuaConnectCallFunc);
     iocshRegister(&opcuaDisconnectFuncDef, opcuaDisconnectCallFunc);
     iocshRegister(&opcuaMapNamespaceFuncDef, opcuaMapNamespaceCallFunc);
+    iocshRegister(&opcuaSnapshotFuncDef, opcuaSnapshotCallFunc);
 
     iocshRegister(&opcuaShowSecurityFuncDef, opcuaShowSecurityCallFunc);
     iocshRegister(&opcuaClientCertificateFuncDef, opcuaClientCertificateCallFunc);
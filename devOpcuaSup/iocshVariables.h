@@ -40,6 +40,10 @@ extern int opcua_DefaultOutputReadback;        /**< output record handling (1 =
 extern double opcua_ClientQueueSizeFactor;     /**< client queue size factor (* server side size) */
 extern int opcua_MinimumClientQueueSize;       /**< minimum client queue size */
 
+// error reporting
+extern double opcua_ErrorReportInterval;       /**< rate limiting window for data path errors [s] (0 = no limit) */
+extern int opcua_ErrorReportBurst;             /**< data path errors printed per window, class and record */
+
 } // namespace DevOpcua
 
 #endif // DEVOPCUA_IOCSHVARIABLES_H
@@ -37,6 +37,8 @@
 #include "iocshVariables.h"
 #include "Subscription.h"
 #include "Session.h"
+#include "PubSubReader.h"
+#include "DataElement.h"
 
 namespace DevOpcua {
 
@@ -76,6 +78,194 @@ splitString(const std::string &str, const char delim)
     return tokens;
 }
 
+void
+parseLinkOptions (linkInfo &info, std::string options, const char *recordName, const int debug)
+{
+    size_t sep = options.find_first_not_of("; \t"), send;
+
+    while (sep != std::string::npos && sep < options.size()) {
+        send = options.find_first_of("; \t", sep);
+        size_t seq = options.find_first_of('=', sep);
+
+        // allow escaping separators
+        while (send != std::string::npos && options[send-1] == '\\') {
+                options.erase(send-1, 1);
+                send = options.find_first_of("; \t", send);
+        }
+
+        if (seq == std::string::npos || (send != std::string::npos && seq >= send))
+            throw std::runtime_error(SB() << "expected '=' in '" << options.substr(0, send) << "'");
+
+        std::string optname(options.substr(sep, seq-sep)),
+                    optval (options.substr(seq+1, send-seq-1));
+
+        if (debug > 19) {
+            std::cerr << recordName << " opt '" << optname << "'='" << optval << "'" << std::endl;
+        }
+
+        // Item/node related options
+        if (info.linkedToItem && optname == "ns") {
+            if (epicsParseUInt16(optval.c_str(), &info.namespaceIndex, 0, nullptr))
+                throw std::runtime_error(SB() << "error converting '" << optval << "' to UInt16");
+        } else if (info.linkedToItem && optname == "s") {
+            info.identifierString = optval;
+            info.identifierIsNumeric = false;
+        } else if (info.linkedToItem && optname == "i") {
+            if (epicsParseUInt32(optval.c_str(), &info.identifierNumber, 0, nullptr))
+                throw std::runtime_error(SB() << "error converting '" << optval << "' to UInt32");
+            info.identifierIsNumeric = true;
+        } else if (info.linkedToItem && optname == "sampling") {
+            if (epicsParseDouble(optval.c_str(), &info.samplingInterval, nullptr))
+                throw std::runtime_error(SB() << "error converting '" << optval << "' to Double");
+        } else if (info.linkedToItem && optname == "qsize") {
+            if (epicsParseUInt32(optval.c_str(), &info.queueSize, 0, nullptr))
+                throw std::runtime_error(SB() << "error converting '" << optval << "' to UInt32");
+        } else if (info.linkedToItem && optname == "cqsize") {
+            if (epicsParseUInt32(optval.c_str(), &info.clientQueueSize, 0, nullptr))
+                throw std::runtime_error(SB() << "error converting '" << optval << "' to UInt32");
+        } else if (info.linkedToItem && optname == "discard") {
+            if (optval == "new")
+                info.discardOldest = false;
+            else if (optval == "old")
+                info.discardOldest = true;
+            else
+                throw std::runtime_error(SB() << "illegal value '" << optval << "'");
+        } else if (info.linkedToItem && optname == "register") {
+            if (optval.length() > 0) {
+                info.registerNode = getYesNo(optval[0]);
+            } else {
+                throw std::runtime_error(SB() << "no value for option '" << optname << "'");
+            }
+        } else if (info.linkedToItem && optname == "dedup") {
+            if (optval.length() > 0) {
+                info.dedup = getYesNo(optval[0]);
+            } else {
+                throw std::runtime_error(SB() << "no value for option '" << optname << "'");
+            }
+        } else if (info.linkedToItem && optname == "dedupmax") {
+            if (epicsParseDouble(optval.c_str(), &info.dedupMax, nullptr))
+                throw std::runtime_error(SB() << "error converting '" << optval << "' to Double");
+        } else if (info.linkedToItem && optname == "group") {
+            info.writeGroup = optval;
+        } else if (info.linkedToItem && optname == "trigger") {
+            if (optval.length() > 0) {
+                info.groupTrigger = getYesNo(optval[0]);
+            } else {
+                throw std::runtime_error(SB() << "no value for option '" << optname << "'");
+            }
+        } else if (info.linkedToItem && optname == "snapshot") {
+            info.snapshotGroup = optval;
+        } else if (info.linkedToItem && optname == "itemproc") {
+            if (optval.length() > 0) {
+                info.itemProcessing = getYesNo(optval[0]);
+            } else {
+                throw std::runtime_error(SB() << "no value for option '" << optname << "'");
+            }
+        } else if (info.pubsubReader.length() && optname == "field") {
+            info.pubsubField = optval;
+        } else if (info.linkedToItem && optname == "meta") {
+            if (optval.length() > 0) {
+                info.meta = getYesNo(optval[0]);
+            } else {
+                throw std::runtime_error(SB() << "no value for option '" << optname << "'");
+            }
+
+        // Item/node or Record/data element related options
+        } else if (optname == "timestamp") {
+            if (optval == linkOptionTimestampString(LinkOptionTimestamp::server))
+                info.timestamp = LinkOptionTimestamp::server;
+            else if (optval == linkOptionTimestampString(LinkOptionTimestamp::source))
+                info.timestamp = LinkOptionTimestamp::source;
+            else if (!info.isItemRecord && optval == linkOptionTimestampString(LinkOptionTimestamp::data))
+                info.timestamp = LinkOptionTimestamp::data;
+            else if (info.isItemRecord && optval[0] == '@') {
+                info.timestamp = LinkOptionTimestamp::data;
+                info.timestampElement = optval.substr(1);
+            } else
+                throw std::runtime_error(SB() << "illegal value '" << optval << "'");
+        } else if (optname == "monitor" || optname == "readback") {
+            if (optval.length() > 0) {
+                info.monitor = getYesNo(optval[0]);
+            } else {
+                throw std::runtime_error(SB() << "no value for option '" << optname << "'");
+            }
+        } else if (optname == "element") {
+            info.element = optval;
+            info.elementPath = splitString(optval);
+        } else if (optname == "burst") {
+            if (epicsParseUInt32(optval.c_str(), &info.burst, 0, nullptr))
+                throw std::runtime_error(SB() << "error converting '" << optval << "' to UInt32");
+        } else if (optname == "json") {
+            if (optval.length() > 0) {
+                info.json = getYesNo(optval[0]);
+            } else {
+                throw std::runtime_error(SB() << "no value for option '" << optname << "'");
+            }
+        } else if (optname == "bursttime") {
+            if (optval.length() > 0) {
+                info.burstTime = getYesNo(optval[0]);
+            } else {
+                throw std::runtime_error(SB() << "no value for option '" << optname << "'");
+            }
+        } else if (optname == "bini") {
+            if (optval == "read")
+                info.bini = LinkOptionBini::read;
+            else if (optval == "ignore")
+                info.bini = LinkOptionBini::ignore;
+            else if ((info.isItemRecord || info.isOutput) && optval == "write")
+                info.bini = LinkOptionBini::write;
+            else
+                throw std::runtime_error(SB() << "illegal value '" << optval << "' for option '" << optname << "'");
+        } else {
+            throw std::runtime_error(SB() << "invalid option '" << optname << "'");
+        }
+
+        sep = options.find_first_not_of("; \t", send);
+    }
+}
+
+void
+checkLinkOptions (const linkInfo &info)
+{
+    if (info.dedupMax > 0.0 && !info.dedup)
+        throw std::runtime_error(SB() << "dedupmax requires dedup=y");
+    if (info.groupTrigger && !info.writeGroup.length())
+        throw std::runtime_error(SB() << "trigger=y requires group option");
+    if (info.writeGroup.length() && !info.isOutput && !info.isItemRecord)
+        throw std::runtime_error(SB() << "group option requires output record or opcuaItemRecord");
+    if (info.writeGroup.length() && info.pubsubReader.length())
+        throw std::runtime_error(SB() << "group option not allowed with PubSub reader link");
+    if (info.snapshotGroup.length() && info.isOutput && !info.isItemRecord)
+        throw std::runtime_error(SB() << "snapshot option requires input record or opcuaItemRecord");
+    if (info.snapshotGroup.length() && info.pubsubReader.length())
+        throw std::runtime_error(SB() << "snapshot option not allowed with PubSub reader link");
+    if (info.burst && (info.isOutput || info.isItemRecord))
+        throw std::runtime_error(SB() << "burst option requires input record");
+    if (info.json && (info.isOutput || info.isItemRecord || !info.isStringRecord))
+        throw std::runtime_error(SB() << "json option requires stringin, lsi or CHAR/UCHAR waveform/aai record");
+    if (info.json && !DataElement::jsonSupported)
+        throw std::runtime_error(SB() << "json option requires open62541 version 1.4 or later "
+                                      << "(built with UA_ENABLE_JSON_ENCODING)");
+    if (info.json && info.burst)
+        throw std::runtime_error(SB() << "json and burst options cannot be combined");
+    if (info.burstTime && !info.burst)
+        throw std::runtime_error(SB() << "bursttime=y requires burst option");
+    if (info.burstTime && !info.isDoubleArray)
+        throw std::runtime_error(SB() << "bursttime=y requires array record with FTVL DOUBLE");
+    if (info.itemProcessing && !info.isItemRecord)
+        throw std::runtime_error(SB() << "itemproc option requires opcuaItemRecord");
+    if (info.pubsubReader.length() && !info.pubsubField.length())
+        throw std::runtime_error(SB() << "link to PubSub reader requires field option");
+    if (info.pubsubReader.length() && info.isOutput)
+        throw std::runtime_error(SB() << "link to PubSub reader is input only");
+    if (info.monitor && info.linkedToItem && !info.subscription.length()
+            && !info.pubsubReader.length())
+        throw std::runtime_error(SB() << "monitor=y requires link to a subscription");
+    if (info.monitor && !info.linkedToItem && !info.item->linkinfo.monitor)
+        throw std::runtime_error(SB() << "monitor=y requires link to monitored opcuaItemRecord (but "
+                                 << info.item->recConnector->getRecordName() << " is not)");
+}
+
 std::unique_ptr<linkInfo>
 parseLink (dbCommon *prec, const DBEntry &ent)
 {
@@ -89,6 +279,8 @@ parseLink (dbCommon *prec, const DBEntry &ent)
 
     pinfo->isOutput = ent.isOutput();
     pinfo->isItemRecord = ent.isItemRecord();
+    pinfo->isStringRecord = ent.isStringRecord();
+    pinfo->isDoubleArray = ent.arrayType() == "DOUBLE";
     pinfo->clientQueueSize = 0;
 
     if (debug > 4)
@@ -199,7 +391,7 @@ parseLink (dbCommon *prec, const DBEntry &ent)
     if (debug > 4)
         std::cerr << prec->name << " parsing inp/out link '" << linkstr << "'" << std::endl;
 
-    size_t sep, send;
+    size_t send;
 
     // first token: session or subscription or itemRecord name
     send = linkstr.find_first_of("; \t", 0);
@@ -211,12 +403,14 @@ parseLink (dbCommon *prec, const DBEntry &ent)
         pinfo->session = sub->getSession().getName();
     } else if (Session::find(name)) {
         pinfo->session = name;
+    } else if (PubSubReader::find(name)) {
+        pinfo->pubsubReader = name;
     } else if (name != "") {
         DBENTRY entry;
         dbInitEntry(pdbbase, &entry);
         if (dbFindRecord(&entry, name.c_str())) {
             dbFinishEntry(&entry);
-            throw std::runtime_error(SB() << "unknown subscription/session/opcuaItemRecord '" << name << "'");
+            throw std::runtime_error(SB() << "unknown subscription/session/pubsubreader/opcuaItemRecord '" << name << "'");
         }
         if (dbFindField(&entry, "RTYP")
                 || strcmp(dbGetString(&entry), "opcuaItem")) {
@@ -232,112 +426,22 @@ parseLink (dbCommon *prec, const DBEntry &ent)
                                      << name << "' was not initialized correctly");
         }
         pinfo->item = pconnector->pitem;
-        sep = linkstr.find_first_not_of("; \t", send);
         dbFinishEntry(&entry);
     } else {
         throw std::runtime_error(SB() << "link is missing subscription/session/opcuaItemRecord name");
     }
 
-    sep = linkstr.find_first_not_of("; \t", send);
-
-    // everything else is "key=value ..." options
-    while (sep != std::string::npos && sep < linkstr.size()) {
-        send = linkstr.find_first_of("; \t", sep);
-        size_t seq = linkstr.find_first_of('=', sep);
-
-        // allow escaping separators
-        while (send != std::string::npos && linkstr[send-1] == '\\') {
-                linkstr.erase(send-1, 1);
-                send = linkstr.find_first_of("; \t", send);
-        }
-
-        if (seq == std::string::npos || (send != std::string::npos && seq >= send))
-            throw std::runtime_error(SB() << "expected '=' in '" << linkstr.substr(0, send) << "'");
-
-        std::string optname(linkstr.substr(sep, seq-sep)),
-                    optval (linkstr.substr(seq+1, send-seq-1));
-
-        if (debug > 19) {
-            std::cerr << prec->name << " opt '" << optname << "'='" << optval << "'" << std::endl;
-        }
-
-        // Item/node related options
-        if (pinfo->linkedToItem && optname == "ns") {
-            if (epicsParseUInt16(optval.c_str(), &pinfo->namespaceIndex, 0, nullptr))
-                throw std::runtime_error(SB() << "error converting '" << optval << "' to UInt16");
-        } else if (pinfo->linkedToItem && optname == "s") {
-            pinfo->identifierString = optval;
-            pinfo->identifierIsNumeric = false;
-        } else if (pinfo->linkedToItem && optname == "i") {
-            if (epicsParseUInt32(optval.c_str(), &pinfo->identifierNumber, 0, nullptr))
-                throw std::runtime_error(SB() << "error converting '" << optval << "' to UInt32");
-            pinfo->identifierIsNumeric = true;
-        } else if (pinfo->linkedToItem && optname == "sampling") {
-            if (epicsParseDouble(optval.c_str(), &pinfo->samplingInterval, nullptr))
-                throw std::runtime_error(SB() << "error converting '" << optval << "' to Double");
-        } else if (pinfo->linkedToItem && optname == "qsize") {
-            if (epicsParseUInt32(optval.c_str(), &pinfo->queueSize, 0, nullptr))
-                throw std::runtime_error(SB() << "error converting '" << optval << "' to UInt32");
-        } else if (pinfo->linkedToItem && optname == "cqsize") {
-            if (epicsParseUInt32(optval.c_str(), &pinfo->clientQueueSize, 0, nullptr))
-                throw std::runtime_error(SB() << "error converting '" << optval << "' to UInt32");
-        } else if (pinfo->linkedToItem && optname == "discard") {
-            if (optval == "new")
-                pinfo->discardOldest = false;
-            else if (optval == "old")
-                pinfo->discardOldest = true;
-            else
-                throw std::runtime_error(SB() << "illegal value '" << optval << "'");
-        } else if (pinfo->linkedToItem && optname == "register") {
-            if (optval.length() > 0) {
-                pinfo->registerNode = getYesNo(optval[0]);
-            } else {
-                throw std::runtime_error(SB() << "no value for option '" << optname << "'");
-            }
-
-        // Item/node or Record/data element related options
-        } else if (optname == "timestamp") {
-            if (optval == linkOptionTimestampString(LinkOptionTimestamp::server))
-                pinfo->timestamp = LinkOptionTimestamp::server;
-            else if (optval == linkOptionTimestampString(LinkOptionTimestamp::source))
-                pinfo->timestamp = LinkOptionTimestamp::source;
-            else if (!pinfo->isItemRecord && optval == linkOptionTimestampString(LinkOptionTimestamp::data))
-                pinfo->timestamp = LinkOptionTimestamp::data;
-            else if (pinfo->isItemRecord && optval[0] == '@') {
-                pinfo->timestamp = LinkOptionTimestamp::data;
-                pinfo->timestampElement = optval.substr(1);
-            } else
-                throw std::runtime_error(SB() << "illegal value '" << optval << "'");
-        } else if (optname == "monitor" || optname == "readback") {
-            if (optval.length() > 0) {
-                pinfo->monitor = getYesNo(optval[0]);
-            } else {
-                throw std::runtime_error(SB() << "no value for option '" << optname << "'");
-            }
-        } else if (optname == "element") {
-            pinfo->element = optval;
-            pinfo->elementPath = splitString(optval);
-        } else if (optname == "bini") {
-            if (optval == "read")
-                pinfo->bini = LinkOptionBini::read;
-            else if (optval == "ignore")
-                pinfo->bini = LinkOptionBini::ignore;
-            else if ((pinfo->isItemRecord || pinfo->isOutput) && optval == "write")
-                pinfo->bini = LinkOptionBini::write;
-            else
-                throw std::runtime_error(SB() << "illegal value '" << optval << "' for option '" << optname << "'");
-        } else {
-            throw std::runtime_error(SB() << "invalid option '" << optname << "'");
-        }
-
-        sep = linkstr.find_first_not_of("; \t", send);
-    }
+    if (send != std::string::npos)
+        parseLinkOptions(*pinfo, linkstr.substr(send), prec->name, debug);
 
     if (!pinfo->clientQueueSize) {
         pinfo->clientQueueSize = static_cast<epicsUInt32>(ceil(abs(opcua_ClientQueueSizeFactor) * pinfo->queueSize));
         epicsUInt32 mini = static_cast<epicsUInt32>(abs(opcua_MinimumClientQueueSize));
         if (pinfo->clientQueueSize < mini) pinfo->clientQueueSize = mini;
     }
+    // a burst must fit into the client queue
+    if (pinfo->clientQueueSize < pinfo->burst)
+        pinfo->clientQueueSize = pinfo->burst;
 
     if (debug > 4) {
         std::cout << prec->name << " :";
@@ -346,6 +450,9 @@ parseLink (dbCommon *prec, const DBEntry &ent)
                 std::cout << " session=" << pinfo->session;
             else if (pinfo->subscription.length())
                 std::cout << " subscription=" << pinfo->subscription;
+            else if (pinfo->pubsubReader.length())
+                std::cout << " pubsubreader=" << pinfo->pubsubReader
+                          << " field=" << pinfo->pubsubField;
             std::cout << " ns=" << pinfo->namespaceIndex;
             if (pinfo->identifierIsNumeric)
                 std::cout << " id(i)=" << pinfo->identifierNumber;
@@ -355,7 +462,18 @@ parseLink (dbCommon *prec, const DBEntry &ent)
                       << " qsize=" << pinfo->queueSize
                       << " cqsize=" << pinfo->clientQueueSize
                       << " discard=" << (pinfo->discardOldest ? "old" : "new")
-                      << " registered=" << (pinfo->registerNode ? "y" : "n");
+                      << " registered=" << (pinfo->registerNode ? "y" : "n")
+                      << " meta=" << (pinfo->meta ? "y" : "n")
+                      << " dedup=" << (pinfo->dedup ? "y" : "n");
+            if (pinfo->dedupMax > 0.0)
+                std::cout << " dedupmax=" << pinfo->dedupMax;
+            if (pinfo->writeGroup.length())
+                std::cout << " group=" << pinfo->writeGroup
+                          << " trigger=" << (pinfo->groupTrigger ? "y" : "n");
+            if (pinfo->snapshotGroup.length())
+                std::cout << " snapshot=" << pinfo->snapshotGroup;
+            if (pinfo->itemProcessing)
+                std::cout << " itemproc=y";
         } else {
             std::cout << " element=" << pinfo->element;
         }
@@ -364,16 +482,16 @@ parseLink (dbCommon *prec, const DBEntry &ent)
             std::cout << "(@" << pinfo->timestampElement << ")";
         std::cout << " output=" << (pinfo->isOutput ? "y" : "n")
                   << " monitor=" << (pinfo->monitor ? "y" : "n")
-                  << " bini=" << linkOptionBiniString(pinfo->bini)
-                  << std::endl;
+                  << " bini=" << linkOptionBiniString(pinfo->bini);
+        if (pinfo->json)
+            std::cout << " json=y";
+        if (pinfo->burst)
+            std::cout << " burst=" << pinfo->burst
+                      << " bursttime=" << (pinfo->burstTime ? "y" : "n");
+        std::cout << std::endl;
     }
 
-    // consistency checks
-    if (pinfo->monitor && pinfo->linkedToItem && !pinfo->subscription.length())
-        throw std::runtime_error(SB() << "monitor=y requires link to a subscription");
-    if (pinfo->monitor && !pinfo->linkedToItem && !pinfo->item->linkinfo.monitor)
-        throw std::runtime_error(SB() << "monitor=y requires link to monitored opcuaItemRecord (but "
-                                 << pinfo->item->recConnector->getRecordName() << " is not)");
+    checkLinkOptions(*pinfo);
 
     return pinfo;
 }
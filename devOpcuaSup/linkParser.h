@@ -40,6 +40,32 @@ bool getYesNo(const char c);
 std::list<std::string> splitString(const std::string &str,
                                    const char delim = defaultElementDelimiter);
 
+/**
+ * @brief Parse the options of an INP/OUT link.
+ *
+ * Options are "key=value" pairs, separated by ';' or whitespace.
+ * The link type in info (linkedToItem, isOutput, isItemRecord, pubsubReader)
+ * must be set, as it decides which options are allowed.
+ *
+ * @param info  link configuration to update
+ * @param options  option part of the link (after the session/subscription name)
+ * @param recordName  record name (for debug output)
+ * @param debug  debug level
+ *
+ * @throws std::runtime_error  on invalid options or values
+ */
+void parseLinkOptions(linkInfo &info, std::string options,
+                      const char *recordName = "", const int debug = 0);
+
+/**
+ * @brief Check that the options of a parsed link are consistent.
+ *
+ * @param info  link configuration
+ *
+ * @throws std::runtime_error  on inconsistent options
+ */
+void checkLinkOptions(const linkInfo &info);
+
 std::unique_ptr<linkInfo> parseLink(dbCommon *prec, const DBEntry &ent);
 
 } // namespace DevOpcua
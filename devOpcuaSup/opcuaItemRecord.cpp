@@ -131,6 +131,11 @@ special (DBADDR *paddr, int after)
         } else if (fieldIndex == opcuaItemRecordWOC) {
             if (reinterpret_cast<opcuaItemRecord *>(paddr->precord)->woc == menuWocIMMEDIATE)
                 pcon->pitem->requestWriteIfDirty();
+        } else if (fieldIndex == opcuaItemRecordRSTAT) {
+            auto prec = reinterpret_cast<opcuaItemRecord *>(paddr->precord);
+            pcon->pitem->resetStatistics();
+            prec->latmax = 0.0;
+            db_post_events(prec, &prec->latmax, DBE_VALUE|DBE_LOG);
         }
     }
 
@@ -149,16 +154,44 @@ monitor (opcuaItemRecord *prec)
     }
 }
 
+template<typename T>
+void
+postIfChanged (opcuaItemRecord *prec, T *field, const T old)
+{
+    if (*field != old)
+        db_post_events(prec, field, DBE_VALUE|DBE_LOG);
+}
+
 long
 readwrite (opcuaItemRecord *prec)
 {
     auto pdset = reinterpret_cast<struct dset6<opcuaItemRecord> *>(prec->dset);
     long status = 0;
+    epicsUInt32 sovf = prec->sovf;
+    epicsUInt32 cdrop = prec->cdrop;
+    epicsFloat64 urate = prec->urate;
+    epicsFloat64 lat = prec->lat;
+    epicsFloat64 latmax = prec->latmax;
+    epicsUInt32 cqhwm = prec->cqhwm;
+    epicsFloat64 rsmpl = prec->rsmpl;
+    epicsUInt32 rqsize = prec->rqsize;
+    epicsFloat64 rrtt = prec->rrtt;
+    epicsFloat64 wrtt = prec->wrtt;
 
     status = pdset->readwrite(prec);
 
     if (!status)
         prec->udf = FALSE;
+    postIfChanged(prec, &prec->sovf, sovf);
+    postIfChanged(prec, &prec->cdrop, cdrop);
+    postIfChanged(prec, &prec->urate, urate);
+    postIfChanged(prec, &prec->lat, lat);
+    postIfChanged(prec, &prec->latmax, latmax);
+    postIfChanged(prec, &prec->cqhwm, cqhwm);
+    postIfChanged(prec, &prec->rsmpl, rsmpl);
+    postIfChanged(prec, &prec->rqsize, rqsize);
+    postIfChanged(prec, &prec->rrtt, rrtt);
+    postIfChanged(prec, &prec->wrtt, wrtt);
 
     return status;
 }
@@ -0,0 +1,354 @@
+/*************************************************************************\
+* Copyright (c) 2026 ITER Organization.
+* This module is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Author: Dirk Zimoch <dirk.zimoch@psi.ch>
+ */
+
+#include <chrono>
+#include <iomanip>
+#include <map>
+
+#include "devOpcua.h"
+#include "CryptoStats.h"
+
+// Since open62541 1.3, the crypto functions do not get the policy as first argument
+#if UA_OPEN62541_VER_MAJOR*100+UA_OPEN62541_VER_MINOR < 103
+#define POLICY_PARAM const UA_SecurityPolicy *policy,
+#define POLICY_ARG policy,
+#else
+#define POLICY_PARAM
+#define POLICY_ARG
+#endif
+
+namespace DevOpcua {
+
+namespace {
+
+typedef decltype(UA_SecurityPolicySignatureAlgorithm::sign) SignFunc;
+typedef decltype(UA_SecurityPolicySignatureAlgorithm::verify) VerifyFunc;
+typedef decltype(UA_SecurityPolicyEncryptionAlgorithm::encrypt) CryptFunc;
+typedef decltype(UA_SecurityPolicyChannelModule::newContext) NewContextFunc;
+typedef decltype(UA_SecurityPolicyChannelModule::deleteContext) DeleteContextFunc;
+
+// Algorithms: asymmetric module, symmetric module, certificate signing
+enum Module { asymModule, symModule, certModule, moduleCount };
+
+const CryptoStats::Operation signOp[moduleCount]
+    = {CryptoStats::asymSign, CryptoStats::symSign, CryptoStats::asymSign};
+const CryptoStats::Operation verifyOp[moduleCount]
+    = {CryptoStats::asymVerify, CryptoStats::symVerify, CryptoStats::asymVerify};
+const CryptoStats::Operation encryptOp[moduleCount]
+    = {CryptoStats::asymEncrypt, CryptoStats::symEncrypt, CryptoStats::asymEncrypt};
+const CryptoStats::Operation decryptOp[moduleCount]
+    = {CryptoStats::asymDecrypt, CryptoStats::symDecrypt, CryptoStats::asymDecrypt};
+
+// Original functions of an instrumented policy
+struct Wrapped {
+    CryptoStats *stats;
+    SignFunc sign[moduleCount];
+    VerifyFunc verify[moduleCount];
+    CryptFunc encrypt[moduleCount];
+    CryptFunc decrypt[moduleCount];
+    NewContextFunc newContext;
+    DeleteContextFunc deleteContext;
+};
+
+epicsMutex &
+registryLock ()
+{
+    static epicsMutex lock;
+    return lock;
+}
+
+// Instrumented policies (by policy) and their open channels (by channel context)
+std::map<const UA_SecurityPolicy *, Wrapped> &
+policyRegistry ()
+{
+    static std::map<const UA_SecurityPolicy *, Wrapped> registry;
+    return registry;
+}
+
+std::map<const void *, Wrapped> &
+channelRegistry ()
+{
+    static std::map<const void *, Wrapped> registry;
+    return registry;
+}
+
+bool
+lookup (const void *channelContext, Wrapped &wrapped)
+{
+    Guard G(registryLock());
+    auto it = channelRegistry().find(channelContext);
+    if (it == channelRegistry().end())
+        return false;
+    wrapped = it->second;
+    return true;
+}
+
+inline double
+since (const std::chrono::steady_clock::time_point &start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+template <int m>
+UA_StatusCode
+timedSign (POLICY_PARAM void *channelContext, const UA_ByteString *message, UA_ByteString *signature)
+{
+    Wrapped w;
+    if (!lookup(channelContext, w))
+        return UA_STATUSCODE_BADINTERNALERROR;
+    auto start = std::chrono::steady_clock::now();
+    UA_StatusCode status = w.sign[m](POLICY_ARG channelContext, message, signature);
+    if (w.stats)
+        w.stats->add(signOp[m], message->length, since(start));
+    return status;
+}
+
+template <int m>
+UA_StatusCode
+timedVerify (POLICY_PARAM void *channelContext, const UA_ByteString *message, const UA_ByteString *signature)
+{
+    Wrapped w;
+    if (!lookup(channelContext, w))
+        return UA_STATUSCODE_BADINTERNALERROR;
+    auto start = std::chrono::steady_clock::now();
+    UA_StatusCode status = w.verify[m](POLICY_ARG channelContext, message, signature);
+    if (w.stats)
+        w.stats->add(verifyOp[m], message->length, since(start));
+    return status;
+}
+
+template <int m>
+UA_StatusCode
+timedEncrypt (POLICY_PARAM void *channelContext, UA_ByteString *data)
+{
+    Wrapped w;
+    if (!lookup(channelContext, w))
+        return UA_STATUSCODE_BADINTERNALERROR;
+    size_t length = data->length;
+    auto start = std::chrono::steady_clock::now();
+    UA_StatusCode status = w.encrypt[m](POLICY_ARG channelContext, data);
+    if (w.stats)
+        w.stats->add(encryptOp[m], length, since(start));
+    return status;
+}
+
+template <int m>
+UA_StatusCode
+timedDecrypt (POLICY_PARAM void *channelContext, UA_ByteString *data)
+{
+    Wrapped w;
+    if (!lookup(channelContext, w))
+        return UA_STATUSCODE_BADINTERNALERROR;
+    size_t length = data->length;
+    auto start = std::chrono::steady_clock::now();
+    UA_StatusCode status = w.decrypt[m](POLICY_ARG channelContext, data);
+    if (w.stats)
+        w.stats->add(decryptOp[m], length, since(start));
+    return status;
+}
+
+// Register the new channel context, so that the wrappers find their originals and statistics
+UA_StatusCode
+registerContext (const UA_SecurityPolicy *policy,
+                 const UA_ByteString *remoteCertificate,
+                 void **channelContext)
+{
+    Wrapped w;
+    {
+        Guard G(registryLock());
+        auto it = policyRegistry().find(policy);
+        if (it == policyRegistry().end())
+            return UA_STATUSCODE_BADINTERNALERROR;
+        w = it->second;
+    }
+    UA_StatusCode status = w.newContext(policy, remoteCertificate, channelContext);
+    if (status == UA_STATUSCODE_GOOD) {
+        Guard G(registryLock());
+        channelRegistry()[*channelContext] = w;
+    }
+    return status;
+}
+
+void
+unregisterContext (void *channelContext)
+{
+    Wrapped w;
+    {
+        Guard G(registryLock());
+        auto it = channelRegistry().find(channelContext);
+        if (it == channelRegistry().end())
+            return;
+        w = it->second;
+        channelRegistry().erase(it);
+    }
+    w.deleteContext(channelContext);
+}
+
+template <int m>
+void
+wrapSignature (UA_SecurityPolicySignatureAlgorithm &alg, Wrapped &w)
+{
+    w.sign[m] = alg.sign;
+    w.verify[m] = alg.verify;
+    if (alg.sign)
+        alg.sign = timedSign<m>;
+    if (alg.verify)
+        alg.verify = timedVerify<m>;
+}
+
+template <int m>
+void
+wrapEncryption (UA_SecurityPolicyEncryptionAlgorithm &alg, Wrapped &w)
+{
+    w.encrypt[m] = alg.encrypt;
+    w.decrypt[m] = alg.decrypt;
+    if (alg.encrypt)
+        alg.encrypt = timedEncrypt<m>;
+    if (alg.decrypt)
+        alg.decrypt = timedDecrypt<m>;
+}
+
+} // namespace
+
+CryptoStats::CryptoStats ()
+{
+    clear();
+}
+
+CryptoStats::~CryptoStats ()
+{
+    Guard G(registryLock());
+    for (auto it = policyRegistry().begin(); it != policyRegistry().end();) {
+        if (it->second.stats == this)
+            it = policyRegistry().erase(it);
+        else
+            ++it;
+    }
+    // Open channels keep working (uninstrumented)
+    for (auto &it : channelRegistry())
+        if (it.second.stats == this)
+            it.second.stats = nullptr;
+}
+
+void
+CryptoStats::instrument (UA_SecurityPolicy *policies, const size_t count)
+{
+    static const UA_ByteString policyNone
+        = UA_STRING_STATIC("http://opcfoundation.org/UA/SecurityPolicy#None");
+
+    Guard G(registryLock());
+    for (size_t i = 0; i < count; i++) {
+        UA_SecurityPolicy &policy = policies[i];
+        if (UA_ByteString_equal(&policy.policyUri, &policyNone))
+            continue;
+        if (policy.channelModule.newContext == registerContext)
+            continue; // already instrumented
+
+        Wrapped w;
+        w.stats = this;
+        wrapSignature<asymModule>(policy.asymmetricModule.cryptoModule.signatureAlgorithm, w);
+        wrapEncryption<asymModule>(policy.asymmetricModule.cryptoModule.encryptionAlgorithm, w);
+        wrapSignature<symModule>(policy.symmetricModule.cryptoModule.signatureAlgorithm, w);
+        wrapEncryption<symModule>(policy.symmetricModule.cryptoModule.encryptionAlgorithm, w);
+        wrapSignature<certModule>(policy.certificateSigningAlgorithm, w);
+        w.encrypt[certModule] = nullptr;
+        w.decrypt[certModule] = nullptr;
+        w.newContext = policy.channelModule.newContext;
+        w.deleteContext = policy.channelModule.deleteContext;
+        policy.channelModule.newContext = registerContext;
+        policy.channelModule.deleteContext = unregisterContext;
+        policyRegistry()[&policy] = w;
+    }
+}
+
+void
+CryptoStats::release (const UA_SecurityPolicy *policies, const size_t count)
+{
+    Guard G(registryLock());
+    for (size_t i = 0; i < count; i++)
+        policyRegistry().erase(&policies[i]);
+}
+
+void
+CryptoStats::add (const Operation op, const size_t bytes, const double seconds)
+{
+    Guard G(lock);
+    count[op]++;
+    this->bytes[op] += bytes;
+    total[op] += seconds;
+    if (seconds > max[op])
+        max[op] = seconds;
+}
+
+void
+CryptoStats::clear ()
+{
+    Guard G(lock);
+    for (int i = 0; i < operationCount; i++) {
+        count[i] = 0;
+        bytes[i] = 0;
+        total[i] = 0.0;
+        max[i] = 0.0;
+    }
+}
+
+unsigned long
+CryptoStats::operations () const
+{
+    Guard G(lock);
+    unsigned long n = 0;
+    for (int i = 0; i < operationCount; i++)
+        n += count[i];
+    return n;
+}
+
+double
+CryptoStats::seconds () const
+{
+    Guard G(lock);
+    double t = 0.0;
+    for (int i = 0; i < operationCount; i++)
+        t += total[i];
+    return t;
+}
+
+const char *
+CryptoStats::operationName (const Operation op)
+{
+    static const char *names[operationCount] = {
+        "asym-sign", "asym-verify", "asym-encrypt", "asym-decrypt",
+        "sym-sign", "sym-verify", "sym-encrypt", "sym-decrypt"
+    };
+    return op < operationCount ? names[op] : "unknown";
+}
+
+void
+CryptoStats::show (std::ostream &os, const int level) const
+{
+    std::ios::fmtflags flags(os.flags());
+    os << std::fixed << std::setprecision(3)
+       << "crypto=" << operations() << " ops/" << seconds() * 1e3 << " ms";
+    if (level >= 1) {
+        Guard G(lock);
+        for (int i = 0; i < operationCount; i++) {
+            if (!count[i])
+                continue;
+            os << "\n  " << std::left << std::setw(13) << operationName(static_cast<Operation>(i))
+               << std::right << " n=" << count[i]
+               << " bytes=" << bytes[i]
+               << " total=" << total[i] * 1e3 << " ms"
+               << " avg=" << total[i] / count[i] * 1e6 << " us"
+               << " max=" << max[i] * 1e6 << " us";
+        }
+    }
+    os.flags(flags);
+}
+
+} // namespace DevOpcua
@@ -0,0 +1,103 @@
+/*************************************************************************\
+* Copyright (c) 2026 ITER Organization.
+* This module is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Author: Dirk Zimoch <dirk.zimoch@psi.ch>
+ */
+
+#ifndef DEVOPCUA_CRYPTOSTATS_H
+#define DEVOPCUA_CRYPTOSTATS_H
+
+#include <iostream>
+
+#include <open62541/client.h>
+#include <open62541/plugin/securitypolicy.h>
+
+#include <epicsMutex.h>
+
+namespace DevOpcua {
+
+/**
+ * @brief Time spent in the cryptographic functions of a session.
+ *
+ * Wraps the sign/verify and encrypt/decrypt functions of the (asymmetric and
+ * symmetric) modules of a client's security policies with timing wrappers.
+ * The wrappers find the statistics to update through the channel context,
+ * which is registered when the policy creates it.
+ *
+ * The policy None is not instrumented (no cost, no overhead).
+ */
+class CryptoStats
+{
+    // Cannot copy the statistics
+    CryptoStats(const CryptoStats &);
+    CryptoStats &operator=(const CryptoStats &);
+
+public:
+    enum Operation {
+        asymSign, asymVerify, asymEncrypt, asymDecrypt,
+        symSign, symVerify, symEncrypt, symDecrypt,
+        operationCount
+    };
+
+    CryptoStats();
+    ~CryptoStats();
+
+    /**
+     * @brief Instrument the (non-None) security policies of a client configuration.
+     *
+     * Must be called after the policies are set up and before connecting.
+     *
+     * @param policies  security policies of the client configuration
+     * @param count  number of policies
+     */
+    void instrument(UA_SecurityPolicy *policies, const size_t count);
+
+    /**
+     * @brief Forget instrumented policies (before the client configuration is deleted).
+     *
+     * Channel contexts that are still open keep working.
+     *
+     * @param policies  security policies of the client configuration
+     * @param count  number of policies
+     */
+    void release(const UA_SecurityPolicy *policies, const size_t count);
+
+    /**
+     * @brief Account for one cryptographic operation.
+     *
+     * @param op  operation
+     * @param bytes  size of the processed data
+     * @param seconds  time spent
+     */
+    void add(const Operation op, const size_t bytes, const double seconds);
+
+    /**
+     * @brief Reset all counters.
+     */
+    void clear();
+
+    unsigned long operations() const;
+    double seconds() const;
+
+    static const char *operationName(const Operation op);
+
+    /**
+     * @brief Print a one-line summary (level 0) or the per-operation statistics.
+     */
+    void show(std::ostream &os, const int level = 0) const;
+
+private:
+    mutable epicsMutex lock;
+    unsigned long count[operationCount];
+    unsigned long long bytes[operationCount];
+    double total[operationCount];   /**< [s] */
+    double max[operationCount];     /**< [s] */
+};
+
+} // namespace DevOpcua
+
+#endif // DEVOPCUA_CRYPTOSTATS_H
@@ -15,6 +15,7 @@
 #include <string>
 #include <cstring>
 #include <cstdlib>
+#include <algorithm>
 
 #include <errlog.h>
 #include <epicsTime.h>
@@ -25,8 +26,19 @@
 #include "UpdateQueue.h"
 #include "RecordConnector.h"
 
+// Public JSON encoding API (with encoding into a given buffer) since open62541 1.4
+#if defined(UA_ENABLE_JSON_ENCODING) && UA_OPEN62541_VER_MAJOR*100+UA_OPEN62541_VER_MINOR >= 104
+#define HAS_JSON_ENCODING
+#endif
+
 namespace DevOpcua {
 
+#ifdef HAS_JSON_ENCODING
+const bool DataElement::jsonSupported = true;
+#else
+const bool DataElement::jsonSupported = false;
+#endif
+
 /* Specific implementation of DataElement's "factory" method */
 void
 DataElement::addElementToTree(Item *item,
@@ -44,11 +56,24 @@ DataElementOpen62541::DataElementOpen62541 (const std::string &name,
     , timesrc(-1)
     , mapped(false)
     , incomingQueue(pconnector->plinkinfo->clientQueueSize, pconnector->plinkinfo->discardOldest)
+    , incomingType(nullptr)
+    , incomingScalar(false)
+    , burstQueued(false)
+    , encoderType(nullptr)
+    , encodeInt32(nullptr)
+    , encodeUInt32(nullptr)
+    , encodeInt64(nullptr)
+    , encodeFloat64(nullptr)
     , outgoingLock(pitem->dataTreeWriteLock)
     , isdirty(false)
 {
     UA_Variant_init(&incomingData);
     UA_Variant_init(&outgoingData);
+    UA_Variant_init(&spareData);
+    UA_Variant_init(&sentData);
+    UA_Variant_init(&confirmedData);
+    if (pconnector->plinkinfo->burst)
+        pitem->burstElements = true;
 }
 
 DataElementOpen62541::DataElementOpen62541 (const std::string &name,
@@ -58,11 +83,31 @@ DataElementOpen62541::DataElementOpen62541 (const std::string &name,
     , timesrc(-1)
     , mapped(false)
     , incomingQueue(0ul)
+    , incomingType(nullptr)
+    , incomingScalar(false)
+    , burstQueued(false)
+    , encoderType(nullptr)
+    , encodeInt32(nullptr)
+    , encodeUInt32(nullptr)
+    , encodeInt64(nullptr)
+    , encodeFloat64(nullptr)
     , outgoingLock(pitem->dataTreeWriteLock)
     , isdirty(false)
 {
     UA_Variant_init(&incomingData);
     UA_Variant_init(&outgoingData);
+    UA_Variant_init(&spareData);
+    UA_Variant_init(&sentData);
+    UA_Variant_init(&confirmedData);
+}
+
+DataElementOpen62541::~DataElementOpen62541 ()
+{
+    UA_Variant_clear(&incomingData);
+    UA_Variant_clear(&outgoingData);
+    UA_Variant_clear(&spareData);
+    UA_Variant_clear(&sentData);
+    UA_Variant_clear(&confirmedData);
 }
 
 void
@@ -88,10 +133,18 @@ DataElementOpen62541::show (const int level, const unsigned int indent) const
     if (isLeaf()) {
         std::cout << "leaf=" << name << " record(" << pconnector->getRecordType() << ")="
                   << pconnector->getRecordName()
-                  << " type=" << variantTypeString(incomingData)
+                  << " type=" << variantTypeString(incomingType)
                   << " timestamp=" << linkOptionTimestampString(pconnector->plinkinfo->timestamp)
                   << " bini=" << linkOptionBiniString(pconnector->plinkinfo->bini)
-                  << " monitor=" << (pconnector->plinkinfo->monitor ? "y" : "n") << "\n";
+                  << " monitor=" << (pconnector->plinkinfo->monitor ? "y" : "n");
+        if (pconnector->plinkinfo->json)
+            std::cout << " json=y";
+        if (pconnector->plinkinfo->burst)
+            std::cout << " burst=" << pconnector->plinkinfo->burst
+                      << (pconnector->plinkinfo->burstTime ? "(time)" : "");
+        if (unsigned long n = incomingQueue.discarded())
+            std::cout << " dropped=" << n;
+        std::cout << "\n";
     } else {
         std::cout << "node=" << name << " children=" << elements.size()
                   << " mapped=" << (mapped ? "y" : "n") << "\n";
@@ -103,6 +156,45 @@ DataElementOpen62541::show (const int level, const unsigned int indent) const
     }
 }
 
+unsigned long
+DataElementOpen62541::discardedUpdates () const
+{
+    if (isLeaf())
+        return incomingQueue.discarded();
+    unsigned long n = 0;
+    for (auto it : elements) {
+        if (auto pelem = it.lock())
+            n += pelem->discardedUpdates();
+    }
+    return n;
+}
+
+size_t
+DataElementOpen62541::queueHighWaterMark () const
+{
+    if (isLeaf())
+        return incomingQueue.highWaterMark();
+    size_t n = 0;
+    for (auto it : elements) {
+        if (auto pelem = it.lock())
+            n = std::max(n, pelem->queueHighWaterMark());
+    }
+    return n;
+}
+
+void
+DataElementOpen62541::resetQueueHighWaterMark ()
+{
+    if (isLeaf()) {
+        incomingQueue.resetHighWaterMark();
+        return;
+    }
+    for (auto it : elements) {
+        if (auto pelem = it.lock())
+            pelem->resetQueueHighWaterMark();
+    }
+}
+
 bool
 DataElementOpen62541::createMap (const UA_DataType *type,
                                  const std::string *timefrom)
@@ -207,26 +299,36 @@ DataElementOpen62541::createMap (const UA_DataType *type,
 
 // Getting the timestamp and status information from the Item assumes that only one thread
 // is pushing data into the Item's DataElement structure at any time.
+// The incoming queue of a leaf is lock-free (single producer, single consumer),
+// so no lock is needed for pushing the update.
 void
 DataElementOpen62541::setIncomingData (const UA_Variant &value,
                                        ProcessReason reason,
                                        const std::string *timefrom)
 {
-    // Make a copy of this element and cache it
-
-    UA_Variant_clear(&incomingData);
-    UA_Variant_copy(&value, &incomingData);
-
     if (isLeaf()) {
+        // Writes only need type and shape: no cached copy of (possibly large) leaf values
+        // (a failed read keeps the type that was discovered from the node)
+        if (value.type || !pitem->hasNodeType()) {
+            incomingType = value.type;
+            incomingScalar = UA_Variant_isScalar(&value);
+        }
+
         if ((pitem->state() == ConnectionStatus::initialRead
              && (reason == ProcessReason::readComplete || reason == ProcessReason::readFailure))
             || (pitem->state() == ConnectionStatus::up)) {
 
-            Guard(pconnector->lock);
             bool wasFirst = false;
             // Make a copy of the value for this element and put it on the queue
             UA_Variant *valuecopy (new UA_Variant);
-            UA_Variant_copy(&value, valuecopy); // As a non-C++ object, UA_Variant has no copy constructor
+            if (pconnector->plinkinfo->burstTime) {
+                // Only the sample's source time stamp (as POSIX seconds) is read
+                epicsTimeStamp ts = pitem->tsSource;
+                UA_Double t = ts.secPastEpoch + POSIX_TIME_AT_EPICS_EPOCH + ts.nsec * 1e-9;
+                UA_Variant_setScalarCopy(valuecopy, &t, &UA_TYPES[UA_TYPES_DOUBLE]);
+            } else {
+                UA_Variant_copy(&value, valuecopy); // As a non-C++ object, UA_Variant has no copy constructor
+            }
             UpdateOpen62541 *u(new UpdateOpen62541(getIncomingTimeStamp(), reason, std::unique_ptr<UA_Variant>(valuecopy), getIncomingReadStatus()));
             incomingQueue.pushUpdate(std::shared_ptr<UpdateOpen62541>(u), &wasFirst);
             if (debug() >= 5)
@@ -236,10 +338,19 @@ DataElementOpen62541::setIncomingData (const UA_Variant &value,
                           << ") for record " << pconnector->getRecordName()
                           << " (queue use " << incomingQueue.size()
                           << "/" << incomingQueue.capacity() << ")" << std::endl;
-            if (wasFirst)
-                pconnector->requestRecordProcessing(reason);
+            if (wasFirst) {
+                // Burst records are processed once at the end of the notification batch
+                if (pconnector->plinkinfo->burst && reason == ProcessReason::incomingData)
+                    burstQueued = true;
+                else
+                    pconnector->requestRecordProcessing(reason);
+            }
         }
     } else {
+        // Make a copy of this element and cache it
+        UA_Variant_clear(&incomingData);
+        UA_Variant_copy(&value, &incomingData);
+
         if (UA_Variant_isEmpty(&value))
             return;
 
@@ -288,11 +399,40 @@ DataElementOpen62541::setIncomingData (const UA_Variant &value,
     }
 }
 
+void
+DataElementOpen62541::requestBurstProcessing ()
+{
+    if (isLeaf()) {
+        if (burstQueued) {
+            burstQueued = false;
+            pconnector->requestRecordProcessing(ProcessReason::incomingData);
+        }
+    } else {
+        for (auto it : elements) {
+            if (auto pelem = it.lock())
+                pelem->requestBurstProcessing();
+        }
+    }
+}
+
+void
+DataElementOpen62541::setWriteType (const UA_DataType *type, const bool scalar)
+{
+    if (!isLeaf() || incomingType)
+        return;
+    incomingType = type;
+    incomingScalar = scalar;
+    if (debug() >= 5)
+        std::cout << "Item " << pitem
+                  << " element " << name
+                  << " set write type " << variantTypeString(type)
+                  << (scalar ? "" : "[]") << std::endl;
+}
+
 void
 DataElementOpen62541::setIncomingEvent (ProcessReason reason)
 {
     if (isLeaf()) {
-        Guard(pconnector->lock);
         bool wasFirst = false;
         // Put the event on the queue
         UpdateOpen62541 *u(new UpdateOpen62541(getIncomingTimeStamp(), reason));
@@ -416,6 +556,55 @@ DataElementOpen62541::getOutgoingData ()
     return outgoingData;
 }
 
+bool
+DataElementOpen62541::isUnchanged (const UA_Variant &data, const double maxAge) const
+{
+    return isUnchanged(data, confirmedData, epicsTime::getCurrent() - tsSent, maxAge);
+}
+
+bool
+DataElementOpen62541::isUnchanged (const UA_Variant &data, const UA_Variant &confirmed,
+                                   const double sentAge, const double maxAge)
+{
+    if (UA_Variant_isEmpty(&confirmed) || UA_Variant_isEmpty(&data))
+        return false;
+    if (maxAge > 0.0 && sentAge >= maxAge)
+        return false;
+    return UA_order(&data, &confirmed, &UA_TYPES[UA_TYPES_VARIANT]) == UA_ORDER_EQ;
+}
+
+void
+DataElementOpen62541::markAsSent (const UA_Variant &data)
+{
+    UA_Variant_clear(&sentData);
+    UA_Variant_copy(&data, &sentData);
+    tsSent = epicsTime::getCurrent();
+}
+
+void
+DataElementOpen62541::confirmSent ()
+{
+    if (!UA_Variant_isEmpty(&sentData)) {
+        UA_Variant_clear(&confirmedData);
+        confirmedData = sentData;       // move: ownership of the content passes over
+        UA_Variant_init(&sentData);
+    }
+}
+
+void
+DataElementOpen62541::setConfirmedData (const UA_Variant &data)
+{
+    UA_Variant_clear(&confirmedData);
+    UA_Variant_copy(&data, &confirmedData);
+}
+
+void
+DataElementOpen62541::clearConfirmedData ()
+{
+    UA_Variant_clear(&sentData);
+    UA_Variant_clear(&confirmedData);
+}
+
 void
 DataElementOpen62541::dbgReadScalar (const UpdateOpen62541 *upd,
                                  const std::string &targetTypeName,
@@ -501,8 +690,15 @@ DataElementOpen62541::readScalar (char *value, const size_t num,
 {
     long ret = 0;
 
+    if (pconnector->plinkinfo->json) {
+        epicsUInt32 numRead;
+        return readJson(value, static_cast<epicsUInt32>(num), &numRead, prec, nextReason,
+                        statusCode, statusText, statusTextLen);
+    }
+
     if (incomingQueue.empty()) {
-        errlogPrintf("%s: incoming data queue empty\n", prec->name);
+        if (reportError(ErrorClass::incomingQueueEmpty, prec))
+            errlogPrintf("%s: incoming data queue empty\n", prec->name);
         if (nextReason)
             *nextReason = ProcessReason::none;
         return 1;
@@ -572,6 +768,101 @@ DataElementOpen62541::readScalar (char *value, const size_t num,
     return ret;
 }
 
+// Encoding goes directly into the record's (preallocated) buffer - no allocation per update
+long
+DataElementOpen62541::readJson (char *value, const epicsUInt32 len,
+                                epicsUInt32 *numRead,
+                                dbCommon *prec,
+                                ProcessReason *nextReason,
+                                epicsUInt32 *statusCode,
+                                char *statusText,
+                                const epicsUInt32 statusTextLen)
+{
+    long ret = 0;
+    epicsUInt32 elemsWritten = 0;
+
+    if (incomingQueue.empty()) {
+        if (reportError(ErrorClass::incomingQueueEmpty, prec))
+            errlogPrintf("%s : incoming data queue empty\n", prec->name);
+        *numRead = 0;
+        return 1;
+    }
+
+    ProcessReason nReason;
+    std::shared_ptr<UpdateOpen62541> upd = incomingQueue.popUpdate(&nReason);
+    dbgReadScalar(upd.get(), "JSON", len);
+
+    switch (upd->getType()) {
+    case ProcessReason::readFailure:
+        (void) recGblSetSevr(prec, READ_ALARM, INVALID_ALARM);
+        ret = 1;
+        break;
+    case ProcessReason::connectionLoss:
+        (void) recGblSetSevr(prec, COMM_ALARM, INVALID_ALARM);
+        ret = 1;
+        break;
+    case ProcessReason::incomingData:
+    case ProcessReason::readComplete:
+    {
+        if (len > 1 && value) {
+            UA_StatusCode stat = upd->getStatus();
+            if (UA_STATUS_IS_BAD(stat)) {
+                (void) recGblSetSevr(prec, READ_ALARM, INVALID_ALARM);
+                ret = 1;
+            } else if (UA_STATUS_IS_UNCERTAIN(stat)) {
+                (void) recGblSetSevr(prec, READ_ALARM, MINOR_ALARM);
+            }
+            UA_Variant &data = upd->getData();
+#ifdef HAS_JSON_ENCODING
+            // The DataValue (value and status) is encoded, also for bad status
+            UA_DataValue dv;
+            UA_DataValue_init(&dv);
+            dv.value = data; // shallow copy
+            dv.hasValue = !UA_Variant_isEmpty(&data);
+            dv.status = stat;
+            dv.hasStatus = (stat != UA_STATUSCODE_GOOD);
+            UA_ByteString buffer;
+            buffer.length = len - 1; // leave space for the terminator
+            buffer.data = reinterpret_cast<UA_Byte *>(value);
+            UA_StatusCode encStat = UA_encodeJson(&dv, &UA_TYPES[UA_TYPES_DATAVALUE], &buffer, nullptr);
+            if (encStat == UA_STATUSCODE_GOOD) {
+                value[buffer.length] = '\0';
+                elemsWritten = static_cast<epicsUInt32>(buffer.length + 1);
+                prec->udf = false;
+            } else {
+                value[0] = '\0';
+                if (reportError(ErrorClass::incomingEncoding, prec))
+                    errlogPrintf("%s : JSON encoding failed (%s; %lu bytes needed, %u available)\n",
+                                 prec->name, UA_StatusCode_name(encStat),
+                                 static_cast<unsigned long>(UA_calcSizeJson(&dv, &UA_TYPES[UA_TYPES_DATAVALUE], nullptr) + 1),
+                                 len);
+                (void) recGblSetSevr(prec, READ_ALARM, INVALID_ALARM);
+                ret = 1;
+            }
+#else
+            value[0] = '\0';
+            (void) recGblSetSevr(prec, READ_ALARM, INVALID_ALARM);
+            ret = 1;
+#endif
+            UA_Variant_clear(&data);
+            if (statusCode) *statusCode = stat;
+            if (statusText) {
+                strncpy(statusText, UA_StatusCode_name(stat), statusTextLen);
+                statusText[statusTextLen-1] = '\0';
+            }
+        }
+        break;
+    }
+    default:
+        break;
+    }
+
+    prec->time = upd->getTimeStamp();
+    if (nextReason) *nextReason = nReason;
+    *numRead = elemsWritten;
+    return ret;
+}
+
 void
 DataElementOpen62541::dbgReadArray (const UpdateOpen62541 *upd,
                                 const epicsUInt32 targetSize,
@@ -617,7 +908,8 @@ DataElementOpen62541::readArray (char *value, const epicsUInt32 len,
     epicsUInt32 elemsWritten = 0;
 
     if (incomingQueue.empty()) {
-        errlogPrintf("%s : incoming data queue empty\n", prec->name);
+        if (reportError(ErrorClass::incomingQueueEmpty, prec))
+            errlogPrintf("%s : incoming data queue empty\n", prec->name);
         *numRead = 0;
         return 1;
     }
@@ -648,12 +940,14 @@ DataElementOpen62541::readArray (char *value, const epicsUInt32 len,
                 // Valid OPC UA value, so try to convert
                 UA_Variant &data = upd->getData();
                 if (UA_Variant_isScalar(&data)) {
-                    errlogPrintf("%s : incoming data is not an array\n", prec->name);
+                    if (reportError(ErrorClass::incomingType, prec))
+                        errlogPrintf("%s : incoming data is not an array\n", prec->name);
                     (void) recGblSetSevr(prec, READ_ALARM, INVALID_ALARM);
                     ret = 1;
                 } else if (data.type != expectedType) {
-                    errlogPrintf("%s : incoming data type (%s) does not match EPICS array type (%s)\n",
-                                 prec->name, variantTypeString(data), epicsTypeString(value));
+                    if (reportError(ErrorClass::incomingType, prec))
+                        errlogPrintf("%s : incoming data type (%s) does not match EPICS array type (%s)\n",
+                                     prec->name, variantTypeString(data), epicsTypeString(value));
                     (void) recGblSetSevr(prec, READ_ALARM, INVALID_ALARM);
                     ret = 1;
                 } else {
@@ -697,6 +991,9 @@ DataElementOpen62541::readArray (epicsInt8 *value, const epicsUInt32 num,
                              char *statusText,
                              const epicsUInt32 statusTextLen)
 {
+    if (pconnector->plinkinfo->json)
+        return readJson(reinterpret_cast<char *>(value), num, numRead, prec, nextReason,
+                        statusCode, statusText, statusTextLen);
     return readArray<epicsInt8>(value, num, numRead, &UA_TYPES[UA_TYPES_SBYTE], prec, nextReason, statusCode, statusText, statusTextLen);
 }
 
@@ -709,6 +1006,9 @@ DataElementOpen62541::readArray (epicsUInt8 *value, const epicsUInt32 num,
                              char *statusText,
                              const epicsUInt32 statusTextLen)
 {
+    if (pconnector->plinkinfo->json)
+        return readJson(reinterpret_cast<char *>(value), num, numRead, prec, nextReason,
+                        statusCode, statusText, statusTextLen);
     return readArray<epicsUInt8>(value, num, numRead, &UA_TYPES[UA_TYPES_BYTE], prec, nextReason, statusCode, statusText, statusTextLen);
 }
 
@@ -865,7 +1165,7 @@ DataElementOpen62541::writeScalar (const char *value, const epicsUInt32 len, dbC
     unsigned long ul;
     double d;
 
-    switch (typeKindOf(incomingData)) {
+    switch (typeKindOf(incomingType)) {
     case UA_TYPES_STRING:
     {
         UA_String val;
@@ -1004,13 +1304,15 @@ DataElementOpen62541::writeScalar (const char *value, const epicsUInt32 len, dbC
         break;
     }
     default:
-        errlogPrintf("%s : unsupported conversion for outgoing data\n",
-                     prec->name);
+        if (reportError(ErrorClass::outgoingConversion, prec))
+            errlogPrintf("%s : unsupported conversion for outgoing data\n",
+                         prec->name);
         (void) recGblSetSevr(prec, WRITE_ALARM, INVALID_ALARM);
     }
     if (ret == 0 && UA_STATUS_IS_BAD(status)) {
-        errlogPrintf("%s : scalar copy failed: %s\n",
-                     prec->name, UA_StatusCode_name(status));
+        if (reportError(ErrorClass::outgoingConversion, prec))
+            errlogPrintf("%s : scalar copy failed: %s\n",
+                         prec->name, UA_StatusCode_name(status));
         (void) recGblSetSevr(prec, WRITE_ALARM, INVALID_ALARM);
         ret = 1;
     }
@@ -1030,6 +1332,32 @@ DataElementOpen62541::dbgWriteArray (const epicsUInt32 targetSize, const std::st
     }
 }
 
+// Write CHAR/UCHAR array to a ByteString scalar
+long
+DataElementOpen62541::writeByteString (const void *value, const epicsUInt32 num, dbCommon *prec)
+{
+    long ret = 0;
+    UA_StatusCode status;
+
+    { // Scope of Guard G
+        Guard G(outgoingLock);
+        status = byteStringFromBuffer(outgoingData, value, num);
+        if (status == UA_STATUSCODE_GOOD)
+            markAsDirty();
+    }
+    if (UA_STATUS_IS_BAD(status)) {
+        if (reportError(ErrorClass::outgoingConversion, prec))
+            errlogPrintf("%s : ByteString copy failed: %s\n",
+                         prec->name, UA_StatusCode_name(status));
+        (void) recGblSetSevr(prec, WRITE_ALARM, INVALID_ALARM);
+        ret = 1;
+    } else if (isLeaf() && debug()) {
+        std::cout << pconnector->getRecordName() << ": writing array of "
+                  << num << " bytes as ByteString" << std::endl;
+    }
+    return ret;
+}
+
 // Write array for EPICS String / UA_String
 long
 DataElementOpen62541::writeArray (const char **value, const epicsUInt32 len,
@@ -1039,22 +1367,25 @@ DataElementOpen62541::writeArray (const char **value, const epicsUInt32 len,
 {
     long ret = 0;
 
-    if (UA_Variant_isScalar(&incomingData)) {
-        errlogPrintf("%s : OPC UA data type is not an array\n", prec->name);
+    if (incomingScalar) {
+        if (reportError(ErrorClass::outgoingConversion, prec))
+            errlogPrintf("%s : OPC UA data type is not an array\n", prec->name);
         (void) recGblSetSevr(prec, WRITE_ALARM, INVALID_ALARM);
         ret = 1;
-    } else if (incomingData.type != targetType) {
-        errlogPrintf("%s : OPC UA data type (%s) does not match expected type (%s) for EPICS array (%s)\n",
-                     prec->name,
-                     variantTypeString(incomingData),
-                     variantTypeString(targetType),
-                     epicsTypeString(*value));
+    } else if (incomingType != targetType) {
+        if (reportError(ErrorClass::outgoingConversion, prec))
+            errlogPrintf("%s : OPC UA data type (%s) does not match expected type (%s) for EPICS array (%s)\n",
+                         prec->name,
+                         variantTypeString(incomingType),
+                         variantTypeString(targetType),
+                         epicsTypeString(*value));
         (void) recGblSetSevr(prec, WRITE_ALARM, INVALID_ALARM);
         ret = 1;
     } else {
         UA_String *arr = static_cast<UA_String *>(UA_Array_new(num, &UA_TYPES[UA_TYPES_STRING]));
         if (!arr) {
-            errlogPrintf("%s : out of memory\n", prec->name);
+            if (reportError(ErrorClass::outgoingConversion, prec))
+                errlogPrintf("%s : out of memory\n", prec->name);
             (void) recGblSetSevr(prec, WRITE_ALARM, INVALID_ALARM);
         } else {
             for (epicsUInt32 i = 0; i < num; i++) {
@@ -1079,8 +1410,9 @@ DataElementOpen62541::writeArray (const char **value, const epicsUInt32 len,
                 markAsDirty();
             }
             if (UA_STATUS_IS_BAD(status)) {
-                errlogPrintf("%s : array copy failed: %s\n",
-                             prec->name, UA_StatusCode_name(status));
+                if (reportError(ErrorClass::outgoingConversion, prec))
+                    errlogPrintf("%s : array copy failed: %s\n",
+                                 prec->name, UA_StatusCode_name(status));
                 (void) recGblSetSevr(prec, WRITE_ALARM, INVALID_ALARM);
                 ret = 1;
             } else {
@@ -1094,13 +1426,17 @@ DataElementOpen62541::writeArray (const char **value, const epicsUInt32 len,
 long
 DataElementOpen62541::writeArray (const epicsInt8 *value, const epicsUInt32 num, dbCommon *prec)
 {
+    if (incomingScalar && incomingType == &UA_TYPES[UA_TYPES_BYTESTRING])
+        return writeByteString(value, num, prec);
     return writeArray<epicsInt8>(value, num, &UA_TYPES[UA_TYPES_SBYTE], prec);
 }
 
 long
 DataElementOpen62541::writeArray (const epicsUInt8 *value, const epicsUInt32 num, dbCommon *prec)
 {
-    return writeArray<epicsUInt8>(value, num, &UA_TYPES[UA_TYPES_SBYTE], prec);
+    if (incomingScalar && incomingType == &UA_TYPES[UA_TYPES_BYTESTRING])
+        return writeByteString(value, num, prec);
+    return writeArray<epicsUInt8>(value, num, &UA_TYPES[UA_TYPES_BYTE], prec);
 }
 
 long
@@ -35,6 +35,7 @@
 #include "RecordConnector.h"
 #include "Update.h"
 #include "UpdateQueue.h"
+#include "ErrorReporter.h"
 #include "ItemOpen62541.h"
 
 namespace DevOpcua {
@@ -76,6 +77,43 @@ inline int typeKindOf(const UA_Variant& v)
     return typeKindOf(v.type);
 }
 
+// ByteString scalars are mapped to/from CHAR/UCHAR arrays (waveform, aai, aao)
+inline bool isByteString(const UA_Variant& v)
+{
+    return UA_Variant_isScalar(&v) && v.type == &UA_TYPES[UA_TYPES_BYTESTRING];
+}
+
+// Copy the content of a ByteString variant into a byte buffer, return the number of bytes copied
+inline size_t
+byteStringToBuffer (const UA_Variant &v, void *buffer, const size_t size)
+{
+    const UA_ByteString *bs = static_cast<const UA_ByteString *>(v.data);
+    size_t n = size < bs->length ? size : bs->length;
+    if (n)
+        memcpy(buffer, bs->data, n);
+    return n;
+}
+
+// Set a variant to a ByteString with a copy of a byte buffer
+// (the variant takes ownership of the new ByteString: one copy only)
+inline UA_StatusCode
+byteStringFromBuffer (UA_Variant &v, const void *buffer, const size_t size)
+{
+    UA_ByteString *bs = UA_ByteString_new();
+    if (!bs)
+        return UA_STATUSCODE_BADOUTOFMEMORY;
+    UA_StatusCode status = UA_ByteString_allocBuffer(bs, size);
+    if (status != UA_STATUSCODE_GOOD) {
+        UA_ByteString_delete(bs);
+        return status;
+    }
+    if (size)
+        memcpy(bs->data, buffer, size);
+    UA_Variant_clear(&v);
+    UA_Variant_setScalar(&v, bs, &UA_TYPES[UA_TYPES_BYTESTRING]);
+    return UA_STATUSCODE_GOOD;
+}
+
 // Template for range check when writing
 template<typename TO, typename FROM>
 inline bool isWithinRange (const FROM &value) {
@@ -218,6 +256,121 @@ inline bool string_to(const std::string& s, epicsFloat64& value) {
     }
 }
 
+// Precompiled write encoders
+// An encoder stores an EPICS value as a scalar of one specific OPC UA type.
+// It is selected once per element and EPICS type (selectScalarEncoder) when the
+// OPC UA type of the node is known, so that a write is a range check plus a store.
+
+template<typename ET>
+using ScalarEncoder = UA_StatusCode (*)(UA_Variant &data, const ET &value);
+
+// Store a scalar of a simple (pointer free) type,
+// reusing the variant's buffer if it already holds a scalar of that type
+template<typename UT>
+inline UA_StatusCode
+storeScalar (UA_Variant &data, const UT &value, const UA_DataType *type)
+{
+    if (data.type != type || !UA_Variant_isScalar(&data) || data.storageType != UA_VARIANT_DATA) {
+        UT *val = static_cast<UT *>(UA_new(type));
+        if (!val)
+            return UA_STATUSCODE_BADOUTOFMEMORY;
+        UA_Variant_clear(&data);
+        UA_Variant_setScalar(&data, val, type);
+    }
+    *static_cast<UT *>(data.data) = value;
+    return UA_STATUSCODE_GOOD;
+}
+
+// Store an array of a simple (pointer free) type,
+// reusing the variant's buffer if it already holds an array of that type and length
+inline UA_StatusCode
+storeArray (UA_Variant &data, const void *value, const size_t num, const UA_DataType *type)
+{
+    if (num && type->pointerFree && data.type == type && data.arrayLength == num
+            && data.storageType == UA_VARIANT_DATA && !data.arrayDimensionsSize) {
+        memcpy(data.data, value, num * type->memSize);
+        return UA_STATUSCODE_GOOD;
+    }
+    UA_Variant_clear(&data);
+    return UA_Variant_setArrayCopy(&data, value, num, type);
+}
+
+// Outgoing value buffers are reused: the write request borrows the buffer
+// and hands it back (as spare) after the request has been encoded,
+// so that the next write stores into it instead of allocating
+
+// Take the spare buffer as outgoing buffer (if there is no outgoing value)
+inline void
+takeSpareBuffer (UA_Variant &data, UA_Variant &spare)
+{
+    if (UA_Variant_isEmpty(&data) && !UA_Variant_isEmpty(&spare)) {
+        data = spare;
+        UA_Variant_init(&spare);
+    }
+}
+
+// Keep the buffer of a sent value as spare (or free it if there is one)
+inline void
+keepSpareBuffer (UA_Variant &spare, UA_Variant &sent)
+{
+    if (UA_Variant_isEmpty(&spare) && sent.storageType == UA_VARIANT_DATA) {
+        spare = sent;
+        UA_Variant_init(&sent);
+    } else {
+        UA_Variant_clear(&sent);
+    }
+}
+
+template<typename ET, typename UT, int UATYPE>
+inline UA_StatusCode
+encodeScalar (UA_Variant &data, const ET &value)
+{
+    if (!isWithinRange<UT>(value))
+        return UA_STATUSCODE_BADOUTOFRANGE;
+    return storeScalar<UT>(data, static_cast<UT>(value), &UA_TYPES[UATYPE]);
+}
+
+template<typename ET>
+inline UA_StatusCode
+encodeBoolean (UA_Variant &data, const ET &value)
+{
+    return storeScalar<UA_Boolean>(data, (value != 0), &UA_TYPES[UA_TYPES_BOOLEAN]);
+}
+
+template<typename ET>
+inline UA_StatusCode
+encodeString (UA_Variant &data, const ET &value)
+{
+    std::string strval = std::to_string(value);
+    UA_String val;
+    val.length = strval.length();
+    val.data = const_cast<UA_Byte*>(reinterpret_cast<const UA_Byte*>(strval.c_str()));
+    UA_Variant_clear(&data);
+    return UA_Variant_setScalarCopy(&data, &val, &UA_TYPES[UA_TYPES_STRING]);
+}
+
+// Select the encoder for writing an EPICS type to an OPC UA type (nullptr if unsupported)
+template<typename ET>
+inline ScalarEncoder<ET>
+selectScalarEncoder (const UA_DataType *type)
+{
+    switch (typeKindOf(type)) {
+    case UA_TYPES_BOOLEAN: return &encodeBoolean<ET>;
+    case UA_TYPES_BYTE:    return &encodeScalar<ET, UA_Byte, UA_TYPES_BYTE>;
+    case UA_TYPES_SBYTE:   return &encodeScalar<ET, UA_SByte, UA_TYPES_SBYTE>;
+    case UA_TYPES_UINT16:  return &encodeScalar<ET, UA_UInt16, UA_TYPES_UINT16>;
+    case UA_TYPES_INT16:   return &encodeScalar<ET, UA_Int16, UA_TYPES_INT16>;
+    case UA_TYPES_UINT32:  return &encodeScalar<ET, UA_UInt32, UA_TYPES_UINT32>;
+    case UA_TYPES_INT32:   return &encodeScalar<ET, UA_Int32, UA_TYPES_INT32>;
+    case UA_TYPES_UINT64:  return &encodeScalar<ET, UA_UInt64, UA_TYPES_UINT64>;
+    case UA_TYPES_INT64:   return &encodeScalar<ET, UA_Int64, UA_TYPES_INT64>;
+    case UA_TYPES_FLOAT:   return &encodeScalar<ET, UA_Float, UA_TYPES_FLOAT>;
+    case UA_TYPES_DOUBLE:  return &encodeScalar<ET, UA_Double, UA_TYPES_DOUBLE>;
+    case UA_TYPES_STRING:  return &encodeString<ET>;
+    default:               return nullptr;
+    }
+}
+
 /**
  * @brief The DataElementOpen62541 implementation of a single piece of data.
  *
@@ -254,6 +407,11 @@ public:
     DataElementOpen62541(const std::string &name,
                      ItemOpen62541 *item);
 
+    /**
+     * @brief Destructor. Frees the cached values.
+     */
+    virtual ~DataElementOpen62541();
+
     /**
      * @brief Create a DataElement and add it to the item's dataTree.
      *
@@ -293,6 +451,25 @@ public:
      */
     void show(const int level, const unsigned int indent) const override;
 
+    /**
+     * @brief Get the number of updates discarded by client side queue overflows.
+     *
+     * @return  discarded updates of this leaf, or of all leaves below this node
+     */
+    unsigned long discardedUpdates() const;
+
+    /**
+     * @brief Get the high-water mark of the client side update queues.
+     *
+     * @return  high-water mark of this leaf, or the max. of all leaves below this node
+     */
+    size_t queueHighWaterMark() const;
+
+    /**
+     * @brief Reset the high-water marks of the client side update queues.
+     */
+    void resetQueueHighWaterMark();
+
     /**
      * @brief Push an incoming data value into the DataElement.
      *
@@ -307,6 +484,22 @@ public:
                          ProcessReason reason,
                          const std::string *timefrom = nullptr);
 
+    /**
+     * @brief Set the OPC UA type used for encoding writes.
+     *
+     * Allows writing before a value has been received (e.g. with bini=ignore).
+     * Only affects a leaf element that has not received a value yet.
+     *
+     * @param type  OPC UA data type of the node
+     * @param scalar  true if the node value is a scalar
+     */
+    void setWriteType(const UA_DataType *type, const bool scalar);
+
+    /**
+     * @brief Return true if the OPC UA type for encoding writes is known.
+     */
+    bool hasWriteType() const { return isLeaf() && !!incomingType; }
+
     /**
      * @brief Push an incoming event into the DataElement.
      *
@@ -317,6 +510,14 @@ public:
      */
     void setIncomingEvent(ProcessReason reason);
 
+    /**
+     * @brief Request processing of burst records at the end of a notification batch.
+     *
+     * Called after all data changes of a publish response have been pushed,
+     * so that the samples of one batch are read in one record processing.
+     */
+    void requestBurstProcessing();
+
     /**
      * @brief Get the outgoing data value from the DataElement.
      *
@@ -716,6 +917,79 @@ public:
      */
     virtual void clearOutgoingData() { UA_Variant_clear(&outgoingData); }
 
+    /**
+     * @brief Move the current outgoing data into a variant (no copy).
+     *
+     * Hands the outgoing buffer over to the write request,
+     * leaving the outgoing data empty.
+     *
+     * @param dest  variant to move the data to (must be empty)
+     */
+    void moveOutgoingData(UA_Variant &dest) { dest = outgoingData; UA_Variant_init(&outgoingData); }
+
+    /**
+     * @brief Hand the buffer of a sent value back for reuse.
+     *
+     * Called after the write request (that the buffer was moved to)
+     * has been encoded. The next write stores its value into the buffer.
+     *
+     * @param data  variant holding the sent value (cleared)
+     */
+    void recycleOutgoingData(UA_Variant &data) { keepSpareBuffer(spareData, data); }
+
+    /**
+     * @brief Check if an outgoing value is unchanged (write suppression).
+     *
+     * Compares the value with the last confirmed value, i.e. the value of
+     * the last successful write or the latest value read back from the server.
+     * Caller must hold the outgoing data lock.
+     *
+     * @param data  outgoing value
+     * @param maxAge  report a change if the last write is older than this [s] (0 = never)
+     * @return  true if the write can be suppressed
+     */
+    bool isUnchanged(const UA_Variant &data, const double maxAge) const;
+
+    /**
+     * @brief Write suppression decision (see isUnchanged).
+     *
+     * @param data  outgoing value
+     * @param confirmed  last confirmed value (empty = unknown)
+     * @param sentAge  time since the last write was sent [s]
+     * @param maxAge  report a change if sentAge is at least this [s] (0 = never)
+     * @return  true if the write can be suppressed
+     */
+    static bool isUnchanged(const UA_Variant &data, const UA_Variant &confirmed,
+                            const double sentAge, const double maxAge);
+
+    /**
+     * @brief Remember an outgoing value that is being sent.
+     * Caller must hold the outgoing data lock.
+     *
+     * @param data  outgoing value
+     */
+    void markAsSent(const UA_Variant &data);
+
+    /**
+     * @brief Make the last sent value the confirmed value (write was successful).
+     * Caller must hold the outgoing data lock.
+     */
+    void confirmSent();
+
+    /**
+     * @brief Set the confirmed value from a value read back from the server.
+     * Caller must hold the outgoing data lock.
+     *
+     * @param data  incoming value
+     */
+    void setConfirmedData(const UA_Variant &data);
+
+    /**
+     * @brief Discard the confirmed value (the next write will be sent).
+     * Caller must hold the outgoing data lock.
+     */
+    void clearConfirmedData();
+
     /**
      * @brief Create processing requests for record(s) attached to this element.
      * See DevOpcua::DataElement::requestRecordProcessing
@@ -737,6 +1011,15 @@ private:
                       const epicsUInt32 targetSize,
                       const std::string &targetTypeName) const;
     void checkWriteArray(const UA_DataType *expectedType, const std::string &targetTypeName) const;
+    long writeByteString(const void *value, const epicsUInt32 num, dbCommon *prec);
+    // Read the incoming value (with status) as JSON string (link option json=y)
+    long readJson(char *value, const epicsUInt32 len,
+                  epicsUInt32 *numRead,
+                  dbCommon *prec,
+                  ProcessReason *nextReason,
+                  epicsUInt32 *statusCode,
+                  char *statusText,
+                  const epicsUInt32 statusTextLen);
     void dbgWriteArray(const epicsUInt32 targetSize, const std::string &targetTypeName) const;
     bool updateDataInStruct(void* container,
                             const int index,
@@ -797,7 +1080,8 @@ private:
         long ret = 0;
 
         if (incomingQueue.empty()) {
-            errlogPrintf("%s: incoming data queue empty\n", prec->name);
+            if (reportError(ErrorClass::incomingQueueEmpty, prec))
+                errlogPrintf("%s: incoming data queue empty\n", prec->name);
             if (nextReason)
                 *nextReason = ProcessReason::none;
             return 1;
@@ -903,13 +1187,15 @@ private:
                             ret = 1;
                     }
                     if (ret == 1) {
-                        UA_String datastring = UA_STRING_NULL;
-                        if (data.type)
-                            UA_print(&data, data.type, &datastring); // Not terminated!
-                        errlogPrintf("%s : incoming data (%.*s) out-of-bounds\n",
-                                     prec->name,
-                                     static_cast<int>(datastring.length), datastring.data);
-                        UA_String_clear(&datastring);
+                        if (reportError(ErrorClass::incomingOutOfBounds, prec)) {
+                            UA_String datastring = UA_STRING_NULL;
+                            if (data.type)
+                                UA_print(&data, data.type, &datastring); // Not terminated!
+                            errlogPrintf("%s : incoming data (%.*s) out-of-bounds\n",
+                                         prec->name,
+                                         static_cast<int>(datastring.length), datastring.data);
+                            UA_String_clear(&datastring);
+                        }
                         (void) recGblSetSevr(prec, READ_ALARM, INVALID_ALARM);
                     } else {
                         if (UA_STATUS_IS_UNCERTAIN(stat)) {
@@ -936,6 +1222,89 @@ private:
         return ret;
     }
 
+    // Read queued scalar samples (burst mode) into an array as templated function on EPICS type
+    // Packs all queued updates (up to the burst size and the array size) in one record processing;
+    // with bursttime=y the per-sample source time stamps are read (as POSIX seconds) instead of the values
+    template<typename ET>
+    long
+    readBurst (ET *value, const epicsUInt32 num,
+               epicsUInt32 *numRead,
+               const UA_DataType *expectedType,
+               dbCommon *prec,
+               ProcessReason *nextReason,
+               epicsUInt32 *statusCode,
+               char *statusText,
+               const epicsUInt32 statusTextLen)
+    {
+        long ret = 0;
+        epicsUInt32 elemsWritten = 0;
+        const bool times = pconnector->plinkinfo->burstTime;
+        const epicsUInt32 max = pconnector->plinkinfo->burst < num ? pconnector->plinkinfo->burst : num;
+        UA_StatusCode stat = UA_STATUSCODE_GOOD;
+        ProcessReason nReason = ProcessReason::none;
+
+        while (elemsWritten < max && !incomingQueue.empty()) {
+            std::shared_ptr<UpdateOpen62541> upd = incomingQueue.popUpdate(&nReason);
+            prec->time = upd->getTimeStamp();
+            ProcessReason type = upd->getType();
+            if (type == ProcessReason::readFailure) {
+                (void) recGblSetSevr(prec, READ_ALARM, INVALID_ALARM);
+                ret = 1;
+                break;
+            } else if (type == ProcessReason::connectionLoss) {
+                (void) recGblSetSevr(prec, COMM_ALARM, INVALID_ALARM);
+                ret = 1;
+                break;
+            } else if (type != ProcessReason::incomingData && type != ProcessReason::readComplete) {
+                continue;
+            }
+            UA_StatusCode sampleStat = upd->getStatus();
+            if (UA_STATUS_IS_BAD(sampleStat)) {
+                // Skip samples without valid OPC UA value
+                (void) recGblSetSevr(prec, READ_ALARM, INVALID_ALARM);
+                stat = sampleStat;
+                ret = 1;
+                continue;
+            }
+            if (UA_STATUS_IS_UNCERTAIN(sampleStat)) {
+                (void) recGblSetSevr(prec, READ_ALARM, MINOR_ALARM);
+                if (!UA_STATUS_IS_BAD(stat))
+                    stat = sampleStat;
+            }
+            UA_Variant &data = upd->getData();
+            if (times) {
+                // bursttime=y (DOUBLE array, checked by the link parser): the sample is its source time stamp
+                value[elemsWritten++] = static_cast<ET>(*static_cast<UA_Double *>(data.data));
+            } else if (!UA_Variant_isScalar(&data) || data.type != expectedType) {
+                if (reportError(ErrorClass::incomingType, prec))
+                    errlogPrintf("%s : incoming data (%s) is not a scalar matching EPICS array type (%s)\n",
+                                 prec->name, variantTypeString(data), epicsTypeString(*value));
+                (void) recGblSetSevr(prec, READ_ALARM, INVALID_ALARM);
+                ret = 1;
+            } else {
+                memcpy(&value[elemsWritten++], data.data, sizeof(ET));
+            }
+            UA_Variant_clear(&data);
+        }
+        if (elemsWritten)
+            prec->udf = false;
+        if (debug() >= 5)
+            std::cout << "Element " << name << " read burst of " << elemsWritten
+                      << (times ? " time stamps" : " samples")
+                      << " for record " << prec->name
+                      << " (queue use " << incomingQueue.size()
+                      << "/" << incomingQueue.capacity() << ")" << std::endl;
+
+        if (statusCode) *statusCode = stat;
+        if (statusText) {
+            strncpy(statusText, UA_StatusCode_name(stat), statusTextLen);
+            statusText[statusTextLen-1] = '\0';
+        }
+        if (nextReason) *nextReason = nReason;
+        *numRead = elemsWritten;
+        return ret;
+    }
+
     // Read array value as templated function on EPICS type
     // CAVEAT: changes must also be reflected in specializations (in DataElementOpen62541.cpp)
     template<typename ET>
@@ -953,11 +1322,16 @@ private:
         epicsUInt32 elemsWritten = 0;
 
         if (incomingQueue.empty()) {
-            errlogPrintf("%s : incoming data queue empty\n", prec->name);
+            if (reportError(ErrorClass::incomingQueueEmpty, prec))
+                errlogPrintf("%s : incoming data queue empty\n", prec->name);
             *numRead = 0;
             return 1;
         }
 
+        if (pconnector->plinkinfo->burst)
+            return readBurst(value, num, numRead, expectedType, prec, nextReason,
+                             statusCode, statusText, statusTextLen);
+
         ProcessReason nReason;
         std::shared_ptr<UpdateOpen62541> upd = incomingQueue.popUpdate(&nReason);
         dbgReadArray(upd.get(), num, epicsTypeString(*value));
@@ -983,13 +1357,21 @@ private:
                 } else  {
                     // Valid OPC UA value, so try to convert
                     UA_Variant &data = upd->getData();
-                    if (UA_Variant_isScalar(&data)) {
-                        errlogPrintf("%s : incoming data is not an array\n", prec->name);
+                    if (sizeof(ET) == 1 && isByteString(data)) {
+                        if (UA_STATUS_IS_UNCERTAIN(stat)) {
+                            (void) recGblSetSevr(prec, READ_ALARM, MINOR_ALARM);
+                        }
+                        elemsWritten = static_cast<epicsUInt32>(byteStringToBuffer(data, value, num));
+                        prec->udf = false;
+                    } else if (UA_Variant_isScalar(&data)) {
+                        if (reportError(ErrorClass::incomingType, prec))
+                            errlogPrintf("%s : incoming data is not an array\n", prec->name);
                         (void) recGblSetSevr(prec, READ_ALARM, INVALID_ALARM);
                         ret = 1;
                     } else if (data.type != expectedType) {
-                        errlogPrintf("%s : incoming data type (%s) does not match EPICS array type (%s)\n",
-                                     prec->name, variantTypeString(data), epicsTypeString(*value));
+                        if (reportError(ErrorClass::incomingType, prec))
+                            errlogPrintf("%s : incoming data type (%s) does not match EPICS array type (%s)\n",
+                                         prec->name, variantTypeString(data), epicsTypeString(*value));
                         (void) recGblSetSevr(prec, READ_ALARM, INVALID_ALARM);
                         ret = 1;
                     } else {
@@ -1040,152 +1422,40 @@ private:
                  dbCommon *prec)
     {
         long ret = 0;
-        UA_StatusCode status = UA_STATUSCODE_BADUNEXPECTEDERROR;
+        ScalarEncoder<ET> &encoder = encoderFor(value);
+
+        // (Re-)select the encoders when the type of the node changes
+        if (encoderType != incomingType) {
+            clearEncoders();
+            encoderType = incomingType;
+        }
+        if (!encoder)
+            encoder = selectScalarEncoder<ET>(incomingType);
+        if (!encoder) {
+            if (reportError(ErrorClass::outgoingConversion, prec))
+                errlogPrintf("%s : unsupported conversion for outgoing data\n",
+                             prec->name);
+            (void) recGblSetSevr(prec, WRITE_ALARM, INVALID_ALARM);
+            return 1;
+        }
 
-        switch (typeKindOf(incomingData)) {
-        case UA_TYPES_BOOLEAN:
+        UA_StatusCode status;
         { // Scope of Guard G
             Guard G(outgoingLock);
-            UA_Boolean val = (value != 0);
-            status = UA_Variant_setScalarCopy(&outgoingData, &val, &UA_TYPES[UA_TYPES_BOOLEAN]);
-            markAsDirty();
-            break;
-        }
-        case UA_TYPES_BYTE:
-            if (isWithinRange<UA_Byte>(value)) {
-                Guard G(outgoingLock);
-                UA_Byte val = static_cast<UA_Byte>(value);
-                status = UA_Variant_setScalarCopy(&outgoingData, &val, &UA_TYPES[UA_TYPES_BYTE]);
+            takeSpareBuffer(outgoingData, spareData);
+            status = encoder(outgoingData, value);
+            if (status == UA_STATUSCODE_GOOD)
                 markAsDirty();
-            } else {
-                (void) recGblSetSevr(prec, WRITE_ALARM, INVALID_ALARM);
-                ret = 1;
-            }
-            break;
-        case UA_TYPES_SBYTE:
-            if (isWithinRange<UA_SByte>(value)) {
-                Guard G(outgoingLock);
-                UA_SByte val = static_cast<UA_Byte>(value);
-                status = UA_Variant_setScalarCopy(&outgoingData, &val, &UA_TYPES[UA_TYPES_SBYTE]);
-                markAsDirty();
-            } else {
-                (void) recGblSetSevr(prec, WRITE_ALARM, INVALID_ALARM);
-                ret = 1;
-            }
-            break;
-        case UA_TYPES_UINT16:
-            if (isWithinRange<UA_UInt16>(value)) {
-                Guard G(outgoingLock);
-                UA_UInt16 val = static_cast<UA_UInt16>(value);
-                status = UA_Variant_setScalarCopy(&outgoingData, &val, &UA_TYPES[UA_TYPES_UINT16]);
-                markAsDirty();
-            } else {
-                (void) recGblSetSevr(prec, WRITE_ALARM, INVALID_ALARM);
-                ret = 1;
-            }
-            break;
-        case UA_TYPES_INT16:
-            if (isWithinRange<UA_Int16>(value)) {
-                Guard G(outgoingLock);
-                UA_Int16 val = static_cast<UA_Int16>(value);
-                status = UA_Variant_setScalarCopy(&outgoingData, &val, &UA_TYPES[UA_TYPES_INT16]);
-                markAsDirty();
-            } else {
-                (void) recGblSetSevr(prec, WRITE_ALARM, INVALID_ALARM);
-                ret = 1;
-            }
-            break;
-        case UA_TYPES_UINT32:
-            if (isWithinRange<UA_UInt32>(value)) {
-                Guard G(outgoingLock);
-                UA_UInt32 val = static_cast<UA_UInt32>(value);
-                status = UA_Variant_setScalarCopy(&outgoingData, &val, &UA_TYPES[UA_TYPES_UINT32]);
-                markAsDirty();
-            } else {
-                (void) recGblSetSevr(prec, WRITE_ALARM, INVALID_ALARM);
-                ret = 1;
-            }
-            break;
-        case UA_TYPES_INT32:
-            if (isWithinRange<UA_Int32>(value)) {
-                Guard G(outgoingLock);
-                UA_Int32 val = static_cast<UA_Int32>(value);
-                status = UA_Variant_setScalarCopy(&outgoingData, &val, &UA_TYPES[UA_TYPES_INT32]);
-                markAsDirty();
-            } else {
-                (void) recGblSetSevr(prec, WRITE_ALARM, INVALID_ALARM);
-                ret = 1;
-            }
-            break;
-        case UA_TYPES_UINT64:
-            if (isWithinRange<UA_UInt64>(value)) {
-                Guard G(outgoingLock);
-                UA_UInt64 val = static_cast<UA_UInt64>(value);
-                status = UA_Variant_setScalarCopy(&outgoingData, &val, &UA_TYPES[UA_TYPES_UINT64]);
-                markAsDirty();
-            } else {
-                (void) recGblSetSevr(prec, WRITE_ALARM, INVALID_ALARM);
-                ret = 1;
-            }
-            break;
-        case UA_TYPES_INT64:
-            if (isWithinRange<UA_Int64>(value)) {
-                Guard G(outgoingLock);
-                UA_Int64 val = static_cast<UA_Int64>(value);
-                status = UA_Variant_setScalarCopy(&outgoingData, &val, &UA_TYPES[UA_TYPES_INT64]);
-                markAsDirty();
-            } else {
-                (void) recGblSetSevr(prec, WRITE_ALARM, INVALID_ALARM);
-                ret = 1;
-            }
-            break;
-        case UA_TYPES_FLOAT:
-            if (isWithinRange<UA_Float>(value)) {
-                Guard G(outgoingLock);
-                UA_Float val = static_cast<UA_Float>(value);
-                status = UA_Variant_setScalarCopy(&outgoingData, &val, &UA_TYPES[UA_TYPES_FLOAT]);
-                markAsDirty();
-            } else {
-                (void) recGblSetSevr(prec, WRITE_ALARM, INVALID_ALARM);
-                ret = 1;
-            }
-            break;
-        case UA_TYPES_DOUBLE:
-            if (isWithinRange<UA_Double>(value)) {
-                Guard G(outgoingLock);
-                UA_Double val = static_cast<UA_Double>(value);
-                status = UA_Variant_setScalarCopy(&outgoingData, &val, &UA_TYPES[UA_TYPES_DOUBLE]);
-                markAsDirty();
-            } else {
-                (void) recGblSetSevr(prec, WRITE_ALARM, INVALID_ALARM);
-                ret = 1;
-            }
-            break;
-        case UA_TYPES_STRING:
-        {
-            std::string strval = std::to_string(value);
-            UA_String val;
-            val.length = strval.length();
-            val.data = const_cast<UA_Byte*>(reinterpret_cast<const UA_Byte*>(strval.c_str()));
-            { // Scope of Guard G
-                Guard G(outgoingLock);
-                status = UA_Variant_setScalarCopy(&outgoingData, &val, &UA_TYPES[UA_TYPES_STRING]);
-                markAsDirty();
-            }
-            break;
         }
-        default:
-            ret = 1;
-            errlogPrintf("%s : unsupported conversion for outgoing data\n",
-                         prec->name);
+        if (status == UA_STATUSCODE_BADOUTOFRANGE) {
             (void) recGblSetSevr(prec, WRITE_ALARM, INVALID_ALARM);
-        }
-        if (ret == 0 && UA_STATUS_IS_BAD(status)) {
-            errlogPrintf("%s : scalar copy failed: %s\n",
-                         prec->name, UA_StatusCode_name(status));
+            ret = 1;
+        } else if (UA_STATUS_IS_BAD(status)) {
+            if (reportError(ErrorClass::outgoingConversion, prec))
+                errlogPrintf("%s : scalar copy failed: %s\n",
+                             prec->name, UA_StatusCode_name(status));
             (void) recGblSetSevr(prec, WRITE_ALARM, INVALID_ALARM);
             ret = 1;
-
         }
         dbgWriteScalar();
         return ret;
@@ -1209,28 +1479,32 @@ private:
     {
         long ret = 0;
 
-        if (UA_Variant_isScalar(&incomingData)) {
-            errlogPrintf("%s : OPC UA data type is not an array\n", prec->name);
+        if (incomingScalar) {
+            if (reportError(ErrorClass::outgoingConversion, prec))
+                errlogPrintf("%s : OPC UA data type is not an array\n", prec->name);
             (void) recGblSetSevr(prec, WRITE_ALARM, INVALID_ALARM);
             ret = 1;
-        } else if (incomingData.type != targetType) {
-            errlogPrintf("%s : OPC UA data type (%s) does not match expected type (%s) for EPICS array (%s)\n",
-                         prec->name,
-                         variantTypeString(incomingData),
-                         variantTypeString(targetType),
-                         epicsTypeString(*value));
+        } else if (incomingType != targetType) {
+            if (reportError(ErrorClass::outgoingConversion, prec))
+                errlogPrintf("%s : OPC UA data type (%s) does not match expected type (%s) for EPICS array (%s)\n",
+                             prec->name,
+                             variantTypeString(incomingType),
+                             variantTypeString(targetType),
+                             epicsTypeString(*value));
             (void) recGblSetSevr(prec, WRITE_ALARM, INVALID_ALARM);
             ret = 1;
         } else {
             UA_StatusCode status;
             { // Scope of Guard G
                 Guard G(outgoingLock);
-                status = UA_Variant_setArrayCopy(&outgoingData, value, num, targetType);
+                takeSpareBuffer(outgoingData, spareData);
+                status = storeArray(outgoingData, value, num, targetType);
                 markAsDirty();
             }
             if (UA_STATUS_IS_BAD(status)) {
-                errlogPrintf("%s : array copy failed: %s\n",
-                             prec->name, UA_StatusCode_name(status));
+                if (reportError(ErrorClass::outgoingConversion, prec))
+                    errlogPrintf("%s : array copy failed: %s\n",
+                                 prec->name, UA_StatusCode_name(status));
                 (void) recGblSetSevr(prec, WRITE_ALARM, INVALID_ALARM);
                 ret = 1;
             } else {
@@ -1240,6 +1514,20 @@ private:
         return ret;
     }
 
+    // Cached write encoders (one per EPICS type)
+    ScalarEncoder<epicsInt32> &encoderFor(const epicsInt32 &) { return encodeInt32; }
+    ScalarEncoder<epicsUInt32> &encoderFor(const epicsUInt32 &) { return encodeUInt32; }
+    ScalarEncoder<epicsInt64> &encoderFor(const epicsInt64 &) { return encodeInt64; }
+    ScalarEncoder<epicsFloat64> &encoderFor(const epicsFloat64 &) { return encodeFloat64; }
+    void
+    clearEncoders()
+    {
+        encodeInt32 = nullptr;
+        encodeUInt32 = nullptr;
+        encodeInt64 = nullptr;
+        encodeFloat64 = nullptr;
+    }
+
     ItemOpen62541 *pitem;                                       /**< corresponding item */
     std::vector<std::weak_ptr<DataElementOpen62541>> elements;  /**< children (if node) */
     std::shared_ptr<DataElementOpen62541> parent;               /**< parent */
@@ -1252,10 +1540,22 @@ private:
 
     bool mapped;                             /**< child name to index mapping done */
     UpdateQueue<UpdateOpen62541> incomingQueue;  /**< queue of incoming values */
-    UA_Variant incomingData;                 /**< cache of latest incoming value */
+    UA_Variant incomingData;                 /**< cache of latest incoming value (if node) */
+    const UA_DataType *incomingType;         /**< type of latest incoming value (if leaf) */
+    bool incomingScalar;                     /**< latest incoming value is a scalar (if leaf) */
+    bool burstQueued;                        /**< samples queued in this batch need a processing request (burst) */
+    const UA_DataType *encoderType;          /**< type the write encoders were selected for */
+    ScalarEncoder<epicsInt32> encodeInt32;   /**< write encoder for epicsInt32 (if selected) */
+    ScalarEncoder<epicsUInt32> encodeUInt32; /**< write encoder for epicsUInt32 (if selected) */
+    ScalarEncoder<epicsInt64> encodeInt64;   /**< write encoder for epicsInt64 (if selected) */
+    ScalarEncoder<epicsFloat64> encodeFloat64; /**< write encoder for epicsFloat64 (if selected) */
     epicsMutex &outgoingLock;                /**< data lock for outgoing value */
     UA_Variant outgoingData;                 /**< cache of latest outgoing value */
+    UA_Variant spareData;                    /**< buffer of a sent value, reused by the next write */
     bool isdirty;                            /**< outgoing value has been (or needs to be) updated */
+    UA_Variant sentData;                     /**< last value sent (write suppression) */
+    UA_Variant confirmedData;                /**< last value confirmed by the server (write suppression) */
+    epicsTime tsSent;                        /**< time of the last write sent (write suppression) */
 };
 
 } // namespace DevOpcua
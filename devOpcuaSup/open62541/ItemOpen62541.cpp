@@ -13,11 +13,15 @@
 #include <memory>
 #include <cstring>
 
+#include <dbAccessDefs.h>
+
 #include "RecordConnector.h"
+#include "ErrorReporter.h"
 #include "opcuaItemRecord.h"
 #include "ItemOpen62541.h"
 #include "SubscriptionOpen62541.h"
 #include "SessionOpen62541.h"
+#include "PubSubReaderOpen62541.h"
 #include "DataElementOpen62541.h"
 
 namespace DevOpcua {
@@ -33,33 +37,102 @@ ItemOpen62541::ItemOpen62541(const linkInfo &info)
     : Item(info)
     , subscription(nullptr)
     , session(nullptr)
+    , reader(nullptr)
+    , readSize(0)
     , registered(false)
     , revisedSamplingInterval(0.0)
     , revisedQueueSize(0)
+    , monitoredItemId(0)
+    , nodeTypeKnown(false)
+    , nodeDataType(nullptr)
+    , nodeValueRank(UA_VALUERANK_ANY)
     , dataTree(this)
     , dataTreeDirty(false)
+    , burstElements(false)
+    , suppressedWrites(0)
+    , overflows(0)
+    , readRoundTrip(0.0)
+    , writeRoundTrip(0.0)
     , lastStatus(UA_STATUSCODE_BADSERVERNOTCONNECTED)
     , lastReason(ProcessReason::connectionLoss)
     , connState(ConnectionStatus::down)
 {
     UA_NodeId_init(&nodeid);
+    if (linkinfo.pubsubReader != "") {
+        reader = PubSubReaderOpen62541::find(linkinfo.pubsubReader);
+        reader->addItemOpen62541(this);
+        return;
+    }
     if (linkinfo.subscription != "" && linkinfo.monitor) {
-        subscription = SubscriptionOpen62541::find(linkinfo.subscription);
-        subscription->addItemOpen62541(this);
+        subscription = SubscriptionOpen62541::find(linkinfo.subscription)->rateGroup(linkinfo.samplingInterval);
         session = &subscription->getSessionOpen62541();
     } else {
         session = SessionOpen62541::find(linkinfo.session);
     }
-    session->addItemOpen62541(this);
+    // At runtime (link change), the item is attached when it is completely set up
+    if (!interruptAccept)
+        attach();
 }
 
 ItemOpen62541::~ItemOpen62541 ()
 {
-    subscription->removeItemOpen62541(this);
-    session->removeItemOpen62541(this);
+    if (reader)
+        reader->removeItemOpen62541(this);
+    if (subscription)
+        subscription->removeItemOpen62541(this);
+    if (session)
+        session->removeItemOpen62541(this);
     UA_NodeId_clear(&nodeid);
 }
 
+void
+ItemOpen62541::attach ()
+{
+    if (subscription)
+        subscription->addItemOpen62541(this);
+    if (session) {
+        try {
+            session->addItemOpen62541(this);
+        } catch (...) {
+            // write group bound to another session
+            if (subscription)
+                subscription->removeItemOpen62541(this);
+            throw;
+        }
+    }
+}
+
+bool
+ItemOpen62541::detach ()
+{
+    // Changing the items of a running PubSub reader is not supported
+    if (reader)
+        return false;
+    if (subscription)
+        subscription->removeItemOpen62541(this);
+    session->removeItemOpen62541(this);
+    return true;
+}
+
+void
+ItemOpen62541::requestRead ()
+{
+    if (reader)
+        reader->requestRead(*this);
+    else
+        session->requestRead(*this);
+}
+
+void
+ItemOpen62541::requestWrite ()
+{
+    // PubSub readers are receive only
+    if (reader)
+        setIncomingEvent(ProcessReason::writeFailure);
+    else
+        session->requestWrite(*this);
+}
+
 void
 ItemOpen62541::rebuildNodeId ()
 {
@@ -81,9 +154,61 @@ ItemOpen62541::requestWriteIfDirty()
         recConnector->requestRecordProcessing(ProcessReason::writeRequest);
 }
 
+void
+ItemOpen62541::setNodeType(const UA_DataType *type,
+                           const UA_Int32 valueRank,
+                           const std::vector<UA_UInt32> &arrayDimensions)
+{
+    nodeDataType = type;
+    nodeValueRank = valueRank;
+    nodeArrayDimensions = arrayDimensions;
+    nodeTypeKnown = true;
+    applyNodeType();
+}
+
+void
+ItemOpen62541::applyNodeType()
+{
+    if (!nodeTypeKnown || !nodeDataType)
+        return;
+    // ValueRank: -1 = scalar, >= 0 = array; Any (-2) and ScalarOrOneDimension (-3) are ambiguous
+    if (nodeValueRank != UA_VALUERANK_SCALAR && nodeValueRank < 0)
+        return;
+    if (auto pd = dataTree.root().lock())
+        pd->setWriteType(nodeDataType, nodeValueRank == UA_VALUERANK_SCALAR);
+}
+
+bool
+ItemOpen62541::hasWriteType() const
+{
+    if (auto pd = dataTree.root().lock())
+        return pd->hasWriteType();
+    return false;
+}
+
 void
 ItemOpen62541::show (int level) const
 {
+    if (reader) {
+        std::cout << "item"
+                  << " pubsubreader=" << linkinfo.pubsubReader
+                  << " field=" << linkinfo.pubsubField
+                  << " record=" << recConnector->getRecordName()
+                  << " state=" << connectionStatusString(connState)
+                  << " status=" << UA_StatusCode_name(lastStatus)
+                  << " timestamp=" << linkOptionTimestampString(linkinfo.timestamp);
+        if (linkinfo.timestamp == LinkOptionTimestamp::data)
+            std::cout << "@" << linkinfo.timestampElement;
+        std::cout << std::endl;
+        if (level >= 1) {
+            if (auto re = dataTree.root().lock()) {
+                re->show(level, 1);
+            }
+            std::cout.flush();
+        }
+        return;
+    }
+
     std::cout << "item"
               << " ns=";
     if (nodeid.namespaceIndex != linkinfo.namespaceIndex)
@@ -114,7 +239,30 @@ ItemOpen62541::show (int level) const
         std::cout << nodeid;
         else std::cout << "-";
     std::cout << "(" << (linkinfo.registerNode ? "y" : "n") << ")"
-              << std::endl;
+              << " meta=" << (linkinfo.meta ? "y" : "n")
+              << " dedup=" << (linkinfo.dedup ? "y" : "n");
+    if (linkinfo.dedup)
+        std::cout << "(max " << linkinfo.dedupMax << "s; suppressed " << suppressedWrites << ")";
+    if (linkinfo.writeGroup.length())
+        std::cout << " group=" << linkinfo.writeGroup << (linkinfo.groupTrigger ? "(trigger)" : "");
+    if (linkinfo.snapshotGroup.length())
+        std::cout << " snapshot=" << linkinfo.snapshotGroup;
+    if (linkinfo.itemProcessing)
+        std::cout << " itemproc=y";
+    if (nodeTypeKnown) {
+        std::cout << " nodetype=" << (nodeDataType ? nodeDataType->typeName : "?");
+        if (nodeArrayDimensions.size()) {
+            for (auto dim : nodeArrayDimensions)
+                std::cout << "[" << dim << "]";
+        } else if (nodeValueRank != UA_VALUERANK_SCALAR) {
+            std::cout << "(rank " << nodeValueRank << ")";
+        }
+    }
+    epicsUInt32 serverOverflows, clientDrops;
+    getOverflowCounts(&serverOverflows, &clientDrops);
+    if (serverOverflows || clientDrops)
+        std::cout << " overflows=" << serverOverflows << "(server)/" << clientDrops << "(client)";
+    std::cout << std::endl;
 
     if (level >= 1) {
         if (auto re = dataTree.root().lock()) {
@@ -129,15 +277,52 @@ int ItemOpen62541::debug() const
     return recConnector->debug();
 }
 
-void
+bool
 ItemOpen62541::copyAndClearOutgoingData(UA_WriteValue &wvalue)
 {
+    bool send = true;
     Guard G(dataTreeWriteLock);
     if (auto pd = dataTree.root().lock()) {
-        UA_Variant_copy(&pd->getOutgoingData(), &wvalue.value.value);
+        const UA_Variant &data = pd->getOutgoingData();
+        if (linkinfo.dedup && pd->isUnchanged(data, linkinfo.dedupMax)) {
+            send = false;
+            suppressedWrites++;
+            if (debug() >= 5)
+                std::cout << "Item " << this << " write suppressed (value unchanged)" << std::endl;
+        } else {
+            if (linkinfo.dedup)
+                pd->markAsSent(data);
+            // Lend the outgoing buffer to the write request (no copy, handed back by recycleOutgoingData)
+            pd->moveOutgoingData(wvalue.value.value);
+        }
         pd->clearOutgoingData();
     }
     dataTreeDirty = false;
+    return send;
+}
+
+void
+ItemOpen62541::recycleOutgoingData(UA_Variant &data)
+{
+    Guard G(dataTreeWriteLock);
+    if (auto pd = dataTree.root().lock())
+        pd->recycleOutgoingData(data);
+    else
+        UA_Variant_clear(&data);
+}
+
+void
+ItemOpen62541::confirmWrite(const bool success)
+{
+    if (!linkinfo.dedup)
+        return;
+    Guard G(dataTreeWriteLock);
+    if (auto pd = dataTree.root().lock()) {
+        if (success)
+            pd->confirmSent();
+        else
+            pd->clearConfirmedData();
+    }
 }
 
 epicsTime
@@ -153,16 +338,20 @@ void
 ItemOpen62541::setIncomingData(const UA_DataValue &value, ProcessReason reason)
 {
     tsClient = epicsTime::getCurrent();
-    if (!UA_STATUS_IS_BAD(value.status)) {
-        tsSource = uaToEpicsTime(value.sourceTimestamp, value.sourcePicoseconds);
-        tsServer = uaToEpicsTime(value.serverTimestamp, value.serverPicoseconds);
-    } else {
-        tsSource = tsClient;
-        tsServer = tsClient;
-        tsData = tsClient;
+    {
+        Guard G(statisticsLock);
+        if (!UA_STATUS_IS_BAD(value.status)) {
+            tsSource = uaToEpicsTime(value.sourceTimestamp, value.sourcePicoseconds);
+            tsServer = uaToEpicsTime(value.serverTimestamp, value.serverPicoseconds);
+        } else {
+            tsSource = tsClient;
+            tsServer = tsClient;
+            tsData = tsClient;
+        }
     }
     setReason(reason);
-    if (getLastStatus() == UA_STATUSCODE_BADSERVERNOTCONNECTED && value.status == UA_STATUSCODE_BADNODEIDUNKNOWN)
+    if (session && getLastStatus() == UA_STATUSCODE_BADSERVERNOTCONNECTED && value.status == UA_STATUSCODE_BADNODEIDUNKNOWN
+            && reportError(ErrorClass::nodeIdUnknown, session, "OPC UA session " + session->getName()))
         errlogPrintf("OPC UA session %s: item ns=%d;%s%.*d%s : BadNodeIdUnknown\n",
                      session->getName().c_str(),
                      linkinfo.namespaceIndex,
@@ -173,11 +362,26 @@ ItemOpen62541::setIncomingData(const UA_DataValue &value, ProcessReason reason)
 
     setLastStatus(value.status);
 
+    // The server's monitored item queue overflowed: values were lost before this one
+    if ((value.status & (UA_STATUSCODE_INFOTYPE_DATAVALUE | UA_STATUSCODE_INFOBITS_OVERFLOW))
+            == (UA_STATUSCODE_INFOTYPE_DATAVALUE | UA_STATUSCODE_INFOBITS_OVERFLOW))
+        overflows++;
+
+    if (reason == ProcessReason::incomingData)
+        updateRate.count(tsClient);
+
     if (auto pd = dataTree.root().lock()) {
         const std::string *timefrom = nullptr;
         if (linkinfo.timestamp == LinkOptionTimestamp::data && linkinfo.timestampElement.length())
             timefrom = &linkinfo.timestampElement;
         pd->setIncomingData(value.value, reason, timefrom);
+        if (linkinfo.dedup) {
+            Guard G(dataTreeWriteLock);
+            if (value.hasValue && !UA_STATUS_IS_BAD(value.status))
+                pd->setConfirmedData(value.value);
+            else
+                pd->clearConfirmedData();
+        }
     }
 
     if (linkinfo.isItemRecord) {
@@ -192,12 +396,53 @@ ItemOpen62541::setIncomingData(const UA_DataValue &value, ProcessReason reason)
     }
 }
 
+void
+ItemOpen62541::getOverflowCounts (epicsUInt32 *serverOverflows, epicsUInt32 *clientDrops) const
+{
+    *serverOverflows = overflows;
+    *clientDrops = 0;
+    if (auto pd = dataTree.root().lock())
+        *clientDrops = static_cast<epicsUInt32>(pd->discardedUpdates());
+}
+
+void
+ItemOpen62541::getStatistics (ItemStatistics &stats) const
+{
+    stats.updateRate = updateRate.rate(epicsTime::getCurrent());
+    {
+        Guard G(statisticsLock);
+        stats.sourceTime = tsSource;
+    }
+    stats.queueHighWater = 0;
+    if (auto pd = dataTree.root().lock())
+        stats.queueHighWater = static_cast<epicsUInt32>(pd->queueHighWaterMark());
+    stats.samplingInterval = revisedSamplingInterval;
+    stats.queueSize = revisedQueueSize;
+    stats.readRoundTrip = readRoundTrip;
+    stats.writeRoundTrip = writeRoundTrip;
+}
+
+void
+ItemOpen62541::resetStatistics ()
+{
+    if (auto pd = dataTree.root().lock())
+        pd->resetQueueHighWaterMark();
+}
+
+void
+ItemOpen62541::requestBurstProcessing()
+{
+    if (auto pd = dataTree.root().lock())
+        pd->requestBurstProcessing();
+}
+
 void
 ItemOpen62541::setIncomingEvent(const ProcessReason reason)
 {
     tsClient = epicsTime::getCurrent();
     setReason(reason);
     if (!(reason == ProcessReason::incomingData || reason == ProcessReason::readComplete)) {
+        Guard G(statisticsLock);
         tsSource = tsClient;
         tsServer = tsClient;
         tsData = tsClient;
@@ -206,6 +451,10 @@ ItemOpen62541::setIncomingEvent(const ProcessReason reason)
     }
 
     if (auto pd = dataTree.root().lock()) {
+        if (linkinfo.dedup && reason == ProcessReason::connectionLoss) {
+            Guard G(dataTreeWriteLock);
+            pd->clearConfirmedData();
+        }
         pd->setIncomingEvent(reason);
     }
 
@@ -14,6 +14,8 @@
 #define DEVOPCUA_ITEMOPEN62541_H
 
 #include <memory>
+#include <atomic>
+#include <vector>
 
 #include <open62541/client.h>
 
@@ -23,11 +25,13 @@
 #include "opcuaItemRecord.h"
 #include "devOpcua.h"
 #include "ElementTree.h"
+#include "UpdateRate.h"
 #include "SessionOpen62541.h"
 
 namespace DevOpcua {
 
 class SubscriptionOpen62541;
+class PubSubReaderOpen62541;
 class DataElementOpen62541;
 struct linkInfo;
 
@@ -57,12 +61,12 @@ public:
     /**
      * @brief Request beginRead service. See DevOpcua::Item::requestRead
      */
-    virtual void requestRead() override { session->requestRead(*this); }
+    virtual void requestRead() override;
 
     /**
      * @brief Request beginWrite service. See DevOpcua::Item::requestWrite
      */
-    virtual void requestWrite() override { session->requestWrite(*this); }
+    virtual void requestWrite() override;
 
     /**
      * @brief Schedule a write request if item data is "dirty".
@@ -78,7 +82,32 @@ public:
     /**
      * @brief Return monitored status. See DevOpcua::Item::isMonitored
      */
-    virtual bool isMonitored() const override { return !!subscription; }
+    virtual bool isMonitored() const override { return !!subscription || !!reader; }
+
+    /**
+     * @brief Get counters of lost updates. See DevOpcua::Item::getOverflowCounts
+     */
+    virtual void getOverflowCounts(epicsUInt32 *serverOverflows, epicsUInt32 *clientDrops) const override;
+
+    /**
+     * @brief Get item statistics. See DevOpcua::Item::getStatistics
+     */
+    virtual void getStatistics(ItemStatistics &stats) const override;
+
+    /**
+     * @brief Reset item statistics maxima. See DevOpcua::Item::resetStatistics
+     */
+    virtual void resetStatistics() override;
+
+    /**
+     * @brief Attach to session and subscription. See DevOpcua::Item::attach
+     */
+    virtual void attach() override;
+
+    /**
+     * @brief Detach from session and subscription. See DevOpcua::Item::detach
+     */
+    virtual bool detach() override;
 
     /**
      * @brief Return OPC UA status code and text.
@@ -100,6 +129,19 @@ public:
      */
     virtual void setState(const ConnectionStatus state) override { connState = state; }
 
+    /**
+     * @brief Getter for the encoded size of the last read result.
+     * @return size [bytes], 0 if unknown
+     */
+    size_t getReadSize() const { return readSize; }
+
+    /**
+     * @brief Setter for the encoded size of the last read result.
+     * Used by the session to keep read requests within the message size limit.
+     * @param size  size [bytes]
+     */
+    void setReadSize(const size_t size) { readSize = size; }
+
     /**
      * @brief Return registered status.
      */
@@ -156,9 +198,35 @@ public:
      * Called from the OPC UA client worker thread when data is being
      * assembled in OPC UA session for sending.
      *
+     * If write suppression is configured (dedup=y) and the outgoing value
+     * is unchanged, nothing is copied and the write should be skipped.
+     *
      * @param[out] wvalue reference to WriteValue (target of copy)
+     * @return  false if the write is suppressed
+     */
+    bool copyAndClearOutgoingData(UA_WriteValue &wvalue);
+
+    /**
+     * @brief Hand the value buffer of an encoded write request back for reuse.
+     *
+     * Called after the write request has been encoded (sent or failed).
+     *
+     * @param data  value of the WriteValue from copyAndClearOutgoingData (cleared)
      */
-    void copyAndClearOutgoingData(UA_WriteValue &wvalue);
+    void recycleOutgoingData(UA_Variant &data);
+
+    /**
+     * @brief Update the write suppression data with the result of a write.
+     *
+     * @param success  true if the server confirmed the write
+     */
+    void confirmWrite(const bool success);
+
+    /**
+     * @brief Getter for the number of suppressed writes.
+     * @return number of writes suppressed because of unchanged values
+     */
+    unsigned long getSuppressedWrites() const { return suppressedWrites; }
 
     /**
      * @brief Push an incoming data value down the root element.
@@ -181,12 +249,75 @@ public:
      */
     void setIncomingEvent(ProcessReason reason);
 
+    /**
+     * @brief Request processing of burst records at the end of a notification batch.
+     *
+     * Called (in order with the incoming data) after the last data change
+     * of a publish response for this item was delivered.
+     */
+    void requestBurstProcessing();
+
+    /**
+     * @brief Return true if any element record uses the burst option.
+     */
+    bool hasBurstElements() const { return burstElements; }
+
      /**
      * @brief Mark the item as dirty and set up itemRecord processing.
      */
     void markAsDirty();
 
-   /**
+    /**
+     * @brief Getter for the subscription of a monitored item.
+     * @return pointer to subscription, nullptr if not monitored
+     */
+    SubscriptionOpen62541 *getSubscription() const { return subscription; }
+
+    /**
+     * @brief Getter for the server-assigned monitored item id.
+     * @return monitored item id, 0 if no monitored item exists
+     */
+    UA_UInt32 getMonitoredItemId() const { return monitoredItemId; }
+
+    /**
+     * @brief Setter for the server-assigned monitored item id.
+     * @param id  monitored item id (0 = none)
+     */
+    void setMonitoredItemId(const UA_UInt32 id) { monitoredItemId = id; }
+
+    /**
+     * @brief Setter for the node type (DataType, ValueRank and ArrayDimensions attributes).
+     *
+     * The node type is kept across reconnects. It is used to encode writes
+     * before a value has been read from the node.
+     *
+     * @param type  data type used for writes, nullptr if not resolvable
+     * @param valueRank  ValueRank attribute of the node
+     * @param arrayDimensions  ArrayDimensions attribute of the node
+     */
+    void setNodeType(const UA_DataType *type,
+                     const UA_Int32 valueRank,
+                     const std::vector<UA_UInt32> &arrayDimensions);
+
+    /**
+     * @brief Return true if the node type has been read from the server.
+     */
+    bool hasNodeType() const { return nodeTypeKnown; }
+
+    /**
+     * @brief Set up the write encoding of the root element from the node type.
+     *
+     * Does nothing if the node type is unknown, or if its value rank does not
+     * tell scalars from arrays. A value received from the server takes precedence.
+     */
+    void applyNodeType();
+
+    /**
+     * @brief Return true if writes can be encoded (a value or the node type is known).
+     */
+    bool hasWriteType() const;
+
+    /**
      * @brief Setter for the revised sampling interval.
      * @param status  status code received by the client library
      */
@@ -200,6 +331,14 @@ public:
     void setRevisedQueueSize(const UA_UInt32 &qsize)
     { revisedQueueSize = qsize; }
 
+    /**
+     * @brief Setter for the round trip time of a read or write request.
+     * @param write  true for a write request
+     * @param ms  round trip time [ms]
+     */
+    void setRoundTrip(const bool write, const double ms)
+    { (write ? writeRoundTrip : readRoundTrip) = ms; }
+
     /**
      * @brief Convert OPC UA time stamp to EPICS time stamp.
      * @param dt time stamp in UaDateTime format
@@ -217,20 +356,34 @@ public:
 private:
     SubscriptionOpen62541 *subscription;   /**< raw pointer to subscription (if monitored) */
     SessionOpen62541 *session;             /**< raw pointer to session */
+    PubSubReaderOpen62541 *reader;         /**< raw pointer to PubSub reader (instead of session) */
+    size_t readSize;                       /**< encoded size of the last read result [bytes] */
     UA_NodeId nodeid;                      /**< node id of this item */
     bool registered;                       /**< flag for registration status */
-    UA_Double revisedSamplingInterval;     /**< server-revised sampling interval */
-    UA_UInt32 revisedQueueSize;            /**< server-revised queue size */
+    std::atomic<UA_Double> revisedSamplingInterval; /**< server-revised sampling interval */
+    std::atomic<UA_UInt32> revisedQueueSize; /**< server-revised queue size */
+    UA_UInt32 monitoredItemId;             /**< server-assigned monitored item id */
+    bool nodeTypeKnown;                    /**< node type attributes have been read */
+    const UA_DataType *nodeDataType;       /**< data type for writes (DataType attribute) */
+    UA_Int32 nodeValueRank;                /**< ValueRank attribute */
+    std::vector<UA_UInt32> nodeArrayDimensions; /**< ArrayDimensions attribute */
     ElementTree<DataElementOpen62541, ItemOpen62541> dataTree; /**< data element tree */
     epicsMutex dataTreeWriteLock;          /**< lock for dirty flag */
     bool dataTreeDirty;                    /**< true if any element has been modified */
+    bool burstElements;                    /**< element records with burst option (set when linking) */
+    std::atomic<unsigned long> suppressedWrites; /**< number of writes suppressed (dedup=y) */
+    std::atomic<epicsUInt32> overflows;    /**< values received with the Overflow InfoBit */
+    UpdateRate updateRate;                 /**< incoming data updates per second */
+    std::atomic<double> readRoundTrip;     /**< round trip time of the last read [ms] */
+    std::atomic<double> writeRoundTrip;    /**< round trip time of the last write [ms] */
     UA_StatusCode lastStatus;              /**< status code of most recent service */
     ProcessReason lastReason;              /**< most recent processing reason */
     ConnectionStatus connState;            /**< Connection state of the item */
     epicsTime tsClient;                    /**< client (local) time stamp */
     epicsTime tsServer;                    /**< server time stamp */
-    epicsTime tsSource;                    /**< source time stamp */
+    epicsTime tsSource;                    /**< source time stamp (written under statisticsLock) */
     epicsTime tsData;                      /**< data time stamp */
+    mutable epicsMutex statisticsLock;     /**< guards tsSource for getStatistics() */
 };
 
 inline std::ostream& operator << (std::ostream& os, const ItemOpen62541& item)
@@ -0,0 +1,226 @@
+/*************************************************************************\
+* Copyright (c) 2026 ITER Organization.
+* This module is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Author: Dirk Zimoch <dirk.zimoch@psi.ch>
+ */
+
+#include <functional>
+#include <set>
+
+#include <epicsExit.h>
+
+#include "NotificationPool.h"
+#include "ItemOpen62541.h"
+
+namespace DevOpcua {
+
+// All pools, for stopping their workers at IOC exit
+static epicsThreadOnceId notificationPoolAtExitOnce = EPICS_THREAD_ONCE_INIT;
+static epicsMutex poolsLock;
+static std::set<NotificationPool *> pools;
+
+static void
+notificationPoolAtExitRegister (void *)
+{
+    epicsAtExit(NotificationPool::atExit, nullptr);
+}
+
+NotificationPool::Worker::Worker (const std::string &name)
+    : workToDo(epicsEventEmpty)
+    , shutdown(false)
+    , delivered(0)
+    , thread(*this, name.c_str(),
+             epicsThreadGetStackSize(epicsThreadStackSmall),
+             epicsThreadPriorityMedium)
+{
+    thread.start();
+}
+
+NotificationPool::Worker::~Worker ()
+{
+    stop();
+    for (auto &n : queue) {
+        UA_DataValue_clear(&n.value);
+        n.item->releaseReference();
+    }
+}
+
+void
+NotificationPool::Worker::stop ()
+{
+    {
+        Guard G(lock);
+        shutdown = true;
+    }
+    workToDo.signal();
+    thread.exitWait();
+}
+
+void
+NotificationPool::Worker::push (Notification &n)
+{
+    bool wasEmpty;
+    n.item->addReference();
+    {
+        Guard G(lock);
+        wasEmpty = queue.empty();
+        queue.push_back(n);
+    }
+    if (wasEmpty)
+        workToDo.signal();
+}
+
+// Worker thread body: deliver all queued notifications in order
+void
+NotificationPool::Worker::run ()
+{
+    std::vector<Notification> batch;
+    while (true) {
+        workToDo.wait();
+        {
+            Guard G(lock);
+            if (shutdown)
+                break;
+            batch.swap(queue);
+        }
+        for (auto &n : batch) {
+            switch (n.kind) {
+            case Notification::incomingData:
+                n.item->setIncomingData(n.value, n.reason);
+                UA_DataValue_clear(&n.value);
+                break;
+            case Notification::incomingEvent:
+                n.item->setIncomingEvent(n.reason);
+                break;
+            case Notification::stateChange:
+                n.item->setState(n.state);
+                break;
+            case Notification::burstEnd:
+                n.item->requestBurstProcessing();
+                break;
+            }
+            n.item->releaseReference();
+        }
+        {
+            Guard G(lock);
+            delivered += batch.size();
+        }
+        batch.clear();
+    }
+}
+
+NotificationPool::NotificationPool (const std::string &name, const unsigned int threads)
+{
+    for (unsigned int i = 0; i < threads; i++)
+        workers.emplace_back(new Worker("OPCnt-" + name + "-" + std::to_string(i)));
+    epicsThreadOnce(&notificationPoolAtExitOnce, notificationPoolAtExitRegister, nullptr);
+    Guard G(poolsLock);
+    pools.insert(this);
+}
+
+NotificationPool::~NotificationPool ()
+{
+    {
+        Guard G(poolsLock);
+        pools.erase(this);
+    }
+    stop();
+}
+
+void
+NotificationPool::stop ()
+{
+    for (auto &w : workers)
+        w->stop();
+}
+
+void
+NotificationPool::atExit (void *)
+{
+    Guard G(poolsLock);
+    for (auto it : pools)
+        it->stop();
+}
+
+NotificationPool::Worker &
+NotificationPool::shard (const ItemOpen62541 *item)
+{
+    return *workers[std::hash<const ItemOpen62541 *>()(item) % workers.size()];
+}
+
+void
+NotificationPool::pushData (ItemOpen62541 *item, UA_DataValue &value, const ProcessReason reason)
+{
+    Notification n;
+    n.item = item;
+    n.kind = Notification::incomingData;
+    n.reason = reason;
+    n.state = ConnectionStatus::down;
+    n.value = value; // shallow copy, ownership moves to the pool
+    UA_DataValue_init(&value);
+    shard(item).push(n);
+}
+
+void
+NotificationPool::pushEvent (ItemOpen62541 *item, const ProcessReason reason)
+{
+    Notification n;
+    n.item = item;
+    n.kind = Notification::incomingEvent;
+    n.reason = reason;
+    n.state = ConnectionStatus::down;
+    UA_DataValue_init(&n.value);
+    shard(item).push(n);
+}
+
+void
+NotificationPool::pushState (ItemOpen62541 *item, const ConnectionStatus state)
+{
+    Notification n;
+    n.item = item;
+    n.kind = Notification::stateChange;
+    n.reason = ProcessReason::none;
+    n.state = state;
+    UA_DataValue_init(&n.value);
+    shard(item).push(n);
+}
+
+void
+NotificationPool::pushBurstEnd (ItemOpen62541 *item)
+{
+    Notification n;
+    n.item = item;
+    n.kind = Notification::burstEnd;
+    n.reason = ProcessReason::none;
+    n.state = ConnectionStatus::down;
+    UA_DataValue_init(&n.value);
+    shard(item).push(n);
+}
+
+size_t
+NotificationPool::pending () const
+{
+    size_t n = 0;
+    for (auto &w : workers) {
+        Guard G(w->lock);
+        n += w->queue.size();
+    }
+    return n;
+}
+
+unsigned long
+NotificationPool::delivered () const
+{
+    unsigned long n = 0;
+    for (auto &w : workers) {
+        Guard G(w->lock);
+        n += w->delivered;
+    }
+    return n;
+}
+
+} // namespace DevOpcua
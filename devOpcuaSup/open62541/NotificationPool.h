@@ -0,0 +1,166 @@
+/*************************************************************************\
+* Copyright (c) 2026 ITER Organization.
+* This module is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Author: Dirk Zimoch <dirk.zimoch@psi.ch>
+ */
+
+#ifndef DEVOPCUA_NOTIFICATIONPOOL_H
+#define DEVOPCUA_NOTIFICATIONPOOL_H
+
+#include <memory>
+#include <vector>
+#include <string>
+
+#include <open62541/types.h>
+#include <open62541/types_generated.h>
+
+#include <epicsMutex.h>
+#include <epicsEvent.h>
+#include <epicsThread.h>
+
+#include "devOpcua.h"
+#include "Item.h"
+
+namespace DevOpcua {
+
+class ItemOpen62541;
+
+/**
+ * @brief A small pool of worker threads that delivers incoming data and events to items.
+ *
+ * Used by a session (option 'notify-threads') to take the per-item work
+ * (time stamp conversion, copying values into the element tree, pushing
+ * updates, requesting record processing) off the client thread, so that
+ * the client thread can return to network I/O immediately.
+ *
+ * Notifications are sharded by item: all notifications for an item go
+ * through the same worker in the order they were pushed, i.e. the per-item
+ * ordering is preserved and every item still has a single producer.
+ * Connection state changes of an item go through the same queue, so they
+ * are applied after the data that was received before them.
+ *
+ * The workers of all pools are stopped at IOC exit.
+ *
+ * Data values are moved into the pool (the source is left empty).
+ * A queued notification holds a reference to its item (see Item::addReference).
+ */
+class NotificationPool
+{
+    // Cannot copy a pool
+    NotificationPool(const NotificationPool &);
+    NotificationPool &operator=(const NotificationPool &);
+
+public:
+    /**
+     * @brief Constructor for NotificationPool. Starts the worker threads.
+     *
+     * @param name  name (used for the thread names)
+     * @param threads  number of worker threads
+     */
+    NotificationPool(const std::string &name, const unsigned int threads);
+
+    /**
+     * @brief Destructor. Stops the worker threads, dropping pending notifications.
+     */
+    ~NotificationPool();
+
+    /**
+     * @brief Stop the worker threads and wait for them to exit.
+     *
+     * Pending notifications are dropped, later ones are not delivered.
+     */
+    void stop();
+
+    /**
+     * @brief Queue incoming data for an item.
+     *
+     * The value is moved into the pool and the source is cleared.
+     *
+     * @param item  item to deliver the data to
+     * @param value  incoming data value (moved)
+     * @param reason  process reason of the update
+     */
+    void pushData(ItemOpen62541 *item, UA_DataValue &value, const ProcessReason reason);
+
+    /**
+     * @brief Queue an event (no data) for an item.
+     *
+     * @param item  item to deliver the event to
+     * @param reason  process reason of the event
+     */
+    void pushEvent(ItemOpen62541 *item, const ProcessReason reason);
+
+    /**
+     * @brief Queue a connection state change for an item.
+     *
+     * @param item  item to set the state of
+     * @param state  new connection state
+     */
+    void pushState(ItemOpen62541 *item, const ConnectionStatus state);
+
+    /**
+     * @brief Queue the end of a notification batch for an item (burst records).
+     *
+     * @param item  item to request burst processing for
+     */
+    void pushBurstEnd(ItemOpen62541 *item);
+
+    /**
+     * @brief Number of worker threads.
+     */
+    size_t size() const { return workers.size(); }
+
+    /**
+     * @brief Number of notifications waiting in all workers.
+     */
+    size_t pending() const;
+
+    /**
+     * @brief Total number of notifications delivered by all workers.
+     */
+    unsigned long delivered() const;
+
+    /**
+     * @brief EPICS IOC atExit function: stops the workers of all pools.
+     */
+    static void atExit(void *);
+
+private:
+    struct Notification {
+        enum Kind { incomingData, incomingEvent, stateChange, burstEnd };
+        ItemOpen62541 *item;
+        Kind kind;
+        ProcessReason reason;
+        ConnectionStatus state;
+        UA_DataValue value;
+    };
+
+    class Worker : public epicsThreadRunable
+    {
+    public:
+        Worker(const std::string &name);
+        ~Worker();
+        void push(Notification &n);
+        void stop();
+        virtual void run() override;
+
+        epicsMutex lock;                    /**< guards queue, shutdown and delivered */
+        std::vector<Notification> queue;    /**< notifications waiting for delivery */
+        epicsEvent workToDo;
+        bool shutdown;
+        unsigned long delivered;            /**< number of delivered notifications */
+        epicsThread thread;
+    };
+
+    Worker &shard(const ItemOpen62541 *item);
+
+    std::vector<std::unique_ptr<Worker>> workers;
+};
+
+} // namespace DevOpcua
+
+#endif // DEVOPCUA_NOTIFICATIONPOOL_H
@@ -0,0 +1,340 @@
+/*************************************************************************\
+* Copyright (c) 2026 ITER Organization.
+* This module is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Author: Dirk Zimoch <dirk.zimoch@psi.ch>
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+
+#include <sys/stat.h>
+#if defined(_WIN32) && !defined(__MINGW32__)
+#include <io.h>
+#else
+#include <dirent.h>
+#endif
+
+#include <errlog.h>
+
+#include <open62541/plugin/pki_default.h>
+
+#include "devOpcua.h"
+#include "PkiCache.h"
+
+namespace DevOpcua {
+
+#ifdef HAS_SECURITY
+
+PkiCache &
+PkiCache::instance ()
+{
+    static PkiCache cache;
+    return cache;
+}
+
+PkiCache::PkiCache ()
+    : valid(false)
+    , trusted(0)
+    , issuers(0)
+    , revocations(0)
+    , loads(0)
+    , checks(0)
+    , lastLoadTime(0.0)
+    , verifications(0)
+    , failedVerifications(0)
+    , verifyTimeTotal(0.0)
+    , verifyTimeMax(0.0)
+{
+    memset(&shared, 0, sizeof(shared));
+    clientCert.stamp = {std::string(), 0, -1};
+    clientCert.content = UA_BYTESTRING_NULL;
+    clientKey.stamp = {std::string(), 0, -1};
+    clientKey.content = UA_BYTESTRING_NULL;
+}
+
+PkiCache::~PkiCache ()
+{
+    if (valid && shared.clear)
+        shared.clear(&shared);
+    UA_ByteString_clear(&clientCert.content);
+    UA_ByteString_clear(&clientKey.content);
+}
+
+std::vector<PkiCache::FileStamp>
+PkiCache::scanDirectory (const std::string &dir)
+{
+    std::vector<std::string> names;
+    std::vector<FileStamp> files;
+    if (dir.empty())
+        return files;
+
+#if defined(_WIN32) && !defined(__MINGW32__)
+    struct _finddata_t entry;
+    intptr_t handle = _findfirst((dir + pathsep + '*').c_str(), &entry);
+    if (handle != -1) {
+        do {
+            if (entry.name[0] != '.' && !(entry.attrib & _A_SUBDIR))
+                names.emplace_back(entry.name);
+        } while (_findnext(handle, &entry) == 0);
+        _findclose(handle);
+    }
+#else
+    DIR *d = opendir(dir.c_str());
+    if (d) {
+        struct dirent *entry;
+        while ((entry = readdir(d)))
+            if (entry->d_name[0] != '.')
+                names.emplace_back(entry->d_name);
+        closedir(d);
+    }
+#endif
+
+    std::sort(names.begin(), names.end());
+    for (const auto &name : names) {
+        std::string path = dir;
+        if (path.back() != pathsep)
+            path += pathsep;
+        path += name;
+        struct stat st;
+        if (stat(path.c_str(), &st) == 0 && (st.st_mode & S_IFMT) == S_IFREG)
+            files.push_back({path, st.st_mtime, st.st_size});
+    }
+    return files;
+}
+
+// PEM input has to be null terminated for the mbedTLS parser
+bool
+PkiCache::readFile (const std::string &path, UA_ByteString &content, const bool terminatePem)
+{
+    UA_ByteString_init(&content);
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file)
+        return false;
+    std::streamoff length = file.tellg();
+    if (length <= 0)
+        return false;
+    file.seekg(0);
+    bool pem = false;
+    if (terminatePem) {
+        char head[10] = {};
+        file.read(head, sizeof(head));
+        pem = (file.gcount() == sizeof(head) && strncmp(head, "-----BEGIN", sizeof(head)) == 0);
+        file.clear();
+        file.seekg(0);
+    }
+    if (UA_ByteString_allocBuffer(&content, static_cast<size_t>(length) + (pem ? 1 : 0)))
+        return false;
+    file.read(reinterpret_cast<char *>(content.data), length);
+    if (file.gcount() != length) {
+        UA_ByteString_clear(&content);
+        return false;
+    }
+    if (pem)
+        content.data[length] = '\0';
+    return true;
+}
+
+bool
+PkiCache::reload (const UA_CertificateVerification *cv,
+                  const std::vector<std::string> &newDirs,
+                  Snapshot &newStamps,
+                  const std::string &sessionName,
+                  const int debug)
+{
+    // Directory index -> list: trusted certs, revocation lists, issuer certs, revocation lists
+    static const int listOf[4] = {0, 2, 1, 2};
+    std::vector<UA_ByteString> lists[3];
+
+    epicsTime start(epicsTime::getCurrent());
+
+    for (size_t i = 0; i < newStamps.size(); i++) {
+        for (const auto &f : newStamps[i]) {
+            UA_ByteString content;
+            if (readFile(f.path, content, true))
+                lists[listOf[i]].push_back(content);
+            else
+                errlogPrintf("OPC UA session %s: cannot read PKI file %s\n",
+                             sessionName.c_str(), f.path.c_str());
+        }
+    }
+
+    // Use the configuration's verification as template (version specific members)
+    UA_CertificateVerification fresh = *cv;
+    fresh.context = nullptr;
+    UA_StatusCode status = UA_CertificateVerification_Trustlist(&fresh,
+        lists[0].data(), lists[0].size(),
+        lists[1].data(), lists[1].size(),
+        lists[2].data(), lists[2].size());
+
+    for (auto &list : lists)
+        for (auto &content : list)
+            UA_ByteString_clear(&content);
+
+    if (status != UA_STATUSCODE_GOOD) {
+        errlogPrintf("OPC UA session %s: setting up PKI context failed with status %s\n",
+                     sessionName.c_str(), UA_StatusCode_name(status));
+        return false;
+    }
+
+    if (valid && shared.clear)
+        shared.clear(&shared);
+    shared = fresh;
+    valid = true;
+    dirs = newDirs;
+    stamps.swap(newStamps);
+    trusted = lists[0].size();
+    issuers = lists[1].size();
+    revocations = lists[2].size();
+
+    lastLoad = epicsTime::getCurrent();
+    lastLoadTime = lastLoad - start;
+    loads++;
+
+    if (debug)
+        std::cout << "Session " << sessionName
+                  << ": (connect) loaded PKI trust list (" << trusted << " trusted, "
+                  << issuers << " issuers, " << revocations << " revocation lists) in "
+                  << lastLoadTime * 1e3 << " ms" << std::endl;
+    return true;
+}
+
+bool
+PkiCache::install (UA_CertificateVerification *cv,
+                   const std::string &trustListDir,
+                   const std::string &revocationListDir,
+                   const std::string &issuersDir,
+                   const std::string &issuersRevocationListDir,
+                   const std::string &sessionName,
+                   const int debug)
+{
+    std::vector<std::string> newDirs = {trustListDir, revocationListDir,
+                                        issuersDir, issuersRevocationListDir};
+    Snapshot current;
+    for (const auto &dir : newDirs)
+        current.push_back(scanDirectory(dir));
+
+    Guard G(lock);
+    checks++;
+    if (!valid || newDirs != dirs || current != stamps) {
+        if (!reload(cv, newDirs, current, sessionName, debug) && !valid)
+            return false;
+    } else if (debug) {
+        std::cout << "Session " << sessionName
+                  << ": (connect) using cached PKI trust list" << std::endl;
+    }
+
+    // Replace the verification of the configuration by one delegating to the shared one
+    UA_CertificateVerification tmpl = *cv;
+    if (cv->clear)
+        cv->clear(cv);
+    *cv = tmpl;
+    cv->context = this;
+    cv->verifyCertificate = verifyCertificate;
+    cv->verifyApplicationURI = verifyApplicationURI;
+    cv->clear = clear;
+    return true;
+}
+
+bool
+PkiCache::refreshFile (CachedFile &cached, const std::string &path)
+{
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0) {
+        UA_ByteString_clear(&cached.content);
+        cached.stamp = {path, 0, -1};
+        return false;
+    }
+    FileStamp stamp = {path, st.st_mtime, st.st_size};
+    if (stamp == cached.stamp && cached.content.length)
+        return true;
+    UA_ByteString_clear(&cached.content);
+    cached.stamp = stamp;
+    return readFile(path, cached.content, false);
+}
+
+void
+PkiCache::clientCredentials (const std::string &certFile,
+                             const std::string &keyFile,
+                             UA_ByteString &cert,
+                             UA_ByteString &key)
+{
+    Guard G(lock);
+    refreshFile(clientCert, certFile);
+    refreshFile(clientKey, keyFile);
+    UA_ByteString_copy(&clientCert.content, &cert);
+    UA_ByteString_copy(&clientKey.content, &key);
+}
+
+UA_StatusCode
+PkiCache::verifyCertificate (void *context, const UA_ByteString *certificate)
+{
+    PkiCache *pc = static_cast<PkiCache *>(context);
+    Guard G(pc->lock);
+    epicsTime start(epicsTime::getCurrent());
+    UA_StatusCode status = pc->shared.verifyCertificate(pc->shared.context, certificate);
+    double dt = epicsTime::getCurrent() - start;
+    pc->verifications++;
+    if (status != UA_STATUSCODE_GOOD)
+        pc->failedVerifications++;
+    pc->verifyTimeTotal += dt;
+    if (dt > pc->verifyTimeMax)
+        pc->verifyTimeMax = dt;
+    return status;
+}
+
+UA_StatusCode
+PkiCache::verifyApplicationURI (void *context,
+                                const UA_ByteString *certificate,
+                                const UA_String *applicationURI)
+{
+    PkiCache *pc = static_cast<PkiCache *>(context);
+    Guard G(pc->lock);
+    if (!pc->shared.verifyApplicationURI)
+        return UA_STATUSCODE_GOOD;
+    return pc->shared.verifyApplicationURI(pc->shared.context, certificate, applicationURI);
+}
+
+// The shared context is owned by the cache
+void
+PkiCache::clear (UA_CertificateVerification *cv)
+{
+    cv->context = nullptr;
+}
+
+void
+PkiCache::show (std::ostream &os)
+{
+    Guard G(lock);
+    std::ios::fmtflags flags(os.flags());
+    os << "PKI cache: ";
+    if (valid)
+        os << trusted << " trusted certificates, " << issuers << " issuer certificates, "
+           << revocations << " revocation lists";
+    else
+        os << "no trust list loaded";
+    os << "\n  Loaded " << loads << " times in " << checks << " checks";
+    if (loads) {
+        char buf[40];
+        lastLoad.strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S");
+        os << ", last load at " << buf << " took "
+           << std::fixed << std::setprecision(3) << lastLoadTime * 1e3 << " ms";
+    }
+    os << "\n  Server certificate verifications: " << verifications
+       << " (" << failedVerifications << " failed)";
+    if (verifications)
+        os << ", avg " << std::fixed << std::setprecision(3)
+           << verifyTimeTotal / verifications * 1e3 << " ms, max "
+           << verifyTimeMax * 1e3 << " ms";
+    os << std::endl;
+    os.flags(flags);
+}
+
+#endif // #ifdef HAS_SECURITY
+
+} // namespace DevOpcua
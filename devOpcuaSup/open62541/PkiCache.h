@@ -0,0 +1,157 @@
+/*************************************************************************\
+* Copyright (c) 2026 ITER Organization.
+* This module is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Author: Dirk Zimoch <dirk.zimoch@psi.ch>
+ */
+
+#ifndef DEVOPCUA_PKICACHE_H
+#define DEVOPCUA_PKICACHE_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <ctime>
+
+#include <sys/types.h>
+
+#include <open62541/client.h>
+
+#include <epicsMutex.h>
+#include <epicsTime.h>
+
+namespace DevOpcua {
+
+/**
+ * @brief In-memory copy of the PKI material, shared by all sessions.
+ *
+ * Reading and parsing the PKI directories (trusted/issuer certificates,
+ * revocation lists) and the client certificate/key on every connect
+ * dominates the reconnect time when many sessions share large CRLs.
+ *
+ * The cache reads the files once into memory and builds a single
+ * certificate verification context from them. Sessions install a delegating
+ * verification that uses the shared context (serialized by the cache lock).
+ *
+ * On every use, the cache compares the file list, sizes and modification
+ * times with the last snapshot (stat() only) and reloads if anything changed.
+ */
+class PkiCache
+{
+    // Cannot copy the cache
+    PkiCache(const PkiCache &);
+    PkiCache &operator=(const PkiCache &);
+
+public:
+    /**
+     * @brief Get the global cache instance.
+     */
+    static PkiCache &instance();
+
+    /**
+     * @brief Install the shared verification in a client configuration.
+     *
+     * Reloads the PKI directories if they changed since the last load.
+     * Replaces (and clears) the verification that is set in the configuration.
+     * If the trust list cannot be loaded, the configuration is not changed.
+     *
+     * @param cv  certificate verification of the client configuration
+     * @param trustListDir  trusted server certificates location
+     * @param revocationListDir  server certificate revocation lists location
+     * @param issuersDir  trusted issuer certificates location
+     * @param issuersRevocationListDir  issuer certificate revocation lists location
+     * @param sessionName  session name (for messages)
+     * @param debug  debug level
+     *
+     * @return true if the shared verification was installed
+     */
+    bool install(UA_CertificateVerification *cv,
+                 const std::string &trustListDir,
+                 const std::string &revocationListDir,
+                 const std::string &issuersDir,
+                 const std::string &issuersRevocationListDir,
+                 const std::string &sessionName,
+                 const int debug = 0);
+
+    /**
+     * @brief Get copies of the client certificate and private key.
+     *
+     * Rereads the files if they changed since the last read.
+     *
+     * @param certFile  client certificate file
+     * @param keyFile  client private key file
+     * @param[out] cert  certificate (empty if the file cannot be read)
+     * @param[out] key  private key (empty if the file cannot be read)
+     */
+    void clientCredentials(const std::string &certFile,
+                           const std::string &keyFile,
+                           UA_ByteString &cert,
+                           UA_ByteString &key);
+
+    /**
+     * @brief Print the contents, load and verification statistics.
+     */
+    void show(std::ostream &os);
+
+private:
+    PkiCache();
+    ~PkiCache();
+
+    struct FileStamp {
+        std::string path;
+        time_t mtime;
+        off_t size;
+        bool operator==(const FileStamp &other) const {
+            return mtime == other.mtime && size == other.size && path == other.path;
+        }
+    };
+
+    struct CachedFile {
+        FileStamp stamp;
+        UA_ByteString content;
+    };
+
+    typedef std::vector<std::vector<FileStamp>> Snapshot;
+
+    static std::vector<FileStamp> scanDirectory(const std::string &dir);
+    static bool readFile(const std::string &path, UA_ByteString &content, const bool terminatePem);
+    bool reload(const UA_CertificateVerification *cv,
+                const std::vector<std::string> &newDirs,
+                Snapshot &newStamps,
+                const std::string &sessionName,
+                const int debug);
+    bool refreshFile(CachedFile &cached, const std::string &path);
+
+    static UA_StatusCode verifyCertificate(void *context, const UA_ByteString *certificate);
+    static UA_StatusCode verifyApplicationURI(void *context,
+                                              const UA_ByteString *certificate,
+                                              const UA_String *applicationURI);
+    static void clear(UA_CertificateVerification *cv);
+
+    epicsMutex lock;
+    UA_CertificateVerification shared;    /**< verification built from the cached lists */
+    bool valid;                           /**< shared verification is set up */
+    std::vector<std::string> dirs;        /**< directories of the snapshot */
+    Snapshot stamps;                      /**< loaded PKI files (per directory) */
+    size_t trusted, issuers, revocations; /**< number of loaded files */
+
+    CachedFile clientCert;
+    CachedFile clientKey;
+
+    // Statistics
+    unsigned long loads;
+    unsigned long checks;
+    double lastLoadTime;                  /**< duration of the last load [s] */
+    epicsTime lastLoad;
+    unsigned long verifications;
+    unsigned long failedVerifications;
+    double verifyTimeTotal;               /**< [s] */
+    double verifyTimeMax;                 /**< [s] */
+};
+
+} // namespace DevOpcua
+
+#endif // DEVOPCUA_PKICACHE_H
@@ -0,0 +1,58 @@
+/*************************************************************************\
+* Copyright (c) 2026 ITER Organization.
+* This module is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Author: Dirk Zimoch <dirk.zimoch@psi.ch>
+ */
+
+#include <errlog.h>
+
+#define epicsExportSharedSymbols
+#include "PubSubReader.h"
+#include "PubSubReaderOpen62541.h"
+
+namespace DevOpcua {
+
+PubSubReader::~PubSubReader() {}
+
+PubSubReader *
+PubSubReader::createPubSubReader(const std::string &name,
+                                 const std::string &url)
+{
+    if (RegistryKeyNamespace::global.contains(name))
+        return nullptr;
+    return new PubSubReaderOpen62541(name, url);
+}
+
+PubSubReader *
+PubSubReader::find (const std::string &name)
+{
+    return PubSubReaderOpen62541::find(name);
+}
+
+std::set<PubSubReader *>
+PubSubReader::glob(const std::string &pattern)
+{
+    return PubSubReaderOpen62541::glob(pattern);
+}
+
+void
+PubSubReader::showAll (const int level)
+{
+    PubSubReaderOpen62541::showAll(level);
+}
+
+const char PubSubReader::optionUsage[]
+    = "Valid PubSub reader options are:\n"
+      "debug              debug level [default 0 = no debug]\n"
+      "interface          local interface address for joining the multicast group [any]\n"
+      "publisher-id       only accept messages with this PublisherId [default 0 = any]\n"
+      "writer-group-id    only accept messages with this WriterGroupId [default 0 = any]\n"
+      "dataset-writer-id  only accept DataSetMessages with this DataSetWriterId [default 0 = any]\n"
+      "timeout            connection loss if no message for timeout [s] [default 1.0]\n"
+      "";
+
+} // namespace DevOpcua
@@ -0,0 +1,583 @@
+/*************************************************************************\
+* Copyright (c) 2026 ITER Organization.
+* This module is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Author: Dirk Zimoch <dirk.zimoch@psi.ch>
+ */
+
+#include <iostream>
+#include <string>
+#include <cstring>
+#include <algorithm>
+
+#include <errlog.h>
+#include <epicsExit.h>
+#include <epicsStdlib.h>
+
+#define epicsExportSharedSymbols
+#include "PubSubReaderOpen62541.h"
+#include "ItemOpen62541.h"
+#include "DataElementOpen62541.h"
+#include "RecordConnector.h"
+#include "devOpcua.h"
+
+namespace DevOpcua {
+
+static epicsThreadOnceId pubsub_open62541_ihooks_once = EPICS_THREAD_ONCE_INIT;
+static epicsThreadOnceId pubsub_open62541_atexit_once = EPICS_THREAD_ONCE_INIT;
+
+static const size_t maxMessageSize = 65536;  // max UDP datagram size
+
+Registry<PubSubReaderOpen62541> PubSubReaderOpen62541::readers;
+
+static
+void pubsub_open62541_ihooks_register (void*)
+{
+    initHookRegister(PubSubReaderOpen62541::initHook);
+}
+
+static
+void pubsub_open62541_atexit_register (void *)
+{
+    epicsAtExit(PubSubReaderOpen62541::atExit, nullptr);
+}
+
+PubSubReaderOpen62541::PubSubReaderOpen62541 (const std::string &name, const std::string &url)
+    : PubSubReader(name)
+    , url(url)
+    , publisherId(0)
+    , writerGroupId(0)
+    , dataSetWriterId(0)
+    , timeout(1.0)
+    , sock(INVALID_SOCKET)
+    , workerThread(nullptr)
+    , running(false)
+    , connected(false)
+    , messages(0)
+    , dataSetMessages(0)
+    , decodeErrors(0)
+    , sequenceGaps(0)
+    , lastSequenceNumber(0)
+    , haveSequenceNumber(false)
+{
+    readers.insert({name, this});
+    epicsThreadOnce(&pubsub_open62541_ihooks_once, &pubsub_open62541_ihooks_register, nullptr);
+}
+
+PubSubReaderOpen62541::~PubSubReaderOpen62541 ()
+{
+    stop();
+    for (auto &field : fields)
+        UA_DataValue_clear(&field.last);
+}
+
+void
+PubSubReaderOpen62541::setOption (const std::string &name, const std::string &value)
+{
+    if (debug || name == "debug")
+        std::cerr << "PubSubReader " << this->name
+                  << ": setting option " << name
+                  << " to " << value
+                  << std::endl;
+
+    if (name == "debug") {
+        unsigned long ul = std::strtoul(value.c_str(), nullptr, 0);
+        debug = ul;
+    } else if (name == "interface") {
+        networkInterface = value;
+    } else if (name == "publisher-id") {
+        unsigned long long ull = std::strtoull(value.c_str(), nullptr, 0);
+        publisherId = static_cast<UA_UInt64>(ull);
+    } else if (name == "writer-group-id") {
+        unsigned long ul = std::strtoul(value.c_str(), nullptr, 0);
+        if (ul > 0xffff)
+            errlogPrintf("option '%s' value out of range - ignored\n", name.c_str());
+        else
+            writerGroupId = static_cast<UA_UInt16>(ul);
+    } else if (name == "dataset-writer-id") {
+        unsigned long ul = std::strtoul(value.c_str(), nullptr, 0);
+        if (ul > 0xffff)
+            errlogPrintf("option '%s' value out of range - ignored\n", name.c_str());
+        else
+            dataSetWriterId = static_cast<UA_UInt16>(ul);
+    } else if (name == "timeout") {
+        double d;
+        if (epicsParseDouble(value.c_str(), &d, nullptr) || d <= 0.0)
+            errlogPrintf("option '%s' value out of range - ignored\n", name.c_str());
+        else
+            timeout = d;
+    } else {
+        errlogPrintf("unknown option '%s' - ignored\n", name.c_str());
+    }
+}
+
+bool
+PubSubReaderOpen62541::addField (const std::string &name, const std::string &type)
+{
+    const UA_DataType *t = nullptr;
+    for (size_t i = 0; i < UA_TYPES_COUNT; i++) {
+        if (type == UA_TYPES[i].typeName) {
+            t = &UA_TYPES[i];
+            break;
+        }
+    }
+    if (!t)
+        return false;
+    fields.emplace_back();
+    fields.back().name = name;
+    fields.back().type = t;
+    UA_DataValue_init(&fields.back().last);
+    return true;
+}
+
+void
+PubSubReaderOpen62541::show (int level) const
+{
+    bool up;
+    {
+        Guard G(lock);
+        up = connected;
+    }
+    std::cout << "pubsubreader=" << name
+              << " url=" << url
+              << " interface=" << (networkInterface.length() ? networkInterface : "-")
+              << " publisher-id=" << publisherId
+              << " writer-group-id=" << writerGroupId
+              << " dataset-writer-id=" << dataSetWriterId
+              << " timeout=" << timeout
+              << " debug=" << debug
+              << " state=" << (up ? "up" : "down")
+              << " fields=" << fields.size()
+              << " items=" << items.size()
+              << " messages=" << messages
+              << " datasets=" << dataSetMessages
+              << " errors=" << decodeErrors
+              << " gaps=" << sequenceGaps
+#ifndef HAS_PUBSUB
+              << " (no PubSub support in open62541 library)"
+#endif
+              << std::endl;
+
+    if (level >= 1) {
+        size_t i = 0;
+        for (auto &field : fields) {
+            std::cout << "  field[" << i++ << "]=" << field.name
+                      << " type=" << field.type->typeName
+                      << " items=" << field.items.size()
+                      << std::endl;
+            if (level >= 2)
+                for (auto &it : field.items)
+                    it->show(level - 2);
+        }
+    }
+}
+
+void
+PubSubReaderOpen62541::showAll (int level)
+{
+    std::cout << "OPC UA: " << readers.size() << " PubSub reader(s) configured" << std::endl;
+    if (level >= 1) {
+        for (auto &it : readers) {
+            it.second->show(level - 1);
+        }
+    }
+}
+
+void
+PubSubReaderOpen62541::addItemOpen62541 (ItemOpen62541 *item)
+{
+    auto field = std::find_if(fields.begin(), fields.end(),
+                              [item] (const Field &f) { return f.name == item->linkinfo.pubsubField; });
+    if (field == fields.end()) {
+        errlogPrintf("OPC UA PubSub reader %s: no field '%s' in DataSetMetaData - item not connected\n",
+                     name.c_str(), item->linkinfo.pubsubField.c_str());
+    } else {
+        field->items.push_back(item);
+    }
+    items.push_back(item);
+}
+
+void
+PubSubReaderOpen62541::removeItemOpen62541 (ItemOpen62541 *item)
+{
+    for (auto &field : fields) {
+        auto it = std::find(field.items.begin(), field.items.end(), item);
+        if (it != field.items.end())
+            field.items.erase(it);
+    }
+    auto it = std::find(items.begin(), items.end(), item);
+    if (it != items.end())
+        items.erase(it);
+}
+
+void
+PubSubReaderOpen62541::requestRead (ItemOpen62541 &item)
+{
+    Guard G(lock);
+    // Data elements only accept data of items that are up
+    for (auto &field : fields) {
+        if (!connected)
+            break;
+        if (std::find(field.items.begin(), field.items.end(), &item) != field.items.end()
+                && field.last.hasValue) {
+            item.setIncomingData(field.last, ProcessReason::readComplete);
+            return;
+        }
+    }
+    item.setIncomingEvent(ProcessReason::readFailure);
+}
+
+void
+PubSubReaderOpen62541::start ()
+{
+#ifdef HAS_PUBSUB
+    if (running)
+        return;
+
+    std::string address(url);
+    const std::string scheme("opc.udp://");
+    if (address.compare(0, scheme.length(), scheme) == 0)
+        address.erase(0, scheme.length());
+    while (address.length() && address.back() == '/')
+        address.pop_back();
+
+    struct sockaddr_in group;
+    if (aToIPAddr(address.c_str(), 4840, &group)) {
+        errlogPrintf("OPC UA PubSub reader %s: cannot parse address '%s'\n",
+                     name.c_str(), url.c_str());
+        return;
+    }
+
+    sock = epicsSocketCreate(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (sock == INVALID_SOCKET) {
+        errlogPrintf("OPC UA PubSub reader %s: cannot create socket\n", name.c_str());
+        return;
+    }
+    epicsSocketEnableAddressUseForDatagramFanout(sock);
+
+    struct sockaddr_in local;
+    memset(&local, 0, sizeof(local));
+    local.sin_family = AF_INET;
+    local.sin_port = group.sin_port;
+    local.sin_addr.s_addr = htonl(INADDR_ANY);
+    if (bind(sock, reinterpret_cast<struct sockaddr *>(&local), sizeof(local))) {
+        char err[64];
+        epicsSocketConvertErrnoToString(err, sizeof(err));
+        errlogPrintf("OPC UA PubSub reader %s: cannot bind to port %u: %s\n",
+                     name.c_str(), ntohs(group.sin_port), err);
+        epicsSocketDestroy(sock);
+        sock = INVALID_SOCKET;
+        return;
+    }
+
+    if (IN_MULTICAST(ntohl(group.sin_addr.s_addr))) {
+        struct ip_mreq mreq;
+        memset(&mreq, 0, sizeof(mreq));
+        mreq.imr_multiaddr = group.sin_addr;
+        mreq.imr_interface.s_addr = htonl(INADDR_ANY);
+        if (networkInterface.length()) {
+            struct sockaddr_in ifaddr;
+            if (aToIPAddr(networkInterface.c_str(), 0, &ifaddr))
+                errlogPrintf("OPC UA PubSub reader %s: cannot parse interface address '%s' - using any\n",
+                             name.c_str(), networkInterface.c_str());
+            else
+                mreq.imr_interface = ifaddr.sin_addr;
+        }
+        if (setsockopt(sock, IPPROTO_IP, IP_ADD_MEMBERSHIP,
+                       reinterpret_cast<char *>(&mreq), sizeof(mreq))) {
+            char err[64];
+            epicsSocketConvertErrnoToString(err, sizeof(err));
+            errlogPrintf("OPC UA PubSub reader %s: cannot join multicast group %s: %s\n",
+                         name.c_str(), address.c_str(), err);
+        }
+    }
+
+    running = true;
+    workerThread = new epicsThread(*this, ("OPCps-" + name).c_str(),
+                                   epicsThreadGetStackSize(epicsThreadStackBig),
+                                   epicsThreadPriorityHigh);
+    workerThread->start();
+    if (debug)
+        std::cout << "PubSubReader " << name << ": receiving on " << address << std::endl;
+#else
+    errlogPrintf("OPC UA PubSub reader %s: open62541 library has no PubSub support "
+                 "(needs UA_ENABLE_PUBSUB and version >= 1.4) - not started\n",
+                 name.c_str());
+#endif
+}
+
+void
+PubSubReaderOpen62541::stop ()
+{
+    if (!running)
+        return;
+    running = false;
+    if (workerThread) {
+        workerThread->exitWait();
+        delete workerThread;
+        workerThread = nullptr;
+    }
+    if (sock != INVALID_SOCKET) {
+        epicsSocketDestroy(sock);
+        sock = INVALID_SOCKET;
+    }
+    markConnectionLoss();
+}
+
+void
+PubSubReaderOpen62541::markConnectionLoss ()
+{
+    {
+        Guard G(lock);
+        connected = false;
+    }
+    haveSequenceNumber = false;
+    for (auto &it : items) {
+        it->setState(ConnectionStatus::down);
+        it->setIncomingEvent(ProcessReason::connectionLoss);
+    }
+}
+
+void
+PubSubReaderOpen62541::markConnected ()
+{
+    {
+        Guard G(lock);
+        connected = true;
+    }
+    errlogPrintf("OPC UA PubSub reader %s: receiving data\n", name.c_str());
+    for (auto &it : items)
+        it->setState(ConnectionStatus::up);
+}
+
+void
+PubSubReaderOpen62541::run ()
+{
+#ifdef HAS_PUBSUB
+    std::vector<UA_Byte> buffer(maxMessageSize);
+
+    if (debug)
+        std::cerr << "PubSubReader " << name << " worker thread starts" << std::endl;
+
+    while (running) {
+        // Wait with timeout, so that stop() and connection loss are detected
+        fd_set readfds;
+        FD_ZERO(&readfds);
+        FD_SET(sock, &readfds);
+        struct timeval tv = { 0, 100000 };
+        int n = select(static_cast<int>(sock) + 1, &readfds, nullptr, nullptr, &tv);
+        if (n > 0) {
+            int len = recv(sock, reinterpret_cast<char *>(buffer.data()),
+                           static_cast<int>(buffer.size()), 0);
+            if (len > 0) {
+                UA_ByteString msg;
+                msg.length = static_cast<size_t>(len);
+                msg.data = buffer.data();
+                messages++;
+                handleMessage(msg);
+            }
+        }
+        bool lost;
+        {
+            Guard G(lock);
+            lost = connected && epicsTime::getCurrent() - lastMessage > timeout;
+        }
+        if (lost) {
+            errlogPrintf("OPC UA PubSub reader %s: no data for %g s\n", name.c_str(), timeout);
+            markConnectionLoss();
+        }
+    }
+
+    if (debug)
+        std::cerr << "PubSubReader " << name << " worker thread exits" << std::endl;
+#endif
+}
+
+#ifdef HAS_PUBSUB
+// Compare the publisher id of a NetworkMessage with the configured filter
+static bool
+publisherIdMatches (const UA_NetworkMessage &nm, const UA_UInt64 id)
+{
+    if (!id || !nm.publisherIdEnabled)
+        return true;
+    switch (nm.publisherId.idType) {
+    case UA_PUBLISHERIDTYPE_BYTE:   return nm.publisherId.id.byte == id;
+    case UA_PUBLISHERIDTYPE_UINT16: return nm.publisherId.id.uint16 == id;
+    case UA_PUBLISHERIDTYPE_UINT32: return nm.publisherId.id.uint32 == id;
+    case UA_PUBLISHERIDTYPE_UINT64: return nm.publisherId.id.uint64 == id;
+    default:                        return false;
+    }
+}
+
+void
+PubSubReaderOpen62541::handleMessage (const UA_ByteString &buffer)
+{
+    UA_NetworkMessage nm;
+    memset(&nm, 0, sizeof(nm));
+    size_t offset = 0;
+    UA_StatusCode status = UA_NetworkMessage_decodeBinary(&buffer, &offset, &nm, nullptr);
+    if (UA_STATUS_IS_BAD(status)) {
+        decodeErrors++;
+        if (debug)
+            std::cerr << "PubSubReader " << name << ": failed to decode NetworkMessage ("
+                      << UA_StatusCode_name(status) << ")" << std::endl;
+        UA_NetworkMessage_clear(&nm);
+        return;
+    }
+
+    if (nm.networkMessageType != UA_NETWORKMESSAGE_DATASET
+            || !publisherIdMatches(nm, publisherId)
+            || (writerGroupId && nm.groupHeaderEnabled && nm.groupHeader.writerGroupIdEnabled
+                && nm.groupHeader.writerGroupId != writerGroupId)) {
+        UA_NetworkMessage_clear(&nm);
+        return;
+    }
+
+    size_t count = nm.payloadHeaderEnabled ? nm.payloadHeader.dataSetPayloadHeader.count : 1;
+    for (size_t i = 0; i < count; i++) {
+        if (dataSetWriterId && nm.payloadHeaderEnabled
+                && nm.payloadHeader.dataSetPayloadHeader.dataSetWriterIds[i] != dataSetWriterId)
+            continue;
+        const UA_DataSetMessage &dsm = nm.payload.dataSetPayload.dataSetMessages[i];
+        if (!dsm.header.dataSetMessageValid)
+            continue;
+
+        dataSetMessages++;
+        bool wasConnected;
+        {
+            Guard G(lock);
+            lastMessage = epicsTime::getCurrent();
+            wasConnected = connected;
+        }
+        if (!wasConnected)
+            markConnected();
+
+        if (dsm.header.dataSetMessageSequenceNrEnabled) {
+            if (haveSequenceNumber
+                    && static_cast<UA_UInt16>(lastSequenceNumber + 1) != dsm.header.dataSetMessageSequenceNr) {
+                sequenceGaps++;
+                if (debug >= 2)
+                    std::cerr << "PubSubReader " << name << ": sequence gap "
+                              << lastSequenceNumber << " -> " << dsm.header.dataSetMessageSequenceNr
+                              << std::endl;
+            }
+            lastSequenceNumber = dsm.header.dataSetMessageSequenceNr;
+            haveSequenceNumber = true;
+        }
+
+        UA_DateTime ts = UA_DateTime_now();
+        if (dsm.header.timestampEnabled)
+            ts = dsm.header.timestamp;
+        else if (nm.timestampEnabled)
+            ts = nm.timestamp;
+
+        if (dsm.header.dataSetMessageType == UA_DATASETMESSAGE_DATAKEYFRAME) {
+            if (dsm.header.fieldEncoding == UA_FIELDENCODING_RAWDATA) {
+                handleRawFields(dsm.data.keyFrameData.rawFields, ts);
+            } else {
+                for (size_t f = 0; f < dsm.data.keyFrameData.fieldCount; f++)
+                    deliver(f, dsm.data.keyFrameData.dataSetFields[f], ts);
+            }
+        } else if (dsm.header.dataSetMessageType == UA_DATASETMESSAGE_DATADELTAFRAME) {
+            for (size_t f = 0; f < dsm.data.deltaFrameData.fieldCount; f++)
+                deliver(dsm.data.deltaFrameData.deltaFrameFields[f].fieldIndex,
+                        dsm.data.deltaFrameData.deltaFrameFields[f].fieldValue, ts);
+        }
+    }
+    UA_NetworkMessage_clear(&nm);
+}
+
+// RawData encoding has no type information: decode along the DataSetMetaData
+void
+PubSubReaderOpen62541::handleRawFields (const UA_ByteString &raw, const UA_DateTime ts)
+{
+    size_t pos = 0;
+    for (size_t f = 0; f < fields.size() && pos < raw.length; f++) {
+        UA_ByteString rest;
+        rest.length = raw.length - pos;
+        rest.data = raw.data + pos;
+        void *data = UA_new(fields[f].type);
+        UA_StatusCode status = UA_decodeBinary(&rest, data, fields[f].type, nullptr);
+        if (UA_STATUS_IS_BAD(status)) {
+            decodeErrors++;
+            if (debug)
+                std::cerr << "PubSubReader " << name << ": failed to decode raw field "
+                          << fields[f].name << " (" << UA_StatusCode_name(status) << ")"
+                          << std::endl;
+            UA_delete(data, fields[f].type);
+            return;
+        }
+        pos += UA_calcSizeBinary(data, fields[f].type);
+        UA_DataValue value;
+        UA_DataValue_init(&value);
+        UA_Variant_setScalar(&value.value, data, fields[f].type);  // value takes ownership
+        value.hasValue = true;
+        deliver(f, value, ts);
+        UA_DataValue_clear(&value);
+    }
+}
+#endif
+
+void
+PubSubReaderOpen62541::deliver (const size_t index, const UA_DataValue &value, const UA_DateTime ts)
+{
+    if (index >= fields.size())
+        return;
+    Field &field = fields[index];
+
+    // Use the message timestamp unless the field (DataValue encoding) has its own
+    UA_DataValue dv = value;  // shallow copy, the data is copied by the data elements
+    if (!dv.hasSourceTimestamp) {
+        dv.hasSourceTimestamp = true;
+        dv.sourceTimestamp = ts;
+    }
+    if (!dv.hasServerTimestamp) {
+        dv.hasServerTimestamp = true;
+        dv.serverTimestamp = dv.sourceTimestamp;
+    }
+
+    Guard G(lock);
+    UA_DataValue_clear(&field.last);
+    UA_DataValue_copy(&dv, &field.last);
+    if (debug >= 5)
+        std::cout << "PubSubReader " << name << ": field " << field.name
+                  << " = " << dv.value << std::endl;
+    for (auto &it : field.items) {
+        it->setIncomingData(dv, ProcessReason::incomingData);
+        // A message carries one sample per field: end of batch for burst records
+        if (it->hasBurstElements())
+            it->requestBurstProcessing();
+    }
+}
+
+void
+PubSubReaderOpen62541::initHook (initHookState state)
+{
+    switch (state) {
+    case initHookAfterIocRunning:
+    {
+        errlogPrintf("OPC UA: Starting PubSub readers\n");
+        for (auto &it : readers) {
+            it.second->markConnectionLoss();
+            it.second->start();
+        }
+        epicsThreadOnce(&DevOpcua::pubsub_open62541_atexit_once, &DevOpcua::pubsub_open62541_atexit_register, nullptr);
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+void
+PubSubReaderOpen62541::atExit (void *)
+{
+    errlogPrintf("OPC UA: Stopping PubSub readers\n");
+    for (auto &it : readers)
+        it.second->stop();
+}
+
+} // namespace DevOpcua
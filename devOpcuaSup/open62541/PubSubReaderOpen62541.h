@@ -0,0 +1,236 @@
+/*************************************************************************\
+* Copyright (c) 2026 ITER Organization.
+* This module is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Author: Dirk Zimoch <dirk.zimoch@psi.ch>
+ */
+
+#ifndef DEVOPCUA_PUBSUBREADEROPEN62541_H
+#define DEVOPCUA_PUBSUBREADEROPEN62541_H
+
+#include <vector>
+#include <atomic>
+#include <set>
+#include <string>
+
+#include <open62541/types.h>
+#include <open62541/types_generated.h>
+
+#include <epicsMutex.h>
+#include <epicsThread.h>
+#include <epicsTime.h>
+#include <osiSock.h>
+#include <initHooks.h>
+
+#include "PubSubReader.h"
+#include "Registry.h"
+
+// PubSub decoding needs an open62541 library built with PubSub support
+// and the public NetworkMessage API (open62541 >= 1.4)
+#if defined(UA_ENABLE_PUBSUB) && UA_OPEN62541_VER_MAJOR*100+UA_OPEN62541_VER_MINOR >= 104
+#define HAS_PUBSUB
+#endif
+
+#ifdef HAS_PUBSUB
+#include <open62541/pubsub.h>
+#endif
+
+namespace DevOpcua {
+
+class ItemOpen62541;
+
+/**
+ * @brief The PubSubReaderOpen62541 implementation of an OPC UA PubSub subscriber.
+ *
+ * See DevOpcua::PubSubReader
+ *
+ * A worker thread receives UADP NetworkMessages on a UDP socket (joining the
+ * multicast group if the address is a multicast address), decodes the
+ * DataSetMessages of the configured DataSetWriter and pushes the field values
+ * into the data elements of the connected items.
+ */
+class PubSubReaderOpen62541 : public PubSubReader, public epicsThreadRunable
+{
+    // Cannot copy a reader
+    PubSubReaderOpen62541(const PubSubReaderOpen62541 &);
+    PubSubReaderOpen62541 &operator=(const PubSubReaderOpen62541 &);
+
+public:
+    /**
+     * @brief Constructor for PubSubReaderOpen62541.
+     *
+     * @param name  reader name
+     * @param url  UADP transport URL (opc.udp://address:port)
+     */
+    PubSubReaderOpen62541(const std::string &name, const std::string &url);
+    ~PubSubReaderOpen62541() override;
+
+    /**
+     * @brief Set an option for the reader. See DevOpcua::PubSubReader::setOption
+     */
+    virtual void setOption(const std::string &name, const std::string &value) override;
+
+    /**
+     * @brief Append a field to the DataSetMetaData. See DevOpcua::PubSubReader::addField
+     */
+    virtual bool addField(const std::string &name, const std::string &type) override;
+
+    /**
+     * @brief Print configuration and status. See DevOpcua::PubSubReader::show
+     */
+    virtual void show(int level) const override;
+
+    /**
+     * @brief Print configuration and status of all readers on stdout.
+     *
+     * @param level  verbosity level
+     */
+    static void showAll(int level);
+
+    /**
+     * @brief Find a reader by name.
+     *
+     * @param name  reader name to search for
+     *
+     * @return  pointer to reader, nullptr if not found
+     */
+    static PubSubReaderOpen62541 *
+    find(const std::string &name)
+    {
+        return readers.find(name);
+    }
+
+    static std::set<PubSubReader *>
+    glob(const std::string &pattern)
+    {
+        return readers.glob<PubSubReader>(pattern);
+    }
+
+    /**
+     * @brief Add an item (implementation) to the reader.
+     *
+     * The item is connected to the DataSet field named in its link
+     * configuration (link option 'field').
+     *
+     * @param item  item (implementation) to add
+     */
+    void addItemOpen62541(ItemOpen62541 *item);
+
+    /**
+     * @brief Remove an item (implementation) from the reader.
+     *
+     * @param item  item (implementation) to remove
+     */
+    void removeItemOpen62541(ItemOpen62541 *item);
+
+    /**
+     * @brief Serve a read request for an item.
+     *
+     * There is no read service in PubSub: the latest received value of the
+     * item's field is pushed (as readComplete), or a readFailure if there is none.
+     *
+     * @param item  item to read
+     */
+    void requestRead(ItemOpen62541 &item);
+
+    /**
+     * @brief Start receiving (open socket and start worker thread).
+     */
+    void start();
+
+    /**
+     * @brief Stop receiving (stop worker thread and close socket).
+     */
+    void stop();
+
+    /**
+     * @brief EPICS IOC Database initHook function.
+     *
+     * Hook function called when the EPICS IOC is being initialized.
+     * Starts all readers after the IOC is running.
+     *
+     * @param state  initialization state
+     */
+    static void initHook(initHookState state);
+
+    /**
+     * @brief EPICS IOC Database atExit function.
+     *
+     * Hook function called when the EPICS IOC is exiting.
+     * Stops all readers.
+     */
+    static void atExit(void *junk);
+
+private:
+    /**
+     * @brief Worker thread body: receive and dispatch messages.
+     */
+    virtual void run() override;
+
+    /**
+     * @brief Mark connection loss: set items down and process records.
+     */
+    void markConnectionLoss();
+
+    /**
+     * @brief Mark connection: set items up.
+     */
+    void markConnected();
+
+#ifdef HAS_PUBSUB
+    /**
+     * @brief Decode a received NetworkMessage and dispatch its DataSetMessages.
+     */
+    void handleMessage(const UA_ByteString &buffer);
+
+    /**
+     * @brief Dispatch the fields of a RawData encoded key frame.
+     */
+    void handleRawFields(const UA_ByteString &raw, const UA_DateTime ts);
+#endif
+
+    /**
+     * @brief Push a field value to the items connected to the field.
+     */
+    void deliver(const size_t index, const UA_DataValue &value, const UA_DateTime ts);
+
+    // Field of the DataSetMetaData
+    struct Field {
+        std::string name;                       /**< field name */
+        const UA_DataType *type;                /**< field (built-in) type */
+        std::vector<ItemOpen62541 *> items;     /**< items connected to this field */
+        UA_DataValue last;                      /**< latest received value */
+    };
+
+    static Registry<PubSubReaderOpen62541> readers;  /**< reader management */
+
+    const std::string url;                 /**< UADP transport URL */
+    std::string networkInterface;          /**< local interface address for multicast */
+    UA_UInt64 publisherId;                 /**< PublisherId filter (0 = any) */
+    UA_UInt16 writerGroupId;               /**< WriterGroupId filter (0 = any) */
+    UA_UInt16 dataSetWriterId;             /**< DataSetWriterId filter (0 = any) */
+    double timeout;                        /**< connection loss after no message for this long [s] */
+    std::vector<Field> fields;             /**< DataSetMetaData and connected items */
+    std::vector<ItemOpen62541 *> items;    /**< items on this reader */
+    mutable epicsMutex lock;               /**< lock for latest values, connected and lastMessage */
+
+    SOCKET sock;                           /**< receiving socket */
+    epicsThread *workerThread;             /**< receiving worker thread */
+    std::atomic<bool> running;             /**< worker thread run flag */
+    bool connected;                        /**< messages are being received */
+    epicsTime lastMessage;                 /**< time of last matching message */
+
+    std::atomic<unsigned long> messages;        /**< number of NetworkMessages received */
+    std::atomic<unsigned long> dataSetMessages; /**< number of matching DataSetMessages */
+    std::atomic<unsigned long> decodeErrors;    /**< number of messages that failed to decode */
+    std::atomic<unsigned long> sequenceGaps;    /**< number of DataSetMessage sequence number gaps */
+    UA_UInt16 lastSequenceNumber;          /**< last DataSetMessage sequence number */
+    bool haveSequenceNumber;               /**< lastSequenceNumber is valid */
+};
+
+} // namespace DevOpcua
+
+#endif // DEVOPCUA_PUBSUBREADEROPEN62541_H
@@ -16,6 +16,7 @@
 #define epicsExportSharedSymbols
 #include "Session.h"
 #include "SessionOpen62541.h"
+#include "PkiCache.h"
 #include "Registry.h"
 
 namespace DevOpcua {
@@ -137,6 +138,7 @@ Session::showClientSecurity()
     for (const auto &p : securitySupportedPolicies)
         std::cout << " " << p.second;
     std::cout << std::endl;
+    PkiCache::instance().show(std::cout);
 }
 #else
 {
@@ -162,6 +164,12 @@ const char Session::optionUsage[]
       "write-nodes-max    max. nodes per write service call [0 = no limit]\n"
       "write-timeout-min  min. timeout (holdoff) after write service call [ms]\n"
       "write-timeout-max  timeout (holdoff) after write service call w/ max elements [ms]\n"
+      "recv-buffer-size   transport receive buffer size [bytes] [0 = library default]\n"
+      "send-buffer-size   transport send buffer size [bytes] [0 = library default]\n"
+      "max-message-size   max. message size [bytes], splits larger requests [0 = library default]\n"
+      "max-chunk-count    max. chunks per message [0 = library default]\n"
+      "notify-threads     threads delivering data to records [0 = client thread]\n"
+      "proxy              socket of a local opcuaProxy, used if it exists (needs sec-mode=None) [default none]\n"
       "sec-mode           requested security mode\n"
       "sec-policy         requested security policy\n"
       "ident-file         file to read identity credentials from\n\n"
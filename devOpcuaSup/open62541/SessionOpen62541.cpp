@@ -14,11 +14,14 @@
 #include <iostream>
 #include <iomanip>
 #include <string>
+#include <cstring>
+#include <sstream>
 #include <map>
 #include <algorithm>
 #include <utility>
 #include <vector>
 #include <limits>
+#include <stdexcept>
 
 #if defined(_WIN32)
 #include <winsock2.h>
@@ -94,10 +97,20 @@ extern const UA_String certificate_policy;
 #include "RecordConnector.h"
 #include "linkParser.h"
 #include "RequestQueueBatcher.h"
+#include "ErrorReporter.h"
 #include "SessionOpen62541.h"
 #include "SubscriptionOpen62541.h"
 #include "DataElementOpen62541.h"
 #include "ItemOpen62541.h"
+#include "UnixTransport.h"
+#include "PkiCache.h"
+#include "CryptoStats.h"
+#include "SubscriptionDiagnostics.h"
+
+// The connection based client network layer (initConnectionFunc) was replaced by the EventLoop in 1.4
+#if UA_OPEN62541_VER_MAJOR*100+UA_OPEN62541_VER_MINOR < 104
+#define HAS_ACK_PROBE
+#endif
 
 namespace DevOpcua {
 
@@ -245,18 +258,126 @@ static epicsThreadOnceId session_open62541_ihooks_once = EPICS_THREAD_ONCE_INIT;
 static epicsThreadOnceId session_open62541_atexit_once = EPICS_THREAD_ONCE_INIT;
 
 Registry<SessionOpen62541> SessionOpen62541::sessions;
+epicsMutex SessionOpen62541::writeGroupsBindLock;
 
-// Cargo structure and batcher for write requests
+// Cargo structure and batcher for write requests (holding a reference to the item)
 struct WriteRequest {
+    explicit WriteRequest(ItemOpen62541 *item = nullptr) : item(item) { if (item) item->addReference(); }
+    ~WriteRequest() { if (item) item->releaseReference(); }
     ItemOpen62541 *item;
     UA_WriteValue wvalue;
+    std::vector<std::shared_ptr<WriteRequest>> group;  // write group (item == nullptr): sent in one request
 };
 
-// Cargo structure and batcher for read requests
+// Cargo structure and batcher for read requests (holding a reference to the item)
 struct ReadRequest {
+    explicit ReadRequest(ItemOpen62541 *item = nullptr) : item(item) { if (item) item->addReference(); }
+    ~ReadRequest() { if (item) item->releaseReference(); }
     ItemOpen62541 *item;
+    std::vector<std::shared_ptr<ReadRequest>> group;   // snapshot group (item == nullptr): read in one request
+};
+
+void
+ReleaseItemReferences::operator() (std::vector<ItemOpen62541 *> *items) const
+{
+    for (auto it : *items)
+        it->releaseReference();
+    delete items;
+}
+
+// Size estimates for splitting service calls [bytes]
+static const size_t readValueOverhead = 32;     // per node: DataValue header and timestamps
+static const size_t messageOverhead = 1024;     // per message: headers, security, padding
+
+#ifdef HAS_ACK_PROBE
+// The limits negotiated in the HEL/ACK exchange are kept in the client's (private) secure channel.
+// While UA_Client_connect() runs, the receive function of the new connection is wrapped
+// to read the server's limits from the ACK message.
+
+typedef UA_StatusCode (*ConnectionRecv)(UA_Connection *, UA_ByteString *, UA_UInt32);
+
+struct AckProbe {
+    UA_ConnectClientConnection init;    // connection init function of the transport
+    ConnectionRecv recv;                // receive function of the connection
+    UA_ConnectionConfig *remote;        // where to put the server's limits
 };
 
+static epicsThreadPrivate<AckProbe> connectingProbe;  // set while UA_Client_connect() runs
+static epicsMutex ackProbesLock;
+static std::map<void *, AckProbe> ackProbes;           // wrapped connections (by connection handle)
+
+static UA_UInt32
+decodeUInt32 (const UA_Byte *p)
+{
+    return static_cast<UA_UInt32>(p[0]) | static_cast<UA_UInt32>(p[1]) << 8
+            | static_cast<UA_UInt32>(p[2]) << 16 | static_cast<UA_UInt32>(p[3]) << 24;
+}
+
+static UA_StatusCode
+ackProbeRecv (UA_Connection *connection, UA_ByteString *response, UA_UInt32 timeout)
+{
+    AckProbe probe;
+    {
+        Guard G(ackProbesLock);
+        probe = ackProbes[connection->handle];
+    }
+    UA_StatusCode status = probe.recv(connection, response, timeout);
+    if (status != UA_STATUSCODE_GOOD || !response->length)
+        return status;
+
+    // The first message from the server is the ACK (or an error): stop probing
+    connection->recv = probe.recv;
+    {
+        Guard G(ackProbesLock);
+        ackProbes.erase(connection->handle);
+    }
+    // ACK: message header, protocol version, receive/send buffer size, max message size, max chunk count
+    if (response->length >= 28 && memcmp(response->data, "ACKF", 4) == 0) {
+        const UA_Byte *ack = response->data + 8;
+        probe.remote->protocolVersion = decodeUInt32(ack);
+        probe.remote->recvBufferSize = decodeUInt32(ack + 4);
+        probe.remote->sendBufferSize = decodeUInt32(ack + 8);
+        probe.remote->localMaxMessageSize = decodeUInt32(ack + 12);
+        probe.remote->localMaxChunkCount = decodeUInt32(ack + 16);
+    }
+    return status;
+}
+
+static UA_Connection
+ackProbeInit (UA_ConnectionConfig config, const UA_String endpointUrl,
+              UA_UInt32 timeout, const UA_Logger *logger)
+{
+    AckProbe *probe = connectingProbe.get();
+    UA_Connection connection = probe->init(config, endpointUrl, timeout, logger);
+    if (connection.handle && connection.recv) {
+        AckProbe p = *probe;
+        p.recv = connection.recv;
+        Guard G(ackProbesLock);
+        ackProbes[connection.handle] = p;
+        connection.recv = ackProbeRecv;
+    }
+    return connection;
+}
+#endif // #ifdef HAS_ACK_PROBE
+
+// Message size limit in one direction (0 = unlimited)
+static UA_UInt32
+messageLimit (const UA_UInt32 maxMessageSize, const UA_UInt32 maxChunkCount, const UA_UInt32 chunkSize)
+{
+    if (maxMessageSize)
+        return maxMessageSize;
+    return maxChunkCount * chunkSize;
+}
+
+// Lower of two limits (0 = unlimited)
+static UA_UInt32
+lowerLimit (const UA_UInt32 a, const UA_UInt32 b)
+{
+    if (!a || !b)
+        return a + b;
+    return std::min(a, b);
+}
+
 static
 void session_open62541_ihooks_register (void*)
 {
@@ -285,10 +406,12 @@ SessionOpen62541::SessionOpen62541 (const std::string &name,
                                     const std::string &serverUrl)
     : Session(name)
     , serverURL(serverUrl)
+    , connectURL(serverUrl)
     , registeredItemsNo(0)
     , reqSecurityMode(RequestedSecurityMode::Best)
     , reqSecurityPolicyUri("http://opcfoundation.org/UA/SecurityPolicy#None")
     , transactionId(0)
+    , coalescedSnapshots(0)
     , writer("OPCwr-" + name, *this)
     , writeNodesMax(0)
     , writeTimeoutMin(0)
@@ -301,6 +424,17 @@ SessionOpen62541::SessionOpen62541 (const std::string &name,
     , channelState(UA_SECURECHANNELSTATE_CLOSED)
     , sessionState(UA_SESSIONSTATE_CLOSED)
     , connectStatus(UA_STATUSCODE_BADINVALIDSTATE)
+    , MaxNodesPerRead(0)
+    , MaxNodesPerWrite(0)
+    , MaxMonitoredItemsPerCall(0)
+    , recvBufferSize(0)
+    , sendBufferSize(0)
+    , maxMessageSize(0)
+    , maxChunkCount(0)
+    , remoteConfig()
+    , messageSizeLimit(0)
+    , splitRequests(0)
+    , notifyThreads(0)
     , workerThread(nullptr)
 {
     sessions.insert({name, this});
@@ -314,6 +448,81 @@ SessionOpen62541::getName () const
     return name;
 }
 
+void
+SessionOpen62541::updateMessageSizeLimit ()
+{
+    const UA_ConnectionConfig &cc = UA_Client_getConfig(client)->localConnectionConfig;
+    // Responses are limited by the client, requests by the server (if its ACK was seen)
+    UA_UInt32 recvChunk = cc.recvBufferSize;
+    if (remoteConfig.sendBufferSize)
+        recvChunk = lowerLimit(recvChunk, remoteConfig.sendBufferSize);
+    messageSizeLimit = messageLimit(cc.localMaxMessageSize, cc.localMaxChunkCount, recvChunk);
+    if (remoteConfig.recvBufferSize) {
+        UA_UInt32 sendChunk = lowerLimit(cc.sendBufferSize, remoteConfig.recvBufferSize);
+        messageSizeLimit = lowerLimit(messageSizeLimit,
+                                      messageLimit(remoteConfig.localMaxMessageSize,
+                                                   remoteConfig.localMaxChunkCount, sendChunk));
+    }
+}
+
+size_t
+SessionOpen62541::usableMessageSize () const
+{
+    if (!messageSizeLimit)
+        return 0;
+    // Reserve for message headers and the per-chunk overhead of signing/encryption
+    size_t reserve = messageOverhead + messageSizeLimit / 16;
+    if (messageSizeLimit <= 2 * reserve)
+        return messageSizeLimit / 2;
+    return messageSizeLimit - reserve;
+}
+
+void
+SessionOpen62541::deliverData (ItemOpen62541 *item, UA_DataValue &value, const ProcessReason reason)
+{
+    if (reason == ProcessReason::incomingData && item->hasBurstElements()
+            && std::find(burstItems.begin(), burstItems.end(), item) == burstItems.end()) {
+        item->addReference();
+        burstItems.push_back(item);
+    }
+    if (notifier)
+        notifier->pushData(item, value, reason);
+    else
+        item->setIncomingData(value, reason);
+}
+
+void
+SessionOpen62541::deliverEvent (ItemOpen62541 *item, const ProcessReason reason)
+{
+    if (notifier)
+        notifier->pushEvent(item, reason);
+    else
+        item->setIncomingEvent(reason);
+}
+
+// State changes after deliveries must not overtake them in the notification pool
+void
+SessionOpen62541::deliverState (ItemOpen62541 *item, const ConnectionStatus state)
+{
+    if (notifier)
+        notifier->pushState(item, state);
+    else
+        item->setState(state);
+}
+
+void
+SessionOpen62541::deliverBurstEnd ()
+{
+    for (auto item : burstItems) {
+        if (notifier)
+            notifier->pushBurstEnd(item);
+        else
+            item->requestBurstProcessing();
+        item->releaseReference();
+    }
+    burstItems.clear();
+}
+
 UA_UInt32
 SessionOpen62541::getTransactionId ()
 {
@@ -400,9 +609,30 @@ SessionOpen62541::setOption (const std::string &name, const std::string &value)
         unsigned long ul = std::strtoul(value.c_str(), nullptr, 0);
         writeTimeoutMax = ul;
         updateWriteBatcher = true;
+    } else if (name == "recv-buffer-size") {
+        unsigned long ul = std::strtoul(value.c_str(), nullptr, 0);
+        recvBufferSize = static_cast<UA_UInt32>(ul);
+    } else if (name == "send-buffer-size") {
+        unsigned long ul = std::strtoul(value.c_str(), nullptr, 0);
+        sendBufferSize = static_cast<UA_UInt32>(ul);
+    } else if (name == "max-message-size") {
+        unsigned long ul = std::strtoul(value.c_str(), nullptr, 0);
+        maxMessageSize = static_cast<UA_UInt32>(ul);
+    } else if (name == "max-chunk-count") {
+        unsigned long ul = std::strtoul(value.c_str(), nullptr, 0);
+        maxChunkCount = static_cast<UA_UInt32>(ul);
+    } else if (name == "notify-threads") {
+        unsigned long ul = std::strtoul(value.c_str(), nullptr, 0);
+        if (notifier)
+            errlogPrintf("OPC UA session %s: option notify-threads can only be set before connecting\n",
+                         this->name.c_str());
+        else
+            notifyThreads = static_cast<unsigned int>(ul);
     } else if (name == "autoconnect") {
         if (value.length() > 0)
             autoConnect = getYesNo(value[0]);
+    } else if (name == "proxy") {
+        proxyPath = isUnixTransportUrl(value) ? unixTransportPath(value) : value;
     } else {
         errlogPrintf("unknown option '%s' - ignored\n", name.c_str());
     }
@@ -435,6 +665,13 @@ SessionOpen62541::connect (bool manual)
         return 0;
     }
 
+    // The proxy has no security: only sessions that explicitly ask for none may use it
+    if (!proxyPath.empty() && reqSecurityMode != RequestedSecurityMode::None) {
+        errlogPrintf("OPC UA session %s: option proxy needs sec-mode=None - not connecting\n",
+                     name.c_str());
+        return -1;
+    }
+
     disconnect(); // Do a proper disconnection before attempting to reconnect
 
     setupClientSecurityInfo(securityInfo, &name, debug);
@@ -454,8 +691,9 @@ SessionOpen62541::connect (bool manual)
     UA_ClientConfig_setDefaultEncryption(config,
         securityInfo.clientCertificate, securityInfo.privateKey,
         NULL, 0, NULL, 0);
+    cryptoStats.instrument(config->securityPolicies, config->securityPoliciesSize);
 
-#ifdef __linux__ /* UA_CertificateVerification_CertFolders supported only for Linux so far */
+    // Trusted/issuer certificates and revocation lists come from the shared cache
     if (securityCertificateTrustListDir.length() ||
         securityIssuersCertificatesDir.length()) {
         if (debug) {
@@ -463,16 +701,13 @@ SessionOpen62541::connect (bool manual)
                       << ": (connect) setting up PKI provider"
                       << std::endl;
         }
-        UA_StatusCode status = UA_CertificateVerification_CertFolders(
-            &config->certificateVerification,
-            securityCertificateTrustListDir.c_str(),
-            securityIssuersCertificatesDir.c_str(),
-            securityIssuersRevocationListDir.c_str());
-        if (UA_STATUS_IS_BAD(status))
-            errlogPrintf("OPC UA session %s: setting up PKI context failed with status %s\n",
-                         name.c_str(), UA_StatusCode_name(status));
+        PkiCache::instance().install(&config->certificateVerification,
+                                     securityCertificateTrustListDir,
+                                     securityCertificateRevocationListDir,
+                                     securityIssuersCertificatesDir,
+                                     securityIssuersRevocationListDir,
+                                     name, debug);
     }
-#endif // #ifdef __linux__
 #else // #ifdef HAS_SECURITY
     UA_ClientConfig_setDefault(config);
 #endif
@@ -482,8 +717,40 @@ SessionOpen62541::connect (bool manual)
     config->clientDescription.applicationUri = UA_STRING_ALLOC(applicationUri.c_str());
 
     config->outStandingPublishRequests = 5; // TODO: configure this as an option
+
+    // Transport buffers and message size limits (0 = keep library default)
+    UA_ConnectionConfig &cc = config->localConnectionConfig;
+    if (recvBufferSize)
+        cc.recvBufferSize = recvBufferSize;
+    if (sendBufferSize)
+        cc.sendBufferSize = sendBufferSize;
+    if (maxMessageSize) {
+        cc.localMaxMessageSize = maxMessageSize;
+        cc.remoteMaxMessageSize = maxMessageSize;
+    }
+    if (maxChunkCount) {
+        cc.localMaxChunkCount = maxChunkCount;
+        cc.remoteMaxChunkCount = maxChunkCount;
+    }
     config->clientContext = this;
 
+    // Go through the local proxy if it is running, directly to the server otherwise
+    connectURL = serverURL;
+    if (!proxyPath.empty() && isUnixSocket(proxyPath)) {
+        connectURL = unixTransportScheme + proxyPath;
+        if (debug || manual)
+            std::cerr << "Session " << name
+                      << ": connecting through proxy at " << connectURL
+                      << std::endl;
+    }
+
+    // Local transport for co-located servers (replaces the TCP connection functions)
+    if (isUnixTransportUrl(connectURL) && !setUnixTransport(config)) {
+        errlogPrintf("OPC UA session %s: fatal - transport '%s' not supported by the client library\n",
+                     name.c_str(), unixTransportScheme);
+        return -1;
+    }
+
     ConnectResult secResult = setupSecurity();
     if (secResult) {
         if (manual || debug)
@@ -509,7 +776,18 @@ SessionOpen62541::connect (bool manual)
     UA_String_copy(&securityInfo.securityPolicyUri, &config->securityPolicyUri);
     UA_copy(&securityInfo.userIdentityToken, &config->userIdentityToken, &UA_TYPES[UA_TYPES_EXTENSIONOBJECT]);
 
-    connectStatus = UA_Client_connect(client, serverURL.c_str());
+#ifdef HAS_ACK_PROBE
+    // Read the server's limits from the HEL/ACK exchange (see ackProbeInit)
+    remoteConfig = UA_ConnectionConfig();
+    AckProbe probe = { config->initConnectionFunc, nullptr, &remoteConfig };
+    connectingProbe.set(&probe);
+    config->initConnectionFunc = ackProbeInit;
+    connectStatus = UA_Client_connect(client, connectURL.c_str());
+    config->initConnectionFunc = probe.init;
+    connectingProbe.set(nullptr);
+#else
+    connectStatus = UA_Client_connect(client, connectURL.c_str());
+#endif
 
     if (!UA_STATUS_IS_BAD(connectStatus)) {
         if (debug)
@@ -521,12 +799,16 @@ SessionOpen62541::connect (bool manual)
             errlogPrintf("OPC UA session %s: connect service failed with status %s\n",
                          name.c_str(),
                          UA_StatusCode_name(connectStatus));
+        cryptoStats.release(config->securityPolicies, config->securityPoliciesSize);
         UA_Client_delete(client);
         client = nullptr;
         if (autoConnect)
            autoConnector.start();
         return -1;
     }
+    if (notifyThreads && !notifier)
+        notifier.reset(new NotificationPool(name, notifyThreads));
+
     // asynchronous: Remaining actions are done in connectionStatusChanged()
     // Use low prio because the thread needs to loop a lot, see run().
     workerThread = new epicsThread(*this, ("OPCrun-" + name).c_str(),
@@ -549,9 +831,22 @@ SessionOpen62541::disconnect ()
     {
         Guard G(clientlock);
         if(!client) return 0;
+        UA_ClientConfig *config = UA_Client_getConfig(client);
+        cryptoStats.release(config->securityPolicies, config->securityPoliciesSize);
         UA_Client_delete(client); // this also deletes all open62541 subscriptions
         client = nullptr;
     }
+    {
+        // Server side state is gone, pending runtime changes are obsolete
+        Guard G(itemsLock);
+        pendingAdd.clear();
+        clearPendingRemove();
+    }
+    if (debug && cryptoStats.operations()) {
+        std::cout << "Session " << name << ": (disconnect) ";
+        cryptoStats.show(std::cout, 1);
+        std::cout << std::endl;
+    }
     // Worker thread terminates when client was destroyed
     if (workerThread) {
         workerThread->exitWait();
@@ -570,21 +865,113 @@ SessionOpen62541::isConnected () const
 void
 SessionOpen62541::requestRead (ItemOpen62541 &item)
 {
-    auto cargo = std::make_shared<ReadRequest>();
-    cargo->item = &item;
+    if (item.linkinfo.snapshotGroup.length()) {
+        pushSnapshot(item.linkinfo.snapshotGroup, item.recConnector->getRecordPriority());
+        return;
+    }
+    auto cargo = std::make_shared<ReadRequest>(&item);
     reader.pushRequest(cargo, item.recConnector->getRecordPriority());
 }
 
+unsigned int
+SessionOpen62541::readSnapshot (const std::string &group)
+{
+    return pushSnapshot(group, menuPriorityHIGH);
+}
+
+unsigned int
+SessionOpen62541::pushSnapshot (const std::string &group, const menuPriority priority)
+{
+    auto snapshot = std::make_shared<ReadRequest>();
+    {
+        Guard G(itemsLock);
+        for (auto it : items) {
+            if (it->linkinfo.snapshotGroup == group) {
+                snapshot->group.push_back(std::make_shared<ReadRequest>(it));
+            }
+        }
+    }
+    if (snapshot->group.empty())
+        return 0;
+    {
+        Guard G(opslock);
+        if (!snapshotsPending.insert(group).second) {
+            coalescedSnapshots++;
+            if (debug >= 5)
+                std::cout << "Session " << name
+                          << ": (readSnapshot) snapshot group " << group
+                          << " already pending" << std::endl;
+            return static_cast<unsigned int>(snapshot->group.size());
+        }
+    }
+
+    if (reader.maxRequests() && snapshot->group.size() > reader.maxRequests())
+        errlogPrintf("OPC UA session %s: snapshot group %s has %lu nodes "
+                     "(more than the limit of %u nodes per read request)\n",
+                     name.c_str(), group.c_str(),
+                     static_cast<unsigned long>(snapshot->group.size()), reader.maxRequests());
+    if (debug >= 5)
+        std::cout << "Session " << name
+                  << ": (readSnapshot) snapshot group " << group
+                  << " (" << snapshot->group.size() << " nodes)"
+                  << std::endl;
+    reader.pushRequest(snapshot, priority);
+    return static_cast<unsigned int>(snapshot->group.size());
+}
+
+void
+SessionOpen62541::snapshotDone (const std::vector<std::shared_ptr<ReadRequest>> &group)
+{
+    Guard G(opslock);
+    snapshotsPending.erase(group.front()->item->linkinfo.snapshotGroup);
+}
+
 // Low level reader function called by the RequestQueueBatcher
 void
 SessionOpen62541::processRequests (std::vector<std::shared_ptr<ReadRequest>> &batch)
 {
-    if (!isConnected())
+    if (!isConnected()) {
+        for (auto &c : batch)
+            if (!c->item)
+                snapshotDone(c->group);
         return;
+    }
+
+    // Each snapshot group goes into a service call of its own
+    // Other reads are split, so that the (estimated) response fits the message size
+    size_t usable = usableMessageSize();
+    std::vector<std::shared_ptr<ReadRequest>> part;
+    size_t size = 0;
+    for (auto &c : batch) {
+        if (!c->item) {
+            sendReadRequest(c->group, true);
+            continue;
+        }
+        if (!usable) {
+            part.push_back(c);
+            continue;
+        }
+        size_t itemSize = c->item->getReadSize() + readValueOverhead;
+        if (part.size() && size + itemSize > usable) {
+            sendReadRequest(part);
+            part.clear();
+            size = 0;
+            splitRequests++;
+        }
+        part.push_back(c);
+        size += itemSize;
+    }
+    if (part.size())
+        sendReadRequest(part);
+}
 
+void
+SessionOpen62541::sendReadRequest (std::vector<std::shared_ptr<ReadRequest>> &batch, const bool snapshot)
+{
     UA_StatusCode status;
-    std::unique_ptr<std::vector<ItemOpen62541 *>> itemsToRead(new std::vector<ItemOpen62541 *>);
+    OutstandingItems itemsToRead(new std::vector<ItemOpen62541 *>);
     UA_UInt32 id = getTransactionId();
+    epicsTime sent;
     UA_ReadRequest request;
 
     UA_ReadRequest_init(&request);
@@ -597,13 +984,20 @@ SessionOpen62541::processRequests (std::vector<std::shared_ptr<ReadRequest>> &ba
     for (auto c : batch) {
         UA_NodeId_copy(&c->item->getNodeId(), &request.nodesToRead[i].nodeId);
         request.nodesToRead[i].attributeId = UA_ATTRIBUTEID_VALUE;
+        c->item->addReference();
         itemsToRead->push_back(c->item);
         i++;
     }
 
     {
         Guard G(clientlock);
-        if (!isConnected()) return; // may have disconnected while we waited
+        if (!isConnected()) { // may have disconnected while we waited
+            UA_ReadRequest_clear(&request);
+            if (snapshot)
+                snapshotDone(batch);
+            return;
+        }
+        sent = epicsTime::getCurrent();
         status=UA_Client_sendAsyncReadRequest(client, &request,
             [] (UA_Client *client,
                 void *userdata,
@@ -617,35 +1011,72 @@ SessionOpen62541::processRequests (std::vector<std::shared_ptr<ReadRequest>> &ba
     }
     UA_ReadRequest_clear(&request);
     if (UA_STATUS_IS_BAD(status)) {
-        errlogPrintf(
-            "OPC UA session %s: (requestRead) beginRead service failed with status %s\n",
-            name.c_str(),
-            UA_StatusCode_name(status));
+        if (reportError(ErrorClass::readService, this, "OPC UA session " + name))
+            errlogPrintf(
+                "OPC UA session %s: (requestRead) beginRead service failed with status %s\n",
+                name.c_str(),
+                UA_StatusCode_name(status));
         // Create readFailure events for all items of the batch
         for (auto c : batch) {
-            c->item->setIncomingEvent(ProcessReason::readFailure);
+            deliverEvent(c->item, ProcessReason::readFailure);
         }
+        if (snapshot)
+            snapshotDone(batch);
     } else {
         if (debug >= 5)
             std::cout << "Session " << name
                       << ": (requestRead) beginRead service ok"
                       << " (transaction id " << id
                       << "; retrieving " << itemsToRead->size()
-                      << " nodes)"
+                      << " nodes" << (snapshot ? ", snapshot" : "") << ")"
                       << std::endl;
         Guard G(opslock);
-        outstandingOps.insert(
-            std::pair<UA_UInt32,
-                std::unique_ptr<std::vector<ItemOpen62541 *>>>(id, std::move(itemsToRead)));
+        if (snapshot)
+            snapshotOps.insert(id);
+        outstandingOps.insert(std::pair<UA_UInt32, OutstandingOp>(id, OutstandingOp{std::move(itemsToRead), sent}));
     }
 }
 
 void
 SessionOpen62541::requestWrite (ItemOpen62541 &item)
 {
-    auto cargo = std::make_shared<WriteRequest>();
-    cargo->item = &item;
-    item.copyAndClearOutgoingData(cargo->wvalue);
+    auto cargo = std::make_shared<WriteRequest>(&item);
+    bool send = item.copyAndClearOutgoingData(cargo->wvalue);
+    if (!send) {
+        // Write suppressed (unchanged value): complete without using the network
+        deliverEvent(&item, ProcessReason::writeComplete);
+        deliverState(&item, ConnectionStatus::up);
+        if (!item.linkinfo.groupTrigger)
+            return;
+    }
+
+    if (item.linkinfo.writeGroup.length()) {
+        // Hold the write until the group trigger is written
+        Guard G(writeGroupsLock);
+        auto &held = writeGroups[item.linkinfo.writeGroup].held;
+        if (send)
+            held.push_back(cargo);
+        if (!item.linkinfo.groupTrigger || held.empty())
+            return;
+
+        // The group is pushed as a single cargo, so that the batcher does not split it
+        auto group = std::make_shared<WriteRequest>();
+        group->group.swap(held);
+        if (writer.maxRequests() && group->group.size() > writer.maxRequests())
+            errlogPrintf("OPC UA session %s: write group %s has %lu nodes "
+                         "(more than the limit of %u nodes per write request)\n",
+                         name.c_str(), item.linkinfo.writeGroup.c_str(),
+                         static_cast<unsigned long>(group->group.size()), writer.maxRequests());
+        if (debug >= 5)
+            std::cout << "Session " << name
+                      << ": (requestWrite) write group " << item.linkinfo.writeGroup
+                      << " triggered by item " << &item
+                      << " (" << group->group.size() << " nodes)"
+                      << std::endl;
+        writer.pushRequest(group, item.recConnector->getRecordPriority());
+        return;
+    }
+
     writer.pushRequest(cargo, item.recConnector->getRecordPriority());
 }
 
@@ -656,9 +1087,40 @@ SessionOpen62541::processRequests (std::vector<std::shared_ptr<WriteRequest>> &b
     if (!isConnected())
         return;
 
+    // Each write group goes into a service call of its own
+    // Other writes are split, so that the encoded request fits the message size
+    size_t usable = usableMessageSize();
+    std::vector<std::shared_ptr<WriteRequest>> part;
+    size_t size = 0;
+    for (auto &c : batch) {
+        if (!c->item) {
+            sendWriteRequest(c->group);
+            continue;
+        }
+        if (usable) {
+            size_t itemSize = UA_calcSizeBinary(&c->wvalue, &UA_TYPES[UA_TYPES_WRITEVALUE])
+                    + UA_calcSizeBinary(&c->item->getNodeId(), &UA_TYPES[UA_TYPES_NODEID]);
+            if (part.size() && size + itemSize > usable) {
+                sendWriteRequest(part);
+                part.clear();
+                size = 0;
+                splitRequests++;
+            }
+            size += itemSize;
+        }
+        part.push_back(c);
+    }
+    if (part.size())
+        sendWriteRequest(part);
+}
+
+void
+SessionOpen62541::sendWriteRequest (std::vector<std::shared_ptr<WriteRequest>> &batch)
+{
     UA_StatusCode status;
-    std::unique_ptr<std::vector<ItemOpen62541 *>> itemsToWrite(new std::vector<ItemOpen62541 *>);
+    OutstandingItems itemsToWrite(new std::vector<ItemOpen62541 *>);
     UA_UInt32 id = getTransactionId();
+    epicsTime sent;
     UA_WriteRequest request;
 
     UA_WriteRequest_init(&request);
@@ -671,6 +1133,7 @@ SessionOpen62541::processRequests (std::vector<std::shared_ptr<WriteRequest>> &b
         request.nodesToWrite[i].attributeId = UA_ATTRIBUTEID_VALUE;
         request.nodesToWrite[i].value.hasValue = true;
         request.nodesToWrite[i].value.value = c->wvalue.value.value;
+        c->item->addReference();
         itemsToWrite->push_back(c->item);
         i++;
     }
@@ -678,6 +1141,7 @@ SessionOpen62541::processRequests (std::vector<std::shared_ptr<WriteRequest>> &b
     {
         Guard G(clientlock);
         if (!isConnected()) return; // may have disconnected while we waited
+        sent = epicsTime::getCurrent();
         status=UA_Client_sendAsyncWriteRequest(client, &request,
             [] (UA_Client *client,
                 void *userdata,
@@ -689,13 +1153,19 @@ SessionOpen62541::processRequests (std::vector<std::shared_ptr<WriteRequest>> &b
             this, &id);
     }
 
+    // The request has been encoded: hand the value buffers back to the items for reuse
+    i = 0;
+    for (auto c : batch)
+        c->item->recycleOutgoingData(request.nodesToWrite[i++].value.value);
     UA_WriteRequest_clear(&request);
     if (UA_STATUS_IS_BAD(status)) {
-        errlogPrintf("OPC UA session %s: (requestWrite) beginWrite service failed with status %s\n",
-                     name.c_str(), UA_StatusCode_name(status));
+        if (reportError(ErrorClass::writeService, this, "OPC UA session " + name))
+            errlogPrintf("OPC UA session %s: (requestWrite) beginWrite service failed with status %s\n",
+                         name.c_str(), UA_StatusCode_name(status));
         // Create writeFailure events for all items of the batch
         for (auto c : batch) {
-            c->item->setIncomingEvent(ProcessReason::writeFailure);
+            c->item->confirmWrite(false);
+            deliverEvent(c->item, ProcessReason::writeFailure);
         }
     } else {
         if (debug >= 5)
@@ -706,75 +1176,538 @@ SessionOpen62541::processRequests (std::vector<std::shared_ptr<WriteRequest>> &b
                       << " nodes)"
                       << std::endl;
         Guard G(opslock);
-        outstandingOps.insert(std::pair<UA_UInt32,
-            std::unique_ptr<std::vector<ItemOpen62541 *>>>(id, std::move(itemsToWrite)));
+        outstandingOps.insert(std::pair<UA_UInt32, OutstandingOp>(id, OutstandingOp{std::move(itemsToWrite), sent}));
     }
 }
 
 void
 SessionOpen62541::createAllSubscriptions ()
 {
-    for (auto &it : subscriptions) {
-        it.second->create();
-    }
+    for (auto &it : subscriptions)
+        for (auto &sub : it.second->serverSubscriptions())
+            sub->create();
 }
 
 void
-SessionOpen62541::addAllMonitoredItems ()
+SessionOpen62541::addAllMonitoredItems (const std::vector<ItemOpen62541 *> &list)
 {
-    for (auto &it : subscriptions) {
-        it.second->addMonitoredItems();
-    }
+    for (auto &it : subscriptions)
+        for (auto &sub : it.second->serverSubscriptions())
+            sub->addMonitoredItems(list);
 }
 
 void
-SessionOpen62541::registerNodes ()
+SessionOpen62541::registerNodes (const std::vector<ItemOpen62541 *> &list)
 {
+    std::vector<ItemOpen62541 *> todo;
+    for (auto &it : list) {
+        if (it->linkinfo.registerNode) {
+            it->show(0);
+            todo.push_back(it);
+        }
+    }
+    if (todo.empty())
+        return;
+
     UA_RegisterNodesRequest request;
     UA_RegisterNodesRequest_init(&request);
+    request.nodesToRegister = static_cast<UA_NodeId*>(UA_Array_new(todo.size(), &UA_TYPES[UA_TYPES_NODEID]));
+    request.nodesToRegisterSize = todo.size();
+    for (size_t i = 0; i < todo.size(); i++)
+        UA_NodeId_copy(&todo[i]->getNodeId(), &request.nodesToRegister[i]);
+
+    UA_RegisterNodesResponse response = UA_Client_Service_registerNodes(client, request);
+    if (UA_STATUS_IS_BAD(response.responseHeader.serviceResult)) {
+        errlogPrintf("OPC UA session %s: (registerNodes) registerNodes service failed with status %s\n",
+                     name.c_str(), UA_StatusCode_name(response.responseHeader.serviceResult));
+    } else {
+        if (debug)
+            std::cout << "Session " << name
+                      << ": (registerNodes) registerNodes service ok"
+                      << " (" << response.registeredNodeIdsSize
+                      << " nodes registered)"
+                      << std::endl;
+        for (size_t i = 0; i < todo.size() && i < response.registeredNodeIdsSize; i++) {
+            todo[i]->setRegisteredNodeId(response.registeredNodeIds[i]);
+            registeredItemsNo++;
+        }
+    }
+    UA_RegisterNodesResponse_clear(&response);
+    UA_RegisterNodesRequest_clear(&request);
+}
 
-    request.nodesToRegister = static_cast<UA_NodeId*>(UA_Array_new(items.size(), &UA_TYPES[UA_TYPES_NODEID]));
-    UA_UInt32 i = 0;
-    for (auto &it : items) {
-        if (it->linkinfo.registerNode) {
-            it->show(0);
-            UA_NodeId_copy(&it->getNodeId(), &request.nodesToRegister[i]);
-            i++;
+void
+SessionOpen62541::unregisterNodes (const std::vector<ItemOpen62541 *> &list)
+{
+    std::vector<ItemOpen62541 *> todo;
+    for (auto &it : list)
+        if (it->isRegistered())
+            todo.push_back(it);
+    if (todo.empty())
+        return;
+
+    UA_UnregisterNodesRequest request;
+    UA_UnregisterNodesRequest_init(&request);
+    request.nodesToUnregister = static_cast<UA_NodeId*>(UA_Array_new(todo.size(), &UA_TYPES[UA_TYPES_NODEID]));
+    request.nodesToUnregisterSize = todo.size();
+    for (size_t i = 0; i < todo.size(); i++)
+        UA_NodeId_copy(&todo[i]->getNodeId(), &request.nodesToUnregister[i]);
+
+    UA_UnregisterNodesResponse response = UA_Client_Service_unregisterNodes(client, request);
+    if (UA_STATUS_IS_BAD(response.responseHeader.serviceResult)) {
+        errlogPrintf("OPC UA session %s: (unregisterNodes) unregisterNodes service failed with status %s\n",
+                     name.c_str(), UA_StatusCode_name(response.responseHeader.serviceResult));
+    } else if (debug) {
+        std::cout << "Session " << name
+                  << ": (unregisterNodes) unregisterNodes service ok"
+                  << " (" << todo.size()
+                  << " nodes unregistered)"
+                  << std::endl;
+    }
+    // The registered ids are invalid from now on, whatever the server answered
+    registeredItemsNo -= std::min<UA_UInt32>(registeredItemsNo, static_cast<UA_UInt32>(todo.size()));
+    UA_UnregisterNodesResponse_clear(&response);
+    UA_UnregisterNodesRequest_clear(&request);
+}
+
+void
+SessionOpen62541::rebuildNodeIds (const std::vector<ItemOpen62541 *> &list)
+{
+    for (auto &it : list)
+        it->rebuildNodeId();
+}
+
+void
+SessionOpen62541::requestInitialRead (const std::vector<ItemOpen62541 *> &list)
+{
+    if (list.empty())
+        return;
+    if (debug) {
+        std::cout << "Session " << name
+                  << ": triggering initial read for "
+                  << list.size() << " items"
+                  << std::endl;
+    }
+    std::vector<std::shared_ptr<ReadRequest>> cargo;
+    cargo.reserve(list.size());
+    for (auto it : list) {
+        // The value would be ignored: writes only need the type
+        if (it->recConnector->bini() == LinkOptionBini::ignore
+                && it->linkinfo.isOutput
+                && !it->linkinfo.isItemRecord
+                && !it->isMonitored()
+                && it->hasWriteType()) {
+            it->setLastStatus(UA_STATUSCODE_GOOD);
+            deliverState(it, ConnectionStatus::up);
+            continue;
+        }
+        deliverState(it, ConnectionStatus::initialRead);
+        cargo.push_back(std::make_shared<ReadRequest>(it));
+    }
+    if (debug && cargo.size() < list.size())
+        std::cout << "Session " << name
+                  << ": skipped initial read for "
+                  << list.size() - cargo.size() << " output items (bini=ignore)"
+                  << std::endl;
+    if (cargo.size())
+        reader.pushRequest(cargo, menuPriorityHIGH);
+}
+
+void
+SessionOpen62541::applyItemChanges ()
+{
+    std::vector<ItemOpen62541 *> added;
+    std::vector<ItemOpen62541 *> removed;
+    {
+        Guard G(itemsLock);
+        if (pendingAdd.empty() && pendingRemove.empty())
+            return;
+        added = pendingAdd.vector();
+        pendingAdd.clear();
+        removed = pendingRemove.vector();
+        // keep the removed items while they are cleaned up
+        for (auto it : removed)
+            it->addReference();
+    }
+
+    if (removed.size()) {
+        for (auto &it : subscriptions)
+            for (auto &sub : it.second->serverSubscriptions())
+                sub->removeMonitoredItems(removed);
+        unregisterNodes(removed);
+        {
+            Guard G(itemsLock);
+            for (auto it : removed)
+                if (pendingRemove.erase(it))
+                    it->releaseReference();
         }
+        for (auto it : removed)
+            it->releaseReference();
     }
-    registeredItemsNo = i;
-    request.nodesToRegisterSize = registeredItemsNo;
 
-    if (registeredItemsNo) {
-        UA_RegisterNodesResponse response = UA_Client_Service_registerNodes(client, request);
+    if (added.size()) {
+        rebuildNodeIds(added);
+        registerNodes(added);
+        readMetadata(added);
+        readNodeTypes(added);
+        // rate groups of auto subscriptions may have been added at runtime
+        for (auto &it : subscriptions)
+            for (auto &sub : it.second->serverSubscriptions())
+                if (!sub->getSubscriptionId())
+                    sub->create();
+        addAllMonitoredItems(added);
+        requestInitialRead(added);
+    }
+
+    if (debug)
+        std::cout << "Session " << name
+                  << ": (applyItemChanges) added " << added.size()
+                  << " items, removed " << removed.size() << " items"
+                  << std::endl;
+}
+
+// Node properties that are imported by the meta=y link option
+static const char *metadataProperties[] = { "EURange", "EngineeringUnits", "EnumStrings", "EnumValues" };
+static const size_t metadataPropertiesNo = sizeof(metadataProperties) / sizeof(metadataProperties[0]);
+
+// Access the content of a scalar variant, unwrapping a decoded ExtensionObject
+static const void *
+metadataScalar (const UA_Variant &value, const UA_DataType *type)
+{
+    if (UA_Variant_hasScalarType(&value, type))
+        return value.data;
+    if (UA_Variant_hasScalarType(&value, &UA_TYPES[UA_TYPES_EXTENSIONOBJECT])) {
+        auto eo = static_cast<const UA_ExtensionObject *>(value.data);
+        if (eo->encoding >= UA_EXTENSIONOBJECT_DECODED && eo->content.decoded.type == type)
+            return eo->content.decoded.data;
+    }
+    return nullptr;
+}
+
+static std::string
+metadataString (const UA_LocalizedText &text)
+{
+    return std::string(reinterpret_cast<const char*>(text.text.data), text.text.length);
+}
+
+// Key of the metadata cache: the node id on the server (shared by all items of a node)
+static std::string
+metadataKey (const ItemOpen62541 *item)
+{
+    std::ostringstream key;
+    key << item->getNodeId();
+    return key.str();
+}
+
+// Store a read property (index into metadataProperties, or -1 for the Description attribute)
+static void
+storeMetadata (ItemMetadata &meta, const int property, const UA_Variant &value)
+{
+    switch (property) {
+    case -1:
+        if (UA_Variant_hasScalarType(&value, &UA_TYPES[UA_TYPES_LOCALIZEDTEXT])) {
+            meta.description = metadataString(*static_cast<const UA_LocalizedText *>(value.data));
+            meta.hasDescription = true;
+        }
+        break;
+    case 0:
+        if (auto range = static_cast<const UA_Range *>(metadataScalar(value, &UA_TYPES[UA_TYPES_RANGE]))) {
+            meta.rangeLow = range->low;
+            meta.rangeHigh = range->high;
+            meta.hasRange = true;
+        }
+        break;
+    case 1:
+        if (auto eu = static_cast<const UA_EUInformation *>(metadataScalar(value, &UA_TYPES[UA_TYPES_EUINFORMATION]))) {
+            meta.units = metadataString(eu->displayName);
+            meta.hasUnits = true;
+        }
+        break;
+    case 2:
+        if (!UA_Variant_isScalar(&value) && value.type == &UA_TYPES[UA_TYPES_LOCALIZEDTEXT]) {
+            auto texts = static_cast<const UA_LocalizedText *>(value.data);
+            meta.enumChoices.clear();
+            for (size_t i = 0; i < value.arrayLength; i++)
+                meta.enumChoices.emplace_back(static_cast<epicsInt64>(i), metadataString(texts[i]));
+        }
+        break;
+    case 3:
+        if (!UA_Variant_isScalar(&value) && value.type == &UA_TYPES[UA_TYPES_ENUMVALUETYPE]) {
+            auto values = static_cast<const UA_EnumValueType *>(value.data);
+            meta.enumChoices.clear();
+            for (size_t i = 0; i < value.arrayLength; i++)
+                meta.enumChoices.emplace_back(values[i].value, metadataString(values[i].displayName));
+        } else if (!UA_Variant_isScalar(&value) && value.type == &UA_TYPES[UA_TYPES_EXTENSIONOBJECT]) {
+            auto eos = static_cast<const UA_ExtensionObject *>(value.data);
+            meta.enumChoices.clear();
+            for (size_t i = 0; i < value.arrayLength; i++) {
+                if (eos[i].encoding >= UA_EXTENSIONOBJECT_DECODED
+                        && eos[i].content.decoded.type == &UA_TYPES[UA_TYPES_ENUMVALUETYPE]) {
+                    auto ev = static_cast<const UA_EnumValueType *>(eos[i].content.decoded.data);
+                    meta.enumChoices.emplace_back(ev->value, metadataString(ev->displayName));
+                }
+            }
+        }
+        break;
+    }
+}
+
+void
+SessionOpen62541::readMetadata (const std::vector<ItemOpen62541 *> &list)
+{
+    std::vector<ItemOpen62541 *> todo;
+
+    for (auto &it : list) {
+        if (!it->linkinfo.meta)
+            continue;
+        auto cached = metadataCache.find(metadataKey(it));
+        if (cached != metadataCache.end())
+            it->recConnector->applyMetadata(cached->second);
+        else
+            todo.push_back(it);
+    }
+    if (todo.empty())
+        return;
+
+    // Up to (metadataPropertiesNo + 1) nodes per item are read: stay within the read limit
+    size_t chunk = todo.size();
+    if (reader.maxRequests())
+        chunk = std::max<size_t>(1, reader.maxRequests() / (metadataPropertiesNo + 1));
+
+    for (size_t first = 0; first < todo.size(); first += chunk) {
+        const size_t n = std::min(chunk, todo.size() - first);
+
+        UA_TranslateBrowsePathsToNodeIdsRequest tRequest;
+        UA_TranslateBrowsePathsToNodeIdsRequest_init(&tRequest);
+        tRequest.browsePathsSize = n * metadataPropertiesNo;
+        tRequest.browsePaths = static_cast<UA_BrowsePath*>(
+            UA_Array_new(tRequest.browsePathsSize, &UA_TYPES[UA_TYPES_BROWSEPATH]));
+        for (size_t i = 0; i < n; i++) {
+            for (size_t j = 0; j < metadataPropertiesNo; j++) {
+                UA_BrowsePath &path = tRequest.browsePaths[i * metadataPropertiesNo + j];
+                UA_NodeId_copy(&todo[first + i]->getNodeId(), &path.startingNode);
+                path.relativePath.elementsSize = 1;
+                path.relativePath.elements = UA_RelativePathElement_new();
+                path.relativePath.elements->referenceTypeId = UA_NODEID_NUMERIC(0, UA_NS0ID_HASPROPERTY);
+                path.relativePath.elements->includeSubtypes = true;
+                path.relativePath.elements->targetName = UA_QUALIFIEDNAME_ALLOC(0, metadataProperties[j]);
+            }
+        }
+        UA_TranslateBrowsePathsToNodeIdsResponse tResponse
+            = UA_Client_Service_translateBrowsePathsToNodeIds(client, tRequest);
+        UA_TranslateBrowsePathsToNodeIdsRequest_clear(&tRequest);
+        if (UA_STATUS_IS_BAD(tResponse.responseHeader.serviceResult)) {
+            errlogPrintf("OPC UA session %s: (readMetadata) translateBrowsePathsToNodeIds service failed with status %s\n",
+                         name.c_str(), UA_StatusCode_name(tResponse.responseHeader.serviceResult));
+            UA_TranslateBrowsePathsToNodeIdsResponse_clear(&tResponse);
+            continue;
+        }
+
+        // Read the Description attribute of all items and all properties that were found
+        UA_ReadRequest request;
+        UA_ReadRequest_init(&request);
+        request.timestampsToReturn = UA_TIMESTAMPSTORETURN_NEITHER;
+        request.nodesToRead = static_cast<UA_ReadValueId*>(
+            UA_Array_new(n * (metadataPropertiesNo + 1), &UA_TYPES[UA_TYPES_READVALUEID]));
+        std::vector<std::pair<size_t, int>> slots;   // (item index, property index or -1)
+        for (size_t i = 0; i < n; i++) {
+            UA_ReadValueId &desc = request.nodesToRead[request.nodesToReadSize++];
+            UA_NodeId_copy(&todo[first + i]->getNodeId(), &desc.nodeId);
+            desc.attributeId = UA_ATTRIBUTEID_DESCRIPTION;
+            slots.emplace_back(i, -1);
+            for (size_t j = 0; j < metadataPropertiesNo; j++) {
+                const size_t k = i * metadataPropertiesNo + j;
+                if (k >= tResponse.resultsSize
+                        || UA_STATUS_IS_BAD(tResponse.results[k].statusCode)
+                        || !tResponse.results[k].targetsSize)
+                    continue;
+                UA_ReadValueId &prop = request.nodesToRead[request.nodesToReadSize++];
+                UA_NodeId_copy(&tResponse.results[k].targets[0].targetId.nodeId, &prop.nodeId);
+                prop.attributeId = UA_ATTRIBUTEID_VALUE;
+                slots.emplace_back(i, static_cast<int>(j));
+            }
+        }
+        UA_TranslateBrowsePathsToNodeIdsResponse_clear(&tResponse);
+
+        UA_ReadResponse response = UA_Client_Service_read(client, request);
+        UA_ReadRequest_clear(&request);
         if (UA_STATUS_IS_BAD(response.responseHeader.serviceResult)) {
-            errlogPrintf("OPC UA session %s: (registerNodes) registerNodes service failed with status %s\n",
+            errlogPrintf("OPC UA session %s: (readMetadata) read service failed with status %s\n",
                          name.c_str(), UA_StatusCode_name(response.responseHeader.serviceResult));
         } else {
+            for (size_t k = 0; k < slots.size() && k < response.resultsSize; k++) {
+                const UA_DataValue &dv = response.results[k];
+                if (dv.hasValue && !(dv.hasStatus && UA_STATUS_IS_BAD(dv.status)))
+                    storeMetadata(metadataCache[metadataKey(todo[first + slots[k].first])], slots[k].second, dv.value);
+            }
+            for (size_t i = 0; i < n; i++) {
+                ItemOpen62541 *item = todo[first + i];
+                item->recConnector->applyMetadata(metadataCache[metadataKey(item)]);
+            }
             if (debug)
                 std::cout << "Session " << name
-                          << ": (registerNodes) registerNodes service ok"
-                          << " (" << response.registeredNodeIdsSize
-                          << " nodes registered)"
+                          << ": (readMetadata) imported metadata for " << n << " items"
+                          << " (" << slots.size() << " nodes read)"
                           << std::endl;
-            i = 0;
-            for (auto &it : items) {
-                if (it->linkinfo.registerNode) {
-                    it->setRegisteredNodeId(response.registeredNodeIds[i]);
-                    i++;
+        }
+        UA_ReadResponse_clear(&response);
+    }
+}
+
+// Node attributes that are read to set up the write encoding
+static const UA_UInt32 nodeTypeAttributes[] = { UA_ATTRIBUTEID_DATATYPE,
+                                                UA_ATTRIBUTEID_VALUERANK,
+                                                UA_ATTRIBUTEID_ARRAYDIMENSIONS };
+static const size_t nodeTypeAttributesNo = sizeof(nodeTypeAttributes) / sizeof(nodeTypeAttributes[0]);
+
+// Resolve a DataType attribute to the type used for encoding writes.
+// Known subtypes of builtin types (e.g. Duration) resolve to their builtin type,
+// enumerations are written as Int32; structures are not resolved.
+static const UA_DataType *
+writeTypeOf (const UA_NodeId &dataTypeId, const UA_DataTypeArray *customTypes)
+{
+    const UA_DataType *type = UA_findDataType(&dataTypeId);
+    for (; !type && customTypes; customTypes = customTypes->next) {
+        for (size_t i = 0; i < customTypes->typesSize; i++) {
+            if (UA_NodeId_equal(&customTypes->types[i].typeId, &dataTypeId)) {
+                type = &customTypes->types[i];
+                break;
+            }
+        }
+    }
+    if (!type)
+        return nullptr;
+    if (type->typeKind <= UA_DATATYPEKIND_DIAGNOSTICINFO)
+        return &UA_TYPES[type->typeKind];
+    if (type->typeKind == UA_DATATYPEKIND_ENUM)
+        return &UA_TYPES[UA_TYPES_INT32];
+    return nullptr;
+}
+
+void
+SessionOpen62541::readNodeTypes (const std::vector<ItemOpen62541 *> &list)
+{
+    std::vector<ItemOpen62541 *> todo;
+
+    for (auto &it : list) {
+        if (!(it->linkinfo.isOutput || it->linkinfo.isItemRecord))
+            continue;
+        if (it->hasNodeType())
+            it->applyNodeType();
+        else
+            todo.push_back(it);
+    }
+    if (todo.empty())
+        return;
+
+    size_t chunk = todo.size();
+    if (reader.maxRequests())
+        chunk = std::max<size_t>(1, reader.maxRequests() / nodeTypeAttributesNo);
+
+    const UA_DataTypeArray *customTypes = UA_Client_getConfig(client)->customDataTypes;
+    size_t resolved = 0;
+    for (size_t first = 0; first < todo.size(); first += chunk) {
+        const size_t n = std::min(chunk, todo.size() - first);
+
+        UA_ReadRequest request;
+        UA_ReadRequest_init(&request);
+        request.timestampsToReturn = UA_TIMESTAMPSTORETURN_NEITHER;
+        request.nodesToReadSize = n * nodeTypeAttributesNo;
+        request.nodesToRead = static_cast<UA_ReadValueId*>(
+            UA_Array_new(request.nodesToReadSize, &UA_TYPES[UA_TYPES_READVALUEID]));
+        for (size_t i = 0; i < n; i++) {
+            for (size_t j = 0; j < nodeTypeAttributesNo; j++) {
+                UA_ReadValueId &rvi = request.nodesToRead[i * nodeTypeAttributesNo + j];
+                UA_NodeId_copy(&todo[first + i]->getNodeId(), &rvi.nodeId);
+                rvi.attributeId = nodeTypeAttributes[j];
+            }
+        }
+
+        UA_ReadResponse response = UA_Client_Service_read(client, request);
+        UA_ReadRequest_clear(&request);
+        if (UA_STATUS_IS_BAD(response.responseHeader.serviceResult)) {
+            errlogPrintf("OPC UA session %s: (readNodeTypes) read service failed with status %s\n",
+                         name.c_str(), UA_StatusCode_name(response.responseHeader.serviceResult));
+        } else {
+            for (size_t i = 0; i < n && (i + 1) * nodeTypeAttributesNo <= response.resultsSize; i++) {
+                const UA_DataValue *dv = &response.results[i * nodeTypeAttributesNo];
+                // Without a DataType (e.g. unknown node), the initial read has to tell
+                if (!dv[0].hasValue || (dv[0].hasStatus && UA_STATUS_IS_BAD(dv[0].status))
+                        || !UA_Variant_hasScalarType(&dv[0].value, &UA_TYPES[UA_TYPES_NODEID]))
+                    continue;
+                const UA_DataType *type = writeTypeOf(*static_cast<UA_NodeId *>(dv[0].value.data),
+                                                      customTypes);
+                UA_Int32 valueRank = UA_VALUERANK_ANY;
+                if (dv[1].hasValue && UA_Variant_hasScalarType(&dv[1].value, &UA_TYPES[UA_TYPES_INT32]))
+                    valueRank = *static_cast<UA_Int32 *>(dv[1].value.data);
+                std::vector<UA_UInt32> arrayDimensions;
+                if (dv[2].hasValue && UA_Variant_hasArrayType(&dv[2].value, &UA_TYPES[UA_TYPES_UINT32])) {
+                    const UA_UInt32 *dims = static_cast<UA_UInt32 *>(dv[2].value.data);
+                    arrayDimensions.assign(dims, dims + dv[2].value.arrayLength);
                 }
+                todo[first + i]->setNodeType(type, valueRank, arrayDimensions);
+                if (type)
+                    resolved++;
             }
-            registeredItemsNo = i;
         }
+        UA_ReadResponse_clear(&response);
     }
-    UA_RegisterNodesRequest_clear(&request);
+    if (debug)
+        std::cout << "Session " << name
+                  << ": (readNodeTypes) read node types of " << todo.size() << " items"
+                  << " (" << resolved << " with write type)"
+                  << std::endl;
 }
 
 void
-SessionOpen62541::rebuildNodeIds ()
+SessionOpen62541::readSubscriptionDiagnostics ()
 {
-    for (auto &it : items)
-        it->rebuildNodeId();
+    const epicsTime now = epicsTime::getCurrent();
+    std::vector<SubscriptionOpen62541 *> due;
+    for (auto &it : subscriptions)
+        for (auto &sub : it.second->serverSubscriptions())
+            if (sub->diagnosticsDue(now))
+                due.push_back(sub);
+    if (due.empty())
+        return;
+
+    UA_ReadValueId rvi;
+    UA_ReadValueId_init(&rvi);
+    rvi.nodeId = UA_NODEID_NUMERIC(0, UA_NS0ID_SERVER_SERVERDIAGNOSTICS_SUBSCRIPTIONDIAGNOSTICSARRAY);
+    rvi.attributeId = UA_ATTRIBUTEID_VALUE;
+    UA_ReadRequest request;
+    UA_ReadRequest_init(&request);
+    request.timestampsToReturn = UA_TIMESTAMPSTORETURN_NEITHER;
+    request.nodesToRead = &rvi;
+    request.nodesToReadSize = 1;
+
+    UA_ReadResponse response = UA_Client_Service_read(client, request);
+    UA_StatusCode status = response.responseHeader.serviceResult;
+    std::map<UA_UInt32, SubscriptionCounters> counters;
+    if (!UA_STATUS_IS_BAD(status)) {
+        if (response.resultsSize != 1)
+            status = UA_STATUSCODE_BADUNEXPECTEDERROR;
+        else if (response.results[0].hasStatus)
+            status = response.results[0].status;
+    }
+    if (!UA_STATUS_IS_BAD(status))
+        decodeSubscriptionDiagnostics(response.results[0].value, counters);
+    UA_ReadResponse_clear(&response);
+
+    for (auto &it : due) {
+        auto found = counters.find(it->getSubscriptionId());
+        if (UA_STATUS_IS_BAD(status))
+            it->setServerDiagnostics(status, nullptr);
+        else if (found == counters.end())
+            it->setServerDiagnostics(UA_STATUSCODE_BADNOTFOUND, nullptr);
+        else
+            it->setServerDiagnostics(UA_STATUSCODE_GOOD, &found->second);
+    }
+    if (debug >= 3)
+        std::cout << "Session " << name
+                  << ": (readSubscriptionDiagnostics) " << counters.size() << " subscriptions on the server, "
+                  << due.size() << " due (" << UA_StatusCode_name(status) << ")"
+                  << std::endl;
 }
 
 /* Add a mapping to the session's map, replacing any existing mappings with the same
@@ -834,6 +1767,8 @@ SessionOpen62541::showSecurity ()
     UA_Client* discovery = UA_Client_new();
     UA_ClientConfig *config = UA_Client_getConfig(discovery);
     UA_ClientConfig_setDefault(config);
+    if (isUnixTransportUrl(serverURL))
+        setUnixTransport(config);
 
     status = UA_Client_findServers(discovery, serverURL.c_str(),
         0, NULL, 0, NULL,
@@ -874,7 +1809,7 @@ SessionOpen62541::showSecurity ()
             else
                 std::cout << "Anonymous";
 
-            if (serverURL.compare(0, 7, "opc.tcp") == 0) {
+            if (serverURL.compare(0, 7, "opc.tcp") == 0 || isUnixTransportUrl(serverURL)) {
                 UA_EndpointDescription* endpointDescriptions;
                 size_t endpointDescriptionsLength;
                 status = UA_Client_getEndpoints(discovery, serverURL.c_str(),
@@ -889,8 +1824,9 @@ SessionOpen62541::showSecurity ()
                 }
 
                 for (size_t k = 0; k < endpointDescriptionsLength; k++) {
-                    if (std::string(reinterpret_cast<const char*>(endpointDescriptions[k].endpointUrl.data),
-                        endpointDescriptions[k].endpointUrl.length).compare(0, 7, "opc.tcp") == 0) {
+                    std::string endpointUrl(reinterpret_cast<const char*>(endpointDescriptions[k].endpointUrl.data),
+                                            endpointDescriptions[k].endpointUrl.length);
+                    if (endpointUrl.compare(0, 7, "opc.tcp") == 0 || isUnixTransportUrl(endpointUrl)) {
                         char dash = '-';
                         std::string marker;
                         if (isConnected()
@@ -962,21 +1898,21 @@ SessionOpen62541::setupSecurity ()
 #ifdef HAS_SECURITY
     } else {
         setupIdentity();
-        if (std::string(serverURL).compare(0, 7, "opc.tcp") == 0) {
+        if (connectURL.compare(0, 7, "opc.tcp") == 0 || isUnixTransportUrl(connectURL)) {
             UA_ClientConfig *config = UA_Client_getConfig(client);
             UA_EndpointDescription* endpointDescriptions;
             size_t endpointDescriptionsLength;
             if (debug)
                 std::cout << "Session " << name
-                          << ": (setupSecurity) reading endpoints from " << serverURL
+                          << ": (setupSecurity) reading endpoints from " << connectURL
                           << std::endl;
 
-            connectStatus = UA_Client_getEndpoints(client, serverURL.c_str(),
+            connectStatus = UA_Client_getEndpoints(client, connectURL.c_str(),
                     &endpointDescriptionsLength, &endpointDescriptions);
             if (UA_STATUS_IS_BAD(connectStatus)) {
                 if (debug)
                     std::cout << "Session " << name
-                              << ": (setupSecurity) UaDiscovery::getEndpoints from " << serverURL
+                              << ": (setupSecurity) UaDiscovery::getEndpoints from " << connectURL
                               << " failed with status "
                               << UA_StatusCode_name(connectStatus)
                               << std::endl;
@@ -986,8 +1922,9 @@ SessionOpen62541::setupSecurity ()
             int selectedSecurityLevel = -1;
             int selectedEndpoint = -1;
             for (size_t k = 0; k < endpointDescriptionsLength; k++) {
-                if (std::string(reinterpret_cast<const char*>(endpointDescriptions[k].endpointUrl.data),
-                        endpointDescriptions[k].endpointUrl.length).compare(0, 7, "opc.tcp") == 0) {
+                std::string endpointUrl(reinterpret_cast<const char*>(endpointDescriptions[k].endpointUrl.data),
+                                        endpointDescriptions[k].endpointUrl.length);
+                if (endpointUrl.compare(0, 7, "opc.tcp") == 0 || isUnixTransportUrl(endpointUrl)) {
                     if (reqSecurityMode == RequestedSecurityMode::Best ||
                         OpcUaSecurityMode(reqSecurityMode) == endpointDescriptions[k].securityMode) {
                         if (reqSecurityPolicyUri.find("#None") != std::string::npos ||
@@ -1079,7 +2016,7 @@ SessionOpen62541::setupSecurity ()
             UA_Array_delete(endpointDescriptions, endpointDescriptionsLength, &UA_TYPES[UA_TYPES_ENDPOINTDESCRIPTION]);
             return ConnectResult::ok;
         } else {
-            errlogPrintf("OPC UA session %s: fatal - only URLs of type 'opc.tcp' supported\n",
+            errlogPrintf("OPC UA session %s: fatal - only URLs of type 'opc.tcp' or 'opc.unix' supported\n",
                          name.c_str());
             return SessionOpen62541::fatal;
         }
@@ -1101,12 +2038,17 @@ void SessionOpen62541::setupClientSecurityInfo(ClientSecurityInfo &securityInfo,
                       << securityClientCertificateFile
                       << std::endl;
         }
-        UA_ByteString cert = loadFile(securityClientCertificateFile.c_str());
+        // Certificate and key files are only reread when they changed
+        UA_ByteString cert, key;
+        PkiCache::instance().clientCredentials(securityClientCertificateFile,
+                                               securityClientPrivateKeyFile,
+                                               cert, key);
         if (cert.length == 0) {
             errlogPrintf("%s%s: loading client certificate %s failed\n",
                          sessionName ? "OPC UA Session " : "OPC UA",
                          sessionName ? sessionName->c_str() : "",
                          securityClientCertificateFile.c_str());
+            UA_ByteString_clear(&key);
             return;
         }
 /* TODO: Implement certificate validity check
@@ -1124,13 +2066,12 @@ void SessionOpen62541::setupClientSecurityInfo(ClientSecurityInfo &securityInfo,
                       << securityClientPrivateKeyFile
                       << std::endl;
         }
-        UA_ByteString key;
-        key = loadFile(securityClientPrivateKeyFile.c_str());
         if (key.length == 0) {
             errlogPrintf("%s%s: loading client private key %s failed\n",
                          sessionName ? "OPC UA Session " : "OPC UA",
                          sessionName ? sessionName->c_str() : "",
                          securityClientPrivateKeyFile.c_str());
+            UA_ByteString_clear(&cert);
             return;
         }
 /* TODO: Implement check if key matches certificate
@@ -1141,6 +2082,8 @@ void SessionOpen62541::setupClientSecurityInfo(ClientSecurityInfo &securityInfo,
             return;
         }
 */
+        UA_ByteString_clear(&securityInfo.clientCertificate);
+        UA_ByteString_clear(&securityInfo.privateKey);
         securityInfo.clientCertificate = cert;
         securityInfo.privateKey = key;
     } else {
@@ -1157,9 +2100,27 @@ void SessionOpen62541::setupClientSecurityInfo(ClientSecurityInfo &securityInfo,
 void
 SessionOpen62541::show (const int level) const
 {
+    std::vector<ItemOpen62541 *> snapshot;
+    {
+        Guard G(itemsLock);
+        snapshot = items.vector();
+    }
+    unsigned long suppressed = 0;
+    for (auto &it : snapshot)
+        suppressed += it->getSuppressedWrites();
+    unsigned long held = 0;
+    {
+        Guard G(writeGroupsLock);
+        for (auto &group : writeGroups)
+            held += group.second.held.size();
+    }
+
     std::cout << "session="      << name
-              << " url="         << serverURL
-              << " connect status=" << UA_StatusCode_name(connectStatus)
+              << " url="         << serverURL;
+    if (!proxyPath.empty())
+        std::cout << " proxy=" << proxyPath
+                  << (connectURL != serverURL ? "(in use)" : "(not used)");
+    std::cout << " connect status=" << UA_StatusCode_name(connectStatus)
               << " sessionState="   << sessionState
               << " channelState="   << channelState
               << " sec-mode="    << securityInfo.securityMode
@@ -1170,14 +2131,27 @@ SessionOpen62541::show (const int level) const
               << " batch r/w="   << MaxNodesPerRead << "/" << MaxNodesPerWrite
               << "(" << readNodesMax << "/" << writeNodesMax << ")"
               << " autoconnect=" << (autoConnect ? "y" : "n")
-              << " items=" << items.size()
+              << " items=" << snapshot.size()
               << " registered=" << registeredItemsNo
               << " subscriptions=" << subscriptions.size()
               << " reader=" << reader.maxRequests() << "/"
               << reader.minHoldOff() << "-" << reader.maxHoldOff() << "ms"
               << " writer=" << writer.maxRequests() << "/"
               << writer.minHoldOff() << "-" << writer.maxHoldOff() << "ms"
-              << std::endl;
+              << " suppressed=" << suppressed
+              << " msg-limit=" << messageSizeLimit
+              << " split=" << splitRequests
+              << " coalesced=" << coalescedSnapshots
+              << " grouped=" << held;
+    if (notifier)
+        std::cout << " notify=" << notifier->size()
+                  << "(pending " << notifier->pending()
+                  << "; delivered " << notifier->delivered() << ")";
+    if (cryptoStats.operations()) {
+        std::cout << " ";
+        cryptoStats.show(std::cout, level);
+    }
+    std::cout << std::endl;
 
     if (level >= 3) {
         if (namespaceMap.size()) {
@@ -1197,9 +2171,9 @@ SessionOpen62541::show (const int level) const
     }
 
     if (level >= 2) {
-        if (items.size() > 0) {
+        if (snapshot.size() > 0) {
             std::cerr << "subscription=[none]" << std::endl;
-            for (auto &it : items) {
+            for (auto &it : snapshot) {
                 if (!it->isMonitored()) it->show(level-1);
             }
         }
@@ -1209,15 +2183,66 @@ SessionOpen62541::show (const int level) const
 void
 SessionOpen62541::addItemOpen62541 (ItemOpen62541 *item)
 {
-    items.push_back(item);
+    const std::string &groupName = item->linkinfo.writeGroup;
+    if (groupName.length()) {
+        {
+            Guard G(itemsLock);
+            if (items.contains(item))
+                return;
+        }
+        // The members of a write group must be on the same session
+        Guard B(writeGroupsBindLock);
+        for (auto &it : sessions) {
+            if (it.second == this)
+                continue;
+            Guard G(it.second->writeGroupsLock);
+            auto group = it.second->writeGroups.find(groupName);
+            if (group != it.second->writeGroups.end() && group->second.members)
+                throw std::runtime_error(SB() << "write group " << groupName
+                                         << " is used on session " << it.first
+                                         << " (members of a group must use the same session)");
+        }
+        Guard G(writeGroupsLock);
+        writeGroups[groupName].members++;
+    }
+    Guard G(itemsLock);
+    items.insert(item);
+    if (client)
+        pendingAdd.insert(item);
 }
 
 void
 SessionOpen62541::removeItemOpen62541 (ItemOpen62541 *item)
 {
-    auto it = std::find(items.begin(), items.end(), item);
-    if (it != items.end())
-        items.erase(it);
+    {
+        Guard G(itemsLock);
+        if (!items.erase(item))
+            return;
+        // Not yet set up on the server: nothing to clean up
+        if (!pendingAdd.erase(item) && client) {
+            item->addReference();
+            pendingRemove.insert(item);
+        }
+    }
+    if (item->linkinfo.writeGroup.length()) {
+        // Drop writes of the item that are held for its write group
+        Guard G(writeGroupsLock);
+        auto group = writeGroups.find(item->linkinfo.writeGroup);
+        if (group != writeGroups.end()) {
+            auto &held = group->second.held;
+            for (auto it = held.begin(); it != held.end(); ) {
+                if ((*it)->item == item) {
+                    UA_WriteValue_clear(&(*it)->wvalue);
+                    it = held.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+            // The last member releases the group (and its binding to this session)
+            if (group->second.members && --group->second.members == 0)
+                writeGroups.erase(group);
+        }
+    }
 }
 
 UA_UInt16
@@ -1232,14 +2257,42 @@ SessionOpen62541::mapNamespaceIndex (const UA_UInt16 nsIndex) const
     return serverIndex;
 }
 
+void
+SessionOpen62541::clearPendingRemove ()
+{
+    for (auto it : pendingRemove.vector())
+        it->releaseReference();
+    pendingRemove.clear();
+}
+
 inline void
 SessionOpen62541::markConnectionLoss()
 {
     reader.clear();
     writer.clear();
-    for (auto it : items) {
-        it->setState(ConnectionStatus::down);
-        it->setIncomingEvent(ProcessReason::connectionLoss);
+    {
+        // queued snapshots are gone with the reader queue
+        Guard G(opslock);
+        snapshotsPending.clear();
+    }
+    {
+        Guard G(writeGroupsLock);
+        for (auto &group : writeGroups) {
+            for (auto &c : group.second.held) {
+                UA_WriteValue_clear(&c->wvalue);
+                c->item->confirmWrite(false);
+            }
+            group.second.held.clear();
+        }
+    }
+    std::vector<ItemOpen62541 *> snapshot;
+    {
+        Guard G(itemsLock);
+        snapshot = items.vector();
+    }
+    for (auto it : snapshot) {
+        deliverState(it, ConnectionStatus::down);
+        deliverEvent(it, ProcessReason::connectionLoss);
     }
 }
 
@@ -1392,6 +2445,13 @@ SessionOpen62541::run ()
             return;
         }
         status = UA_Client_run_iterate(client, 1);
+        // All notifications of the publish responses have been delivered
+        if (burstItems.size())
+            deliverBurstEnd();
+        if (isConnected()) {
+            applyItemChanges();
+            readSubscriptionDiagnostics();
+        }
         {
             UnGuard U(G);
             epicsThreadSleep(0.01); // give other threads a chance to execute
@@ -2029,6 +3089,46 @@ SessionOpen62541::connectionStatusChanged (
                 if (max != writeNodesMax)
                     writer.setParams(max, writeTimeoutMin, writeTimeoutMax);
 
+                // max monitored items per create/delete request
+                status = UA_Client_readValueAttribute(client,
+                    UA_NODEID_NUMERIC(0, UA_NS0ID_SERVER_SERVERCAPABILITIES_OPERATIONLIMITS_MAXMONITOREDITEMSPERCALL)
+                    , &value);
+                if (status == UA_STATUSCODE_GOOD && UA_Variant_hasScalarType(&value, &UA_TYPES[UA_TYPES_UINT32]))
+                    MaxMonitoredItemsPerCall = *static_cast<UA_UInt32*>(value.data);
+                UA_Variant_clear(&value);
+
+                // transport and encoding limits
+                updateMessageSizeLimit();
+                if (debug || recvBufferSize || sendBufferSize || maxMessageSize || maxChunkCount) {
+                    const UA_ConnectionConfig &cc = UA_Client_getConfig(client)->localConnectionConfig;
+                    const UA_UInt32 limitIds[3] = {
+                        UA_NS0ID_SERVER_SERVERCAPABILITIES_MAXARRAYLENGTH,
+                        UA_NS0ID_SERVER_SERVERCAPABILITIES_MAXSTRINGLENGTH,
+                        UA_NS0ID_SERVER_SERVERCAPABILITIES_MAXBYTESTRINGLENGTH
+                    };
+                    UA_UInt32 serverLimits[3] = { 0, 0, 0 };
+                    for (int j = 0; j < 3; j++) {
+                        status = UA_Client_readValueAttribute(client, UA_NODEID_NUMERIC(0, limitIds[j]), &value);
+                        if (status == UA_STATUSCODE_GOOD && UA_Variant_hasScalarType(&value, &UA_TYPES[UA_TYPES_UINT32]))
+                            serverLimits[j] = *static_cast<UA_UInt32*>(value.data);
+                        UA_Variant_clear(&value);
+                    }
+                    std::string remote("not known");
+                    if (remoteConfig.recvBufferSize)
+                        remote = SB() << "recv/send " << remoteConfig.recvBufferSize
+                                      << "/" << remoteConfig.sendBufferSize
+                                      << ", max message size " << remoteConfig.localMaxMessageSize
+                                      << ", max chunks " << remoteConfig.localMaxChunkCount;
+                    errlogPrintf("OPC UA session %s: client transport buffers recv/send %u/%u, "
+                                 "max message size %u, max chunks %u; server (HEL/ACK) %s; "
+                                 "batching limit %u; "
+                                 "server max array/string/bytestring length %u/%u/%u (0 = unlimited)\n",
+                                 name.c_str(), cc.recvBufferSize, cc.sendBufferSize,
+                                 cc.localMaxMessageSize, cc.localMaxChunkCount, remote.c_str(),
+                                 messageSizeLimit,
+                                 serverLimits[0], serverLimits[1], serverLimits[2]);
+                }
+
                 // namespaces
                 status = UA_Client_readValueAttribute(client,
                     UA_NODEID_NUMERIC(0, UA_NS0ID_SERVER_NAMESPACEARRAY)
@@ -2039,27 +3139,24 @@ SessionOpen62541::connectionStatusChanged (
 
                 getTypeDictionaries(client);
 
-                rebuildNodeIds();
-                registerNodes();
-                createAllSubscriptions();
-                addAllMonitoredItems();
-                if (debug) {
-                    std::cout << "Session " << name
-                              << ": triggering initial read for all "
-                              << items.size() << " items"
-                              << std::endl;
-                }
-                auto cargo = std::vector<std::shared_ptr<ReadRequest>>(items.size());
-                unsigned int i = 0;
-                for (auto it : items) {
-                    it->setState(ConnectionStatus::initialRead);
-                    cargo[i] = std::make_shared<ReadRequest>();
-                    cargo[i]->item = it;
-                    i++;
+                // Set up all items; runtime changes from now on are applied by the worker thread
+                std::vector<ItemOpen62541 *> snapshot;
+                {
+                    Guard G(itemsLock);
+                    snapshot = items.vector();
+                    pendingAdd.clear();
+                    clearPendingRemove();
                 }
+                registeredItemsNo = 0;
+                rebuildNodeIds(snapshot);
+                registerNodes(snapshot);
+                readMetadata(snapshot);
+                readNodeTypes(snapshot);
+                createAllSubscriptions();
+                addAllMonitoredItems(snapshot);
                 // status needs to be updated before requests are being issued
                 sessionState = newSessionState;
-                reader.pushRequest(cargo, menuPriorityHIGH);
+                requestInitialRead(snapshot);
                 break;
             }
 
@@ -2085,23 +3182,35 @@ SessionOpen62541::readComplete (UA_UInt32 transactionId,
         errlogPrintf("OPC UA session %s: (readComplete) received a callback "
                      "with unknown transaction id %u - ignored\n",
                      name.c_str(), transactionId);
-    } else if (!UA_STATUS_IS_BAD(response->responseHeader.serviceResult)) {
+        return;
+    }
+    const bool snapshot = snapshotOps.erase(transactionId) > 0;
+    // Reads of the group from now on need a new snapshot
+    if (snapshot && it->second.items->size())
+        snapshotsPending.erase(it->second.items->front()->linkinfo.snapshotGroup);
+    if (!UA_STATUS_IS_BAD(response->responseHeader.serviceResult)) {
         if (debug >= 2)
             std::cout << "Session " << name
                       << ": (readComplete) getting data for read service"
                       << " (transaction id " << transactionId
                       << "; data for " << response->resultsSize << " items)"
                       << std::endl;
-        if ((*it->second).size() != response->resultsSize)
+        if ((*it->second.items).size() != response->resultsSize)
             errlogPrintf("OPC UA session %s: (readComplete) received a callback "
                          "with %llu values for a request containing %llu items\n",
                          name.c_str(),
                          static_cast<long long unsigned>(response->resultsSize),
-                         static_cast<long long unsigned>((*it->second).size()));
+                         static_cast<long long unsigned>((*it->second.items).size()));
+        // All values of a snapshot get the same server time stamp (the response time stamp)
+        UA_DateTime snapshotTime = response->responseHeader.timestamp;
+        if (snapshot && !snapshotTime)
+            snapshotTime = UA_DateTime_now();
         UA_UInt32 i = 0;
-        for (auto item : (*it->second)) {
+        const double roundTrip = (epicsTime::getCurrent() - it->second.sent) * 1e3;
+        for (auto item : (*it->second.items)) {
+            item->setRoundTrip(false, roundTrip);
             if (i >= response->resultsSize) {
-                item->setIncomingEvent(ProcessReason::readFailure);
+                deliverEvent(item, ProcessReason::readFailure);
             } else {
                 if (debug >= 5) {
                     std::cout << "** Session " << name
@@ -2144,9 +3253,8 @@ SessionOpen62541::readComplete (UA_UInt32 transactionId,
                                       << ": re-triggering initial read for " << item
                                       << std::endl;
                             auto cargo = std::vector<std::shared_ptr<ReadRequest>>(1);
-                            item->setState(ConnectionStatus::initialRead);
-                            cargo[0] = std::make_shared<ReadRequest>();
-                            cargo[0]->item = item;
+                            deliverState(item, ConnectionStatus::initialRead);
+                            cargo[0] = std::make_shared<ReadRequest>(item);
                             //reader.pushRequest(cargo, menuPriorityHIGH);
                         }
                         UA_QualifiedName_clear(&browseName);
@@ -2154,28 +3262,68 @@ SessionOpen62541::readComplete (UA_UInt32 transactionId,
                         continue;
                     }
                 }
-                item->setIncomingData(response->results[i], reason);
+                if (messageSizeLimit)
+                    item->setReadSize(UA_calcSizeBinary(&response->results[i], &UA_TYPES[UA_TYPES_DATAVALUE]));
+                if (snapshot) {
+                    response->results[i].serverTimestamp = snapshotTime;
+                    response->results[i].serverPicoseconds = 0;
+                    response->results[i].hasServerTimestamp = true;
+                }
+                deliverData(item, response->results[i], reason);
             }
             i++;
         }
         outstandingOps.erase(it);
-    } else {
+    } else if (it->second.items->size() > 1 && !snapshot
+               && (response->responseHeader.serviceResult == UA_STATUSCODE_BADENCODINGLIMITSEXCEEDED
+                   || response->responseHeader.serviceResult == UA_STATUSCODE_BADRESPONSETOOLARGE
+                   || response->responseHeader.serviceResult == UA_STATUSCODE_BADTCPMESSAGETOOLARGE)) {
+        // Response too large: split the request in two and retry
+        // (the new requests take their item references before the operation is erased)
+        std::vector<std::shared_ptr<ReadRequest>> failed;
+        for (auto item : *it->second.items)
+            failed.push_back(std::make_shared<ReadRequest>(item));
+        outstandingOps.erase(it);
+        size_t half = failed.size() / 2;
         if (debug)
+            std::cout << "Session " << name
+                      << ": (readComplete) read service"
+                      << " (transaction id " << transactionId
+                      << ") failed with status "
+                      << UA_StatusCode_name(response->responseHeader.serviceResult)
+                      << " - retrying as 2 requests of " << half << " and " << failed.size() - half
+                      << " nodes" << std::endl;
+        std::vector<std::shared_ptr<ReadRequest>> part;
+        for (size_t j = 0; j < failed.size(); j++) {
+            part.push_back(failed[j]);
+            if (j + 1 == half || j + 1 == failed.size()) {
+                sendReadRequest(part);
+                part.clear();
+            }
+        }
+        splitRequests++;
+    } else {
+        if (snapshot && reportError(ErrorClass::readService, this, "OPC UA session " + name))
+            errlogPrintf("OPC UA session %s: (readComplete) snapshot read of %llu nodes failed with status %s\n",
+                         name.c_str(),
+                         static_cast<long long unsigned>(it->second.items->size()),
+                         UA_StatusCode_name(response->responseHeader.serviceResult));
+        else if (debug)
             std::cout << "Session " << name
                       << ": (readComplete) for read service"
                       << " (transaction id " << transactionId
                       << ") failed with status "
                       << UA_StatusCode_name(response->responseHeader.serviceResult)
                       << std::endl;
-        for (auto item : (*it->second)) {
+        for (auto item : (*it->second.items)) {
             if (debug >= 5) {
                 std::cout << "** Session " << name
                           << ": (readComplete) filing read error (no data) for item "
                           << item << std::endl;
             }
-            item->setIncomingEvent(ProcessReason::readFailure);
+            deliverEvent(item, ProcessReason::readFailure);
             // Not doing initial write if the read has failed
-            item->setState(ConnectionStatus::up);
+            deliverState(item, ConnectionStatus::up);
         }
         outstandingOps.erase(it);
     }
@@ -2198,7 +3346,9 @@ SessionOpen62541::writeComplete (UA_UInt32 transactionId,
                       << " (transaction id " << transactionId
                       << "; results for " << response->resultsSize << " items)" << std::endl;
         UA_UInt32 i = 0;
-        for (auto item : (*it->second)) {
+        const double roundTrip = (epicsTime::getCurrent() - it->second.sent) * 1e3;
+        for (auto item : (*it->second.items)) {
+            item->setRoundTrip(true, roundTrip);
             if (debug >= 5) {
                 std::cout << "** Session " << name
                           << ": (writeComplete) getting results for item "
@@ -2209,8 +3359,9 @@ SessionOpen62541::writeComplete (UA_UInt32 transactionId,
             ProcessReason reason = ProcessReason::writeComplete;
             if (UA_STATUS_IS_BAD(response->results[i]))
                 reason = ProcessReason::writeFailure;
-            item->setIncomingEvent(reason);
-            item->setState(ConnectionStatus::up);
+            item->confirmWrite(reason == ProcessReason::writeComplete);
+            deliverEvent(item, reason);
+            deliverState(item, ConnectionStatus::up);
             i++;
         }
         outstandingOps.erase(it);
@@ -2222,15 +3373,16 @@ SessionOpen62541::writeComplete (UA_UInt32 transactionId,
                       << ") failed with status "
                       << UA_StatusCode_name(response->responseHeader.serviceResult)
                       << std::endl;
-        for (auto item : (*it->second)) {
+        for (auto item : (*it->second.items)) {
             if (debug >= 5) {
                 std::cout << "** Session " << name
                           << ": (writeComplete) filing write error for item "
                           << item
                           << std::endl;
             }
-            item->setIncomingEvent(ProcessReason::writeFailure);
-            item->setState(ConnectionStatus::up);
+            item->confirmWrite(false);
+            deliverEvent(item, ProcessReason::writeFailure);
+            deliverState(item, ConnectionStatus::up);
         }
         outstandingOps.erase(it);
     }
@@ -24,11 +24,16 @@
 #include <epicsMutex.h>
 #include <epicsTypes.h>
 #include <epicsThread.h>
+#include <epicsTime.h>
 #include <initHooks.h>
 
 #include "RequestQueueBatcher.h"
+#include "NotificationPool.h"
+#include "CryptoStats.h"
 #include "Session.h"
+#include "Item.h"
 #include "Registry.h"
+#include "IndexedVector.h"
 
 namespace DevOpcua {
 
@@ -65,6 +70,19 @@ std::ostream& operator << (std::ostream& os, const UA_NodeId& ua_nodeId);
 
 std::ostream& operator << (std::ostream& os, const UA_Variant &ua_variant);
 
+// Items of an outstanding read or write operation hold a reference (see Item::addReference)
+// that is released when the operation's entry is erased
+struct ReleaseItemReferences {
+    void operator() (std::vector<ItemOpen62541 *> *items) const;
+};
+typedef std::unique_ptr<std::vector<ItemOpen62541 *>, ReleaseItemReferences> OutstandingItems;
+
+// An outstanding read or write operation
+struct OutstandingOp {
+    OutstandingItems items;            /**< items of the request */
+    epicsTime sent;                    /**< time the request was sent (for the round trip time) */
+};
+
 // Open62541 has no ClientSecurityInfo structure
 // Make our own for convenience
 struct ClientSecurityInfo {
@@ -177,6 +195,12 @@ public:
      */
     void requestRead(ItemOpen62541 &item);
 
+    /**
+     * @brief Read all items of a snapshot group in one read service call.
+     * See DevOpcua::Session::readSnapshot
+     */
+    virtual unsigned int readSnapshot(const std::string &group) override;
+
     /**
      * @brief Request a beginWrite service for an item
      *
@@ -190,9 +214,11 @@ public:
     void createAllSubscriptions();
 
     /**
-     * @brief Add all monitored items to subscriptions related to this session.
+     * @brief Add monitored items to subscriptions related to this session.
+     *
+     * @param list  items to create monitored items for
      */
-    void addAllMonitoredItems();
+    void addAllMonitoredItems(const std::vector<ItemOpen62541 *> &list);
 
     /**
      * @brief Print configuration and status of all sessions on stdout.
@@ -236,18 +262,29 @@ public:
     virtual void addNamespaceMapping(const unsigned short nsIndex, const std::string &uri) override;
 
     unsigned int noOfSubscriptions() const { return static_cast<unsigned int>(subscriptions.size()); }
-    unsigned int noOfItems() const { return static_cast<unsigned int>(items.size()); }
+    unsigned int noOfItems() const { Guard G(itemsLock); return static_cast<unsigned int>(items.size()); }
 
     /**
      * @brief Add an item to the session.
      *
+     * If the session is connected (runtime link change), the item is set up
+     * on the server by the worker thread, see applyItemChanges().
+     * An item of a write group binds the group to this session,
+     * until the last member of the group is removed.
+     *
      * @param item  item to add
+     *
+     * @throws std::runtime_error if the item's write group has members on another session
      */
     void addItemOpen62541(ItemOpen62541 *item);
 
     /**
      * @brief Remove an item from the session.
      *
+     * If the session is connected (runtime link change), the item's monitored
+     * item and registered node are cleaned up by the worker thread,
+     * see applyItemChanges(). Held writes of the item are dropped.
+     *
      * @param item  item to remove
      */
     void removeItemOpen62541(ItemOpen62541 *item);
@@ -296,10 +333,34 @@ public:
             UA_UInt32 transactionId,
             UA_WriteResponse* response);
 
+    // Deliver incoming data (moved), an event or a state change to an item, through the notification pool if configured
+    void deliverData(ItemOpen62541 *item, UA_DataValue &value, const ProcessReason reason);
+    void deliverEvent(ItemOpen62541 *item, const ProcessReason reason);
+    void deliverState(ItemOpen62541 *item, const ConnectionStatus state);
+    // End of a notification batch: request processing of the burst records that got data
+    void deliverBurstEnd();
+
     // RequestConsumer<> interfaces
     virtual void processRequests(std::vector<std::shared_ptr<WriteRequest>> &batch) override;
     virtual void processRequests(std::vector<std::shared_ptr<ReadRequest>> &batch) override;
 
+    // Push a read request for all items of a snapshot group (one cargo, not split by the batcher)
+    // While a snapshot of the group is queued or outstanding, no new one is pushed:
+    // the requesting records get their data from the pending snapshot
+    unsigned int pushSnapshot(const std::string &group, const menuPriority priority);
+    // Mark the snapshot of a group as completed or dropped
+    void snapshotDone(const std::vector<std::shared_ptr<ReadRequest>> &group);
+
+    // Send a batch of read/write requests in one service call
+    void sendReadRequest(std::vector<std::shared_ptr<ReadRequest>> &batch, const bool snapshot = false);
+    void sendWriteRequest(std::vector<std::shared_ptr<WriteRequest>> &batch);
+
+    // Set the message size limit from the client's and the server's (negotiated) limits
+    void updateMessageSizeLimit();
+
+    // Usable payload of a service call within the message size limit [bytes] (0 = no limit)
+    size_t usableMessageSize() const;
+
     /**
      * @brief Setup ClientSecurityInfo object from PKI store locations and cert files
      */
@@ -309,14 +370,69 @@ public:
 
 private:
     /**
-     * @brief Register all nodes that are configured to be registered.
+     * @brief Register the nodes of all items in the list that are configured to be registered.
+     */
+    void registerNodes(const std::vector<ItemOpen62541 *> &list);
+
+    /**
+     * @brief Unregister the nodes of all items in the list that were registered.
+     */
+    void unregisterNodes(const std::vector<ItemOpen62541 *> &list);
+
+    /**
+     * @brief Rebuild nodeIds for all items in the list.
+     */
+    void rebuildNodeIds(const std::vector<ItemOpen62541 *> &list);
+
+    /**
+     * @brief Trigger the initial read for all items in the list.
+     *
+     * Output items with bini=ignore and a known write type are set up
+     * directly, without reading their value.
+     */
+    void requestInitialRead(const std::vector<ItemOpen62541 *> &list);
+
+    /**
+     * @brief Apply runtime item additions and removals to the server.
+     *
+     * Called by the worker thread while connected. Only the items that were
+     * added or removed since the last call are affected: their nodes are
+     * registered or unregistered and their monitored items created or deleted
+     * in batched service calls.
+     */
+    void applyItemChanges();
+
+    // Drop the pending removals, releasing their item references (itemsLock must be held)
+    void clearPendingRemove();
+
+    /**
+     * @brief Import metadata for all items in the list configured with meta=y and apply it to their records.
+     *
+     * Properties (EURange, EngineeringUnits, EnumStrings, EnumValues) are resolved
+     * using batched TranslateBrowsePathsToNodeIds calls, then read together with the
+     * Description attributes in batched Read calls.
+     * Results are cached by node id, so that reconnects only apply the cached data.
+     */
+    void readMetadata(const std::vector<ItemOpen62541 *> &list);
+
+    /**
+     * @brief Read the node types of all output items in the list.
+     *
+     * Reads the DataType, ValueRank and ArrayDimensions attributes in batched
+     * Read calls and sets up the write encoding of the items, so that they can
+     * be written before a value has been read.
+     * Results are kept by the items, so that reconnects only apply them.
      */
-    void registerNodes();
+    void readNodeTypes(const std::vector<ItemOpen62541 *> &list);
 
     /**
-     * @brief Rebuild nodeIds for all nodes that were registered.
+     * @brief Read the server diagnostics of the subscriptions that are due.
+     *
+     * Reads the server's SubscriptionDiagnosticsArray (once for all due
+     * subscriptions of the session, see subscription option diag) and hands
+     * the counters to the subscriptions, matched by subscription id.
      */
-    void rebuildNodeIds();
+    void readSubscriptionDiagnostics();
 
     /**
      * @brief Rebuild the namespace index map from the server's array.
@@ -364,11 +480,17 @@ private:
     static Registry<SessionOpen62541> sessions;                   /**< session management */
 
     const std::string serverURL;                                  /**< server URL */
+    std::string proxyPath;                                        /**< socket of a local proxy (empty = none) */
+    std::string connectURL;                                       /**< URL used for the current connection */
     std::map<std::string, SubscriptionOpen62541*> subscriptions;  /**< subscriptions on this session */
-    std::vector<ItemOpen62541 *> items;                           /**< items on this session */
+    IndexedVector<ItemOpen62541> items;                           /**< items on this session */
+    IndexedVector<ItemOpen62541> pendingAdd;                      /**< items added at runtime, to be set up on the server */
+    IndexedVector<ItemOpen62541> pendingRemove;                   /**< items removed at runtime, to be cleaned up on the server (holding a reference) */
+    mutable epicsMutex itemsLock;                                 /**< lock for items and pending lists (also subscriptions' items) */
     UA_UInt32 registeredItemsNo;                                  /**< number of registered items */
     std::map<std::string, UA_UInt16> namespaceMap;                /**< local namespace map (URI->index) */
     std::map<UA_UInt16, UA_UInt16> nsIndexMap;                    /**< namespace index map (local->server-side) */
+    std::map<std::string, ItemMetadata> metadataCache;            /**< node metadata of items with meta=y (by node id) */
 
     ClientSecurityInfo securityInfo;                              /**< security metadata */
     unsigned int securityLevel;                                   /**< actual security level */
@@ -376,11 +498,22 @@ private:
     std::string reqSecurityPolicyUri;                             /**< requested security policy */
 
     int transactionId;                                            /**< next transaction id */
-    /** itemOpen62541 vectors of outstanding read or write operations, indexed by transaction id */
-    std::map<UA_UInt32, std::unique_ptr<std::vector<ItemOpen62541 *>>> outstandingOps;
+    /** outstanding read or write operations, indexed by transaction id */
+    std::map<UA_UInt32, OutstandingOp> outstandingOps;
     epicsMutex opslock;                                           /**< lock for outstandingOps map */
+    std::set<UA_UInt32> snapshotOps;                              /**< outstanding snapshot reads (under opslock) */
+    std::set<std::string> snapshotsPending;                       /**< snapshot groups queued or being read (under opslock) */
+    unsigned long coalescedSnapshots;                             /**< snapshot requests served by a pending snapshot */
 
     RequestQueueBatcher<WriteRequest> writer;                     /**< batcher for write requests */
+    /** a write group on this session */
+    struct WriteGroup {
+        unsigned int members = 0;                                 /**< items of the group */
+        std::vector<std::shared_ptr<WriteRequest>> held;          /**< writes held until the trigger is written */
+    };
+    std::map<std::string, WriteGroup> writeGroups;                /**< write groups, indexed by group name */
+    mutable epicsMutex writeGroupsLock;                           /**< lock for writeGroups map */
+    static epicsMutex writeGroupsBindLock;                        /**< serializes binding groups to sessions */
     unsigned int writeNodesMax;                                   /**< max number of nodes per write request */
     unsigned int writeTimeoutMin;                                 /**< timeout after write request batch of 1 node [ms] */
     unsigned int writeTimeoutMax;                                 /**< timeout after write request of NodesMax nodes [ms] */
@@ -397,6 +530,18 @@ private:
     UA_StatusCode connectStatus;                                  /**< status for this session */
     unsigned int MaxNodesPerRead;                                 /**< server max number of nodes per write request */
     unsigned int MaxNodesPerWrite;                                /**< server max number of nodes per write request */
+    unsigned int MaxMonitoredItemsPerCall;                        /**< server max number of monitored items per create/delete request */
+    UA_UInt32 recvBufferSize;                                     /**< requested transport receive buffer size (0 = default) */
+    UA_UInt32 sendBufferSize;                                     /**< requested transport send buffer size (0 = default) */
+    UA_UInt32 maxMessageSize;                                     /**< requested max message size (0 = default) */
+    UA_UInt32 maxChunkCount;                                      /**< requested max chunks per message (0 = default) */
+    UA_ConnectionConfig remoteConfig;                             /**< server limits from the HEL/ACK exchange (zero if not known) */
+    UA_UInt32 messageSizeLimit;                                   /**< effective message size limit for batching (0 = none) */
+    unsigned long splitRequests;                                  /**< number of service calls split to fit the message size */
+    unsigned int notifyThreads;                                   /**< number of notification worker threads (0 = client thread) */
+    std::unique_ptr<NotificationPool> notifier;                   /**< notification worker pool */
+    std::vector<ItemOpen62541 *> burstItems;                      /**< items with burst records that got data in this batch */
+    CryptoStats cryptoStats;                                      /**< time spent in the security policies' crypto */
     epicsThread *workerThread;                                    /**< Asynchronous worker thread */
 };
 
@@ -58,6 +58,10 @@ const char Subscription::optionUsage[]
     = "Valid subscription options are:\n"
       "debug              debug level [default 0 = no debug]\n"
       "priority           priority level [default 0(lowest) .. 255]\n"
+      "diag               interval to read the server's diagnostics [s] [default 0 = off]\n"
+      "auto               group items by sampling rate class [y|n] [default n]\n"
+      "auto-min           lower bound of the groups' publishing interval [ms] [default publishing interval]\n"
+      "auto-max           upper bound of the groups' publishing interval [ms] [default 0 = none]\n"
       "";
 
 } // namespace DevOpcua
@@ -0,0 +1,172 @@
+/*************************************************************************\
+* Copyright (c) 2026 ITER Organization.
+* This module is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Author: Dirk Zimoch <dirk.zimoch@psi.ch>
+ */
+
+#include <map>
+
+#include "SubscriptionDiagnostics.h"
+
+namespace DevOpcua {
+
+namespace {
+
+// Binary encoding of SubscriptionDiagnosticsDataType (OPC UA Part 5, 12.15):
+// SessionId (NodeId), SubscriptionId, Priority (Byte), PublishingInterval (Double),
+// MaxKeepAliveCount, MaxLifetimeCount, MaxNotificationsPerPublish, PublishingEnabled (Boolean),
+// followed by 23 UInt32 counters
+enum Counter {
+    modifyCount, enableCount, disableCount, republishRequestCount,
+    republishMessageRequestCount, republishMessageCount, transferRequestCount,
+    transferredToAltClientCount, transferredToSameClientCount, publishRequestCount,
+    dataChangeNotificationsCount, eventNotificationsCount, notificationsCount,
+    latePublishRequestCount, currentKeepAliveCount, currentLifetimeCount,
+    unacknowledgedMessageCount, discardedMessageCount, monitoredItemCount,
+    disabledMonitoredItemCount, monitoringQueueOverflowCount, nextSequenceNumber,
+    eventQueueOverFlowCount,
+    counterCount
+};
+
+// Little endian reader on an encoded buffer
+class Decoder
+{
+public:
+    Decoder(const UA_ByteString &buffer)
+        : pos(buffer.data)
+        , end(buffer.data + buffer.length)
+    {}
+
+    bool skip(const size_t n)
+    {
+        if (static_cast<size_t>(end - pos) < n)
+            return false;
+        pos += n;
+        return true;
+    }
+
+    bool uint32(UA_UInt32 &value)
+    {
+        if (end - pos < 4)
+            return false;
+        value = static_cast<UA_UInt32>(pos[0]) | static_cast<UA_UInt32>(pos[1]) << 8
+                | static_cast<UA_UInt32>(pos[2]) << 16 | static_cast<UA_UInt32>(pos[3]) << 24;
+        pos += 4;
+        return true;
+    }
+
+    bool nodeId()
+    {
+        if (end - pos < 1)
+            return false;
+        const UA_Byte encoding = *pos++;
+        UA_UInt32 length;
+        switch (encoding) {
+        case 0x00: return skip(1);          // two byte
+        case 0x01: return skip(3);          // four byte
+        case 0x02: return skip(6);          // numeric
+        case 0x04: return skip(18);         // guid
+        case 0x03:                          // string
+        case 0x05:                          // bytestring
+            if (!skip(2) || !uint32(length))
+                return false;
+            return length == 0xffffffff || skip(length);
+        default:   return false;
+        }
+    }
+
+private:
+    const UA_Byte *pos;
+    const UA_Byte *end;
+};
+
+bool
+decodeEncoded (const UA_ByteString &body, UA_UInt32 &subscriptionId, SubscriptionCounters &counters)
+{
+    Decoder d(body);
+    UA_UInt32 counter[counterCount];
+
+    if (!d.nodeId() || !d.uint32(subscriptionId) || !d.skip(1 + 8 + 3 * 4 + 1))
+        return false;
+    for (int i = 0; i < counterCount; i++)
+        if (!d.uint32(counter[i]))
+            return false;
+
+    counters.hasServerDiagnostics = true;
+    counters.monitoringQueueOverflows = counter[monitoringQueueOverflowCount];
+    counters.discardedMessages = counter[discardedMessageCount];
+    counters.latePublishRequests = counter[latePublishRequestCount];
+    counters.unacknowledgedMessages = counter[unacknowledgedMessageCount];
+    counters.dataChangeNotifications = counter[dataChangeNotificationsCount];
+    return true;
+}
+
+#ifdef UA_TYPES_SUBSCRIPTIONDIAGNOSTICSDATATYPE
+void
+takeDecoded (const UA_SubscriptionDiagnosticsDataType &diag, SubscriptionCounters &counters)
+{
+    counters.hasServerDiagnostics = true;
+    counters.monitoringQueueOverflows = diag.monitoringQueueOverflowCount;
+    counters.discardedMessages = diag.discardedMessageCount;
+    counters.latePublishRequests = diag.latePublishRequestCount;
+    counters.unacknowledgedMessages = diag.unacknowledgedMessageCount;
+    counters.dataChangeNotifications = diag.dataChangeNotificationsCount;
+}
+#endif
+
+} // namespace
+
+size_t
+decodeSubscriptionDiagnostics (const UA_Variant &value,
+                               std::map<UA_UInt32, SubscriptionCounters> &result)
+{
+    size_t decoded = 0;
+    if (!value.data || UA_Variant_isScalar(&value))
+        return 0;
+
+#ifdef UA_TYPES_SUBSCRIPTIONDIAGNOSTICSDATATYPE
+    const UA_DataType *diagType = &UA_TYPES[UA_TYPES_SUBSCRIPTIONDIAGNOSTICSDATATYPE];
+    if (value.type == diagType) {
+        const UA_SubscriptionDiagnosticsDataType *diag
+                = static_cast<const UA_SubscriptionDiagnosticsDataType *>(value.data);
+        for (size_t i = 0; i < value.arrayLength; i++, decoded++)
+            takeDecoded(diag[i], result[diag[i].subscriptionId]);
+        return decoded;
+    }
+#endif
+    if (value.type != &UA_TYPES[UA_TYPES_EXTENSIONOBJECT])
+        return 0;
+
+    const UA_ExtensionObject *eo = static_cast<const UA_ExtensionObject *>(value.data);
+    for (size_t i = 0; i < value.arrayLength; i++) {
+        if (eo[i].encoding == UA_EXTENSIONOBJECT_ENCODED_BYTESTRING) {
+            const UA_NodeId &typeId = eo[i].content.encoded.typeId;
+            if (typeId.namespaceIndex != 0
+                    || typeId.identifierType != UA_NODEIDTYPE_NUMERIC
+                    || typeId.identifier.numeric != UA_NS0ID_SUBSCRIPTIONDIAGNOSTICSDATATYPE_ENCODING_DEFAULTBINARY)
+                continue;
+            UA_UInt32 subscriptionId;
+            SubscriptionCounters counters;
+            if (decodeEncoded(eo[i].content.encoded.body, subscriptionId, counters)) {
+                result[subscriptionId] = counters;
+                decoded++;
+            }
+#ifdef UA_TYPES_SUBSCRIPTIONDIAGNOSTICSDATATYPE
+        } else if ((eo[i].encoding == UA_EXTENSIONOBJECT_DECODED
+                    || eo[i].encoding == UA_EXTENSIONOBJECT_DECODED_NODELETE)
+                   && eo[i].content.decoded.type == diagType) {
+            const UA_SubscriptionDiagnosticsDataType *diag
+                    = static_cast<const UA_SubscriptionDiagnosticsDataType *>(eo[i].content.decoded.data);
+            takeDecoded(*diag, result[diag->subscriptionId]);
+            decoded++;
+#endif
+        }
+    }
+    return decoded;
+}
+
+} // namespace DevOpcua
@@ -0,0 +1,42 @@
+/*************************************************************************\
+* Copyright (c) 2026 ITER Organization.
+* This module is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Author: Dirk Zimoch <dirk.zimoch@psi.ch>
+ */
+
+#ifndef DEVOPCUA_SUBSCRIPTIONDIAGNOSTICS_H
+#define DEVOPCUA_SUBSCRIPTIONDIAGNOSTICS_H
+
+#include <map>
+
+#include <open62541/client.h>
+
+#include "Subscription.h"
+
+namespace DevOpcua {
+
+/**
+ * @brief Decode the value of the server's SubscriptionDiagnosticsArray.
+ *
+ * Takes the server counters of every SubscriptionDiagnosticsDataType
+ * element, indexed by subscription id.
+ *
+ * Builds of open62541 with the reduced type set (default) do not know the
+ * type and deliver the elements as binary encoded extension objects, which
+ * are decoded here. Elements of other types are skipped.
+ *
+ * @param value  value of the SubscriptionDiagnosticsArray variable (i=2290)
+ * @param[out] result  server counters by subscription id
+ *
+ * @return  number of decoded elements
+ */
+size_t decodeSubscriptionDiagnostics(const UA_Variant &value,
+                                     std::map<UA_UInt32, SubscriptionCounters> &result);
+
+} // namespace DevOpcua
+
+#endif // DEVOPCUA_SUBSCRIPTIONDIAGNOSTICS_H
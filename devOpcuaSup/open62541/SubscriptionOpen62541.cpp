@@ -10,9 +10,12 @@
  *  based on the UaSdk implementation by Ralph Lange <ralph.lange@gmx.de>
  */
 
+#include <algorithm>
 #include <iostream>
+#include <sstream>
 #include <string>
 #include <map>
+#include <cmath>
 
 #include <open62541/client_subscriptions.h>
 
@@ -23,6 +26,7 @@
 #include "ItemOpen62541.h"
 #include "DataElementOpen62541.h"
 #include "Registry.h"
+#include "linkParser.h"
 #include "devOpcua.h"
 
 // Note: No guard needed for UA_Client_* functions calls because SubscriptionOpen62541 methods
@@ -40,17 +44,62 @@ SubscriptionOpen62541::SubscriptionOpen62541 (const std::string &name, SessionOp
     //TODO: add runtime support for subscription enable/disable
     , requestedSettings(UA_CreateSubscriptionRequest_default())
     , enable(true)
+    , diagInterval(0.0)
+    , diagStatus(UA_STATUSCODE_GOOD)
+    // keep the default timeout
+    , timeout(requestedSettings.requestedPublishingInterval * requestedSettings.requestedLifetimeCount)
+    , autoGroups(false)
+    , autoMin(-1.0)
+    , autoMax(0.0)
+    , parent(nullptr)
+    , groupClass(0.0)
+    , notifications(0)
 {
     UA_CreateSubscriptionResponse_init(&subscriptionSettings);
-    // keep the default timeout
-    double deftimeout = requestedSettings.requestedPublishingInterval * requestedSettings.requestedLifetimeCount;
-    subscriptionSettings.revisedPublishingInterval = requestedSettings.requestedPublishingInterval = publishingInterval;
-    subscriptionSettings.revisedLifetimeCount = requestedSettings.requestedLifetimeCount = static_cast<UA_UInt32>(deftimeout / publishingInterval);
+    setPublishingInterval(publishingInterval);
 
     subscriptions.insert({name, this});
     session.subscriptions[name] = this;
 }
 
+static std::string
+groupName (const std::string &name, const double rateClass)
+{
+    std::ostringstream s;
+    s << name << "/" << rateClass;
+    return s.str();
+}
+
+// Rate groups are owned by their auto subscription and not registered
+SubscriptionOpen62541::SubscriptionOpen62541 (SubscriptionOpen62541 &owner, const double rateClass)
+    : Subscription(groupName(owner.name, rateClass))
+    , session(owner.session)
+    , requestedSettings(owner.requestedSettings)
+    , enable(owner.enable)
+    , diagInterval(owner.diagInterval)
+    , diagStatus(UA_STATUSCODE_GOOD)
+    , timeout(owner.timeout)
+    , autoGroups(false)
+    , autoMin(-1.0)
+    , autoMax(0.0)
+    , parent(&owner)
+    , groupClass(rateClass)
+    , notifications(0)
+{
+    debug = owner.debug;
+    UA_CreateSubscriptionResponse_init(&subscriptionSettings);
+    setPublishingInterval(groupInterval(rateClass, owner.minGroupInterval(), owner.autoMax));
+}
+
+void
+SubscriptionOpen62541::setPublishingInterval (const double interval)
+{
+    subscriptionSettings.revisedPublishingInterval = requestedSettings.requestedPublishingInterval = interval;
+    if (interval > 0.0)
+        subscriptionSettings.revisedLifetimeCount = requestedSettings.requestedLifetimeCount
+                = static_cast<UA_UInt32>(timeout / interval);
+}
+
 void SubscriptionOpen62541::setOption(const std::string &name, const std::string &value)
 {
     if (debug || name == "debug")
@@ -68,32 +117,138 @@ void SubscriptionOpen62541::setOption(const std::string &name, const std::string
             errlogPrintf("option '%s' value out of range - ignored\n", name.c_str());
         else
             requestedSettings.priority = static_cast<UA_Byte>(ul);
+    } else if (name == "diag") {
+        double d = std::strtod(value.c_str(), nullptr);
+        if (d < 0.0)
+            errlogPrintf("option '%s' value out of range - ignored\n", name.c_str());
+        else
+            diagInterval = d;
+    } else if (name == "auto") {
+        Guard G(session.itemsLock);
+        if (parent || items.size() || groups.size())
+            errlogPrintf("option '%s' can not be changed on a subscription with items - ignored\n", name.c_str());
+        else if (value.length() > 0)
+            autoGroups = getYesNo(value[0]);
+    } else if (name == "auto-min" || name == "auto-max") {
+        double d = std::strtod(value.c_str(), nullptr);
+        if (d < 0.0)
+            errlogPrintf("option '%s' value out of range - ignored\n", name.c_str());
+        else if (name == "auto-min")
+            autoMin = d;
+        else
+            autoMax = d;
     } else {
         errlogPrintf("unknown option '%s' - ignored\n", name.c_str());
     }
+
+    // Existing rate groups follow their auto subscription
+    if (name == "debug" || name == "priority" || name == "diag") {
+        Guard G(session.itemsLock);
+        for (auto &it : groups)
+            it.second->setOption(name, value);
+    }
 }
 
 void
 SubscriptionOpen62541::show (int level) const
 {
+    std::vector<ItemOpen62541 *> snapshot;
+    std::vector<SubscriptionOpen62541 *> groupSnapshot;
+    size_t noOfItems;
+    {
+        Guard G(session.itemsLock);
+        snapshot = items.vector();
+        noOfItems = snapshot.size();
+        for (auto &it : groups) {
+            groupSnapshot.push_back(it.second.get());
+            noOfItems += it.second->items.size();
+        }
+    }
+
     std::cout << "subscription=" << name
-              << " session="     << session.getName()
-              << " interval="    << subscriptionSettings.revisedPublishingInterval
-              << "("             << requestedSettings.requestedPublishingInterval  << ")"
-              << " prio="        << static_cast<int>(requestedSettings.priority)
+              << " session="     << session.getName();
+    if (autoGroups) {
+        std::cout << " interval=auto(" << minGroupInterval() << "-";
+        if (autoMax > 0.0)
+            std::cout << autoMax;
+        std::cout << ")";
+    } else {
+        std::cout << " interval="    << subscriptionSettings.revisedPublishingInterval
+                  << "("             << requestedSettings.requestedPublishingInterval  << ")";
+    }
+    std::cout << " prio="        << static_cast<int>(requestedSettings.priority)
               << " enable="    "?" // << (puasubscription ? (puasubscription->publishingEnabled() ? "y" : "n") : "?")
               << "(" << (enable ? "Y" : "N") << ")"
               << " debug=" << debug
-              << " items=" << items.size()
-              << std::endl;
+              << " items=" << noOfItems;
+    if (autoGroups)
+        std::cout << " groups=" << groupSnapshot.size();
+    SubscriptionCounters counters;
+    getCounters(counters);
+    showCounters(counters);
+    std::cout << std::endl;
+
+    for (auto &it : groupSnapshot)
+        it->showGroup(level);
 
     if (level >= 1) {
-        for (auto &it : items) {
+        for (auto &it : snapshot) {
             it->show(level-1);
         }
     }
 }
 
+void
+SubscriptionOpen62541::showGroup (int level) const
+{
+    std::vector<ItemOpen62541 *> snapshot;
+    {
+        Guard G(session.itemsLock);
+        snapshot = items.vector();
+    }
+
+    std::cout << "  group=" << name
+              << " interval=" << subscriptionSettings.revisedPublishingInterval
+              << "(" << requestedSettings.requestedPublishingInterval << ")"
+              << " items=" << snapshot.size()
+              << " notifications=" << notifications;
+    if (subscriptionSettings.subscriptionId) {
+        const double elapsed = epicsTime::getCurrent() - created;
+        if (elapsed > 0.0)
+            std::cout << "(" << notifications / elapsed << "/s)";
+    }
+    SubscriptionCounters counters;
+    getCounters(counters);
+    showCounters(counters);
+    std::cout << std::endl;
+
+    if (level >= 1) {
+        for (auto &it : snapshot) {
+            it->show(level-1);
+        }
+    }
+}
+
+void
+SubscriptionOpen62541::showCounters (const SubscriptionCounters &counters) const
+{
+    if (counters.itemOverflows || counters.clientDrops)
+        std::cout << " overflows=" << counters.itemOverflows << "(server)/"
+                  << counters.clientDrops << "(client)";
+    // auto subscriptions have no server side counters of their own
+    if (diagInterval > 0.0 && !autoGroups) {
+        std::cout << " diag=" << diagInterval;
+        if (counters.hasServerDiagnostics)
+            std::cout << "(queueOverflows=" << counters.monitoringQueueOverflows
+                      << " discardedMessages=" << counters.discardedMessages
+                      << " latePublishRequests=" << counters.latePublishRequests
+                      << " unacknowledged=" << counters.unacknowledgedMessages
+                      << " notifications=" << counters.dataChangeNotifications << ")";
+        else
+            std::cout << "(" << UA_StatusCode_name(diagStatus) << ")";
+    }
+}
+
 void
 SubscriptionOpen62541::showAll (int level)
 {
@@ -120,9 +275,158 @@ SubscriptionOpen62541::getSessionOpen62541 () const
     return session;
 }
 
+void
+SubscriptionOpen62541::getCounters (SubscriptionCounters &counters) const
+{
+    if (autoGroups) {
+        Guard G(session.itemsLock);
+        counters = SubscriptionCounters();
+        counters.hasServerDiagnostics = !groups.empty();
+        for (auto &it : groups) {
+            SubscriptionCounters c;
+            it.second->getCounters(c);
+            counters.itemOverflows += c.itemOverflows;
+            counters.clientDrops += c.clientDrops;
+            counters.hasServerDiagnostics = counters.hasServerDiagnostics && c.hasServerDiagnostics;
+            counters.monitoringQueueOverflows += c.monitoringQueueOverflows;
+            counters.discardedMessages += c.discardedMessages;
+            counters.latePublishRequests += c.latePublishRequests;
+            counters.unacknowledgedMessages += c.unacknowledgedMessages;
+            counters.dataChangeNotifications += c.dataChangeNotifications;
+        }
+        return;
+    }
+    {
+        Guard G(diagLock);
+        counters = serverCounters;
+    }
+    counters.itemOverflows = 0;
+    counters.clientDrops = 0;
+    Guard G(session.itemsLock);
+    for (auto &it : items) {
+        epicsUInt32 serverOverflows, clientDrops;
+        it->getOverflowCounts(&serverOverflows, &clientDrops);
+        counters.itemOverflows += serverOverflows;
+        counters.clientDrops += clientDrops;
+    }
+}
+
+bool
+SubscriptionOpen62541::diagnosticsDue (const epicsTime &now)
+{
+    if (diagInterval <= 0.0 || !subscriptionSettings.subscriptionId || now < diagNext)
+        return false;
+    diagNext = now + diagInterval;
+    return true;
+}
+
+void
+SubscriptionOpen62541::setServerDiagnostics (const UA_StatusCode status, const SubscriptionCounters *counters)
+{
+    UA_StatusCode previous;
+    {
+        Guard G(diagLock);
+        previous = diagStatus;
+        diagStatus = status;
+        if (counters && !UA_STATUS_IS_BAD(status))
+            serverCounters = *counters;
+        else
+            serverCounters = SubscriptionCounters();
+    }
+    if (UA_STATUS_IS_BAD(status) && status != previous)
+        errlogPrintf("OPC UA subscription %s: server diagnostics on session %s not available (%s)\n",
+                     name.c_str(), session.getName().c_str(), UA_StatusCode_name(status));
+    if (debug >= 3 && counters)
+        std::cout << "Subscription " << name << "@" << session.getName()
+                  << ": (setServerDiagnostics) queue overflows " << counters->monitoringQueueOverflows
+                  << " discarded messages " << counters->discardedMessages
+                  << std::endl;
+}
+
+SubscriptionOpen62541 *
+SubscriptionOpen62541::rateGroup (const double samplingInterval)
+{
+    if (!autoGroups)
+        return this;
+    // Items sampling at the publishing interval use the subscription's interval
+    const double rate = rateClass(samplingInterval < 0.0
+                                  ? requestedSettings.requestedPublishingInterval
+                                  : samplingInterval);
+    Guard G(session.itemsLock);
+    std::unique_ptr<SubscriptionOpen62541> &group = groups[rate];
+    if (!group) {
+        group.reset(new SubscriptionOpen62541(*this, rate));
+        if (debug)
+            std::cout << "Subscription " << name << "@" << session.getName()
+                      << ": (rateGroup) added group " << group->name << std::endl;
+    }
+    return group.get();
+}
+
+std::vector<SubscriptionOpen62541 *>
+SubscriptionOpen62541::serverSubscriptions ()
+{
+    std::vector<SubscriptionOpen62541 *> result;
+    if (!autoGroups) {
+        result.push_back(this);
+    } else {
+        Guard G(session.itemsLock);
+        for (auto &it : groups)
+            result.push_back(it.second.get());
+    }
+    return result;
+}
+
+double
+SubscriptionOpen62541::rateClass (const double interval)
+{
+    if (interval <= 0.0)
+        return 0.0;
+    static const double steps[] = { 1.0, 2.0, 5.0, 10.0 };
+    const double decade = std::pow(10.0, std::floor(std::log10(interval)));
+    for (const double step : steps)
+        if (interval <= step * decade * (1.0 + 1e-9))
+            return step * decade;
+    return 10.0 * decade;
+}
+
+double
+SubscriptionOpen62541::groupInterval (const double fastest, const double min, const double max)
+{
+    double interval = std::max(fastest, min);
+    if (max > 0.0 && interval > max)
+        interval = max;
+    return interval;
+}
+
+double
+SubscriptionOpen62541::minGroupInterval () const
+{
+    return autoMin < 0.0 ? requestedSettings.requestedPublishingInterval : autoMin;
+}
+
+double
+SubscriptionOpen62541::fastestSamplingInterval () const
+{
+    double fastest = -1.0;
+    Guard G(session.itemsLock);
+    for (auto &it : items) {
+        double interval = it->linkinfo.samplingInterval;
+        if (interval < 0.0)
+            interval = parent->requestedSettings.requestedPublishingInterval;
+        if (fastest < 0.0 || interval < fastest)
+            fastest = interval;
+    }
+    return fastest < 0.0 ? groupClass : fastest;
+}
+
 void
 SubscriptionOpen62541::create ()
 {
+    // A rate group publishes at the rate of its fastest member (within the bounds)
+    if (parent)
+        setPublishingInterval(groupInterval(fastestSamplingInterval(),
+                                            parent->minGroupInterval(), parent->autoMax));
     subscriptionSettings = UA_Client_Subscriptions_create(session.client,
         requestedSettings, this, [] (UA_Client *client, UA_UInt32 subscriptionId,
             void *context, UA_StatusChangeNotification *notification) {
@@ -134,6 +438,8 @@ SubscriptionOpen62541::create ()
                     name.c_str(), session.getName().c_str(),
                     UA_StatusCode_name(subscriptionSettings.responseHeader.serviceResult));
     } else {
+        notifications = 0;
+        created = epicsTime::getCurrent();
         if (debug)
             errlogPrintf("OPC UA subscription %s on session %s created (%s)\n",
                     name.c_str(), session.getName().c_str(),
@@ -141,56 +447,140 @@ SubscriptionOpen62541::create ()
     }
 }
 
+// Data change callback of all monitored items (context = item)
+static void
+dataChangeCallback (UA_Client *client, UA_UInt32 subId, void *subContext,
+                    UA_UInt32 monId, void *monContext, UA_DataValue *value)
+{
+    static_cast<SubscriptionOpen62541*>(subContext)->
+        dataChange(monId, *static_cast<ItemOpen62541*>(monContext), value);
+}
+
 void
-SubscriptionOpen62541::addMonitoredItems ()
-{
-    UA_UInt32 i;
-    UA_MonitoredItemCreateRequest monitoredItemCreateRequest;
-    UA_MonitoredItemCreateResult monitoredItemCreateResult;
-
-    if (items.size()) {
-        monitoredItemCreateResult.statusCode = UA_STATUSCODE_GOOD; // suppress compiler warning
-        i = 0;
-        for (auto &it : items) {
-            UA_MonitoredItemCreateRequest_init(&monitoredItemCreateRequest);
-            monitoredItemCreateRequest.itemToMonitor.nodeId = it->getNodeId();
-            monitoredItemCreateRequest.itemToMonitor.attributeId = UA_ATTRIBUTEID_VALUE;
-            monitoredItemCreateRequest.monitoringMode = UA_MONITORINGMODE_REPORTING;
-            monitoredItemCreateRequest.requestedParameters.clientHandle = i;
-            monitoredItemCreateRequest.requestedParameters.samplingInterval = it->linkinfo.samplingInterval;
-            monitoredItemCreateRequest.requestedParameters.queueSize = it->linkinfo.queueSize;
-            monitoredItemCreateRequest.requestedParameters.discardOldest = it->linkinfo.discardOldest;
-            monitoredItemCreateResult = UA_Client_MonitoredItems_createDataChange(
-                session.client, subscriptionSettings.subscriptionId, UA_TIMESTAMPSTORETURN_BOTH,
-                monitoredItemCreateRequest, items[i], [] (UA_Client *client, UA_UInt32 subId, void *subContext,
-                         UA_UInt32 monId, void *monContext, UA_DataValue *value) {
-                            static_cast<SubscriptionOpen62541*>(subContext)->
-                                dataChange(monId, *static_cast<ItemOpen62541*>(monContext), value);
-                         }, nullptr /* deleteCallback */);
-            if (monitoredItemCreateResult.statusCode == UA_STATUSCODE_GOOD) {
-                items[i]->setRevisedSamplingInterval(monitoredItemCreateResult.revisedSamplingInterval);
-                items[i]->setRevisedQueueSize(monitoredItemCreateResult.revisedQueueSize);
-            }
-            if (debug >= 5) {
-                if (monitoredItemCreateResult.statusCode == UA_STATUSCODE_GOOD)
-                    std::cout << "** Monitored item " << monitoredItemCreateRequest.itemToMonitor.nodeId
-                              << " succeeded with id " << monitoredItemCreateResult.monitoredItemId
-                              << " revised sampling interval " << monitoredItemCreateResult.revisedSamplingInterval
-                              << " revised queue size " << monitoredItemCreateResult.revisedQueueSize
-                              << std::endl;
-                else
-                    std::cout << "** Monitored item " << monitoredItemCreateRequest.itemToMonitor.nodeId
-                              << " failed with error "
-                              << UA_StatusCode_name(monitoredItemCreateResult.statusCode)
-                              << std::endl;
+SubscriptionOpen62541::addMonitoredItems (const std::vector<ItemOpen62541 *> &list)
+{
+    std::vector<ItemOpen62541 *> todo;
+    for (auto &it : list)
+        if (it->getSubscription() == this)
+            todo.push_back(it);
+    if (todo.empty())
+        return;
+
+    size_t chunk = todo.size();
+    if (session.MaxMonitoredItemsPerCall)
+        chunk = session.MaxMonitoredItemsPerCall;
+    size_t created = 0;
+    UA_StatusCode status = UA_STATUSCODE_GOOD;
+
+    for (size_t first = 0; first < todo.size(); first += chunk) {
+        const size_t n = std::min(chunk, todo.size() - first);
+        UA_CreateMonitoredItemsRequest request;
+        UA_CreateMonitoredItemsRequest_init(&request);
+        request.subscriptionId = subscriptionSettings.subscriptionId;
+        request.timestampsToReturn = UA_TIMESTAMPSTORETURN_BOTH;
+        request.itemsToCreate = static_cast<UA_MonitoredItemCreateRequest*>(
+            UA_Array_new(n, &UA_TYPES[UA_TYPES_MONITOREDITEMCREATEREQUEST]));
+        request.itemsToCreateSize = n;
+        std::vector<void *> contexts(n);
+        std::vector<UA_Client_DataChangeNotificationCallback> callbacks(n, dataChangeCallback);
+        std::vector<UA_Client_DeleteMonitoredItemCallback> deleteCallbacks(n, nullptr);
+        for (size_t i = 0; i < n; i++) {
+            ItemOpen62541 *item = todo[first + i];
+            UA_MonitoredItemCreateRequest &mi = request.itemsToCreate[i];
+            UA_NodeId_copy(&item->getNodeId(), &mi.itemToMonitor.nodeId);
+            mi.itemToMonitor.attributeId = UA_ATTRIBUTEID_VALUE;
+            mi.monitoringMode = UA_MONITORINGMODE_REPORTING;
+            mi.requestedParameters.samplingInterval = item->linkinfo.samplingInterval;
+            mi.requestedParameters.queueSize = item->linkinfo.queueSize;
+            mi.requestedParameters.discardOldest = item->linkinfo.discardOldest;
+            contexts[i] = item;
+            // a failed create must not leave the id of an earlier monitored item
+            item->setMonitoredItemId(0);
+        }
+        UA_CreateMonitoredItemsResponse response = UA_Client_MonitoredItems_createDataChanges(
+            session.client, request, contexts.data(), callbacks.data(), deleteCallbacks.data());
+        status = response.responseHeader.serviceResult;
+        if (UA_STATUS_IS_BAD(status)) {
+            errlogPrintf("OPC UA subscription %s: createMonitoredItems on session %s failed (%s)\n",
+                         name.c_str(), session.getName().c_str(), UA_StatusCode_name(status));
+        } else {
+            for (size_t i = 0; i < n && i < response.resultsSize; i++) {
+                const UA_MonitoredItemCreateResult &result = response.results[i];
+                ItemOpen62541 *item = todo[first + i];
+                if (result.statusCode == UA_STATUSCODE_GOOD) {
+                    item->setRevisedSamplingInterval(result.revisedSamplingInterval);
+                    item->setRevisedQueueSize(result.revisedQueueSize);
+                    item->setMonitoredItemId(result.monitoredItemId);
+                    created++;
+                }
+                if (debug >= 5) {
+                    if (result.statusCode == UA_STATUSCODE_GOOD)
+                        std::cout << "** Monitored item " << request.itemsToCreate[i].itemToMonitor.nodeId
+                                  << " succeeded with id " << result.monitoredItemId
+                                  << " revised sampling interval " << result.revisedSamplingInterval
+                                  << " revised queue size " << result.revisedQueueSize
+                                  << std::endl;
+                    else
+                        std::cout << "** Monitored item " << request.itemsToCreate[i].itemToMonitor.nodeId
+                                  << " failed with error "
+                                  << UA_StatusCode_name(result.statusCode)
+                                  << std::endl;
+                }
             }
-            i++;
         }
-        if (debug)
-            std::cout << "Subscription " << name << "@" << session.getName()
-                      << ": created " << items.size() << " monitored items ("
-                      << UA_StatusCode_name(monitoredItemCreateResult.statusCode) << ")" << std::endl;
+        UA_CreateMonitoredItemsResponse_clear(&response);
+        UA_CreateMonitoredItemsRequest_clear(&request);
+    }
+    if (debug)
+        std::cout << "Subscription " << name << "@" << session.getName()
+                  << ": created " << created << " of " << todo.size() << " monitored items ("
+                  << UA_StatusCode_name(status) << ")" << std::endl;
+}
+
+void
+SubscriptionOpen62541::removeMonitoredItems (const std::vector<ItemOpen62541 *> &list)
+{
+    std::vector<ItemOpen62541 *> todo;
+    for (auto &it : list)
+        if (it->getSubscription() == this && it->getMonitoredItemId())
+            todo.push_back(it);
+    if (todo.empty())
+        return;
+
+    size_t chunk = todo.size();
+    if (session.MaxMonitoredItemsPerCall)
+        chunk = session.MaxMonitoredItemsPerCall;
+    size_t deleted = 0;
+    UA_StatusCode status = UA_STATUSCODE_GOOD;
+
+    for (size_t first = 0; first < todo.size(); first += chunk) {
+        const size_t n = std::min(chunk, todo.size() - first);
+        UA_DeleteMonitoredItemsRequest request;
+        UA_DeleteMonitoredItemsRequest_init(&request);
+        request.subscriptionId = subscriptionSettings.subscriptionId;
+        request.monitoredItemIds = static_cast<UA_UInt32*>(UA_Array_new(n, &UA_TYPES[UA_TYPES_UINT32]));
+        request.monitoredItemIdsSize = n;
+        for (size_t i = 0; i < n; i++) {
+            request.monitoredItemIds[i] = todo[first + i]->getMonitoredItemId();
+            todo[first + i]->setMonitoredItemId(0);
+        }
+        UA_DeleteMonitoredItemsResponse response = UA_Client_MonitoredItems_delete(session.client, request);
+        status = response.responseHeader.serviceResult;
+        if (UA_STATUS_IS_BAD(status)) {
+            errlogPrintf("OPC UA subscription %s: deleteMonitoredItems on session %s failed (%s)\n",
+                         name.c_str(), session.getName().c_str(), UA_StatusCode_name(status));
+        } else {
+            for (size_t i = 0; i < response.resultsSize; i++)
+                if (response.results[i] == UA_STATUSCODE_GOOD)
+                    deleted++;
+        }
+        UA_DeleteMonitoredItemsResponse_clear(&response);
+        UA_DeleteMonitoredItemsRequest_clear(&request);
     }
+    if (debug)
+        std::cout << "Subscription " << name << "@" << session.getName()
+                  << ": deleted " << deleted << " of " << todo.size() << " monitored items ("
+                  << UA_StatusCode_name(status) << ")" << std::endl;
 }
 
 void
@@ -203,15 +593,15 @@ SubscriptionOpen62541::clear ()
 void
 SubscriptionOpen62541::addItemOpen62541 (ItemOpen62541 *item)
 {
-    items.push_back(item);
+    Guard G(session.itemsLock);
+    items.insert(item);
 }
 
 void
 SubscriptionOpen62541::removeItemOpen62541 (ItemOpen62541 *item)
 {
-    auto it = std::find(items.begin(), items.end(), item);
-    if (it != items.end())
-        items.erase(it);
+    Guard G(session.itemsLock);
+    items.erase(item);
 }
 
 
@@ -236,7 +626,8 @@ SubscriptionOpen62541::dataChange (UA_UInt32 monitorId, ItemOpen62541 &item, UA_
             std::cout << "/" << item.linkinfo.identifierString;
         std::cout << ")" << std::endl;
     }
-    item.setIncomingData(*value, ProcessReason::incomingData);
+    notifications++;
+    session.deliverData(&item, *value, ProcessReason::incomingData);
 }
 
 } // namespace DevOpcua
@@ -15,14 +15,19 @@
 
 #include <vector>
 #include <set>
+#include <map>
+#include <memory>
 
 #include <epicsString.h>
 #include <epicsTypes.h>
+#include <epicsTime.h>
+#include <epicsMutex.h>
 #include <shareLib.h>
 
 #include "SessionOpen62541.h"
 #include "Subscription.h"
 #include "Registry.h"
+#include "IndexedVector.h"
 
 namespace DevOpcua {
 
@@ -108,6 +113,11 @@ public:
      */
     virtual Session &getSession() const override;
 
+    /**
+     * @brief Get the counters of lost updates. See DevOpcua::Subscription::getCounters
+     */
+    virtual void getCounters(SubscriptionCounters &counters) const override;
+
     /**
      * @brief Get the session (implementation) that this subscription
      * is running on.
@@ -146,13 +156,26 @@ public:
     void create();
 
     /**
-     * @brief Add all monitored items of this subscription to the server.
+     * @brief Add monitored items of this subscription to the server.
+     *
+     * If the subscription is created, the monitored items for the items of
+     * the list that are configured to be on this subscription are being added
+     * (created on the server side) using batched createMonitoredItems service calls.
+     *
+     * @param list  items to create monitored items for (others are skipped)
+     */
+    void addMonitoredItems(const std::vector<ItemOpen62541 *> &list);
+
+    /**
+     * @brief Remove monitored items of this subscription from the server.
+     *
+     * The monitored items of the items in the list that have been created on
+     * this subscription are being deleted using batched deleteMonitoredItems
+     * service calls.
      *
-     * If the subscription is created, all monitored items (i.e. all items
-     * configured to be on the subscription) are being added (created on the
-     * server side) using the createMonitoredItems service.
+     * @param list  items to delete monitored items for (others are skipped)
      */
-    void addMonitoredItems();
+    void removeMonitoredItems(const std::vector<ItemOpen62541 *> &list);
 
     /**
      * @brief Clear connection to driver level.
@@ -162,6 +185,74 @@ public:
      */
     void clear();
 
+    /**
+     * @brief Check if the server diagnostics of the subscription should be read.
+     *
+     * Schedules the next read if true.
+     *
+     * @param now  current time
+     *
+     * @return true if diagnostics are enabled (option diag) and due
+     */
+    bool diagnosticsDue(const epicsTime &now);
+
+    /**
+     * @brief Set the result of reading the server diagnostics.
+     *
+     * @param status  status of the read (bad if the server does not provide them)
+     * @param counters  server counters of the subscription, nullptr if not found
+     */
+    void setServerDiagnostics(const UA_StatusCode status, const SubscriptionCounters *counters);
+
+    /**
+     * @brief Get the server-assigned subscription id.
+     *
+     * @return subscription id, 0 if not created
+     */
+    UA_UInt32 getSubscriptionId() const { return subscriptionSettings.subscriptionId; }
+
+    /**
+     * @brief Get the subscription that an item is monitored on.
+     *
+     * In auto mode (option auto), items are grouped by the rate class of
+     * their sampling interval. Each group is a subscription of its own on the
+     * server, which is created when the first item of its class is added.
+     *
+     * @param samplingInterval  requested sampling interval of the item [ms]
+     *
+     * @return  rate group of the item in auto mode, this subscription otherwise
+     */
+    SubscriptionOpen62541 *rateGroup(const double samplingInterval);
+
+    /**
+     * @brief Get the subscriptions that are created on the server.
+     *
+     * @return  the rate groups in auto mode, this subscription otherwise
+     */
+    std::vector<SubscriptionOpen62541 *> serverSubscriptions();
+
+    /**
+     * @brief Rate class of a sampling interval.
+     *
+     * Rounds up to the 1-2-5 series (..., 50, 100, 200, 500, 1000, ...).
+     *
+     * @param interval  sampling interval [ms]
+     *
+     * @return  rate class [ms], 0 for intervals <= 0
+     */
+    static double rateClass(const double interval);
+
+    /**
+     * @brief Publishing interval of a rate group.
+     *
+     * @param fastest  shortest sampling interval of the members [ms]
+     * @param min  lower bound [ms]
+     * @param max  upper bound [ms] (0 = none)
+     *
+     * @return  publishing interval [ms]
+     */
+    static double groupInterval(const double fastest, const double min, const double max);
+
     // SubscriptionCallback interface
     void subscriptionStatusChanged(
             UA_StatusCode   status
@@ -174,12 +265,34 @@ public:
             );
 
 private:
+    // Rate group of an auto subscription
+    SubscriptionOpen62541(SubscriptionOpen62541 &parent, const double rateClass);
+    void setPublishingInterval(const double interval);
+    double fastestSamplingInterval() const;
+    double minGroupInterval() const;
+    void showCounters(const SubscriptionCounters &counters) const;
+    void showGroup(int level) const;
+
     static Registry<SubscriptionOpen62541> subscriptions; /**< subscription management */
     SessionOpen62541 &session;                            /**< reference to session */
-    std::vector<ItemOpen62541 *> items;                   /**< items on this subscription */
+    IndexedVector<ItemOpen62541> items;                   /**< items on this subscription (session.itemsLock) */
     UA_CreateSubscriptionResponse subscriptionSettings;   /**< subscription specific settings */
     UA_CreateSubscriptionRequest requestedSettings;       /**< requested subscription specific settings */
     bool enable;                                          /**< subscription enable flag */
+    double diagInterval;                                  /**< server diagnostics read interval [s] (0 = off) */
+    epicsTime diagNext;                                   /**< time of the next server diagnostics read */
+    mutable epicsMutex diagLock;                          /**< lock for the server diagnostics */
+    UA_StatusCode diagStatus;                             /**< status of the last server diagnostics read */
+    SubscriptionCounters serverCounters;                  /**< server counters (from the last read) */
+    double timeout;                                       /**< subscription lifetime [ms] */
+    bool autoGroups;                                      /**< group items by rate class (option auto) */
+    double autoMin;                                       /**< lower bound of group intervals [ms] (< 0 = publishing interval) */
+    double autoMax;                                       /**< upper bound of group intervals [ms] (0 = none) */
+    std::map<double, std::unique_ptr<SubscriptionOpen62541>> groups; /**< rate groups by class (session.itemsLock) */
+    SubscriptionOpen62541 *parent;                        /**< auto subscription of a rate group */
+    double groupClass;                                    /**< rate class of a rate group [ms] */
+    unsigned long notifications;                          /**< data change notifications since created */
+    epicsTime created;                                    /**< time of the last creation on the server */
 };
 
 } // namespace DevOpcua
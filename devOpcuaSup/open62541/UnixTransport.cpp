@@ -0,0 +1,276 @@
+/*************************************************************************\
+* Copyright (c) 2026 ITER Organization.
+* This module is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Author: Dirk Zimoch <dirk.zimoch@psi.ch>
+ */
+
+#include <cstring>
+#include <cerrno>
+#include <string>
+
+#include "UnixTransport.h"
+
+#ifdef HAS_UNIX_TRANSPORT
+#include <unistd.h>
+#include <poll.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/stat.h>
+
+#include <open62541/plugin/log.h>
+#include <open62541/plugin/network.h>
+#endif
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+namespace DevOpcua {
+
+const char unixTransportScheme[] = "opc.unix://";
+
+bool
+isUnixTransportUrl (const std::string &url)
+{
+    return url.compare(0, sizeof(unixTransportScheme) - 1, unixTransportScheme) == 0;
+}
+
+std::string
+unixTransportPath (const std::string &url)
+{
+    if (!isUnixTransportUrl(url))
+        return std::string();
+    return url.substr(sizeof(unixTransportScheme) - 1);
+}
+
+#ifdef HAS_UNIX_TRANSPORT
+
+namespace {
+
+// Connection handle: what the poll and recv functions need to know
+struct UnixConnection {
+    std::string url;
+    std::string path;
+    UA_ConnectionConfig config;
+};
+
+UA_StatusCode
+unixGetSendBuffer (UA_Connection *connection, size_t length, UA_ByteString *buf)
+{
+    const UnixConnection *uc = static_cast<UnixConnection *>(connection->handle);
+    if (uc && uc->config.sendBufferSize && uc->config.sendBufferSize < length)
+        return UA_STATUSCODE_BADCOMMUNICATIONERROR;
+    return UA_ByteString_allocBuffer(buf, length);
+}
+
+void
+unixReleaseBuffer (UA_Connection *, UA_ByteString *buf)
+{
+    UA_ByteString_clear(buf);
+}
+
+void
+unixClose (UA_Connection *connection)
+{
+    if (connection->state == UA_CONNECTIONSTATE_CLOSED)
+        return;
+    if (connection->sockfd != UA_INVALID_SOCKET) {
+        shutdown(connection->sockfd, SHUT_RDWR);
+        close(connection->sockfd);
+        connection->sockfd = UA_INVALID_SOCKET;
+    }
+    connection->state = UA_CONNECTIONSTATE_CLOSED;
+}
+
+void
+unixFree (UA_Connection *connection)
+{
+    delete static_cast<UnixConnection *>(connection->handle);
+    connection->handle = nullptr;
+}
+
+// The socket is blocking: send the full buffer, which is always freed
+UA_StatusCode
+unixSend (UA_Connection *connection, UA_ByteString *buf)
+{
+    if (connection->state == UA_CONNECTIONSTATE_CLOSED) {
+        UA_ByteString_clear(buf);
+        return UA_STATUSCODE_BADCONNECTIONCLOSED;
+    }
+    size_t nWritten = 0;
+    while (nWritten < buf->length) {
+        ssize_t n = send(connection->sockfd, buf->data + nWritten,
+                         buf->length - nWritten, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            connection->close(connection);
+            UA_ByteString_clear(buf);
+            return UA_STATUSCODE_BADCONNECTIONCLOSED;
+        }
+        nWritten += static_cast<size_t>(n);
+    }
+    UA_ByteString_clear(buf);
+    return UA_STATUSCODE_GOOD;
+}
+
+UA_StatusCode
+unixRecv (UA_Connection *connection, UA_ByteString *response, UA_UInt32 timeout)
+{
+    if (connection->state == UA_CONNECTIONSTATE_CLOSED)
+        return UA_STATUSCODE_BADCONNECTIONCLOSED;
+
+    struct pollfd pfd;
+    pfd.fd = connection->sockfd;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    int result = poll(&pfd, 1, static_cast<int>(timeout));
+    if (result == 0 || (result < 0 && errno == EINTR))
+        return UA_STATUSCODE_GOODNONCRITICALTIMEOUT;
+    if (result < 0) {
+        connection->close(connection);
+        return UA_STATUSCODE_BADCONNECTIONCLOSED;
+    }
+
+    bool internallyAllocated = !response->length;
+    if (internallyAllocated) {
+        const UnixConnection *uc = static_cast<UnixConnection *>(connection->handle);
+        size_t bufferSize = 16384; // same default as the TCP layer
+        if (uc && uc->config.recvBufferSize)
+            bufferSize = uc->config.recvBufferSize;
+        UA_StatusCode status = UA_ByteString_allocBuffer(response, bufferSize);
+        if (status != UA_STATUSCODE_GOOD)
+            return status;
+    }
+
+    ssize_t n;
+    do {
+        n = recv(connection->sockfd, response->data, response->length, 0);
+    } while (n < 0 && errno == EINTR);
+
+    if (n <= 0) { // 0 = closed by the server
+        if (internallyAllocated)
+            UA_ByteString_clear(response);
+        connection->close(connection);
+        return UA_STATUSCODE_BADCONNECTIONCLOSED;
+    }
+    response->length = static_cast<size_t>(n);
+    return UA_STATUSCODE_GOOD;
+}
+
+// Connecting a Unix-domain socket either succeeds or fails immediately
+UA_StatusCode
+unixPoll (UA_Connection *connection, UA_UInt32, const UA_Logger *logger)
+{
+    if (connection->state == UA_CONNECTIONSTATE_CLOSED)
+        return UA_STATUSCODE_BADDISCONNECT;
+    if (connection->state == UA_CONNECTIONSTATE_ESTABLISHED)
+        return UA_STATUSCODE_GOOD;
+
+    UnixConnection *uc = static_cast<UnixConnection *>(connection->handle);
+
+    if (connection->sockfd == UA_INVALID_SOCKET) {
+        connection->sockfd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (connection->sockfd == UA_INVALID_SOCKET) {
+            UA_LOG_WARNING(logger, UA_LOGCATEGORY_NETWORK,
+                           "Could not create client socket: %s", strerror(errno));
+            unixClose(connection);
+            return UA_STATUSCODE_BADDISCONNECT;
+        }
+#ifdef SO_NOSIGPIPE
+        int val = 1;
+        setsockopt(connection->sockfd, SOL_SOCKET, SO_NOSIGPIPE, &val, sizeof(val));
+#endif
+    }
+
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, uc->path.c_str(), sizeof(addr.sun_path) - 1);
+
+    int status;
+    do {
+        status = ::connect(connection->sockfd, reinterpret_cast<struct sockaddr *>(&addr),
+                           sizeof(addr));
+    } while (status < 0 && errno == EINTR);
+    if (status < 0) {
+        UA_LOG_WARNING(logger, UA_LOGCATEGORY_NETWORK,
+                       "Connection to %s failed with error: %s",
+                       uc->url.c_str(), strerror(errno));
+        unixClose(connection);
+        return UA_STATUSCODE_BADDISCONNECT;
+    }
+
+    connection->state = UA_CONNECTIONSTATE_ESTABLISHED;
+    return UA_STATUSCODE_GOOD;
+}
+
+UA_Connection
+unixInit (UA_ConnectionConfig config, const UA_String endpointUrl,
+          UA_UInt32, const UA_Logger *logger)
+{
+    UA_Connection connection;
+    memset(&connection, 0, sizeof(UA_Connection));
+    connection.state = UA_CONNECTIONSTATE_OPENING;
+    connection.sockfd = UA_INVALID_SOCKET;
+    connection.send = unixSend;
+    connection.recv = unixRecv;
+    connection.close = unixClose;
+    connection.free = unixFree;
+    connection.getSendBuffer = unixGetSendBuffer;
+    connection.releaseSendBuffer = unixReleaseBuffer;
+    connection.releaseRecvBuffer = unixReleaseBuffer;
+
+    UnixConnection *uc = new UnixConnection;
+    uc->url.assign(reinterpret_cast<const char *>(endpointUrl.data), endpointUrl.length);
+    uc->path = unixTransportPath(uc->url);
+    uc->config = config;
+    connection.handle = uc;
+
+    if (uc->path.empty() || uc->path.length() >= sizeof(sockaddr_un::sun_path)) {
+        UA_LOG_WARNING(logger, UA_LOGCATEGORY_NETWORK,
+                       "Server url is invalid: %s", uc->url.c_str());
+        connection.state = UA_CONNECTIONSTATE_CLOSED;
+    }
+    return connection;
+}
+
+} // namespace
+
+bool
+setUnixTransport (UA_ClientConfig *config)
+{
+    config->initConnectionFunc = unixInit;
+    config->pollConnectionFunc = unixPoll;
+    return true;
+}
+
+bool
+isUnixSocket (const std::string &path)
+{
+    struct stat st;
+    return !path.empty() && stat(path.c_str(), &st) == 0 && S_ISSOCK(st.st_mode);
+}
+
+#else // #ifdef HAS_UNIX_TRANSPORT
+
+bool
+setUnixTransport (UA_ClientConfig *)
+{
+    return false;
+}
+
+bool
+isUnixSocket (const std::string &)
+{
+    return false;
+}
+
+#endif // #ifdef HAS_UNIX_TRANSPORT
+
+} // namespace DevOpcua
@@ -0,0 +1,76 @@
+/*************************************************************************\
+* Copyright (c) 2026 ITER Organization.
+* This module is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Author: Dirk Zimoch <dirk.zimoch@psi.ch>
+ */
+
+#ifndef DEVOPCUA_UNIXTRANSPORT_H
+#define DEVOPCUA_UNIXTRANSPORT_H
+
+#include <string>
+
+#include <open62541/client.h>
+
+// The Unix-domain transport plugs into the connection based client network
+// layer (initConnectionFunc/pollConnectionFunc) that was replaced by the
+// EventLoop in open62541 1.4
+#if UA_OPEN62541_VER_MAJOR*100+UA_OPEN62541_VER_MINOR < 104 && !defined(_WIN32)
+#define HAS_UNIX_TRANSPORT
+#endif
+
+namespace DevOpcua {
+
+/**
+ * @brief URL scheme selecting the Unix-domain socket transport.
+ *
+ * The path of the socket follows the scheme, e.g. "opc.unix:///run/plc.sock"
+ * connects to the socket "/run/plc.sock".
+ * The OPC UA binary protocol (UACP/UASC) runs unchanged on the stream socket,
+ * so a co-located server only needs to accept connections on that socket.
+ */
+extern const char unixTransportScheme[];
+
+/**
+ * @brief Check if a server URL selects the Unix-domain socket transport.
+ *
+ * @param url  server URL
+ * @return  true if the URL starts with "opc.unix://"
+ */
+bool isUnixTransportUrl(const std::string &url);
+
+/**
+ * @brief Extract the socket path from a Unix-domain transport URL.
+ *
+ * @param url  server URL (must start with "opc.unix://")
+ * @return  socket path, empty if the URL has no path
+ */
+std::string unixTransportPath(const std::string &url);
+
+/**
+ * @brief Install the Unix-domain socket transport in a client configuration.
+ *
+ * Replaces the TCP connection functions of the client network layer.
+ * Must be called before connecting (or running discovery) with the client.
+ *
+ * @param config  client configuration
+ * @return  false if the client library does not support custom transports
+ */
+bool setUnixTransport(UA_ClientConfig *config);
+
+/**
+ * @brief Check if a Unix-domain socket exists at a path.
+ *
+ * Used to detect a running local proxy (opcuaProxy).
+ *
+ * @param path  socket path
+ * @return  false if there is no socket or the transport is not supported
+ */
+bool isUnixSocket(const std::string &path);
+
+} // namespace DevOpcua
+
+#endif // DEVOPCUA_UNIXTRANSPORT_H
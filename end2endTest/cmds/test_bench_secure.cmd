@@ -0,0 +1,24 @@
+# Run CAS on localhost
+epicsEnvSet("EPICS_CAS_INTF_ADDR_LIST", "127.0.0.1")
+
+# Secured benchmark server (server/opcuaTestSecureServer)
+# OPCUA_BENCH_* are set by the test harness for each security mode/policy
+epicsEnvSet("OPCSERVER", "127.0.0.1")
+epicsEnvSet("OPCPORT", "4842")
+
+# OPCUA environment variables
+epicsEnvSet("SESSION",   "OPC1")
+epicsEnvSet("SUBSCRIPT", "SUB1")
+
+# Register all support components
+dbLoadDatabase "${IOC_TOP}/dbd/opcuaIoc.dbd"
+opcuaIoc_registerRecordDeviceDriver pdbbase
+
+opcuaClientCertificate $(OPCUA_BENCH_CERT) $(OPCUA_BENCH_KEY)
+# debug=1 prints the crypto statistics when the session disconnects
+opcuaSession $(SESSION) opc.tcp://$(OPCSERVER):$(OPCPORT) sec-mode=$(OPCUA_BENCH_SECMODE):sec-policy=$(OPCUA_BENCH_SECPOLICY):debug=1
+opcuaSubscription $(SUBSCRIPT) $(SESSION) 10
+
+dbLoadRecords("test_bench.db", "SESS=$(SESSION), OPCSUB=$(SUBSCRIPT)")
+
+iocInit()
@@ -0,0 +1,15 @@
+# Run CAS on localhost
+epicsEnvSet("EPICS_CAS_INTF_ADDR_LIST", "127.0.0.1")
+
+# Register all support components
+dbLoadDatabase "${IOC_TOP}/dbd/opcuaIoc.dbd"
+opcuaIoc_registerRecordDeviceDriver pdbbase
+
+# PubSub reader for the test publisher (server/opcuaTestPublisher)
+opcuaPubSubReader PS1 opc.udp://224.0.0.22:4840 publisher-id=2234:writer-group-id=100:dataset-writer-id=62541
+opcuaPubSubField PS1 Counter UInt32
+opcuaPubSubField PS1 Ramp Double
+
+dbLoadRecords("test_pubsub.db", "READER=PS1")
+
+iocInit()
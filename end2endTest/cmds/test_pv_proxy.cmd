@@ -0,0 +1,23 @@
+# Run CAS on localhost
+epicsEnvSet("EPICS_CAS_INTF_ADDR_LIST", "127.0.0.1")
+
+# OPC simulation server, served through a local opcuaProxy
+# (started with its socket in OPCUA_PROXY_SOCKET)
+epicsEnvSet("OPCSERVER", "127.0.0.1")
+epicsEnvSet("OPCPORT", "4840")
+epicsEnvSet("OPCNAMESPACE", "2")
+
+# OPCUA environment variables
+epicsEnvSet("SESSION",   "OPC1")
+epicsEnvSet("SUBSCRIPT", "SUB1")
+
+# Register all support components
+dbLoadDatabase "${IOC_TOP}/dbd/opcuaIoc.dbd"
+opcuaIoc_registerRecordDeviceDriver pdbbase
+
+opcuaSession $(SESSION) opc.tcp://$(OPCSERVER):$(OPCPORT) sec-mode=None proxy=$(OPCUA_PROXY_SOCKET)
+opcuaSubscription $(SUBSCRIPT) $(SESSION) 100
+
+dbLoadRecords("test_pv.db", "OPCSUB=$(SUBSCRIPT), NS=$(OPCNAMESPACE)")
+
+iocInit()
@@ -0,0 +1,25 @@
+# Run CAS on localhost
+epicsEnvSet("EPICS_CAS_INTF_ADDR_LIST", "127.0.0.1")
+
+# OPC simulation server
+epicsEnvSet("OPCSERVER", "127.0.0.1")
+epicsEnvSet("OPCPORT", "4840")
+epicsEnvSet("OPCNAMESPACE", "2")
+
+# OPCUA environment variables
+epicsEnvSet("SESSION",   "OPC1")
+epicsEnvSet("SUBSCRIPT", "SUB1")
+
+# Load OPCUA module startup script
+iocshLoad("$(opcua_DIR)/opcua.iocsh", "P=OPC:,SESS=$(SESSION),SUBS=$(SUBSCRIPT),INET=$(OPCSERVER),PORT=$(OPCPORT)")
+
+# At most 2 nodes per read request: snapshot group snap1 (3 nodes) is not split
+opcuaOptions $(SESSION) read-nodes-max=2
+
+dbLoadRecords("test_snapshot.db", "OPCSESS=$(SESSION), NS=$(OPCNAMESPACE)")
+
+iocInit()
+
+# Read snap1 once the session is connected
+epicsThreadSleep 3
+opcuaSnapshot $(SESSION) snap1
@@ -0,0 +1,22 @@
+# Run CAS on localhost
+epicsEnvSet("EPICS_CAS_INTF_ADDR_LIST", "127.0.0.1")
+
+# OPC simulation server on a Unix-domain socket
+# (started with OPCUA_TEST_UNIX_SOCKET set to the same path)
+epicsEnvSet("OPCSOCKET", "/tmp/opcuaTestServer.sock")
+epicsEnvSet("OPCNAMESPACE", "2")
+
+# OPCUA environment variables
+epicsEnvSet("SESSION",   "OPC1")
+epicsEnvSet("SUBSCRIPT", "SUB1")
+
+# Register all support components
+dbLoadDatabase "${IOC_TOP}/dbd/opcuaIoc.dbd"
+opcuaIoc_registerRecordDeviceDriver pdbbase
+
+opcuaSession $(SESSION) opc.unix://$(OPCSOCKET) sec-mode=None
+opcuaSubscription $(SUBSCRIPT) $(SESSION) 100
+
+dbLoadRecords("test_pv.db", "OPCSUB=$(SUBSCRIPT), NS=$(OPCNAMESPACE)")
+
+iocInit()
@@ -0,0 +1,21 @@
+# Run CAS on localhost
+epicsEnvSet("EPICS_CAS_INTF_ADDR_LIST", "127.0.0.1")
+
+# OPC simulation server
+epicsEnvSet("OPCSERVER", "127.0.0.1")
+epicsEnvSet("OPCPORT", "4840")
+epicsEnvSet("OPCNAMESPACE", "2")
+
+# OPCUA environment variables
+epicsEnvSet("SESSION",   "OPC1")
+epicsEnvSet("SUBSCRIPT", "SUB1")
+
+# Load OPCUA module startup script
+iocshLoad("$(opcua_DIR)/opcua.iocsh", "P=OPC:,SESS=$(SESSION),SUBS=$(SUBSCRIPT),INET=$(OPCSERVER),PORT=$(OPCPORT)")
+
+# Second session to the same server
+opcuaSession OPC2 opc.tcp://$(OPCSERVER):$(OPCPORT) sec-mode=None
+
+dbLoadRecords("test_writegroup.db", "OPCSESS=$(SESSION), OPCSESS2=OPC2, OPCSUB=$(SUBSCRIPT), NS=$(OPCNAMESPACE)")
+
+iocInit()
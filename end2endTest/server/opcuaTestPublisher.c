@@ -0,0 +1,179 @@
+/*************************************************************************\
+* Copyright (c) 2026 ITER Organization.
+* This module is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ * OPC UA PubSub test publisher (UADP over UDP multicast)
+ *
+ * Publishes a DataSet with two fields (Counter: UInt32, Ramp: Double)
+ * to opc.udp://224.0.0.22:4840 every 100 ms,
+ * PublisherId 2234, WriterGroupId 100, DataSetWriterId 62541.
+ *
+ * Needs an open62541 (>= 1.4) installation built with UA_ENABLE_PUBSUB.
+ * The server part listens on opc.tcp://localhost:4841 (to not collide with opcuaTestServer).
+ */
+
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <open62541/plugin/log_stdout.h>
+#include <open62541/server.h>
+#include <open62541/server_config_default.h>
+#include <open62541/server_pubsub.h>
+
+#if UA_OPEN62541_VER_MAJOR*100+UA_OPEN62541_VER_MINOR < 104
+#error "opcuaTestPublisher needs open62541 >= 1.4"
+#endif
+#ifndef UA_ENABLE_PUBSUB
+#error "opcuaTestPublisher needs open62541 built with UA_ENABLE_PUBSUB"
+#endif
+
+#define PUBLISHER_ID       2234
+#define WRITER_GROUP_ID    100
+#define DATASET_WRITER_ID  62541
+#define PUBLISH_URL        "opc.udp://224.0.0.22:4840/"
+#define INTERVAL_MS        100
+
+static UA_NodeId counterId;
+static UA_NodeId rampId;
+static UA_UInt32 counter = 0;
+
+static volatile UA_Boolean running = true;
+
+static void
+stopHandler(int sig) {
+    running = false;
+}
+
+static void
+addVariable(UA_Server *server, const char *name, const UA_DataType *type,
+            void *value, UA_NodeId *outId) {
+    UA_VariableAttributes attr = UA_VariableAttributes_default;
+    UA_Variant_setScalar(&attr.value, value, type);
+    attr.displayName = UA_LOCALIZEDTEXT("en-US", (char *)name);
+    attr.dataType = type->typeId;
+    UA_Server_addVariableNode(server, UA_NODEID_STRING(1, (char *)name),
+                              UA_NODEID_NUMERIC(0, UA_NS0ID_OBJECTSFOLDER),
+                              UA_NODEID_NUMERIC(0, UA_NS0ID_ORGANIZES),
+                              UA_QUALIFIEDNAME(1, (char *)name),
+                              UA_NODEID_NUMERIC(0, UA_NS0ID_BASEDATAVARIABLETYPE),
+                              attr, NULL, outId);
+}
+
+/* Update the published variables */
+static void
+updateValues(UA_Server *server, void *data) {
+    UA_Variant value;
+    UA_Double ramp;
+
+    counter++;
+    ramp = (UA_Double)(counter % 100) / 10.0;
+    UA_Variant_setScalar(&value, &counter, &UA_TYPES[UA_TYPES_UINT32]);
+    UA_Server_writeValue(server, counterId, value);
+    UA_Variant_setScalar(&value, &ramp, &UA_TYPES[UA_TYPES_DOUBLE]);
+    UA_Server_writeValue(server, rampId, value);
+}
+
+static void
+addPublishedField(UA_Server *server, UA_NodeId pds, const char *alias, UA_NodeId var) {
+    UA_DataSetFieldConfig fieldConfig;
+    UA_NodeId fieldId;
+
+    memset(&fieldConfig, 0, sizeof(UA_DataSetFieldConfig));
+    fieldConfig.dataSetFieldType = UA_PUBSUB_DATASETFIELD_VARIABLE;
+    fieldConfig.field.variable.fieldNameAlias = UA_STRING((char *)alias);
+    fieldConfig.field.variable.promotedField = UA_FALSE;
+    fieldConfig.field.variable.publishParameters.publishedVariable = var;
+    fieldConfig.field.variable.publishParameters.attributeId = UA_ATTRIBUTEID_VALUE;
+    UA_Server_addDataSetField(server, pds, &fieldConfig, &fieldId);
+}
+
+static UA_StatusCode
+addPublisher(UA_Server *server) {
+    UA_PubSubConnectionConfig connectionConfig;
+    UA_NetworkAddressUrlDataType networkAddressUrl = {UA_STRING_NULL, UA_STRING(PUBLISH_URL)};
+    UA_PublishedDataSetConfig pdsConfig;
+    UA_WriterGroupConfig writerGroupConfig;
+    UA_UadpWriterGroupMessageDataType *writerGroupMessage;
+    UA_DataSetWriterConfig dataSetWriterConfig;
+    UA_NodeId connectionId, pdsId, writerGroupId, dataSetWriterId;
+    UA_StatusCode status;
+
+    memset(&connectionConfig, 0, sizeof(connectionConfig));
+    connectionConfig.name = UA_STRING("UADP Connection");
+    connectionConfig.transportProfileUri =
+        UA_STRING("http://opcfoundation.org/UA-Profile/Transport/pubsub-udp-uadp");
+    UA_Variant_setScalar(&connectionConfig.address, &networkAddressUrl,
+                         &UA_TYPES[UA_TYPES_NETWORKADDRESSURLDATATYPE]);
+    connectionConfig.publisherIdType = UA_PUBLISHERIDTYPE_UINT16;
+    connectionConfig.publisherId.uint16 = PUBLISHER_ID;
+    status = UA_Server_addPubSubConnection(server, &connectionConfig, &connectionId);
+    if (status != UA_STATUSCODE_GOOD)
+        return status;
+
+    memset(&pdsConfig, 0, sizeof(pdsConfig));
+    pdsConfig.publishedDataSetType = UA_PUBSUB_DATASET_PUBLISHEDITEMS;
+    pdsConfig.name = UA_STRING("Test PDS");
+    UA_Server_addPublishedDataSet(server, &pdsConfig, &pdsId);
+
+    /* Field order defines the DataSetMetaData (see cmds/test_pubsub.cmd) */
+    addPublishedField(server, pdsId, "Counter", counterId);
+    addPublishedField(server, pdsId, "Ramp", rampId);
+
+    memset(&writerGroupConfig, 0, sizeof(writerGroupConfig));
+    writerGroupConfig.name = UA_STRING("Test WriterGroup");
+    writerGroupConfig.publishingInterval = INTERVAL_MS;
+    writerGroupConfig.writerGroupId = WRITER_GROUP_ID;
+    writerGroupConfig.encodingMimeType = UA_PUBSUB_ENCODING_UADP;
+    writerGroupConfig.messageSettings.encoding = UA_EXTENSIONOBJECT_DECODED;
+    writerGroupConfig.messageSettings.content.decoded.type =
+        &UA_TYPES[UA_TYPES_UADPWRITERGROUPMESSAGEDATATYPE];
+    writerGroupMessage = UA_UadpWriterGroupMessageDataType_new();
+    writerGroupMessage->networkMessageContentMask =
+        (UA_UadpNetworkMessageContentMask)(UA_UADPNETWORKMESSAGECONTENTMASK_PUBLISHERID |
+                                           UA_UADPNETWORKMESSAGECONTENTMASK_GROUPHEADER |
+                                           UA_UADPNETWORKMESSAGECONTENTMASK_WRITERGROUPID |
+                                           UA_UADPNETWORKMESSAGECONTENTMASK_PAYLOADHEADER);
+    writerGroupConfig.messageSettings.content.decoded.data = writerGroupMessage;
+    status = UA_Server_addWriterGroup(server, connectionId, &writerGroupConfig, &writerGroupId);
+    UA_UadpWriterGroupMessageDataType_delete(writerGroupMessage);
+    if (status != UA_STATUSCODE_GOOD)
+        return status;
+    UA_Server_setWriterGroupOperational(server, writerGroupId);
+
+    memset(&dataSetWriterConfig, 0, sizeof(dataSetWriterConfig));
+    dataSetWriterConfig.name = UA_STRING("Test DataSetWriter");
+    dataSetWriterConfig.dataSetWriterId = DATASET_WRITER_ID;
+    dataSetWriterConfig.keyFrameCount = 10;
+    return UA_Server_addDataSetWriter(server, writerGroupId, pdsId,
+                                      &dataSetWriterConfig, &dataSetWriterId);
+}
+
+int main(void) {
+    UA_Server *server;
+    UA_Double ramp = 0.0;
+    UA_StatusCode status;
+
+    signal(SIGINT, stopHandler);
+    signal(SIGTERM, stopHandler);
+
+    server = UA_Server_new();
+    UA_ServerConfig_setMinimal(UA_Server_getConfig(server), 4841, NULL);
+
+    addVariable(server, "Counter", &UA_TYPES[UA_TYPES_UINT32], &counter, &counterId);
+    addVariable(server, "Ramp", &UA_TYPES[UA_TYPES_DOUBLE], &ramp, &rampId);
+    UA_Server_addRepeatedCallback(server, updateValues, NULL, INTERVAL_MS, NULL);
+
+    status = addPublisher(server);
+    if (status == UA_STATUSCODE_GOOD)
+        status = UA_Server_run(server, &running);
+    else
+        UA_LOG_ERROR(UA_Log_Stdout, UA_LOGCATEGORY_SERVER,
+                     "Failed to set up the PubSub publisher: %s", UA_StatusCode_name(status));
+
+    UA_Server_delete(server);
+    return status == UA_STATUSCODE_GOOD ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,153 @@
+/*************************************************************************\
+* Copyright (c) 2026 ITER Organization.
+* This module is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ * OPC UA test server with all security policies (benchmarks)
+ *
+ * Usage: opcuaTestSecureServer <certificate.der> <private-key.der> [port]
+ *
+ * Offers all security modes and policies of the library, accepts all client
+ * certificates and anonymous logins. Listens on opc.tcp://localhost:4842 by default.
+ * Variables (namespace 1):
+ *   Bench.Double   Double, read/write
+ *   Bench.Counter  Int32, incremented every 10 ms
+ *
+ * Needs an open62541 installation built with encryption (UA_ENABLE_ENCRYPTION).
+ */
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <open62541/plugin/log_stdout.h>
+#include <open62541/server.h>
+#include <open62541/server_config_default.h>
+
+#ifndef UA_ENABLE_ENCRYPTION
+#error "opcuaTestSecureServer needs open62541 built with UA_ENABLE_ENCRYPTION"
+#endif
+
+#if UA_OPEN62541_VER_MAJOR*100+UA_OPEN62541_VER_MINOR >= 104
+#include <open62541/plugin/certificategroup_default.h>
+#else
+#include <open62541/plugin/pki_default.h>
+#endif
+
+#define DEFAULT_PORT      4842
+#define COUNTER_PERIOD_MS 10
+#define APPLICATION_URI   "urn:opcuaTestSecureServer"
+
+static UA_NodeId counterId;
+static UA_Int32 counter = 0;
+
+static volatile UA_Boolean running = true;
+
+static void
+stopHandler(int sig) {
+    running = false;
+}
+
+static UA_ByteString
+loadFile(const char *path) {
+    UA_ByteString content = UA_BYTESTRING_NULL;
+    FILE *fp = fopen(path, "rb");
+    if(!fp)
+        return content;
+    fseek(fp, 0, SEEK_END);
+    long length = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    if(length > 0 && UA_ByteString_allocBuffer(&content, (size_t)length) == UA_STATUSCODE_GOOD) {
+        if(fread(content.data, 1, content.length, fp) != content.length)
+            UA_ByteString_clear(&content);
+    }
+    fclose(fp);
+    return content;
+}
+
+static void
+addVariable(UA_Server *server, const char *name, const UA_DataType *type,
+            void *value, UA_NodeId *outId) {
+    UA_VariableAttributes attr = UA_VariableAttributes_default;
+    UA_Variant_setScalar(&attr.value, value, type);
+    attr.displayName = UA_LOCALIZEDTEXT("en-US", (char *)name);
+    attr.dataType = type->typeId;
+    attr.accessLevel = UA_ACCESSLEVELMASK_READ | UA_ACCESSLEVELMASK_WRITE;
+    UA_Server_addVariableNode(server, UA_NODEID_STRING(1, (char *)name),
+                              UA_NODEID_NUMERIC(0, UA_NS0ID_OBJECTSFOLDER),
+                              UA_NODEID_NUMERIC(0, UA_NS0ID_ORGANIZES),
+                              UA_QUALIFIEDNAME(1, (char *)name),
+                              UA_NODEID_NUMERIC(0, UA_NS0ID_BASEDATAVARIABLETYPE),
+                              attr, NULL, outId);
+}
+
+static void
+updateCounter(UA_Server *server, void *data) {
+    UA_Variant value;
+    counter++;
+    UA_Variant_setScalar(&value, &counter, &UA_TYPES[UA_TYPES_INT32]);
+    UA_Server_writeValue(server, counterId, value);
+}
+
+int main(int argc, char **argv) {
+    signal(SIGINT, stopHandler);
+    signal(SIGTERM, stopHandler);
+
+    if(argc < 3) {
+        fprintf(stderr, "Usage: %s <certificate.der> <private-key.der> [port]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    UA_UInt16 port = argc > 3 ? (UA_UInt16)atoi(argv[3]) : DEFAULT_PORT;
+
+    UA_ByteString certificate = loadFile(argv[1]);
+    UA_ByteString privateKey = loadFile(argv[2]);
+    if(!certificate.length || !privateKey.length) {
+        UA_LOG_FATAL(UA_Log_Stdout, UA_LOGCATEGORY_USERLAND,
+                     "Cannot read certificate %s or private key %s", argv[1], argv[2]);
+        return EXIT_FAILURE;
+    }
+
+    UA_Server *server = UA_Server_new();
+    UA_ServerConfig *config = UA_Server_getConfig(server);
+    UA_StatusCode retval =
+        UA_ServerConfig_setDefaultWithSecurityPolicies(config, port, &certificate, &privateKey,
+                                                       NULL, 0, NULL, 0, NULL, 0);
+    UA_ByteString_clear(&certificate);
+    UA_ByteString_clear(&privateKey);
+    if(retval != UA_STATUSCODE_GOOD) {
+        UA_LOG_FATAL(UA_Log_Stdout, UA_LOGCATEGORY_USERLAND,
+                     "Setting up the security policies failed: %s", UA_StatusCode_name(retval));
+        UA_Server_delete(server);
+        return EXIT_FAILURE;
+    }
+
+    /* The certificate is created for this URI */
+    UA_String_clear(&config->applicationDescription.applicationUri);
+    config->applicationDescription.applicationUri = UA_STRING_ALLOC(APPLICATION_URI);
+    for(size_t i = 0; i < config->endpointsSize; i++) {
+        UA_String_clear(&config->endpoints[i].server.applicationUri);
+        config->endpoints[i].server.applicationUri = UA_STRING_ALLOC(APPLICATION_URI);
+    }
+
+    /* Benchmarks use throw-away client certificates */
+#if UA_OPEN62541_VER_MAJOR*100+UA_OPEN62541_VER_MINOR >= 104
+    UA_CertificateGroup_AcceptAll(&config->secureChannelPKI);
+    UA_CertificateGroup_AcceptAll(&config->sessionPKI);
+#else
+    if(config->certificateVerification.clear)
+        config->certificateVerification.clear(&config->certificateVerification);
+    UA_CertificateVerification_AcceptAll(&config->certificateVerification);
+#endif
+
+    UA_Double dbl = 0.0;
+    addVariable(server, "Bench.Double", &UA_TYPES[UA_TYPES_DOUBLE], &dbl, NULL);
+    addVariable(server, "Bench.Counter", &UA_TYPES[UA_TYPES_INT32], &counter, &counterId);
+    UA_Server_addRepeatedCallback(server, updateCounter, NULL, COUNTER_PERIOD_MS, NULL);
+
+    retval = UA_Server_run(server, &running);
+
+    UA_Server_delete(server);
+    return retval == UA_STATUSCODE_GOOD ? EXIT_SUCCESS : EXIT_FAILURE;
+}
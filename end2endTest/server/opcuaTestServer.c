@@ -5,6 +5,7 @@
 #include <pthread.h>
 #include "open62541.h"
 #include "opcuaTestNodeSet.h"
+#include "opcuaUnixNetworkLayer.h"
 
 /* Local definitions */
 #define SLEEP_TIME_MS 1000
@@ -69,6 +70,20 @@ int main(void) {
     UA_Server *server = UA_Server_new();
     UA_ServerConfig_setDefault(UA_Server_getConfig(server));
 
+    /* Serve a Unix-domain socket instead of TCP if OPCUA_TEST_UNIX_SOCKET is set.
+     * (The server polls its network layers one after the other, each with the
+     * full timeout, so a second layer would add latency to the first.)
+     */
+    const char *unixSocket = getenv("OPCUA_TEST_UNIX_SOCKET");
+    if (unixSocket && *unixSocket) {
+        UA_ServerConfig *config = UA_Server_getConfig(server);
+        UA_ConnectionConfig cc = config->networkLayers[0].localConnectionConfig;
+        for (size_t i = 0; i < config->networkLayersSize; i++)
+            config->networkLayers[i].clear(&config->networkLayers[i]);
+        config->networkLayers[0] = opcuaUnixNetworkLayer(cc, unixSocket);
+        config->networkLayersSize = 1;
+    }
+
     /* Use namespace ids generated by the server */
     UA_UInt16 ns[2];
     ns[0] = UA_Server_addNamespace(server, "http://opcfoundation.org/UA/");
@@ -0,0 +1,278 @@
+/*************************************************************************\
+* Copyright (c) 2026 ITER Organization.
+* This module is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ * Unix-domain socket server network layer for the OPC UA test server
+ *
+ * Author: Dirk Zimoch <dirk.zimoch@psi.ch>
+ */
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "opcuaUnixNetworkLayer.h"
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+/* Modelled on the TCP server network layer of open62541 1.2 */
+
+typedef struct UnixConnectionEntry {
+    UA_Connection connection;
+    struct UnixConnectionEntry *next;
+} UnixConnectionEntry;
+
+typedef struct {
+    const UA_Logger *logger;
+    char *path;
+    int serverSocket;
+    UA_UInt32 recvBufferSize;
+    UnixConnectionEntry *connections;
+} ServerNetworkLayerUnix;
+
+static UA_StatusCode
+unix_getSendBuffer(UA_Connection *connection, size_t length, UA_ByteString *buf) {
+    return UA_ByteString_allocBuffer(buf, length);
+}
+
+static void
+unix_releaseBuffer(UA_Connection *connection, UA_ByteString *buf) {
+    UA_ByteString_clear(buf);
+}
+
+static UA_StatusCode
+unix_send(UA_Connection *connection, UA_ByteString *buf) {
+    if(connection->state == UA_CONNECTIONSTATE_CLOSED) {
+        UA_ByteString_clear(buf);
+        return UA_STATUSCODE_BADCONNECTIONCLOSED;
+    }
+    size_t nWritten = 0;
+    while(nWritten < buf->length) {
+        ssize_t n = send(connection->sockfd, buf->data + nWritten,
+                         buf->length - nWritten, MSG_NOSIGNAL);
+        if(n < 0) {
+            if(errno == EINTR)
+                continue;
+            connection->close(connection);
+            UA_ByteString_clear(buf);
+            return UA_STATUSCODE_BADCONNECTIONCLOSED;
+        }
+        nWritten += (size_t)n;
+    }
+    UA_ByteString_clear(buf);
+    return UA_STATUSCODE_GOOD;
+}
+
+/* Only 'shutdown', the socket is closed when listen picks up the closed connection */
+static void
+unix_close(UA_Connection *connection) {
+    if(connection->state == UA_CONNECTIONSTATE_CLOSED)
+        return;
+    shutdown(connection->sockfd, SHUT_RDWR);
+    connection->state = UA_CONNECTIONSTATE_CLOSED;
+}
+
+static void
+unix_free(UA_Connection *connection) {
+    free(connection);
+}
+
+static UA_StatusCode
+ServerNetworkLayerUnix_start(UA_ServerNetworkLayer *nl, const UA_Logger *logger,
+                             const UA_String *customHostname) {
+    ServerNetworkLayerUnix *layer = (ServerNetworkLayerUnix *)nl->handle;
+    layer->logger = logger;
+
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if(strlen(layer->path) >= sizeof(addr.sun_path)) {
+        UA_LOG_ERROR(logger, UA_LOGCATEGORY_NETWORK,
+                     "Unix socket path too long: %s", layer->path);
+        return UA_STATUSCODE_BADINTERNALERROR;
+    }
+    strcpy(addr.sun_path, layer->path);
+
+    layer->serverSocket = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(layer->serverSocket < 0) {
+        UA_LOG_ERROR(logger, UA_LOGCATEGORY_NETWORK,
+                     "Error opening the Unix server socket: %s", strerror(errno));
+        return UA_STATUSCODE_BADCOMMUNICATIONERROR;
+    }
+    unlink(layer->path);
+    if(bind(layer->serverSocket, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+       listen(layer->serverSocket, 100) < 0) {
+        UA_LOG_ERROR(logger, UA_LOGCATEGORY_NETWORK,
+                     "Error binding the Unix server socket %s: %s",
+                     layer->path, strerror(errno));
+        close(layer->serverSocket);
+        layer->serverSocket = -1;
+        return UA_STATUSCODE_BADCOMMUNICATIONERROR;
+    }
+
+    size_t len = strlen("opc.unix://") + strlen(layer->path);
+    nl->discoveryUrl.data = (UA_Byte *)UA_malloc(len);
+    if(nl->discoveryUrl.data) {
+        memcpy(nl->discoveryUrl.data, "opc.unix://", strlen("opc.unix://"));
+        memcpy(nl->discoveryUrl.data + strlen("opc.unix://"), layer->path, strlen(layer->path));
+        nl->discoveryUrl.length = len;
+    }
+
+    UA_LOG_INFO(logger, UA_LOGCATEGORY_NETWORK,
+                "Unix network layer listening on %.*s",
+                (int)nl->discoveryUrl.length, nl->discoveryUrl.data);
+    return UA_STATUSCODE_GOOD;
+}
+
+static void
+ServerNetworkLayerUnix_add(ServerNetworkLayerUnix *layer, int sockfd) {
+    UnixConnectionEntry *e = (UnixConnectionEntry *)calloc(1, sizeof(UnixConnectionEntry));
+    if(!e) {
+        close(sockfd);
+        return;
+    }
+    UA_Connection *c = &e->connection;
+    c->sockfd = sockfd;
+    c->handle = layer;
+    c->send = unix_send;
+    c->close = unix_close;
+    c->free = unix_free;
+    c->getSendBuffer = unix_getSendBuffer;
+    c->releaseSendBuffer = unix_releaseBuffer;
+    c->releaseRecvBuffer = unix_releaseBuffer;
+    c->state = UA_CONNECTIONSTATE_OPENING;
+    c->openingDate = UA_DateTime_nowMonotonic();
+    e->next = layer->connections;
+    layer->connections = e;
+
+    UA_LOG_INFO(layer->logger, UA_LOGCATEGORY_NETWORK,
+                "Connection %i | New connection over Unix socket", sockfd);
+}
+
+static UA_StatusCode
+ServerNetworkLayerUnix_listen(UA_ServerNetworkLayer *nl, UA_Server *server,
+                              UA_UInt16 timeout) {
+    ServerNetworkLayerUnix *layer = (ServerNetworkLayerUnix *)nl->handle;
+
+    fd_set fdset;
+    FD_ZERO(&fdset);
+    int highestfd = -1;
+    if(layer->serverSocket >= 0) {
+        FD_SET(layer->serverSocket, &fdset);
+        highestfd = layer->serverSocket;
+    }
+    for(UnixConnectionEntry *e = layer->connections; e; e = e->next) {
+        FD_SET(e->connection.sockfd, &fdset);
+        if(e->connection.sockfd > highestfd)
+            highestfd = e->connection.sockfd;
+    }
+    if(highestfd < 0)
+        return UA_STATUSCODE_GOOD;
+
+    struct timeval tmptv = {0, timeout * 1000};
+    if(select(highestfd + 1, &fdset, NULL, NULL, &tmptv) <= 0)
+        return UA_STATUSCODE_GOOD;
+
+    if(layer->serverSocket >= 0 && FD_ISSET(layer->serverSocket, &fdset)) {
+        int newsockfd = accept(layer->serverSocket, NULL, NULL);
+        if(newsockfd >= 0)
+            ServerNetworkLayerUnix_add(layer, newsockfd);
+    }
+
+    UnixConnectionEntry **pe = &layer->connections;
+    while(*pe) {
+        UnixConnectionEntry *e = *pe;
+        if(!FD_ISSET(e->connection.sockfd, &fdset)) {
+            pe = &e->next;
+            continue;
+        }
+
+        UA_ByteString buf;
+        ssize_t n = -1;
+        if(e->connection.state != UA_CONNECTIONSTATE_CLOSED &&
+           UA_ByteString_allocBuffer(&buf, layer->recvBufferSize) == UA_STATUSCODE_GOOD) {
+            do {
+                n = recv(e->connection.sockfd, buf.data, buf.length, 0);
+            } while(n < 0 && errno == EINTR);
+            if(n > 0) {
+                buf.length = (size_t)n;
+                UA_Server_processBinaryMessage(server, &e->connection, &buf);
+            }
+            UA_ByteString_clear(&buf);
+        }
+
+        /* Remote side or server closed the connection */
+        if(n <= 0 || e->connection.state == UA_CONNECTIONSTATE_CLOSED) {
+            UA_LOG_INFO(layer->logger, UA_LOGCATEGORY_NETWORK,
+                        "Connection %i | Closed", (int)e->connection.sockfd);
+            *pe = e->next;
+            e->connection.state = UA_CONNECTIONSTATE_CLOSED;
+            close(e->connection.sockfd);
+            UA_Server_removeConnection(server, &e->connection);
+            continue;
+        }
+        pe = &e->next;
+    }
+    return UA_STATUSCODE_GOOD;
+}
+
+static void
+ServerNetworkLayerUnix_stop(UA_ServerNetworkLayer *nl, UA_Server *server) {
+    ServerNetworkLayerUnix *layer = (ServerNetworkLayerUnix *)nl->handle;
+    UA_LOG_INFO(layer->logger, UA_LOGCATEGORY_NETWORK,
+                "Shutting down the Unix network layer");
+
+    if(layer->serverSocket >= 0) {
+        close(layer->serverSocket);
+        layer->serverSocket = -1;
+        unlink(layer->path);
+    }
+
+    /* Shut down the connections, listen picks them up and frees them */
+    for(UnixConnectionEntry *e = layer->connections; e; e = e->next)
+        unix_close(&e->connection);
+    ServerNetworkLayerUnix_listen(nl, server, 0);
+}
+
+static void
+ServerNetworkLayerUnix_clear(UA_ServerNetworkLayer *nl) {
+    ServerNetworkLayerUnix *layer = (ServerNetworkLayerUnix *)nl->handle;
+    UA_String_clear(&nl->discoveryUrl);
+    while(layer->connections) {
+        UnixConnectionEntry *e = layer->connections;
+        layer->connections = e->next;
+        close(e->connection.sockfd);
+        free(e);
+    }
+    free(layer->path);
+    free(layer);
+}
+
+UA_ServerNetworkLayer
+opcuaUnixNetworkLayer(UA_ConnectionConfig config, const char *path) {
+    UA_ServerNetworkLayer nl;
+    memset(&nl, 0, sizeof(UA_ServerNetworkLayer));
+    nl.clear = ServerNetworkLayerUnix_clear;
+    nl.localConnectionConfig = config;
+    nl.start = ServerNetworkLayerUnix_start;
+    nl.listen = ServerNetworkLayerUnix_listen;
+    nl.stop = ServerNetworkLayerUnix_stop;
+
+    ServerNetworkLayerUnix *layer =
+        (ServerNetworkLayerUnix *)calloc(1, sizeof(ServerNetworkLayerUnix));
+    if(!layer)
+        return nl;
+    layer->path = strdup(path);
+    layer->serverSocket = -1;
+    layer->recvBufferSize = config.recvBufferSize ? config.recvBufferSize : 16384;
+    nl.handle = layer;
+    return nl;
+}
@@ -0,0 +1,25 @@
+/*************************************************************************\
+* Copyright (c) 2026 ITER Organization.
+* This module is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ * Unix-domain socket server network layer for the OPC UA test server
+ *
+ * Author: Dirk Zimoch <dirk.zimoch@psi.ch>
+ */
+
+#ifndef OPCUAUNIXNETWORKLAYER_H_
+#define OPCUAUNIXNETWORKLAYER_H_
+
+#include "open62541.h"
+
+/* Server network layer accepting OPC UA binary connections
+ * on a Unix-domain stream socket at the given path.
+ * Clients connect using the URL opc.unix://<path>
+ */
+UA_ServerNetworkLayer
+opcuaUnixNetworkLayer(UA_ConnectionConfig config, const char *path);
+
+#endif /* OPCUAUNIXNETWORKLAYER_H_ */
@@ -69,7 +69,16 @@ class opcuaTestHarness:
 
         self.cmd = f"{self.TESTSUBDIR}/cmds/test_pv.cmd"
         self.neg_cmd = f"{self.TESTSUBDIR}/cmds/test_pv_neg.cmd"
+        self.snapshot_cmd = f"{self.TESTSUBDIR}/cmds/test_pv_snapshot.cmd"
+        self.writegroup_cmd = f"{self.TESTSUBDIR}/cmds/test_pv_writegroup.cmd"
         self.testServer = f"{self.TESTSUBDIR}/server/opcuaTestServer"
+        self.pubsub_cmd = f"{self.TESTSUBDIR}/cmds/test_pubsub.cmd"
+        self.testPublisher = f"{self.TESTSUBDIR}/server/opcuaTestPublisher"
+        self.unix_cmd = f"{self.TESTSUBDIR}/cmds/test_pv_unix.cmd"
+        self.secure_cmd = f"{self.TESTSUBDIR}/cmds/test_bench_secure.cmd"
+        self.testSecureServer = f"{self.TESTSUBDIR}/server/opcuaTestSecureServer"
+        self.proxy_cmd = f"{self.TESTSUBDIR}/cmds/test_pv_proxy.cmd"
+        self.opcuaProxy = f"bin/{environ.get('EPICS_HOST_ARCH')}/opcuaProxy"
 
         # Default IOC
         self.IOC = self.get_ioc()
@@ -86,6 +95,10 @@ class opcuaTestHarness:
         self.isServerRunning = False
         self.serverURI = "opc.tcp://127.0.0.1:4840"
         self.serverFakeTime = "2019-05-02 09:22:52"
+        # Socket of the server started with start_unix_server (see test_pv_unix.cmd)
+        self.serverSocket = "/tmp/opcuaTestServer.sock"
+        # Port of the secured benchmark server (see test_bench_secure.cmd)
+        self.secureServerPort = 4842
 
         # Message catalog
         self.connectMsg = (
@@ -96,6 +109,13 @@ class opcuaTestHarness:
         )
 
         self.badNodeIdMsg = "item ns=2;s=Sim.BadVarName : BadNodeIdUnknown"
+        self.snapshotLimitMsg = (
+            "OPC UA session OPC1: snapshot group snap1 has 3 nodes "
+            "(more than the limit of 2 nodes per read request)"
+        )
+        self.writeGroupSessionMsg = (
+            "GrpOtherSession Error in add_record : write group g1 is used on session OPC1"
+        )
 
         # Server variables
         self.serverVars = [
@@ -153,6 +173,75 @@ class opcuaTestHarness:
 
         assert retryCount < 5, "Unable to start server"
 
+    def start_unix_server(self):
+        # The server listens on the Unix-domain socket only
+        env = dict(environ, OPCUA_TEST_UNIX_SOCKET=self.serverSocket)
+        self.serverProc = subprocess.Popen(
+            self.testServer,
+            shell=False,
+            env=env,
+        )
+
+        print("\nOpening Unix socket server with pid = %s" % self.serverProc.pid)
+        retryCount = 0
+        while (not os.path.exists(self.serverSocket)) and retryCount < 5:
+            retryCount = retryCount + 1
+            sleep(1)
+
+        assert retryCount < 5, "Unable to start server"
+
+    def make_bench_certificates(self, certdir):
+        # Self-signed throw-away certificates (DER) and keys for server and client
+        def make(name, uri, keyform):
+            subprocess.run(
+                ["openssl", "req", "-x509", "-newkey", "rsa:2048", "-nodes",
+                 "-days", "1", "-subj", f"/CN={name}",
+                 "-addext", f"subjectAltName=URI:{uri},DNS:localhost",
+                 "-addext", "keyUsage=critical,digitalSignature,nonRepudiation,"
+                            "keyEncipherment,dataEncipherment",
+                 "-addext", "extendedKeyUsage=serverAuth,clientAuth",
+                 "-keyout", f"{certdir}/{name}.key.pem",
+                 "-outform", "DER", "-out", f"{certdir}/{name}.der"],
+                check=True, capture_output=True,
+            )
+            if keyform == "DER":
+                subprocess.run(
+                    ["openssl", "pkey", "-in", f"{certdir}/{name}.key.pem",
+                     "-outform", "DER", "-out", f"{certdir}/{name}.key.der"],
+                    check=True, capture_output=True,
+                )
+        make("server", "urn:opcuaTestSecureServer", "DER")
+        make("client", "urn:opcuaBench:EPICS:IOC", "PEM")
+        environ["OPCUA_BENCH_CERT"] = f"{certdir}/client.der"
+        environ["OPCUA_BENCH_KEY"] = f"{certdir}/client.key.pem"
+
+    def start_secure_server(self, certdir):
+        import socket
+
+        self.secureServerProc = subprocess.Popen(
+            [self.testSecureServer, f"{certdir}/server.der",
+             f"{certdir}/server.key.der", str(self.secureServerPort)],
+            shell=False,
+            stdout=subprocess.DEVNULL,
+        )
+
+        print("\nOpening secured server with pid = %s" % self.secureServerProc.pid)
+        retryCount = 0
+        while retryCount < 5:
+            try:
+                socket.create_connection(("127.0.0.1", self.secureServerPort), 1).close()
+                break
+            except OSError:
+                retryCount = retryCount + 1
+                sleep(1)
+
+        assert retryCount < 5, "Unable to start secured server"
+
+    def stop_secure_server(self):
+        print("\nClosing secured server with pid = %s" % self.secureServerProc.pid)
+        self.secureServerProc.terminate()
+        self.secureServerProc.wait(timeout=5)
+
     def stop_server_group(self):
         # Get the process group ID for the spawned shell,
         # and send terminate signal
@@ -612,6 +701,56 @@ class TestVariableTests:
             pvWrite.disconnect()
             pvRead.disconnect()
 
+    def test_write_without_read(self, test_inst):
+        """
+        Write through an output PV with bini=ignore that is not
+        monitored: no value is ever read from the variable, the
+        write encoding comes from the node's DataType attribute.
+        Read back via the input PV and check the value matches.
+        """
+        ioc = test_inst.IOC
+
+        with ioc:
+            assert ioc.is_running()
+            pvWrite = PV("VarCheckInt32OutNoRead")
+            pvWrite.wait_for_connection()
+            assert (
+                pvWrite.put(-1000, wait=True, timeout=test_inst.putTimeout)
+                is not None
+            ), "Failed to write to PV VarCheckInt32OutNoRead"
+
+            pvRead = PV("VarCheckInt32")
+            res = wait_for_value(pvRead, -1000, timeout=test_inst.getTimeout)
+            assert res == -1000
+            assert pvWrite.severity == 0, "Write raised an alarm"
+            pvWrite.disconnect()
+            pvRead.disconnect()
+
+    def test_change_link(self, test_inst):
+        """
+        Change the INP link of a monitored record at runtime
+        to a different variable and back. Check that the record
+        follows the new variable without restarting the IOC.
+        """
+        ioc = test_inst.IOC
+
+        with ioc:
+            pv = PV("VarCheckInt16")
+            pvInp = PV("VarCheckInt16.INP")
+            res = wait_for_value(pv, -32768, timeout=test_inst.getTimeout)
+            assert res == -32768
+
+            assert pvInp.put("@SUB1 ns=2;s=Sim.TestVarUInt16", wait=True) is not None
+            res = wait_for_value(pv, 65535, timeout=test_inst.getTimeout)
+            assert res == 65535, "Record did not follow the new link"
+
+            assert pvInp.put("@SUB1 ns=2;s=Sim.TestVarInt16", wait=True) is not None
+            res = wait_for_value(pv, -32768, timeout=test_inst.getTimeout)
+            assert res == -32768, "Record did not follow the original link"
+            assert ioc.is_running()
+            pv.disconnect()
+            pvInp.disconnect()
+
     @pytest.mark.xfail
     def test_timestamps(self, test_inst_TZ):
         """
@@ -767,6 +906,59 @@ class TestPerformanceTests:
             assert totr < 1000
 
 
+    @pytest.mark.xfail("CI" in environ, reason="CI runner performance varies")
+    def test_unix_transport_performance(self, test_inst):
+        """
+        Write 2000 variable values through an IOC connected over
+        opc.tcp://127.0.0.1 and through an IOC connected over the
+        Unix-domain socket transport (opc.unix://), compare the times.
+        The Unix transport needs open62541 < 1.4, the test is skipped otherwise.
+        """
+        testruns = 5
+        writeperrun = 2000
+
+        def measure(ioc):
+            times = []
+            with ioc:
+                assert ioc.is_running()
+                pvWrite = PV("VarCheckInt16Out")
+                pvWrite.get(timeout=test_inst.getTimeout)
+                for j in range(0, testruns):
+                    t0 = time.perf_counter()
+                    for i in range(0, writeperrun):
+                        pvWrite.put(i, wait=True, timeout=test_inst.putTimeout)
+                    times.append(time.perf_counter() - t0)
+                pvWrite.disconnect()
+            ioc.check_output()
+            return min(times), ioc.errs
+
+        # TCP to the default server
+        ttcp, output = measure(test_inst.get_ioc())
+        assert output.find(test_inst.connectMsg) >= 0, output
+
+        # Unix-domain socket (the server serves only one of the transports)
+        test_inst.stop_server()
+        test_inst.start_unix_server()
+        try:
+            tunix, output = measure(test_inst.get_ioc(cmd=test_inst.unix_cmd))
+        finally:
+            test_inst.serverProc.terminate()
+            test_inst.serverProc.wait(timeout=5)
+            test_inst.start_server()
+
+        if output.find("not supported by the client library") >= 0:
+            pytest.skip("Unix-domain socket transport not supported by the client library")
+        assert output.find(test_inst.connectMsg) >= 0, output
+
+        print("TCP  best run: ", "{:.3f} s".format(ttcp),
+              " ({:.1f} us/write)".format(ttcp / writeperrun * 1e6))
+        print("Unix best run: ", "{:.3f} s".format(tunix),
+              " ({:.1f} us/write)".format(tunix / writeperrun * 1e6))
+        print("Unix/TCP ratio: ", "{:.2f}".format(tunix / ttcp))
+
+        assert tunix < ttcp * 1.2
+
+
 class TestNegativeTests:
     def test_no_server(self, test_inst):
         """
@@ -846,3 +1038,402 @@ class TestNegativeTests:
 
         regx = "VarNotBoolean : incoming data (.*) out-of-bounds"
         assert re.search(regx, output)
+
+
+class TestSnapshotTests:
+    def test_snapshot_read(self, test_inst):
+        """
+        Read the snapshot groups of test_snapshot.db (opcuaSnapshot in the
+        startup script, then processing all members of a group at once).
+        Check that all members of a group get the same time stamp,
+        that a bad node only fails its own record, and that the group
+        is read in one request although it exceeds the node limit.
+        """
+        ioc = test_inst.get_ioc(cmd=test_inst.snapshot_cmd)
+
+        ioc.start()
+        assert ioc.is_running()
+
+        members = [
+            ("SnapDouble", 0.002),
+            ("SnapInt32", -2147483648),
+            ("SnapUInt16", 65535),
+        ]
+        pvs = [PV(name, form="time") for name, _ in members]
+
+        # Values read by opcuaSnapshot
+        for pv, (name, expected) in zip(pvs, members):
+            res = wait_for_value(pv, expected, timeout=test_inst.getTimeout)
+            assert res == expected, "%s not read by opcuaSnapshot" % name
+        for pv in pvs:
+            pv.get(timeout=test_inst.getTimeout)
+        first = [pv.timestamp for pv in pvs]
+        assert len(set(first)) == 1, "Snapshot time stamps differ: %s" % first
+
+        # Processing all members queues one snapshot (the others wait for it)
+        sleep(1)
+        snapAll = PV("SnapAll.PROC")
+        assert snapAll.put(1, wait=True) is not None
+        sleep(1)
+        for pv in pvs:
+            pv.get(timeout=test_inst.getTimeout)
+            assert pv.severity == 0
+        second = [pv.timestamp for pv in pvs]
+        assert len(set(second)) == 1, "Snapshot time stamps differ: %s" % second
+        assert second[0] > first[0], "Group not read again"
+
+        # A bad node fails its own record only
+        good = PV("SnapGood")
+        bad = PV("SnapBad")
+        assert PV("SnapGood.PROC").put(1, wait=True) is not None
+        sleep(1)
+        assert good.get(timeout=test_inst.getTimeout) == -32768
+        assert good.severity == 0
+        bad.get(timeout=test_inst.getTimeout)
+        assert bad.severity == 3
+
+        ioc.exit()
+        assert not ioc.is_running()
+
+        ioc.check_output()
+        output = ioc.errs
+        print(output)
+
+        assert output.find(test_inst.snapshotLimitMsg) >= 0, (
+            "Failed to find snapshot limit message\n%s" % output
+        )
+
+
+class TestWriteGroupTests:
+    def test_write_group(self, test_inst):
+        """
+        Write the members of a write group (test_writegroup.db) and check
+        that the writes are held until the trigger is written.
+        Check that held writes are dropped when the session disconnects,
+        and that a member on a different session is rejected.
+        """
+        ioc = test_inst.get_ioc(cmd=test_inst.writegroup_cmd)
+
+        ioc.start()
+        assert ioc.is_running()
+
+        int32 = PV("GrpInt32")
+        double = PV("GrpDouble")
+        trigger = PV("GrpTrigger")
+        int32RB = PV("GrpInt32RB")
+        doubleRB = PV("GrpDoubleRB")
+        triggerRB = PV("GrpTriggerRB")
+        res = wait_for_value(int32RB, -2147483648, timeout=test_inst.getTimeout)
+        assert res == -2147483648
+
+        # Member writes are held
+        assert int32.put(42, wait=True) is not None
+        assert double.put(1.5, wait=True) is not None
+        sleep(1)
+        assert int32RB.get(timeout=test_inst.getTimeout) == -2147483648, "Member write not held"
+        assert doubleRB.get(timeout=test_inst.getTimeout) == 0.002, "Member write not held"
+
+        # Writing the trigger sends the whole group
+        assert trigger.put(7, wait=True) is not None
+        assert wait_for_value(int32RB, 42, timeout=test_inst.getTimeout) == 42
+        assert wait_for_value(doubleRB, 1.5, timeout=test_inst.getTimeout) == 1.5
+        assert wait_for_value(triggerRB, 7, timeout=test_inst.getTimeout) == 7
+
+        # Held writes are dropped on disconnect
+        assert int32.put(43, wait=True) is not None
+        test_inst.stop_server()
+        sleep(test_inst.sleepTime)
+        test_inst.start_server()
+        assert wait_for_value(triggerRB, 65535, timeout=2 * test_inst.sleepTime) == 65535
+        assert trigger.put(8, wait=True) is not None
+        assert wait_for_value(triggerRB, 8, timeout=test_inst.getTimeout) == 8
+        sleep(1)
+        assert int32RB.get(timeout=test_inst.getTimeout) == -2147483648, (
+            "Held write sent after reconnect"
+        )
+
+        ioc.exit()
+        assert not ioc.is_running()
+
+        ioc.check_output()
+        output = ioc.errs
+        print(output)
+
+        assert output.find(test_inst.writeGroupSessionMsg) >= 0, (
+            "Failed to find write group session message\n%s" % output
+        )
+
+
+class TestPubSubTests:
+    @pytest.mark.skipif(
+        not os.path.exists("end2endTest/server/opcuaTestPublisher"),
+        reason="PubSub test publisher not built",
+    )
+    def test_pubsub_reader(self, test_inst):
+        """
+        Start the PubSub test publisher and an IOC with a PubSub reader.
+        Check that the records follow the published values,
+        and that the reader reports connection loss when the publisher stops.
+        """
+        publisher = subprocess.Popen(test_inst.testPublisher, shell=False)
+        ioc = test_inst.get_ioc(cmd=test_inst.pubsub_cmd)
+
+        try:
+            ioc.start()
+            assert ioc.is_running()
+
+            pv = PV("PubSubCounter")
+            first = pv.get(timeout=test_inst.getTimeout)
+            sleep(1)
+            second = pv.get(timeout=test_inst.getTimeout)
+            assert second > first, "Counter not updated (%s -> %s)" % (first, second)
+            assert pv.severity == 0
+
+            ramp = PV("PubSubRamp")
+            ramp.get(timeout=test_inst.getTimeout)
+            assert ramp.severity == 0
+
+            # Stop the publisher: records must go INVALID after the reader timeout
+            publisher.terminate()
+            publisher.wait(timeout=5)
+            sleep(test_inst.sleepTime)
+            pv.get(timeout=test_inst.getTimeout)
+            assert pv.severity == 3
+
+            ioc.exit()
+            assert not ioc.is_running()
+        finally:
+            if publisher.poll() is None:
+                publisher.terminate()
+                publisher.wait(timeout=5)
+
+        ioc.check_output()
+        output = ioc.errs
+        print(output)
+
+        assert output.find("OPC UA PubSub reader PS1: receiving data") >= 0, (
+            "Failed to find PubSub receiving message\n%s" % output
+        )
+
+
+class TestProxyTests:
+    @pytest.mark.skipif(
+        not os.path.exists(f"bin/{environ.get('EPICS_HOST_ARCH')}/opcuaProxy"),
+        reason="opcuaProxy not built",
+    )
+    def test_proxy(self, test_inst, tmp_path):
+        """
+        Start opcuaProxy on a Unix socket and an IOC that uses it.
+        Check the socket permissions, read, monitor and write through the proxy,
+        and that the proxy reconnects when the server is restarted.
+        """
+        import re
+        import stat
+
+        # Serve all variables of the test database
+        with open(f"{test_inst.TESTSUBDIR}/db/test_pv.db") as db:
+            nodes = sorted(set(re.findall(r"s=(Sim\.\w+)", db.read())))
+        nodeList = tmp_path / "nodes.txt"
+        nodeList.write_text("".join(f"ns=2;s={n}\n" for n in nodes))
+        socket = tmp_path / "proxy.sock"
+        environ["OPCUA_PROXY_SOCKET"] = str(socket)
+
+        proxy = subprocess.Popen(
+            [test_inst.opcuaProxy, "-l", f"opc.unix://{socket}", "-n", str(nodeList),
+             "-r", "1", test_inst.serverURI],
+            shell=False,
+            stdout=subprocess.PIPE,
+            stderr=subprocess.STDOUT,
+            text=True,
+        )
+        ioc = test_inst.get_ioc(cmd=test_inst.proxy_cmd)
+
+        try:
+            retryCount = 0
+            while (not socket.exists()) and retryCount < 5:
+                retryCount = retryCount + 1
+                sleep(1)
+            assert retryCount < 5, "Unable to start proxy"
+            assert stat.S_IMODE(os.stat(socket).st_mode) == 0o660
+
+            ioc.start()
+            assert ioc.is_running()
+
+            # Monitor
+            ramp = PV("TstRamp")
+            first = ramp.get(timeout=test_inst.getTimeout)
+            sleep(2)
+            second = ramp.get(timeout=test_inst.getTimeout)
+            assert second != first, "Ramp not updated (%s -> %s)" % (first, second)
+            assert ramp.severity == 0
+
+            # Read (initial value) and write
+            pvRead = PV("VarCheckDouble")
+            assert wait_for_value(pvRead, 0.002, timeout=test_inst.getTimeout) == 0.002
+            pvWrite = PV("VarCheckInt64Out")
+            pvWrite.wait_for_connection()
+            assert (
+                pvWrite.put(4242, wait=True, timeout=test_inst.putTimeout)
+                is not None
+            ), "Failed to write to PV VarCheckInt64Out"
+            pvRead = PV("VarCheckInt64")
+            assert wait_for_value(pvRead, 4242, timeout=test_inst.getTimeout) == 4242
+            assert pvWrite.severity == 0, "Write raised an alarm"
+
+            # Server restart: the proxy serves a bad status, then reconnects (every 5 s)
+            test_inst.stop_server()
+            sleep(test_inst.sleepTime)
+            ramp.get(timeout=test_inst.getTimeout)
+            assert ramp.severity == 3
+            test_inst.start_server()
+            t0 = time.perf_counter()
+            while ramp.severity != 0 and time.perf_counter() - t0 < 15:
+                sleep(0.5)
+                ramp.get(timeout=test_inst.getTimeout)
+            assert ramp.severity == 0, "Ramp not updated after server restart"
+
+            ioc.exit()
+            assert not ioc.is_running()
+        finally:
+            proxy.terminate()
+            output, _ = proxy.communicate(timeout=10)
+
+        print(output)
+        assert output.count("opcuaProxy: connected to") == 2, output
+        assert re.search(r"writes=[1-9]", output), output
+        assert not socket.exists(), "Socket not removed on exit"
+
+        ioc.check_output()
+        print(ioc.errs)
+
+
+def percentiles(samples, points=(50, 90, 99)):
+    """
+    Percentiles (nearest rank) of a list of samples.
+    """
+    ordered = sorted(samples)
+    if not ordered:
+        return {p: float("nan") for p in points}
+    return {
+        p: ordered[min(len(ordered) - 1, max(0, int(round(p / 100 * len(ordered))) - 1))]
+        for p in points
+    }
+
+
+class TestSecurityBenchmark:
+    # Security modes and policies of SessionOpen62541 (see Session.cpp)
+    securityModes = ["None", "Sign", "SignAndEncrypt"]
+    securityPolicies = [
+        "Basic128Rsa15",
+        "Basic256",
+        "Basic256Sha256",
+        "Aes128_Sha256_RsaOaep",
+        "Aes256_Sha256_RsaPss",
+    ]
+
+    @pytest.mark.skipif(
+        not os.path.exists("end2endTest/server/opcuaTestSecureServer"),
+        reason="secured test server not built",
+    )
+    @pytest.mark.xfail("CI" in environ, reason="CI runner performance varies")
+    def test_security_throughput(self, test_inst, tmp_path):
+        """
+        Run identical write, read and subscription workloads through an IOC
+        connected to the secured test server, once for each security mode and policy.
+        Report messages/s, IOC CPU time per message, latency percentiles
+        and the time the client spent in crypto (session statistics at disconnect).
+        Combinations that the client or server library does not support are reported and skipped.
+        """
+        import re
+
+        writes = 2000
+        reads = 2000
+        subscriptionTime = 5.0
+
+        test_inst.make_bench_certificates(tmp_path)
+        test_inst.start_secure_server(tmp_path)
+
+        combinations = [("None", "None")] + [
+            (mode, policy)
+            for mode in self.securityModes[1:]
+            for policy in self.securityPolicies
+        ]
+        results = []
+        try:
+            for mode, policy in combinations:
+                environ["OPCUA_BENCH_SECMODE"] = mode
+                environ["OPCUA_BENCH_SECPOLICY"] = policy
+                ioc = test_inst.get_ioc(cmd=test_inst.secure_cmd)
+                cpu0 = resource.getrusage(resource.RUSAGE_CHILDREN)
+                result = {"mode": mode, "policy": policy}
+
+                with ioc:
+                    assert ioc.is_running()
+                    pvOut = PV("BenchOut")
+                    pvProc = PV("BenchIn.PROC")
+                    pvIn = PV("BenchIn")
+                    pvCounter = PV("BenchCounter")
+                    # BenchIn stays INVALID if the session does not connect
+                    sleep(test_inst.sleepTime)
+                    pvProc.put(1, wait=True, timeout=test_inst.getTimeout)
+                    pvIn.get(timeout=test_inst.getTimeout)
+                    if pvIn.severity == 0:
+                        latency = []
+                        t0 = time.perf_counter()
+                        for i in range(0, writes):
+                            t = time.perf_counter()
+                            pvOut.put(i, wait=True, timeout=test_inst.putTimeout)
+                            latency.append(time.perf_counter() - t)
+                        result["write"] = (writes / (time.perf_counter() - t0), percentiles(latency))
+
+                        latency = []
+                        t0 = time.perf_counter()
+                        for i in range(0, reads):
+                            t = time.perf_counter()
+                            pvProc.put(1, wait=True, timeout=test_inst.getTimeout)
+                            latency.append(time.perf_counter() - t)
+                        result["read"] = (reads / (time.perf_counter() - t0), percentiles(latency))
+
+                        updates = []
+                        pvCounter.add_callback(lambda value=None, **kw: updates.append(value))
+                        sleep(subscriptionTime)
+                        pvCounter.clear_callbacks()
+                        result["subscription"] = len(updates) / subscriptionTime
+                    for pv in (pvOut, pvProc, pvIn, pvCounter):
+                        pv.disconnect()
+
+                ioc.check_output()
+                cpu1 = resource.getrusage(resource.RUSAGE_CHILDREN)
+                output = ioc.outs + ioc.errs
+
+                if "write" not in result:
+                    print(f"\n{mode}/{policy}: not supported (no connection)")
+                    continue
+
+                # IOC process CPU (including start-up) per OPC UA message
+                messages = writes + reads + result["subscription"] * subscriptionTime
+                cpu = (cpu1.ru_utime + cpu1.ru_stime) - (cpu0.ru_utime + cpu0.ru_stime)
+                result["cpu"] = cpu / messages
+                match = re.search(r"crypto=(\d+) ops/([0-9.]+) ms", output)
+                result["crypto"] = (int(match.group(1)), float(match.group(2))) if match else (0, 0.0)
+                results.append(result)
+        finally:
+            test_inst.stop_secure_server()
+
+        print("\n{:<15} {:<22} {:>9} {:>9} {:>9} {:>9} {:>9} {:>9} {:>9} {:>9} {:>11}".format(
+            "mode", "policy", "write/s", "w-p50us", "w-p99us",
+            "read/s", "r-p50us", "r-p99us", "upd/s", "cpu-us", "crypto-ms"))
+        for r in results:
+            w, wl = r["write"]
+            rd, rl = r["read"]
+            print("{:<15} {:<22} {:>9.0f} {:>9.0f} {:>9.0f} {:>9.0f} {:>9.0f} {:>9.0f} {:>9.1f} {:>9.1f} {:>11.1f}".format(
+                r["mode"], r["policy"], w, wl[50] * 1e6, wl[99] * 1e6,
+                rd, rl[50] * 1e6, rl[99] * 1e6, r["subscription"],
+                r["cpu"] * 1e6, r["crypto"][1]))
+
+        assert results and results[0]["mode"] == "None", "No connection without security"
+        for r in results:
+            # The counter is updated every 10 ms
+            assert r["subscription"] > 10
+            if r["mode"] != "None":
+                assert r["crypto"][0] > 0, "No crypto statistics for %s/%s" % (r["mode"], r["policy"])
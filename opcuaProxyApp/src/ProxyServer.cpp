@@ -0,0 +1,1151 @@
+/*************************************************************************\
+* Copyright (c) 2026 ITER Organization.
+* This module is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Author: Dirk Zimoch <dirk.zimoch@psi.ch>
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstring>
+#include <cstdlib>
+
+#include <open62541/client_config_default.h>
+#include <open62541/client_highlevel.h>
+#include <open62541/client_subscriptions.h>
+#include <open62541/server_config_default.h>
+#include <open62541/plugin/accesscontrol_default.h>
+#ifdef HAS_SECURITY
+#include <open62541/plugin/pki_default.h>
+#endif
+
+#include "ProxyServer.h"
+#include "UnixListener.h"
+#include "UnixTransport.h"
+
+namespace DevOpcua {
+
+namespace {
+
+// Map key of a node id
+std::string
+nodeKey (const UA_NodeId &id)
+{
+    std::ostringstream s;
+    s << "ns=" << id.namespaceIndex << ";";
+    if (id.identifierType == UA_NODEIDTYPE_NUMERIC)
+        s << "i=" << id.identifier.numeric;
+    else if (id.identifierType == UA_NODEIDTYPE_STRING)
+        s << "s=" << std::string(reinterpret_cast<const char *>(id.identifier.string.data),
+                                 id.identifier.string.length);
+    else
+        s << "?" << UA_NodeId_hash(&id);
+    return s.str();
+}
+
+std::string
+toString (const UA_String &s)
+{
+    return std::string(reinterpret_cast<const char *>(s.data), s.length);
+}
+
+// Delay between retries of a failed createMonitoredItems or reconnect
+const UA_DateTime retryDelay = 5 * UA_DATETIME_SEC;
+
+// Read the credentials file of the proxy (same format as the session option ident-file)
+bool
+readIdentity (const std::string &file, ProxyServer::Identity &identity)
+{
+    std::ifstream in(file);
+    if (!in) {
+        std::cerr << "opcuaProxy: can not read credentials file " << file << std::endl;
+        return false;
+    }
+    std::string line;
+    while (std::getline(in, line)) {
+        const std::string::size_type hash = line.find_first_of('#');
+        const std::string::size_type equ = line.find_first_of('=');
+        if (hash < equ || equ == std::string::npos)
+            continue;
+        if (line.substr(0, equ) == "user")
+            identity.user = line.substr(equ + 1);
+        else if (line.substr(0, equ) == "pass")
+            identity.password = line.substr(equ + 1);
+    }
+    if (identity.user.empty() || identity.password.empty()) {
+        std::cerr << "opcuaProxy: credentials file " << file << " needs user and pass" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Read the local users file (<user>:<password> per line)
+bool
+readUsers (const std::string &file, std::vector<std::pair<std::string, std::string>> &users)
+{
+    std::ifstream in(file);
+    if (!in) {
+        std::cerr << "opcuaProxy: can not read users file " << file << std::endl;
+        return false;
+    }
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#')
+            continue;
+        const std::string::size_type colon = line.find_first_of(':');
+        if (colon == std::string::npos || colon == 0 || colon + 1 == line.length()) {
+            std::cerr << "opcuaProxy: invalid line in users file " << file << std::endl;
+            return false;
+        }
+        users.emplace_back(line.substr(0, colon), line.substr(colon + 1));
+    }
+    if (users.empty()) {
+        std::cerr << "opcuaProxy: no users in users file " << file << std::endl;
+        return false;
+    }
+    return true;
+}
+
+#ifdef HAS_SECURITY
+bool
+loadFile (const std::string &file, UA_ByteString &content)
+{
+    std::ifstream in(file, std::ios::binary);
+    if (!in) {
+        std::cerr << "opcuaProxy: can not read " << file << std::endl;
+        return false;
+    }
+    std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    UA_ByteString_init(&content);
+    if (UA_ByteString_allocBuffer(&content, data.length()) != UA_STATUSCODE_GOOD)
+        return false;
+    memcpy(content.data, data.data(), data.length());
+    return true;
+}
+#endif
+
+// Access control of the local server
+//
+// Wraps the default access control: anonymous tokens and (on the TCP listener)
+// the check of username tokens are left to the default plugin. The identity of
+// username tokens is kept as session context and forwarded upstream with writes.
+
+struct AccessContext {
+    void *inner;                            // context of the default plugin
+    UA_StatusCode (*activate)(UA_Server *, UA_AccessControl *, const UA_EndpointDescription *,
+                              const UA_ByteString *, const UA_NodeId *, const UA_ExtensionObject *, void **);
+    void (*close)(UA_Server *, UA_AccessControl *, const UA_NodeId *, void *);
+    void (*clear)(UA_AccessControl *);
+    bool checkUsers;                        // check username tokens against the users file
+};
+
+UA_StatusCode
+activateSession (UA_Server *server, UA_AccessControl *ac,
+                 const UA_EndpointDescription *endpointDescription,
+                 const UA_ByteString *secureChannelRemoteCertificate,
+                 const UA_NodeId *sessionId,
+                 const UA_ExtensionObject *userIdentityToken,
+                 void **sessionContext)
+{
+    AccessContext *ctx = static_cast<AccessContext *>(ac->context);
+    UA_AccessControl inner = *ac;
+    inner.context = ctx->inner;
+
+    const UA_UserNameIdentityToken *token = nullptr;
+    if (userIdentityToken->encoding >= UA_EXTENSIONOBJECT_DECODED
+            && userIdentityToken->content.decoded.type == &UA_TYPES[UA_TYPES_USERNAMEIDENTITYTOKEN])
+        token = static_cast<const UA_UserNameIdentityToken *>(userIdentityToken->content.decoded.data);
+    if (!token)
+        return ctx->activate(server, &inner, endpointDescription, secureChannelRemoteCertificate,
+                             sessionId, userIdentityToken, sessionContext);
+
+    if (ctx->checkUsers) {
+        UA_StatusCode status = ctx->activate(server, &inner, endpointDescription, secureChannelRemoteCertificate,
+                                             sessionId, userIdentityToken, sessionContext);
+        if (status != UA_STATUSCODE_GOOD)
+            return status;
+        ctx->close(server, &inner, sessionId, *sessionContext);
+    } else if (!token->userName.length) {
+        // Unchecked tokens are checked by the upstream server with the first write
+        return UA_STATUSCODE_BADIDENTITYTOKENINVALID;
+    }
+    ProxyServer::Identity *identity = new ProxyServer::Identity;
+    identity->user = toString(token->userName);
+    identity->password = toString(token->password);
+    *sessionContext = identity;
+    return UA_STATUSCODE_GOOD;
+}
+
+void
+closeSession (UA_Server *, UA_AccessControl *, const UA_NodeId *, void *sessionContext)
+{
+    delete static_cast<ProxyServer::Identity *>(sessionContext);
+}
+
+void
+clearAccessControl (UA_AccessControl *ac)
+{
+    AccessContext *ctx = static_cast<AccessContext *>(ac->context);
+    ac->context = ctx->inner;
+    ctx->clear(ac);
+    delete ctx;
+}
+
+} // namespace
+
+bool
+parseNodeId (const std::string &text, UA_NodeId &nodeId)
+{
+    std::string::size_type pos = 0;
+    unsigned long ns = 0;
+    if (text.compare(0, 3, "ns=") == 0) {
+        char *end;
+        ns = std::strtoul(text.c_str() + 3, &end, 10);
+        if (*end != ';' || end == text.c_str() + 3 || ns > 65535)
+            return false;
+        pos = static_cast<std::string::size_type>(end - text.c_str()) + 1;
+    }
+    if (text.compare(pos, 2, "i=") == 0) {
+        char *end;
+        const char *start = text.c_str() + pos + 2;
+        unsigned long id = std::strtoul(start, &end, 10);
+        if (*end || end == start)
+            return false;
+        nodeId = UA_NODEID_NUMERIC(static_cast<UA_UInt16>(ns), static_cast<UA_UInt32>(id));
+        return true;
+    }
+    if (text.compare(pos, 2, "s=") == 0 && text.length() > pos + 2) {
+        nodeId = UA_NODEID_STRING_ALLOC(static_cast<UA_UInt16>(ns), text.c_str() + pos + 2);
+        return true;
+    }
+    return false;
+}
+
+ProxyServer::Node::Node (ProxyServer &proxy, const UA_NodeId &id)
+    : proxy(proxy)
+    , monitoredItemId(0)
+    , monitorQueued(false)
+    , lastAccess(0)
+    , nextMonitor(0)
+    , updates(0)
+    , reads(0)
+    , writes(0)
+{
+    UA_NodeId_copy(&id, &nodeId);
+    UA_DataValue_init(&value);
+}
+
+ProxyServer::Node::~Node ()
+{
+    UA_NodeId_clear(&nodeId);
+    UA_DataValue_clear(&value);
+}
+
+ProxyServer::ProxyServer (const Config &config)
+    : config(config)
+    , client(nullptr)
+    , server(nullptr)
+    , sessionState(UA_SESSIONSTATE_CLOSED)
+    , upstreamUp(false)
+    , stopping(false)
+    , subscriptionId(0)
+    , serving(false)
+    , resync(false)
+    , nextReconnect(0)
+    , connects(0)
+    , monitorFailures(0)
+    , idleRemoved(0)
+    , writeTimeouts(0)
+{}
+
+ProxyServer::~ProxyServer ()
+{
+    if (server)
+        UA_Server_delete(server);
+    for (auto &it : writers) {
+        UA_Client_disconnect(it.second.client);
+        UA_Client_delete(it.second.client);
+    }
+    if (client) {
+        UA_Client_disconnect(client);
+        UA_Client_delete(client);
+    }
+}
+
+UA_Client *
+ProxyServer::newClient (const Identity &, const bool withState)
+{
+    UA_Client *c = UA_Client_new();
+    UA_ClientConfig *cconfig = UA_Client_getConfig(c);
+    UA_ClientConfig_setDefault(cconfig);
+    if (withState) {
+        cconfig->clientContext = this;
+        cconfig->stateCallback = stateChanged;
+    }
+    if (isUnixTransportUrl(config.upstreamUrl) && !setUnixTransport(cconfig)) {
+        std::cerr << "opcuaProxy: transport " << unixTransportScheme
+                  << " not supported by the client library" << std::endl;
+        UA_Client_delete(c);
+        return nullptr;
+    }
+    return c;
+}
+
+UA_StatusCode
+ProxyServer::connectClient (UA_Client *c, const Identity &id)
+{
+    if (id.user.empty())
+        return UA_Client_connect(c, config.upstreamUrl.c_str());
+    return UA_Client_connectUsername(c, config.upstreamUrl.c_str(), id.user.c_str(), id.password.c_str());
+}
+
+bool
+ProxyServer::setup ()
+{
+    if (config.identityFile.length() && !readIdentity(config.identityFile, identity))
+        return false;
+    client = newClient(identity, true);
+    if (!client)
+        return false;
+
+#ifdef HAS_UNIX_TRANSPORT
+    // Check the listener before connecting upstream
+    if (isUnixTransportUrl(config.listen)) {
+        std::string error;
+        if (!prepareSocketPath(unixTransportPath(config.listen), error)) {
+            std::cerr << "opcuaProxy: " << error << std::endl;
+            return false;
+        }
+    }
+#endif
+
+    UA_StatusCode status = connectClient(client, identity);
+    if (status != UA_STATUSCODE_GOOD) {
+        std::cerr << "opcuaProxy: connecting to " << config.upstreamUrl
+                  << " failed (" << UA_StatusCode_name(status) << ")" << std::endl;
+        return false;
+    }
+
+    // The local server needs the namespace indices of the upstream server
+    UA_Variant value;
+    UA_Variant_init(&value);
+    status = UA_Client_readValueAttribute(client, UA_NODEID_NUMERIC(0, UA_NS0ID_SERVER_NAMESPACEARRAY), &value);
+    if (status == UA_STATUSCODE_GOOD && UA_Variant_hasArrayType(&value, &UA_TYPES[UA_TYPES_STRING])) {
+        const UA_String *uris = static_cast<const UA_String *>(value.data);
+        for (size_t i = 0; i < value.arrayLength; i++)
+            namespaces.emplace_back(toString(uris[i]));
+    }
+    UA_Variant_clear(&value);
+    if (namespaces.size() < 2) {
+        std::cerr << "opcuaProxy: reading the namespace array of " << config.upstreamUrl
+                  << " failed (" << UA_StatusCode_name(status) << ")" << std::endl;
+        return false;
+    }
+
+    UA_ServerConfig sconfig;
+    std::memset(&sconfig, 0, sizeof(sconfig));
+    if (!setupListener(sconfig)) {
+        UA_ServerConfig_clean(&sconfig);
+        return false;
+    }
+    // Namespace 1 is the application URI
+    UA_String_clear(&sconfig.applicationDescription.applicationUri);
+    sconfig.applicationDescription.applicationUri = UA_STRING_ALLOC(namespaces[1].c_str());
+    server = UA_Server_newWithConfig(&sconfig);
+    if (!server) {
+        std::cerr << "opcuaProxy: creating the local server failed" << std::endl;
+        return false;
+    }
+    for (size_t i = 2; i < namespaces.size(); i++) {
+        if (UA_Server_addNamespace(server, namespaces[i].c_str()) != i) {
+            std::cerr << "opcuaProxy: namespace " << i << " (" << namespaces[i]
+                      << ") can not be mirrored" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+// The Unix socket listener relies on the socket permissions (security mode None,
+// anonymous and unchecked username tokens); the TCP listener binds to localhost
+// and requires encryption and a user from the users file.
+bool
+ProxyServer::setupListener (UA_ServerConfig &sconfig)
+{
+    if (isUnixTransportUrl(config.listen)) {
+#ifdef HAS_UNIX_TRANSPORT
+        if (UA_ServerConfig_setMinimal(&sconfig, 4840, nullptr) != UA_STATUSCODE_GOOD)
+            return false;
+        UA_ConnectionConfig cc = sconfig.networkLayers[0].localConnectionConfig;
+        for (size_t i = 0; i < sconfig.networkLayersSize; i++)
+            sconfig.networkLayers[i].clear(&sconfig.networkLayers[i]);
+        sconfig.networkLayers[0] = unixListener(cc, unixTransportPath(config.listen),
+                                                config.socketMode, config.socketGroup);
+        sconfig.networkLayersSize = 1;
+        return setupAccessControl(sconfig, true, false, UA_SECURITY_POLICY_NONE_URI)
+                && setupEndpoints(sconfig, true);
+#else
+        std::cerr << "opcuaProxy: transport " << unixTransportScheme
+                  << " not supported by the server library" << std::endl;
+        return false;
+#endif
+    }
+
+#ifdef HAS_SECURITY
+    char *end;
+    unsigned long port = std::strtoul(config.listen.c_str(), &end, 0);
+    if (*end || !port || port > 65535) {
+        std::cerr << "opcuaProxy: invalid local endpoint " << config.listen << std::endl;
+        return false;
+    }
+    if (config.certificate.empty() || config.privateKey.empty()
+            || config.trustList.empty() || config.userFile.empty()) {
+        std::cerr << "opcuaProxy: a TCP listener needs a certificate (-c), private key (-k), "
+                  << "trusted client certificates (-a) and a users file (-u)" << std::endl;
+        return false;
+    }
+    UA_ByteString certificate, privateKey;
+    if (!loadFile(config.certificate, certificate))
+        return false;
+    if (!loadFile(config.privateKey, privateKey)) {
+        UA_ByteString_clear(&certificate);
+        return false;
+    }
+    std::vector<UA_ByteString> trustList(config.trustList.size());
+    bool ok = true;
+    for (size_t i = 0; i < trustList.size(); i++)
+        if (!loadFile(config.trustList[i], trustList[i])) {
+            UA_ByteString_init(&trustList[i]);
+            ok = false;
+        }
+
+    ok = ok && UA_ServerConfig_setMinimal(&sconfig, static_cast<UA_UInt16>(port), &certificate) == UA_STATUSCODE_GOOD;
+    if (ok) {
+        sconfig.customHostname = UA_STRING_ALLOC("localhost");
+        sconfig.certificateVerification.clear(&sconfig.certificateVerification);
+        ok = UA_CertificateVerification_Trustlist(&sconfig.certificateVerification,
+                                                  trustList.data(), trustList.size(),
+                                                  nullptr, 0, nullptr, 0) == UA_STATUSCODE_GOOD
+                && UA_ServerConfig_addSecurityPolicyBasic256Sha256(&sconfig, &certificate, &privateKey)
+                       == UA_STATUSCODE_GOOD
+                && UA_ServerConfig_addSecurityPolicyAes128Sha256RsaOaep(&sconfig, &certificate, &privateKey)
+                       == UA_STATUSCODE_GOOD;
+    }
+    UA_ByteString_clear(&certificate);
+    UA_ByteString_clear(&privateKey);
+    for (auto &it : trustList)
+        UA_ByteString_clear(&it);
+    if (!ok) {
+        std::cerr << "opcuaProxy: setting up the security of the TCP listener failed" << std::endl;
+        return false;
+    }
+    // The None policy stays for discovery, there are no endpoints without encryption
+    return setupAccessControl(sconfig, false, true,
+                              sconfig.securityPolicies[sconfig.securityPoliciesSize - 2].policyUri)
+            && setupEndpoints(sconfig, false);
+#else
+    std::cerr << "opcuaProxy: a TCP listener needs the client library with encryption support" << std::endl;
+    return false;
+#endif
+}
+
+bool
+ProxyServer::setupAccessControl (UA_ServerConfig &sconfig, const bool allowAnonymous, const bool checkUsers,
+                                 const UA_String &userTokenPolicyUri)
+{
+    std::vector<std::pair<std::string, std::string>> users;
+    if (checkUsers) {
+        if (!readUsers(config.userFile, users))
+            return false;
+    } else {
+        // Placeholder to offer the username token policy (the tokens are not checked against it)
+        users.emplace_back("proxy", "unchecked");
+    }
+    std::vector<UA_UsernamePasswordLogin> logins(users.size());
+    for (size_t i = 0; i < users.size(); i++) {
+        logins[i].username = UA_STRING(const_cast<char *>(users[i].first.c_str()));
+        logins[i].password = UA_STRING(const_cast<char *>(users[i].second.c_str()));
+    }
+
+    // The policy URI points into the security policies of the configuration
+    UA_String policyUri;
+    UA_String_copy(&userTokenPolicyUri, &policyUri);
+    if (sconfig.accessControl.clear)
+        sconfig.accessControl.clear(&sconfig.accessControl);
+    UA_StatusCode status = UA_AccessControl_default(&sconfig, allowAnonymous, &policyUri,
+                                                    logins.size(), logins.data());
+    UA_String_clear(&policyUri);
+    if (status != UA_STATUSCODE_GOOD) {
+        std::cerr << "opcuaProxy: setting up the access control failed ("
+                  << UA_StatusCode_name(status) << ")" << std::endl;
+        return false;
+    }
+
+    AccessContext *ctx = new AccessContext;
+    ctx->inner = sconfig.accessControl.context;
+    ctx->activate = sconfig.accessControl.activateSession;
+    ctx->close = sconfig.accessControl.closeSession;
+    ctx->clear = sconfig.accessControl.clear;
+    ctx->checkUsers = checkUsers;
+    sconfig.accessControl.context = ctx;
+    sconfig.accessControl.activateSession = activateSession;
+    sconfig.accessControl.closeSession = closeSession;
+    sconfig.accessControl.clear = clearAccessControl;
+    return true;
+}
+
+// Endpoints copy the user token policies: recreate them for the new access control
+bool
+ProxyServer::setupEndpoints (UA_ServerConfig &sconfig, const bool allowNone)
+{
+    for (size_t i = 0; i < sconfig.endpointsSize; i++)
+        UA_EndpointDescription_clear(&sconfig.endpoints[i]);
+    UA_free(sconfig.endpoints);
+    sconfig.endpoints = nullptr;
+    sconfig.endpointsSize = 0;
+    for (size_t i = 0; i < sconfig.securityPoliciesSize; i++) {
+        const UA_String &uri = sconfig.securityPolicies[i].policyUri;
+        const bool none = UA_String_equal(&uri, &UA_SECURITY_POLICY_NONE_URI);
+        if (none && !allowNone)
+            continue;
+        UA_StatusCode status = UA_ServerConfig_addEndpoint(&sconfig, uri,
+                                                           none ? UA_MESSAGESECURITYMODE_NONE
+                                                                : UA_MESSAGESECURITYMODE_SIGNANDENCRYPT);
+        if (status != UA_STATUSCODE_GOOD) {
+            std::cerr << "opcuaProxy: adding an endpoint failed ("
+                      << UA_StatusCode_name(status) << ")" << std::endl;
+            return false;
+        }
+    }
+    return sconfig.endpointsSize > 0;
+}
+
+bool
+ProxyServer::addVariable (const UA_NodeId &nodeId)
+{
+    const std::string key = nodeKey(nodeId);
+    if (nodes.count(key))
+        return false;
+    if (nodeId.namespaceIndex == 0) {
+        std::cerr << "opcuaProxy: " << key << " - nodes of namespace 0 can not be mirrored" << std::endl;
+        return false;
+    }
+
+    static const UA_AttributeId attributes[] = {
+        UA_ATTRIBUTEID_NODECLASS, UA_ATTRIBUTEID_BROWSENAME, UA_ATTRIBUTEID_DISPLAYNAME,
+        UA_ATTRIBUTEID_DATATYPE, UA_ATTRIBUTEID_VALUERANK, UA_ATTRIBUTEID_ARRAYDIMENSIONS,
+        UA_ATTRIBUTEID_ACCESSLEVEL
+    };
+    const size_t n = sizeof(attributes) / sizeof(attributes[0]);
+    UA_ReadValueId rvi[n];
+    for (size_t i = 0; i < n; i++) {
+        UA_ReadValueId_init(&rvi[i]);
+        rvi[i].nodeId = nodeId;
+        rvi[i].attributeId = attributes[i];
+    }
+    UA_ReadRequest request;
+    UA_ReadRequest_init(&request);
+    request.nodesToRead = rvi;
+    request.nodesToReadSize = n;
+    UA_ReadResponse response = UA_Client_Service_read(client, request);
+
+    UA_StatusCode status = response.responseHeader.serviceResult;
+    if (status == UA_STATUSCODE_GOOD && response.resultsSize != n)
+        status = UA_STATUSCODE_BADUNEXPECTEDERROR;
+    for (size_t i = 0; status == UA_STATUSCODE_GOOD && i < n; i++) {
+        // ArrayDimensions are optional
+        if (attributes[i] != UA_ATTRIBUTEID_ARRAYDIMENSIONS
+                && (response.results[i].hasStatus || !response.results[i].hasValue))
+            status = response.results[i].hasStatus ? response.results[i].status : UA_STATUSCODE_BADNODATA;
+    }
+    if (status == UA_STATUSCODE_GOOD
+            && *static_cast<UA_NodeClass *>(response.results[0].value.data) != UA_NODECLASS_VARIABLE)
+        status = UA_STATUSCODE_BADNODECLASSINVALID;
+    if (status != UA_STATUSCODE_GOOD) {
+        std::cerr << "opcuaProxy: " << key << " - reading the attributes failed ("
+                  << UA_StatusCode_name(status) << ")" << std::endl;
+        UA_ReadResponse_clear(&response);
+        return false;
+    }
+
+    // Attributes are shallow copies of the response
+    UA_VariableAttributes attr = UA_VariableAttributes_default;
+    attr.displayName = *static_cast<UA_LocalizedText *>(response.results[2].value.data);
+    attr.dataType = *static_cast<UA_NodeId *>(response.results[3].value.data);
+    attr.valueRank = *static_cast<UA_Int32 *>(response.results[4].value.data);
+    if (response.results[5].hasValue
+            && UA_Variant_hasArrayType(&response.results[5].value, &UA_TYPES[UA_TYPES_UINT32])) {
+        attr.arrayDimensions = static_cast<UA_UInt32 *>(response.results[5].value.data);
+        attr.arrayDimensionsSize = response.results[5].value.arrayLength;
+    }
+    attr.accessLevel = *static_cast<UA_Byte *>(response.results[6].value.data)
+            & (UA_ACCESSLEVELMASK_READ | UA_ACCESSLEVELMASK_WRITE);
+    const UA_QualifiedName browseName = *static_cast<UA_QualifiedName *>(response.results[1].value.data);
+
+    std::unique_ptr<Node> node(new Node(*this, nodeId));
+    UA_DataSource dataSource;
+    dataSource.read = readValue;
+    dataSource.write = writeValue;
+    status = UA_Server_addDataSourceVariableNode(server, nodeId,
+                                                 UA_NODEID_NUMERIC(0, UA_NS0ID_OBJECTSFOLDER),
+                                                 UA_NODEID_NUMERIC(0, UA_NS0ID_ORGANIZES), browseName,
+                                                 UA_NODEID_NUMERIC(0, UA_NS0ID_BASEDATAVARIABLETYPE),
+                                                 attr, dataSource, node.get(), nullptr);
+    if (status != UA_STATUSCODE_GOOD && attr.dataType.namespaceIndex != 0) {
+        // Data types of the upstream server are unknown to the local server
+        attr.dataType = UA_NODEID_NUMERIC(0, UA_NS0ID_BASEDATATYPE);
+        status = UA_Server_addDataSourceVariableNode(server, nodeId,
+                                                     UA_NODEID_NUMERIC(0, UA_NS0ID_OBJECTSFOLDER),
+                                                     UA_NODEID_NUMERIC(0, UA_NS0ID_ORGANIZES), browseName,
+                                                     UA_NODEID_NUMERIC(0, UA_NS0ID_BASEDATAVARIABLETYPE),
+                                                     attr, dataSource, node.get(), nullptr);
+    }
+    UA_ReadResponse_clear(&response);
+    if (status != UA_STATUSCODE_GOOD) {
+        std::cerr << "opcuaProxy: " << key << " - adding the variable failed ("
+                  << UA_StatusCode_name(status) << ")" << std::endl;
+        return false;
+    }
+    if (config.debug >= 2)
+        std::cout << "opcuaProxy: added " << key << std::endl;
+    nodes[key] = std::move(node);
+    return true;
+}
+
+size_t
+ProxyServer::addVariablesBelow (const UA_NodeId &root)
+{
+    size_t added = 0;
+    std::vector<UA_NodeId> todo(1);
+    UA_NodeId_copy(&root, &todo[0]);
+    std::map<std::string, bool> visited;
+
+    while (!todo.empty()) {
+        UA_NodeId id = todo.back();
+        todo.pop_back();
+        if (visited[nodeKey(id)]) {
+            UA_NodeId_clear(&id);
+            continue;
+        }
+        visited[nodeKey(id)] = true;
+
+        UA_BrowseDescription bd;
+        UA_BrowseDescription_init(&bd);
+        bd.nodeId = id;
+        bd.browseDirection = UA_BROWSEDIRECTION_FORWARD;
+        bd.referenceTypeId = UA_NODEID_NUMERIC(0, UA_NS0ID_HIERARCHICALREFERENCES);
+        bd.includeSubtypes = true;
+        bd.nodeClassMask = UA_NODECLASS_OBJECT | UA_NODECLASS_VARIABLE;
+        bd.resultMask = UA_BROWSERESULTMASK_NODECLASS;
+        UA_BrowseRequest request;
+        UA_BrowseRequest_init(&request);
+        request.nodesToBrowse = &bd;
+        request.nodesToBrowseSize = 1;
+        UA_BrowseResponse response = UA_Client_Service_browse(client, request);
+
+        UA_ByteString continuation = UA_BYTESTRING_NULL;
+        UA_BrowseResult *result = response.resultsSize ? &response.results[0] : nullptr;
+        UA_BrowseNextResponse next;
+        UA_BrowseNextResponse_init(&next);
+        while (result && result->statusCode == UA_STATUSCODE_GOOD) {
+            for (size_t i = 0; i < result->referencesSize; i++) {
+                const UA_ReferenceDescription &ref = result->references[i];
+                if (!UA_ExpandedNodeId_isLocal(&ref.nodeId))
+                    continue;
+                if (ref.nodeClass == UA_NODECLASS_VARIABLE && addVariable(ref.nodeId.nodeId))
+                    added++;
+                // Variables can have variables (properties, structure members) below
+                if (ref.nodeId.nodeId.namespaceIndex != 0) {
+                    todo.emplace_back();
+                    UA_NodeId_copy(&ref.nodeId.nodeId, &todo.back());
+                }
+            }
+            if (!result->continuationPoint.length)
+                break;
+            UA_ByteString_clear(&continuation);
+            UA_ByteString_copy(&result->continuationPoint, &continuation);
+            UA_BrowseNextResponse_clear(&next);
+            UA_BrowseNextRequest nextRequest;
+            UA_BrowseNextRequest_init(&nextRequest);
+            nextRequest.continuationPoints = &continuation;
+            nextRequest.continuationPointsSize = 1;
+            next = UA_Client_Service_browseNext(client, nextRequest);
+            result = next.resultsSize ? &next.results[0] : nullptr;
+        }
+        UA_ByteString_clear(&continuation);
+        UA_BrowseNextResponse_clear(&next);
+        UA_BrowseResponse_clear(&response);
+        UA_NodeId_clear(&id);
+    }
+    return added;
+}
+
+int
+ProxyServer::run (volatile bool &running)
+{
+    UA_StatusCode status = UA_Server_run_startup(server);
+    if (status != UA_STATUSCODE_GOOD) {
+        std::cerr << "opcuaProxy: starting the local server failed ("
+                  << UA_StatusCode_name(status) << ")" << std::endl;
+        return 1;
+    }
+    std::cout << "opcuaProxy: serving " << nodes.size() << " variables of " << config.upstreamUrl
+              << " on " << config.listen << std::endl;
+    serving = true;
+    upstream = std::thread(&ProxyServer::upstreamLoop, this);
+
+    UA_DateTime nextReport = UA_DateTime_nowMonotonic()
+            + static_cast<UA_DateTime>(config.reportInterval * UA_DATETIME_SEC);
+    while (running) {
+        UA_Server_run_iterate(server, true);
+
+        const UA_DateTime now = UA_DateTime_nowMonotonic();
+        if (config.reportInterval > 0.0 && now >= nextReport) {
+            nextReport = now + static_cast<UA_DateTime>(config.reportInterval * UA_DATETIME_SEC);
+            report();
+        }
+    }
+
+    serving = false;
+    stopping = true;
+    upstream.join();
+    UA_Server_run_shutdown(server);
+    report();
+    return 0;
+}
+
+void
+ProxyServer::report ()
+{
+    std::lock_guard<std::mutex> guard(lock);
+    unsigned long monitored = 0, updates = 0, reads = 0, writes = 0;
+    for (auto &it : nodes) {
+        if (it.second->monitoredItemId)
+            monitored++;
+        updates += it.second->updates;
+        reads += it.second->reads;
+        writes += it.second->writes;
+    }
+    std::cout << "opcuaProxy: upstream=" << config.upstreamUrl
+              << " state=" << (upstreamUp ? "connected" : "down")
+              << " connects=" << connects
+              << " variables=" << nodes.size()
+              << " monitored=" << monitored
+              << " updates=" << updates
+              << " reads=" << reads
+              << " writes=" << writes
+              << " failed=" << monitorFailures
+              << " idle=" << idleRemoved
+              << " timeouts=" << writeTimeouts
+              << std::endl;
+    if (config.debug >= 2) {
+        for (auto &it : nodes)
+            std::cout << "  " << it.first
+                      << " monitored=" << (it.second->monitoredItemId ? "y" : "n")
+                      << " updates=" << it.second->updates
+                      << " reads=" << it.second->reads
+                      << " writes=" << it.second->writes
+                      << std::endl;
+    }
+}
+
+// Upstream thread: the only user of the upstream clients
+// (the lock is never held during upstream service calls, they deliver data changes)
+void
+ProxyServer::upstreamLoop ()
+{
+    UA_DateTime nextHousekeeping = 0;
+    while (!stopping) {
+        if (upstreamUp)
+            UA_Client_run_iterate(client, 10);
+        else
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+        const UA_DateTime now = UA_DateTime_nowMonotonic();
+        if (resync) {
+            // A new upstream session has no subscription: monitor again on the next access
+            resync = false;
+            if (subscriptionId)
+                UA_Client_Subscriptions_deleteSingle(client, subscriptionId);
+            subscriptionId = 0;
+            std::lock_guard<std::mutex> guard(lock);
+            for (auto &it : nodes) {
+                it.second->monitoredItemId = 0;
+                it.second->nextMonitor = 0;
+            }
+        }
+        if (!upstreamUp && now >= nextReconnect) {
+            nextReconnect = now + retryDelay;
+            UA_Client_disconnect(client);
+            UA_StatusCode status = connectClient(client, identity);
+            if (config.debug)
+                std::cout << "opcuaProxy: reconnecting to " << config.upstreamUrl
+                          << " (" << UA_StatusCode_name(status) << ")" << std::endl;
+        }
+
+        std::deque<Node *> monitors;
+        std::deque<std::shared_ptr<WriteJob>> writes;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            monitors.swap(monitorQueue);
+            writes.swap(writeQueue);
+        }
+        for (auto node : monitors) {
+            monitor(*node);
+            std::lock_guard<std::mutex> guard(lock);
+            node->monitorQueued = false;
+        }
+        for (auto &job : writes) {
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                if (job->cancelled)
+                    continue;
+            }
+            forwardWrite(*job);
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                job->done = true;
+            }
+            writeDone.notify_all();
+        }
+
+        if (now >= nextHousekeeping) {
+            nextHousekeeping = now + UA_DATETIME_SEC;
+            if (upstreamUp)
+                removeIdle(now);
+            for (auto &it : writers)
+                UA_Client_run_iterate(it.second.client, 0);
+        }
+    }
+
+    for (auto &it : writers) {
+        UA_Client_disconnect(it.second.client);
+        UA_Client_delete(it.second.client);
+    }
+    writers.clear();
+}
+
+// Called with the lock held
+void
+ProxyServer::queueMonitor (Node &node, const UA_DateTime now)
+{
+    if (node.monitoredItemId || node.monitorQueued || !upstreamUp || now < node.nextMonitor)
+        return;
+    node.monitorQueued = true;
+    monitorQueue.push_back(&node);
+}
+
+void
+ProxyServer::monitor (Node &node)
+{
+    const UA_DateTime now = UA_DateTime_nowMonotonic();
+    if (!upstreamUp)
+        return;
+
+    if (!subscriptionId) {
+        UA_CreateSubscriptionRequest request = UA_CreateSubscriptionRequest_default();
+        request.requestedPublishingInterval = config.publishingInterval;
+        UA_CreateSubscriptionResponse response
+                = UA_Client_Subscriptions_create(client, request, this, nullptr, nullptr);
+        if (response.responseHeader.serviceResult == UA_STATUSCODE_GOOD)
+            subscriptionId = response.subscriptionId;
+        else
+            std::cerr << "opcuaProxy: createSubscription failed ("
+                      << UA_StatusCode_name(response.responseHeader.serviceResult) << ")" << std::endl;
+        UA_CreateSubscriptionResponse_clear(&response);
+        if (!subscriptionId) {
+            std::lock_guard<std::mutex> guard(lock);
+            node.nextMonitor = now + retryDelay;
+            return;
+        }
+    }
+
+    UA_MonitoredItemCreateRequest request = UA_MonitoredItemCreateRequest_default(node.nodeId);
+    request.requestedParameters.samplingInterval = config.samplingInterval;
+    UA_MonitoredItemCreateResult result = UA_Client_MonitoredItems_createDataChange(
+                client, subscriptionId, UA_TIMESTAMPSTORETURN_BOTH, request, &node, dataChange, nullptr);
+    bool needValue = false;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if (result.statusCode == UA_STATUSCODE_GOOD) {
+            node.monitoredItemId = result.monitoredItemId;
+            needValue = !node.value.hasValue;
+        } else {
+            monitorFailures++;
+            node.nextMonitor = now + retryDelay;
+            UA_DataValue_clear(&node.value);
+            node.value.hasStatus = true;
+            node.value.status = result.statusCode;
+        }
+    }
+    if (result.statusCode != UA_STATUSCODE_GOOD && config.debug)
+        std::cerr << "opcuaProxy: " << nodeKey(node.nodeId) << " - createMonitoredItems failed ("
+                  << UA_StatusCode_name(result.statusCode) << ")" << std::endl;
+    UA_MonitoredItemCreateResult_clear(&result);
+
+    // The first notification comes with the next publish response: read the current value now
+    if (needValue) {
+        UA_ReadValueId rvi;
+        UA_ReadValueId_init(&rvi);
+        rvi.nodeId = node.nodeId;
+        rvi.attributeId = UA_ATTRIBUTEID_VALUE;
+        UA_ReadRequest request;
+        UA_ReadRequest_init(&request);
+        request.timestampsToReturn = UA_TIMESTAMPSTORETURN_BOTH;
+        request.nodesToRead = &rvi;
+        request.nodesToReadSize = 1;
+        UA_ReadResponse response = UA_Client_Service_read(client, request);
+        if (response.responseHeader.serviceResult == UA_STATUSCODE_GOOD && response.resultsSize == 1) {
+            std::lock_guard<std::mutex> guard(lock);
+            if (!node.value.hasValue) {
+                UA_DataValue_clear(&node.value);
+                UA_DataValue_copy(&response.results[0], &node.value);
+            }
+        }
+        UA_ReadResponse_clear(&response);
+    }
+}
+
+UA_Client *
+ProxyServer::writerFor (const Identity &id, const UA_DateTime now, UA_StatusCode &status)
+{
+    const std::string key = id.key();
+    auto it = writers.find(key);
+    if (it == writers.end()) {
+        UA_Client *c = newClient(id, false);
+        if (!c) {
+            status = UA_STATUSCODE_BADINTERNALERROR;
+            return nullptr;
+        }
+        it = writers.emplace(key, Writer{c, now}).first;
+    }
+    Writer &writer = it->second;
+    writer.lastUse = now;
+
+    UA_SecureChannelState channelState;
+    UA_SessionState state;
+    UA_StatusCode connectStatus;
+    UA_Client_getState(writer.client, &channelState, &state, &connectStatus);
+    if (state == UA_SESSIONSTATE_ACTIVATED)
+        return writer.client;
+
+    UA_Client_disconnect(writer.client);
+    status = connectClient(writer.client, id);
+    if (status == UA_STATUSCODE_GOOD)
+        return writer.client;
+    // Do not keep sessions with rejected credentials
+    if (config.debug)
+        std::cerr << "opcuaProxy: upstream session for "
+                  << (id.user.empty() ? std::string("anonymous") : "user " + id.user)
+                  << " failed (" << UA_StatusCode_name(status) << ")" << std::endl;
+    UA_Client_delete(writer.client);
+    writers.erase(it);
+    return nullptr;
+}
+
+void
+ProxyServer::forwardWrite (WriteJob &job)
+{
+    UA_StatusCode status = UA_STATUSCODE_GOOD;
+    UA_Client *c = nullptr;
+    if (!upstreamUp)
+        status = UA_STATUSCODE_BADSERVERNOTCONNECTED;
+    else if (job.identity.key() == identity.key())
+        c = client;
+    else
+        c = writerFor(job.identity, UA_DateTime_nowMonotonic(), status);
+
+    if (c) {
+        // Request parts are shallow copies
+        UA_WriteValue wv;
+        UA_WriteValue_init(&wv);
+        wv.nodeId = job.node->nodeId;
+        wv.attributeId = UA_ATTRIBUTEID_VALUE;
+        wv.value = job.value;
+        UA_WriteRequest request;
+        UA_WriteRequest_init(&request);
+        request.nodesToWrite = &wv;
+        request.nodesToWriteSize = 1;
+        UA_WriteResponse response = UA_Client_Service_write(c, request);
+        status = response.responseHeader.serviceResult;
+        if (status == UA_STATUSCODE_GOOD)
+            status = response.resultsSize == 1 ? response.results[0] : UA_STATUSCODE_BADUNEXPECTEDERROR;
+        UA_WriteResponse_clear(&response);
+    }
+    job.status = status;
+}
+
+void
+ProxyServer::removeIdle (const UA_DateTime now)
+{
+    const UA_DateTime idle = static_cast<UA_DateTime>(config.idleTime * UA_DATETIME_SEC);
+    if (idle <= 0)
+        return;
+
+    std::vector<UA_UInt32> idleItems;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        for (auto &it : nodes) {
+            Node &node = *it.second;
+            if (!node.monitoredItemId || now - node.lastAccess < idle)
+                continue;
+            idleItems.push_back(node.monitoredItemId);
+            node.monitoredItemId = 0;
+            UA_DataValue_clear(&node.value);
+            idleRemoved++;
+            if (config.debug >= 2)
+                std::cout << "opcuaProxy: " << it.first << " idle - monitored item deleted" << std::endl;
+        }
+    }
+    for (auto id : idleItems)
+        UA_Client_MonitoredItems_deleteSingle(client, subscriptionId, id);
+
+    for (auto it = writers.begin(); it != writers.end();) {
+        if (now - it->second.lastUse < idle) {
+            ++it;
+            continue;
+        }
+        UA_Client_disconnect(it->second.client);
+        UA_Client_delete(it->second.client);
+        it = writers.erase(it);
+    }
+}
+
+// Called with the lock held
+void
+ProxyServer::setDisconnected ()
+{
+    for (auto &it : nodes) {
+        Node &node = *it.second;
+        UA_DataValue_clear(&node.value);
+        // (one of the codes that local clients can create monitored items with)
+        node.value.hasStatus = true;
+        node.value.status = UA_STATUSCODE_BADCOMMUNICATIONERROR;
+    }
+}
+
+// callbacks
+
+UA_StatusCode
+ProxyServer::readValue (UA_Server *, const UA_NodeId *, void *,
+                        const UA_NodeId *, void *nodeContext,
+                        UA_Boolean includeSourceTimeStamp, const UA_NumericRange *range,
+                        UA_DataValue *value)
+{
+    Node *node = static_cast<Node *>(nodeContext);
+    // Adding the variable reads the value for the type check
+    if (!node || !node->proxy.serving)
+        return UA_STATUSCODE_GOOD;
+    ProxyServer &proxy = node->proxy;
+
+    const UA_DateTime now = UA_DateTime_nowMonotonic();
+    std::lock_guard<std::mutex> guard(proxy.lock);
+    node->lastAccess = now;
+    node->reads++;
+    proxy.queueMonitor(*node, now);
+
+    UA_StatusCode status = UA_STATUSCODE_GOOD;
+    if (range && node->value.hasValue) {
+        *value = node->value;
+        UA_Variant_init(&value->value);
+        status = UA_Variant_copyRange(&node->value.value, &value->value, *range);
+    } else {
+        status = UA_DataValue_copy(&node->value, value);
+    }
+    if (!value->hasValue && !value->hasStatus) {
+        value->hasStatus = true;
+        value->status = UA_STATUSCODE_BADWAITINGFORINITIALDATA;
+    }
+    if (!includeSourceTimeStamp) {
+        value->hasSourceTimestamp = false;
+        value->hasSourcePicoseconds = false;
+    }
+    return status;
+}
+
+UA_StatusCode
+ProxyServer::writeValue (UA_Server *, const UA_NodeId *, void *sessionContext,
+                         const UA_NodeId *, void *nodeContext,
+                         const UA_NumericRange *range, const UA_DataValue *value)
+{
+    Node *node = static_cast<Node *>(nodeContext);
+    // Adding the variable writes the (empty) value attribute
+    if (!node || !node->proxy.serving)
+        return UA_STATUSCODE_GOOD;
+    ProxyServer &proxy = node->proxy;
+    if (!proxy.upstreamUp)
+        return UA_STATUSCODE_BADSERVERNOTCONNECTED;
+    if (range)
+        return UA_STATUSCODE_BADWRITENOTSUPPORTED;
+
+    std::shared_ptr<WriteJob> job(new WriteJob);
+    job->node = node;
+    UA_StatusCode status = UA_DataValue_copy(value, &job->value);
+    if (status != UA_STATUSCODE_GOOD)
+        return status;
+    // Set by the access control for sessions with a username token
+    if (sessionContext)
+        job->identity = *static_cast<const Identity *>(sessionContext);
+
+    const UA_DateTime now = UA_DateTime_nowMonotonic();
+    std::unique_lock<std::mutex> guard(proxy.lock);
+    node->lastAccess = now;
+    node->writes++;
+    // Local readbacks of the written value
+    proxy.queueMonitor(*node, now);
+    proxy.writeQueue.push_back(job);
+    if (!proxy.writeDone.wait_for(guard, std::chrono::duration<double>(proxy.config.writeTimeout),
+                                  [&job] { return job->done; })) {
+        job->cancelled = true;
+        proxy.writeTimeouts++;
+        return UA_STATUSCODE_BADTIMEOUT;
+    }
+    return job->status;
+}
+
+void
+ProxyServer::dataChange (UA_Client *, UA_UInt32, void *,
+                         UA_UInt32, void *monContext, UA_DataValue *value)
+{
+    Node *node = static_cast<Node *>(monContext);
+    std::lock_guard<std::mutex> guard(node->proxy.lock);
+    UA_DataValue_clear(&node->value);
+    UA_DataValue_copy(value, &node->value);
+    node->updates++;
+}
+
+void
+ProxyServer::stateChanged (UA_Client *client, UA_SecureChannelState,
+                           UA_SessionState sessionState, UA_StatusCode)
+{
+    ProxyServer *proxy = static_cast<ProxyServer *>(UA_Client_getContext(client));
+    if (!proxy || sessionState == proxy->sessionState)
+        return;
+    if (sessionState == UA_SESSIONSTATE_ACTIVATED) {
+        {
+            std::lock_guard<std::mutex> guard(proxy->lock);
+            proxy->connects++;
+        }
+        proxy->resync = true;
+        proxy->upstreamUp = true;
+        std::cout << "opcuaProxy: connected to " << proxy->config.upstreamUrl << std::endl;
+    } else if (proxy->sessionState == UA_SESSIONSTATE_ACTIVATED) {
+        proxy->upstreamUp = false;
+        {
+            std::lock_guard<std::mutex> guard(proxy->lock);
+            proxy->setDisconnected();
+        }
+        proxy->nextReconnect = UA_DateTime_nowMonotonic() + retryDelay;
+        std::cout << "opcuaProxy: disconnected from " << proxy->config.upstreamUrl << std::endl;
+    }
+    proxy->sessionState = sessionState;
+}
+
+} // namespace DevOpcua
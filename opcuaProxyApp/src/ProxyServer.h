@@ -0,0 +1,249 @@
+/*************************************************************************\
+* Copyright (c) 2026 ITER Organization.
+* This module is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Author: Dirk Zimoch <dirk.zimoch@psi.ch>
+ */
+
+#ifndef DEVOPCUA_PROXYSERVER_H
+#define DEVOPCUA_PROXYSERVER_H
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+#include <open62541/client.h>
+#include <open62541/server.h>
+
+namespace DevOpcua {
+
+/**
+ * @brief Parse a node id in the link syntax of the device support.
+ *
+ * Accepts "ns=<index>;i=<number>" and "ns=<index>;s=<string>"
+ * (the namespace part is optional and defaults to 0).
+ *
+ * @param text  node id string
+ * @param[out] nodeId  parsed node id (allocated, to be cleared by the caller)
+ *
+ * @return  true if successful
+ */
+bool parseNodeId(const std::string &text, UA_NodeId &nodeId);
+
+/**
+ * @brief Local multiplexing proxy for an upstream OPC UA server.
+ *
+ * Holds one session to the upstream server and serves the configured
+ * variables of the upstream server to local clients (IOCs), with the same
+ * node ids and namespace indices.
+ *
+ * A variable gets one monitored item on the upstream server when a local
+ * client first accesses it. Local reads and the sampling of local monitored
+ * items are served from the values delivered by that monitored item, so any
+ * number of local clients and monitored items create no additional load on
+ * the upstream server. The upstream monitored items use one sampling rate
+ * (the local monitored items apply their own sampling interval, queue and
+ * deadband to the values of that rate).
+ * Monitored items that have not been accessed for the idle time are deleted.
+ *
+ * Writes are forwarded to the upstream server with the identity of the local
+ * session: username tokens are passed on to an upstream session of that user,
+ * anonymous writes use an anonymous upstream session.
+ * The cached values are read with the identity of the proxy itself.
+ *
+ * The local server runs in the thread calling run(). All upstream service
+ * calls (connect, monitored items, reads, writes) run in an upstream thread,
+ * so a slow or disconnected upstream server does not block the local clients.
+ * Local reads never wait for the upstream server (the first read of a variable
+ * that is not monitored yet returns BadWaitingForInitialData).
+ * Writes wait for the upstream result up to the write timeout.
+ */
+class ProxyServer
+{
+    // Cannot copy a proxy
+    ProxyServer(const ProxyServer &);
+    ProxyServer &operator=(const ProxyServer &);
+
+public:
+    /**
+     * @brief Proxy configuration.
+     */
+    struct Config {
+        std::string upstreamUrl;            /**< URL of the upstream server */
+        std::string identityFile;           /**< upstream credentials of the proxy (user=/pass=) */
+        std::string listen;                 /**< local endpoint (opc.unix://<path> or TCP port) */
+        unsigned int socketMode = 0660;     /**< permissions of the Unix socket */
+        std::string socketGroup;            /**< group of the Unix socket (empty = of the process) */
+        std::string certificate;            /**< server certificate (TCP listener) */
+        std::string privateKey;             /**< server private key (TCP listener) */
+        std::vector<std::string> trustList; /**< trusted client certificates (TCP listener) */
+        std::string userFile;               /**< local users (TCP listener, <user>:<password> lines) */
+        double publishingInterval = 100.0;  /**< upstream publishing interval [ms] */
+        double samplingInterval = -1.0;     /**< upstream sampling interval [ms] (-1 = publishing interval) */
+        double idleTime = 60.0;             /**< delete unused upstream monitored items after [s] */
+        double writeTimeout = 2.0;          /**< local write waits for the upstream result [s] */
+        double reportInterval = 0.0;        /**< print statistics every [s] (0 = off) */
+        int debug = 0;                      /**< debug level */
+    };
+
+    explicit ProxyServer(const Config &config);
+    ~ProxyServer();
+
+    /**
+     * @brief Connect to the upstream server and set up the local server.
+     *
+     * Mirrors the namespace array of the upstream server.
+     *
+     * @return  true if successful
+     */
+    bool setup();
+
+    /**
+     * @brief Add an upstream variable to the local server.
+     *
+     * Reads the attributes of the node from the upstream server and adds
+     * a variable with the same node id to the local server.
+     *
+     * @param nodeId  upstream node id
+     *
+     * @return  true if the variable was added
+     */
+    bool addVariable(const UA_NodeId &nodeId);
+
+    /**
+     * @brief Add all upstream variables below a node.
+     *
+     * Follows the hierarchical references of the upstream address space.
+     *
+     * @param root  node to start browsing at
+     *
+     * @return  number of variables added
+     */
+    size_t addVariablesBelow(const UA_NodeId &root);
+
+    /**
+     * @brief Serve local clients until running is cleared.
+     *
+     * Starts the upstream thread and stops it before returning.
+     *
+     * @param running  flag to stop the loop (e.g. from a signal handler)
+     *
+     * @return  0 on clean exit
+     */
+    int run(volatile bool &running);
+
+    /**
+     * @brief Print statistics on stdout.
+     */
+    void report();
+
+    /**
+     * @brief Identity of a local session (username token), forwarded upstream.
+     */
+    struct Identity {
+        std::string user;                   /**< user name (empty = anonymous) */
+        std::string password;
+        std::string key() const { return user.empty() ? std::string() : user + '\n' + password; }
+    };
+
+private:
+    // A mirrored upstream variable (the mutable members are guarded by lock)
+    struct Node {
+        Node(ProxyServer &proxy, const UA_NodeId &id);
+        ~Node();
+        ProxyServer &proxy;
+        UA_NodeId nodeId;
+        UA_DataValue value;                 /**< last value from upstream */
+        UA_UInt32 monitoredItemId;          /**< upstream monitored item (0 = none) */
+        bool monitorQueued;                 /**< creation of the monitored item queued */
+        UA_DateTime lastAccess;             /**< last local read or write */
+        UA_DateTime nextMonitor;            /**< earliest retry of a failed createMonitoredItems */
+        unsigned long updates;              /**< values received from upstream */
+        unsigned long reads;                /**< local reads served */
+        unsigned long writes;               /**< local writes forwarded */
+    };
+
+    // A local write waiting for the upstream result
+    struct WriteJob {
+        WriteJob() { UA_DataValue_init(&value); }
+        ~WriteJob() { UA_DataValue_clear(&value); }
+        Node *node = nullptr;
+        UA_DataValue value;
+        Identity identity;
+        bool done = false;
+        bool cancelled = false;             /**< timed out locally, do not forward */
+        UA_StatusCode status = UA_STATUSCODE_BADTIMEOUT;
+    };
+
+    // Upstream session with the identity of local writers
+    struct Writer {
+        UA_Client *client;
+        UA_DateTime lastUse;
+    };
+
+    static UA_StatusCode readValue(UA_Server *server, const UA_NodeId *sessionId, void *sessionContext,
+                                   const UA_NodeId *nodeId, void *nodeContext,
+                                   UA_Boolean includeSourceTimeStamp, const UA_NumericRange *range,
+                                   UA_DataValue *value);
+    static UA_StatusCode writeValue(UA_Server *server, const UA_NodeId *sessionId, void *sessionContext,
+                                    const UA_NodeId *nodeId, void *nodeContext,
+                                    const UA_NumericRange *range, const UA_DataValue *value);
+    static void dataChange(UA_Client *client, UA_UInt32 subId, void *subContext,
+                           UA_UInt32 monId, void *monContext, UA_DataValue *value);
+    static void stateChanged(UA_Client *client, UA_SecureChannelState channelState,
+                             UA_SessionState sessionState, UA_StatusCode connectStatus);
+
+    // Local server configuration
+    bool setupListener(UA_ServerConfig &sconfig);
+    bool setupAccessControl(UA_ServerConfig &sconfig, const bool allowAnonymous, const bool checkUsers,
+                            const UA_String &userTokenPolicyUri);
+    bool setupEndpoints(UA_ServerConfig &sconfig, const bool allowNone);
+
+    // Upstream thread
+    void upstreamLoop();
+    UA_Client *newClient(const Identity &identity, const bool withState);
+    UA_StatusCode connectClient(UA_Client *client, const Identity &identity);
+    UA_Client *writerFor(const Identity &identity, const UA_DateTime now, UA_StatusCode &status);
+    void queueMonitor(Node &node, const UA_DateTime now);
+    void monitor(Node &node);
+    void forwardWrite(WriteJob &job);
+    void removeIdle(const UA_DateTime now);
+    void setDisconnected();
+
+    Config config;
+    Identity identity;                      /**< upstream identity of the proxy */
+    UA_Client *client;                      /**< upstream session (cache) */
+    UA_Server *server;                      /**< local server */
+    UA_SessionState sessionState;           /**< upstream session state (upstream thread) */
+    std::atomic<bool> upstreamUp;           /**< upstream session activated */
+    std::atomic<bool> stopping;             /**< stop the upstream thread */
+    UA_UInt32 subscriptionId;               /**< upstream subscription (0 = none) */
+    bool serving;                           /**< local server is running */
+    bool resync;                            /**< upstream session (re)activated */
+    UA_DateTime nextReconnect;              /**< earliest upstream reconnect */
+    std::vector<std::string> namespaces;    /**< upstream namespace array */
+    std::map<std::string, std::unique_ptr<Node>> nodes; /**< mirrored variables by node id */
+    std::map<std::string, Writer> writers;  /**< upstream sessions of writing identities (upstream thread) */
+    std::thread upstream;                   /**< upstream thread */
+    std::mutex lock;                        /**< guards the node values, statistics and queues */
+    std::condition_variable writeDone;      /**< signals completed writes */
+    std::deque<Node *> monitorQueue;        /**< monitored items to create */
+    std::deque<std::shared_ptr<WriteJob>> writeQueue; /**< writes to forward */
+    unsigned long connects;                 /**< upstream session activations */
+    unsigned long monitorFailures;          /**< failed createMonitoredItems */
+    unsigned long idleRemoved;              /**< monitored items deleted as idle */
+    unsigned long writeTimeouts;            /**< local writes that timed out */
+};
+
+} // namespace DevOpcua
+
+#endif // DEVOPCUA_PROXYSERVER_H
@@ -0,0 +1,360 @@
+/*************************************************************************\
+* Copyright (c) 2026 ITER Organization.
+* This module is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Author: Dirk Zimoch <dirk.zimoch@psi.ch>
+ */
+
+#include <cstring>
+#include <cerrno>
+#include <string>
+#include <list>
+
+#include "UnixListener.h"
+
+#ifdef HAS_UNIX_TRANSPORT
+#include <unistd.h>
+#include <grp.h>
+#include <libgen.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+
+#include <open62541/plugin/log.h>
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+namespace DevOpcua {
+
+namespace {
+
+// Modelled on the TCP server network layer of open62541 1.2
+
+struct Listener {
+    const UA_Logger *logger;
+    std::string path;
+    unsigned int mode;
+    std::string group;
+    int socket;
+    UA_UInt32 recvBufferSize;
+    std::list<UA_Connection *> connections;
+};
+
+UA_StatusCode
+listenerGetSendBuffer (UA_Connection *, size_t length, UA_ByteString *buf)
+{
+    return UA_ByteString_allocBuffer(buf, length);
+}
+
+void
+listenerReleaseBuffer (UA_Connection *, UA_ByteString *buf)
+{
+    UA_ByteString_clear(buf);
+}
+
+UA_StatusCode
+listenerSend (UA_Connection *connection, UA_ByteString *buf)
+{
+    if (connection->state == UA_CONNECTIONSTATE_CLOSED) {
+        UA_ByteString_clear(buf);
+        return UA_STATUSCODE_BADCONNECTIONCLOSED;
+    }
+    size_t nWritten = 0;
+    while (nWritten < buf->length) {
+        ssize_t n = send(connection->sockfd, buf->data + nWritten,
+                         buf->length - nWritten, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            connection->close(connection);
+            UA_ByteString_clear(buf);
+            return UA_STATUSCODE_BADCONNECTIONCLOSED;
+        }
+        nWritten += static_cast<size_t>(n);
+    }
+    UA_ByteString_clear(buf);
+    return UA_STATUSCODE_GOOD;
+}
+
+// Only shut down, the socket is closed when listen picks up the closed connection
+void
+listenerClose (UA_Connection *connection)
+{
+    if (connection->state == UA_CONNECTIONSTATE_CLOSED)
+        return;
+    shutdown(connection->sockfd, SHUT_RDWR);
+    connection->state = UA_CONNECTIONSTATE_CLOSED;
+}
+
+void
+listenerFree (UA_Connection *connection)
+{
+    delete connection;
+}
+
+UA_StatusCode
+listenerStart (UA_ServerNetworkLayer *nl, const UA_Logger *logger, const UA_String *)
+{
+    Listener *listener = static_cast<Listener *>(nl->handle);
+    listener->logger = logger;
+
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (listener->path.length() >= sizeof(addr.sun_path)) {
+        UA_LOG_ERROR(logger, UA_LOGCATEGORY_NETWORK,
+                     "Unix socket path too long: %s", listener->path.c_str());
+        return UA_STATUSCODE_BADINTERNALERROR;
+    }
+    strcpy(addr.sun_path, listener->path.c_str());
+
+    std::string error;
+    if (!prepareSocketPath(listener->path, error)) {
+        UA_LOG_ERROR(logger, UA_LOGCATEGORY_NETWORK, "%s", error.c_str());
+        return UA_STATUSCODE_BADCOMMUNICATIONERROR;
+    }
+    gid_t gid = static_cast<gid_t>(-1);
+    if (listener->group.length()) {
+        struct group *gr = getgrnam(listener->group.c_str());
+        if (!gr) {
+            UA_LOG_ERROR(logger, UA_LOGCATEGORY_NETWORK,
+                         "Unknown group %s for the Unix server socket", listener->group.c_str());
+            return UA_STATUSCODE_BADCONFIGURATIONERROR;
+        }
+        gid = gr->gr_gid;
+    }
+
+    listener->socket = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener->socket < 0) {
+        UA_LOG_ERROR(logger, UA_LOGCATEGORY_NETWORK,
+                     "Error opening the Unix server socket: %s", strerror(errno));
+        return UA_STATUSCODE_BADCOMMUNICATIONERROR;
+    }
+    // Create the socket file without access for others, then set the configured permissions
+    const mode_t oldMask = umask(0177);
+    int status = bind(listener->socket, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr));
+    umask(oldMask);
+    if (status < 0
+            || (gid != static_cast<gid_t>(-1) && chown(listener->path.c_str(), static_cast<uid_t>(-1), gid) < 0)
+            || chmod(listener->path.c_str(), static_cast<mode_t>(listener->mode)) < 0
+            || listen(listener->socket, 100) < 0) {
+        UA_LOG_ERROR(logger, UA_LOGCATEGORY_NETWORK,
+                     "Error binding the Unix server socket %s: %s",
+                     listener->path.c_str(), strerror(errno));
+        if (status == 0)
+            unlink(listener->path.c_str());
+        close(listener->socket);
+        listener->socket = -1;
+        return UA_STATUSCODE_BADCOMMUNICATIONERROR;
+    }
+
+    const std::string url = unixTransportScheme + listener->path;
+    UA_String_clear(&nl->discoveryUrl);
+    nl->discoveryUrl = UA_STRING_ALLOC(url.c_str());
+    UA_LOG_INFO(logger, UA_LOGCATEGORY_NETWORK, "Unix network layer listening on %s", url.c_str());
+    return UA_STATUSCODE_GOOD;
+}
+
+void
+listenerAdd (Listener *listener, int sockfd)
+{
+    UA_Connection *c = new UA_Connection();
+    c->sockfd = sockfd;
+    c->handle = listener;
+    c->send = listenerSend;
+    c->close = listenerClose;
+    c->free = listenerFree;
+    c->getSendBuffer = listenerGetSendBuffer;
+    c->releaseSendBuffer = listenerReleaseBuffer;
+    c->releaseRecvBuffer = listenerReleaseBuffer;
+    c->state = UA_CONNECTIONSTATE_OPENING;
+    c->openingDate = UA_DateTime_nowMonotonic();
+    listener->connections.push_back(c);
+    UA_LOG_INFO(listener->logger, UA_LOGCATEGORY_NETWORK,
+                "Connection %i | New connection over Unix socket", sockfd);
+}
+
+UA_StatusCode
+listenerListen (UA_ServerNetworkLayer *nl, UA_Server *server, UA_UInt16 timeout)
+{
+    Listener *listener = static_cast<Listener *>(nl->handle);
+
+    fd_set fdset;
+    FD_ZERO(&fdset);
+    int highestfd = -1;
+    if (listener->socket >= 0) {
+        FD_SET(listener->socket, &fdset);
+        highestfd = listener->socket;
+    }
+    for (auto c : listener->connections) {
+        FD_SET(c->sockfd, &fdset);
+        if (c->sockfd > highestfd)
+            highestfd = c->sockfd;
+    }
+    if (highestfd < 0)
+        return UA_STATUSCODE_GOOD;
+
+    struct timeval tv = {0, timeout * 1000};
+    if (select(highestfd + 1, &fdset, nullptr, nullptr, &tv) <= 0)
+        return UA_STATUSCODE_GOOD;
+
+    if (listener->socket >= 0 && FD_ISSET(listener->socket, &fdset)) {
+        int sockfd = accept(listener->socket, nullptr, nullptr);
+        if (sockfd >= 0)
+            listenerAdd(listener, sockfd);
+    }
+
+    for (auto it = listener->connections.begin(); it != listener->connections.end(); ) {
+        UA_Connection *c = *it;
+        if (!FD_ISSET(c->sockfd, &fdset)) {
+            ++it;
+            continue;
+        }
+        UA_ByteString buf;
+        ssize_t n = -1;
+        if (c->state != UA_CONNECTIONSTATE_CLOSED
+                && UA_ByteString_allocBuffer(&buf, listener->recvBufferSize) == UA_STATUSCODE_GOOD) {
+            do {
+                n = recv(c->sockfd, buf.data, buf.length, 0);
+            } while (n < 0 && errno == EINTR);
+            if (n > 0) {
+                buf.length = static_cast<size_t>(n);
+                UA_Server_processBinaryMessage(server, c, &buf);
+            }
+            UA_ByteString_clear(&buf);
+        }
+        // Remote side or server closed the connection
+        if (n <= 0 || c->state == UA_CONNECTIONSTATE_CLOSED) {
+            UA_LOG_INFO(listener->logger, UA_LOGCATEGORY_NETWORK,
+                        "Connection %i | Closed", static_cast<int>(c->sockfd));
+            it = listener->connections.erase(it);
+            c->state = UA_CONNECTIONSTATE_CLOSED;
+            close(c->sockfd);
+            UA_Server_removeConnection(server, c);
+            continue;
+        }
+        ++it;
+    }
+    return UA_STATUSCODE_GOOD;
+}
+
+void
+listenerStop (UA_ServerNetworkLayer *nl, UA_Server *server)
+{
+    Listener *listener = static_cast<Listener *>(nl->handle);
+    UA_LOG_INFO(listener->logger, UA_LOGCATEGORY_NETWORK, "Shutting down the Unix network layer");
+    if (listener->socket >= 0) {
+        close(listener->socket);
+        listener->socket = -1;
+        unlink(listener->path.c_str());
+    }
+    // Shut down the connections, listen picks them up and frees them
+    for (auto c : listener->connections)
+        listenerClose(c);
+    listenerListen(nl, server, 0);
+}
+
+void
+listenerClear (UA_ServerNetworkLayer *nl)
+{
+    Listener *listener = static_cast<Listener *>(nl->handle);
+    UA_String_clear(&nl->discoveryUrl);
+    for (auto c : listener->connections) {
+        close(c->sockfd);
+        delete c;
+    }
+    delete listener;
+}
+
+} // namespace
+
+bool
+prepareSocketPath (const std::string &path, std::string &error)
+{
+    std::string dir(path);
+    dir = dirname(&dir[0]);
+    struct stat st;
+    if (stat(dir.c_str(), &st) < 0) {
+        error = "Directory " + dir + " of the Unix server socket: " + strerror(errno);
+        return false;
+    }
+    if (st.st_mode & S_IWOTH) {
+        error = "Directory " + dir + " of the Unix server socket is writable by all users";
+        return false;
+    }
+
+    if (lstat(path.c_str(), &st) < 0) {
+        if (errno == ENOENT)
+            return true;
+        error = "Unix server socket " + path + ": " + strerror(errno);
+        return false;
+    }
+    if (!S_ISSOCK(st.st_mode)) {
+        error = "Unix server socket " + path + " exists and is not a socket";
+        return false;
+    }
+
+    // Only remove a stale socket: a listening one belongs to a running process
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (path.length() >= sizeof(addr.sun_path)) {
+        error = "Unix socket path too long: " + path;
+        return false;
+    }
+    strcpy(addr.sun_path, path.c_str());
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        error = std::string("Error opening a Unix socket: ") + strerror(errno);
+        return false;
+    }
+    int status = connect(fd, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr));
+    int connectErrno = errno;
+    close(fd);
+    if (status == 0) {
+        error = "Unix server socket " + path + " is in use by another process";
+        return false;
+    }
+    if (connectErrno != ECONNREFUSED) {
+        error = "Unix server socket " + path + ": " + strerror(connectErrno);
+        return false;
+    }
+    if (unlink(path.c_str()) < 0) {
+        error = "Removing the stale Unix server socket " + path + ": " + strerror(errno);
+        return false;
+    }
+    return true;
+}
+
+UA_ServerNetworkLayer
+unixListener (const UA_ConnectionConfig &config, const std::string &path,
+              const unsigned int mode, const std::string &group)
+{
+    UA_ServerNetworkLayer nl;
+    memset(&nl, 0, sizeof(nl));
+    nl.clear = listenerClear;
+    nl.localConnectionConfig = config;
+    nl.start = listenerStart;
+    nl.listen = listenerListen;
+    nl.stop = listenerStop;
+
+    Listener *listener = new Listener();
+    listener->logger = nullptr;
+    listener->path = path;
+    listener->mode = mode;
+    listener->group = group;
+    listener->socket = -1;
+    listener->recvBufferSize = config.recvBufferSize ? config.recvBufferSize : 16384;
+    nl.handle = listener;
+    return nl;
+}
+
+} // namespace DevOpcua
+
+#endif // HAS_UNIX_TRANSPORT
@@ -0,0 +1,64 @@
+/*************************************************************************\
+* Copyright (c) 2026 ITER Organization.
+* This module is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Author: Dirk Zimoch <dirk.zimoch@psi.ch>
+ */
+
+#ifndef DEVOPCUA_UNIXLISTENER_H
+#define DEVOPCUA_UNIXLISTENER_H
+
+#include <string>
+
+#include <open62541/server.h>
+
+#include "UnixTransport.h"
+
+#ifdef HAS_UNIX_TRANSPORT
+
+#include <open62541/plugin/network.h>
+
+namespace DevOpcua {
+
+/**
+ * @brief Check if a Unix-domain socket can safely be created at a path.
+ *
+ * Refuses directories that are writable by all users (another user could
+ * replace the socket) and existing files that are not sockets or are sockets
+ * that a process is still listening on. Stale sockets (left by a crashed
+ * proxy) are removed.
+ *
+ * @param path  path of the socket
+ * @param[out] error  reason if the path can not be used
+ *
+ * @return  true if the socket can be created
+ */
+bool prepareSocketPath(const std::string &path, std::string &error);
+
+/**
+ * @brief Server network layer on a Unix-domain socket.
+ *
+ * The server side of the opc.unix:// transport (see UnixTransport.h):
+ * accepts OPC UA binary connections on a Unix-domain stream socket.
+ * The socket is created with the given permissions (and group), so that
+ * only the users allowed by them can connect. It is not created if
+ * prepareSocketPath() fails for the path.
+ *
+ * @param config  connection configuration of the server
+ * @param path  path of the socket
+ * @param mode  permissions of the socket file (e.g. 0660)
+ * @param group  group of the socket file (empty = group of the process)
+ *
+ * @return  network layer for UA_ServerConfig::networkLayers
+ */
+UA_ServerNetworkLayer unixListener(const UA_ConnectionConfig &config, const std::string &path,
+                                   const unsigned int mode, const std::string &group);
+
+} // namespace DevOpcua
+
+#endif // HAS_UNIX_TRANSPORT
+
+#endif // DEVOPCUA_UNIXLISTENER_H
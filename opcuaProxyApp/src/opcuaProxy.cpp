@@ -0,0 +1,156 @@
+/*************************************************************************\
+* Copyright (c) 2026 ITER Organization.
+* This module is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Author: Dirk Zimoch <dirk.zimoch@psi.ch>
+ */
+
+/*
+ * Local multiplexing proxy: one upstream session shared by the IOCs of a host
+ * (see ProxyServer.h and the open62541 README)
+ */
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <csignal>
+
+#include <unistd.h>
+
+#include "ProxyServer.h"
+
+namespace {
+
+using namespace DevOpcua;
+
+volatile bool running = true;
+
+const char *defaultListen = "opc.unix:///run/opcua/opcuaProxy.sock";
+
+void
+stopHandler (int)
+{
+    running = false;
+}
+
+void
+usage (const char *name)
+{
+    std::cerr << "Usage: " << name << " [options] <upstream URL>\n"
+              << "  -l <endpoint>  local endpoint: opc.unix://<path> or TCP port on localhost\n"
+              << "                 [default " << defaultListen << "]\n"
+              << "  -m <mode>      permissions of the Unix socket [default 0660]\n"
+              << "  -g <group>     group of the Unix socket [default: group of the process]\n"
+              << "  -U <file>      upstream credentials of the proxy (user=/pass= lines) [default anonymous]\n"
+              << "  -w <s>         local writes wait for the upstream result [default 2]\n"
+              << "  -c <file>      server certificate (TCP endpoint, DER)\n"
+              << "  -k <file>      server private key (TCP endpoint, DER)\n"
+              << "  -a <file>      trusted client certificate (TCP endpoint, may be repeated)\n"
+              << "  -u <file>      local users (TCP endpoint, <user>:<password> lines)\n"
+              << "  -n <file>      serve the variables listed in file (one node id per line)\n"
+              << "  -b <node id>   serve all variables below node (may be repeated)\n"
+              << "  -i <ms>        upstream publishing interval [default 100]\n"
+              << "  -s <ms>        upstream sampling interval [default -1 = publishing interval]\n"
+              << "  -t <s>         delete upstream monitored items unused for [default 60, 0 = never]\n"
+              << "  -r <s>         print statistics every [default 0 = off]\n"
+              << "  -d <level>     debug level [default 0]\n"
+              << "Node ids use the syntax of the device support links, e.g. ns=2;s=Tank1.Level\n"
+              << "A TCP endpoint requires encryption and a user from the users file.\n";
+}
+
+bool
+readNodeList (const std::string &file, std::vector<std::string> &ids)
+{
+    std::ifstream in(file);
+    if (!in) {
+        std::cerr << "opcuaProxy: can not read node list " << file << std::endl;
+        return false;
+    }
+    std::string line;
+    while (std::getline(in, line)) {
+        const std::string::size_type first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == '#')
+            continue;
+        const std::string::size_type last = line.find_last_not_of(" \t\r");
+        ids.push_back(line.substr(first, last - first + 1));
+    }
+    return true;
+}
+
+} // namespace
+
+int
+main (int argc, char *argv[])
+{
+    ProxyServer::Config config;
+    config.listen = defaultListen;
+    std::vector<std::string> variables;
+    std::vector<std::string> roots;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "l:m:g:U:w:c:k:a:u:n:b:i:s:t:r:d:h")) != -1) {
+        switch (opt) {
+        case 'l': config.listen = optarg; break;
+        case 'm': config.socketMode = static_cast<unsigned int>(std::strtoul(optarg, nullptr, 8)); break;
+        case 'g': config.socketGroup = optarg; break;
+        case 'U': config.identityFile = optarg; break;
+        case 'w': config.writeTimeout = std::strtod(optarg, nullptr); break;
+        case 'c': config.certificate = optarg; break;
+        case 'k': config.privateKey = optarg; break;
+        case 'a': config.trustList.push_back(optarg); break;
+        case 'u': config.userFile = optarg; break;
+        case 'n': if (!readNodeList(optarg, variables)) return 1; break;
+        case 'b': roots.push_back(optarg); break;
+        case 'i': config.publishingInterval = std::strtod(optarg, nullptr); break;
+        case 's': config.samplingInterval = std::strtod(optarg, nullptr); break;
+        case 't': config.idleTime = std::strtod(optarg, nullptr); break;
+        case 'r': config.reportInterval = std::strtod(optarg, nullptr); break;
+        case 'd': config.debug = std::atoi(optarg); break;
+        default: usage(argv[0]); return opt == 'h' ? 0 : 1;
+        }
+    }
+    if (optind != argc - 1 || (variables.empty() && roots.empty())) {
+        usage(argv[0]);
+        return 1;
+    }
+    config.upstreamUrl = argv[optind];
+
+    ProxyServer proxy(config);
+    if (!proxy.setup())
+        return 1;
+
+    size_t added = 0;
+    for (auto &it : variables) {
+        UA_NodeId id;
+        if (!parseNodeId(it, id)) {
+            std::cerr << "opcuaProxy: invalid node id " << it << std::endl;
+            continue;
+        }
+        if (proxy.addVariable(id))
+            added++;
+        UA_NodeId_clear(&id);
+    }
+    for (auto &it : roots) {
+        UA_NodeId id;
+        if (!parseNodeId(it, id)) {
+            std::cerr << "opcuaProxy: invalid node id " << it << std::endl;
+            continue;
+        }
+        added += proxy.addVariablesBelow(id);
+        UA_NodeId_clear(&id);
+    }
+    if (!added) {
+        std::cerr << "opcuaProxy: no variables to serve" << std::endl;
+        return 1;
+    }
+
+    signal(SIGINT, stopHandler);
+    signal(SIGTERM, stopHandler);
+    signal(SIGPIPE, SIG_IGN);
+    return proxy.run(running);
+}
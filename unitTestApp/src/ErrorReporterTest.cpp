@@ -0,0 +1,87 @@
+/*************************************************************************\
+* Copyright (c) 2026 ITER Organization.
+* This module is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Author: Dirk Zimoch <dirk.zimoch@psi.ch>
+ */
+
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ErrorReporter.h"
+
+namespace {
+
+using namespace DevOpcua;
+
+class ErrorReporterTest : public ::testing::Test {
+protected:
+    unsigned int allowed(const ErrorClass cls, const void *source, const double now, const unsigned int n) {
+        unsigned int count = 0;
+        for (unsigned int i = 0; i < n; i++)
+            if (reporter.allow(cls, source, "REC", now, 10.0, 3))
+                count++;
+        return count;
+    }
+
+    ErrorReporter reporter;
+    int rec1, rec2;
+    std::vector<std::string> lines;
+};
+
+TEST_F(ErrorReporterTest, allow_Burst_RestSuppressed)
+{
+    EXPECT_EQ(allowed(ErrorClass::incomingOutOfBounds, &rec1, 100.0, 1000), 3u) << "wrong number of messages allowed";
+    EXPECT_EQ(reporter.suppressed(), 997u) << "wrong number of messages suppressed";
+}
+
+TEST_F(ErrorReporterTest, allow_ClassesAndSources_CountedSeparately)
+{
+    EXPECT_EQ(allowed(ErrorClass::incomingOutOfBounds, &rec1, 100.0, 10), 3u) << "first source/class";
+    EXPECT_EQ(allowed(ErrorClass::incomingType, &rec1, 100.0, 10), 3u) << "other class limited by first";
+    EXPECT_EQ(allowed(ErrorClass::incomingOutOfBounds, &rec2, 100.0, 10), 3u) << "other source limited by first";
+    EXPECT_EQ(reporter.size(), 3u) << "wrong number of tracked class/source pairs";
+}
+
+TEST_F(ErrorReporterTest, allow_NextWindow_AllowedAgain)
+{
+    EXPECT_EQ(allowed(ErrorClass::readService, &rec1, 100.0, 10), 3u) << "first window";
+    EXPECT_EQ(allowed(ErrorClass::readService, &rec1, 105.0, 10), 0u) << "allowed within the same window";
+    EXPECT_EQ(allowed(ErrorClass::readService, &rec1, 110.0, 10), 3u) << "not allowed in the next window";
+}
+
+TEST_F(ErrorReporterTest, summarize_Suppressed_OneLineAndReset)
+{
+    allowed(ErrorClass::incomingQueueEmpty, &rec1, 100.0, 50);
+    allowed(ErrorClass::incomingQueueEmpty, &rec2, 100.0, 2);
+    EXPECT_EQ(reporter.summarize(110.0, 10.0, lines), 47u) << "wrong number of suppressed messages";
+    ASSERT_EQ(lines.size(), 1u) << "wrong number of summary lines";
+    EXPECT_EQ(lines[0], "REC : 47 more 'incoming data queue empty' messages suppressed") << "wrong summary";
+    lines.clear();
+    EXPECT_EQ(reporter.summarize(115.0, 10.0, lines), 0u) << "counts not reset by summary";
+    EXPECT_TRUE(lines.empty()) << "summary without suppressed messages";
+}
+
+TEST_F(ErrorReporterTest, summarize_QuietSources_Forgotten)
+{
+    allowed(ErrorClass::writeService, &rec1, 100.0, 1);
+    allowed(ErrorClass::writeService, &rec2, 125.0, 1);
+    reporter.summarize(125.0, 10.0, lines);
+    EXPECT_EQ(reporter.size(), 1u) << "quiet source not forgotten";
+}
+
+TEST_F(ErrorReporterTest, summarize_EncodingErrors_OwnClass)
+{
+    allowed(ErrorClass::incomingEncoding, &rec1, 100.0, 5);
+    allowed(ErrorClass::incomingOutOfBounds, &rec1, 100.0, 5);
+    EXPECT_EQ(reporter.summarize(110.0, 10.0, lines), 4u) << "wrong number of suppressed messages";
+    ASSERT_EQ(lines.size(), 2u) << "encoding errors not counted separately";
+    EXPECT_NE(std::string(errorClassString(ErrorClass::incomingEncoding)),
+              errorClassString(ErrorClass::incomingOutOfBounds)) << "encoding errors share the out-of-bounds name";
+}
+
+} // namespace
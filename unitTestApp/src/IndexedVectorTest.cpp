@@ -0,0 +1,139 @@
+/*************************************************************************\
+* Copyright (c) 2026 ITER Organization.
+* This module is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Author: Dirk Zimoch <dirk.zimoch@psi.ch>
+ */
+
+#include <algorithm>
+#include <gtest/gtest.h>
+
+#include "IndexedVector.h"
+
+namespace {
+
+using namespace DevOpcua;
+using namespace testing;
+
+class TestObject
+{
+public:
+    TestObject(unsigned int val)
+        : tag(val)
+    {}
+    unsigned int tag;
+};
+
+// Fixture for testing IndexedVector
+class IndexedVectorTest : public ::testing::Test
+{
+public:
+    IndexedVectorTest()
+        : t0(0)
+        , t1(1)
+        , t2(2)
+        , t3(3)
+    {}
+
+protected:
+    void fill() {
+        v0.insert(&t0);
+        v0.insert(&t1);
+        v0.insert(&t2);
+        v0.insert(&t3);
+    }
+
+    // Check that all elements are reachable through the index
+    void checkConsistent() {
+        for (size_t i = 0; i < v0.size(); i++)
+            EXPECT_TRUE(v0.contains(v0[i])) << "element " << i << " not in index";
+    }
+
+    IndexedVector<TestObject> v0;
+    TestObject t0, t1, t2, t3;
+};
+
+TEST_F(IndexedVectorTest, insert_fill_ReturnCorrectSizes)
+{
+    EXPECT_EQ(v0.size(), 0u) << "empty vector has size != 0";
+    EXPECT_TRUE(v0.empty()) << "empty vector is not empty()";
+    v0.insert(&t0);
+    EXPECT_EQ(v0.size(), 1u) << "vector with 1 obj has size != 1";
+    v0.insert(&t1);
+    EXPECT_EQ(v0.size(), 2u) << "vector with 2 obj has size != 2";
+    EXPECT_FALSE(v0.empty()) << "vector with 2 obj is empty()";
+}
+
+TEST_F(IndexedVectorTest, insert_duplicate_IsRejected)
+{
+    EXPECT_TRUE(v0.insert(&t0)) << "first insertion returned false";
+    EXPECT_FALSE(v0.insert(&t0)) << "second insertion returned true";
+    EXPECT_EQ(v0.size(), 1u) << "duplicate was added";
+}
+
+TEST_F(IndexedVectorTest, iterators_full_GetInsertionOrder)
+{
+    fill();
+    auto i = v0.begin();
+    EXPECT_EQ(*i++, &t0) << "first object is not t0";
+    EXPECT_EQ(*i++, &t1) << "second object is not t1";
+    EXPECT_EQ(*i++, &t2) << "third object is not t2";
+    EXPECT_EQ(*i++, &t3) << "fourth object is not t3";
+    EXPECT_EQ(i, v0.end()) << "invalid end() marker";
+}
+
+TEST_F(IndexedVectorTest, contains_mixed_returnValuesCorrect)
+{
+    EXPECT_FALSE(v0.contains(&t0)) << "contains() is true on empty vector";
+    v0.insert(&t0);
+    v0.insert(&t2);
+    EXPECT_TRUE(v0.contains(&t0)) << "contains() is false for t0";
+    EXPECT_FALSE(v0.contains(&t1)) << "contains() is true for t1";
+    EXPECT_TRUE(v0.contains(&t2)) << "contains() is false for t2";
+}
+
+TEST_F(IndexedVectorTest, erase_middle_LastElementMovesIn)
+{
+    fill();
+    EXPECT_TRUE(v0.erase(&t1)) << "erasing t1 returned false";
+    EXPECT_EQ(v0.size(), 3u) << "wrong size after erase";
+    EXPECT_FALSE(v0.contains(&t1)) << "t1 still contained after erase";
+    EXPECT_EQ(v0[1], &t3) << "last element not moved into freed slot";
+    checkConsistent();
+}
+
+TEST_F(IndexedVectorTest, erase_firstAndLast_IndexConsistent)
+{
+    fill();
+    EXPECT_TRUE(v0.erase(&t3)) << "erasing last element returned false";
+    EXPECT_TRUE(v0.erase(&t0)) << "erasing first element returned false";
+    EXPECT_EQ(v0.size(), 2u) << "wrong size after erase";
+    checkConsistent();
+    EXPECT_TRUE(v0.insert(&t0)) << "re-insertion of t0 returned false";
+    EXPECT_EQ(v0[2], &t0) << "re-inserted element not at the end";
+    checkConsistent();
+}
+
+TEST_F(IndexedVectorTest, erase_notContained_ReturnsFalse)
+{
+    v0.insert(&t0);
+    EXPECT_FALSE(v0.erase(&t1)) << "erasing non-contained t1 returned true";
+    EXPECT_TRUE(v0.erase(&t0)) << "erasing t0 returned false";
+    EXPECT_FALSE(v0.erase(&t0)) << "erasing t0 twice returned true";
+    EXPECT_TRUE(v0.empty()) << "vector not empty after erasing all";
+}
+
+TEST_F(IndexedVectorTest, clear_full_IsEmpty)
+{
+    fill();
+    std::vector<TestObject *> snapshot(v0.vector());
+    v0.clear();
+    EXPECT_TRUE(v0.empty()) << "vector not empty after clear()";
+    EXPECT_FALSE(v0.contains(&t2)) << "index not cleared";
+    EXPECT_EQ(snapshot.size(), 4u) << "snapshot affected by clear()";
+}
+
+} // namespace
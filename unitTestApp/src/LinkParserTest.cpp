@@ -9,11 +9,13 @@
  */
 
 #include <list>
+#include <stdexcept>
 #include <gtest/gtest.h>
 
 #include <epicsTime.h>
 
 #include "linkParser.h"
+#include "DataElement.h"
 
 namespace {
 
@@ -172,4 +174,148 @@ TEST(LinkParserTest, splitString_endsWithTwoDelimiters) {
     EXPECT_EQ(*it++, "") << "path[2] not empty after splitting '" << s << "'";
 }
 
+/* void parseLinkOptions(linkInfo &info, std::string options,
+ *                       const char *recordName = "", const int debug = 0);
+ * void checkLinkOptions(const linkInfo &info);
+ *
+ * @brief Parse the options of an INP/OUT link, check that they are consistent.
+ *
+ * The link type in info decides which options are allowed.
+ */
+
+// Link of a record to a session (no subscription)
+linkInfo
+sessionLink (const bool output, const bool itemRecord = false)
+{
+    linkInfo info;
+    info.session = "session";
+    info.isOutput = output;
+    info.isItemRecord = itemRecord;
+    info.monitor = false;
+    return info;
+}
+
+TEST(LinkParserTest, snapshot_inputRecord) {
+    linkInfo info = sessionLink(false);
+    parseLinkOptions(info, "ns=2;s=Demo.Var snapshot=group1");
+    EXPECT_EQ(info.namespaceIndex, 2u) << "wrong namespace index";
+    EXPECT_EQ(info.identifierString, "Demo.Var") << "wrong identifier";
+    EXPECT_EQ(info.snapshotGroup, "group1") << "snapshot group not set";
+    EXPECT_NO_THROW(checkLinkOptions(info)) << "snapshot rejected for input record";
+}
+
+TEST(LinkParserTest, snapshot_itemRecord) {
+    linkInfo info = sessionLink(false, true);
+    parseLinkOptions(info, "ns=2;i=1001;snapshot=group1");
+    EXPECT_EQ(info.snapshotGroup, "group1") << "snapshot group not set";
+    EXPECT_NO_THROW(checkLinkOptions(info)) << "snapshot rejected for opcuaItem record";
+}
+
+TEST(LinkParserTest, snapshot_default) {
+    linkInfo info = sessionLink(false);
+    parseLinkOptions(info, "ns=2;s=Demo.Var");
+    EXPECT_TRUE(info.snapshotGroup.empty()) << "snapshot group set without option";
+}
+
+TEST(LinkParserTest, snapshot_outputRecordRejected) {
+    linkInfo info = sessionLink(true);
+    parseLinkOptions(info, "ns=2;s=Demo.Var;snapshot=group1");
+    EXPECT_THROW(checkLinkOptions(info), std::runtime_error) << "snapshot accepted for output record";
+}
+
+TEST(LinkParserTest, snapshot_pubsubRejected) {
+    linkInfo info = sessionLink(false);
+    info.session = "";
+    info.pubsubReader = "reader";
+    parseLinkOptions(info, "field=Temperature;snapshot=group1");
+    EXPECT_THROW(checkLinkOptions(info), std::runtime_error) << "snapshot accepted for PubSub reader link";
+}
+
+TEST(LinkParserTest, snapshot_elementLinkRejected) {
+    linkInfo info = sessionLink(false);
+    info.linkedToItem = false;
+    EXPECT_THROW(parseLinkOptions(info, "element=x;snapshot=group1"), std::runtime_error)
+        << "snapshot accepted for link to an opcuaItem record";
+}
+
+TEST(LinkParserTest, json_stringRecord) {
+    linkInfo info = sessionLink(false);
+    info.isStringRecord = true;
+    parseLinkOptions(info, "ns=2;s=Demo.Struct json=y");
+    EXPECT_TRUE(info.json) << "json option not set";
+    if (DataElement::jsonSupported)
+        EXPECT_NO_THROW(checkLinkOptions(info)) << "json rejected for string input record";
+    else
+        EXPECT_THROW(checkLinkOptions(info), std::runtime_error) << "json accepted without JSON encoding";
+}
+
+TEST(LinkParserTest, json_numericRecordRejected) {
+    linkInfo info = sessionLink(false);
+    parseLinkOptions(info, "ns=2;s=Demo.Struct json=y");
+    EXPECT_THROW(checkLinkOptions(info), std::runtime_error) << "json accepted for numeric input record";
+}
+
+TEST(LinkParserTest, json_outputRecordRejected) {
+    linkInfo info = sessionLink(true);
+    info.isStringRecord = true;
+    parseLinkOptions(info, "ns=2;s=Demo.Struct json=y");
+    EXPECT_THROW(checkLinkOptions(info), std::runtime_error) << "json accepted for output record";
+}
+
+TEST(LinkParserTest, json_disabled) {
+    linkInfo info = sessionLink(false);
+    parseLinkOptions(info, "ns=2;s=Demo.Struct json=n");
+    EXPECT_FALSE(info.json) << "json option set by json=n";
+    EXPECT_NO_THROW(checkLinkOptions(info)) << "json=n rejected for numeric input record";
+}
+
+TEST(LinkParserTest, writeGroup_outputRecord) {
+    linkInfo info = sessionLink(true);
+    parseLinkOptions(info, "ns=2;s=Demo.Var group=wgOptions trigger=y");
+    EXPECT_EQ(info.writeGroup, "wgOptions") << "write group not set";
+    EXPECT_TRUE(info.groupTrigger) << "group trigger not set";
+    EXPECT_NO_THROW(checkLinkOptions(info)) << "write group rejected for output record";
+}
+
+TEST(LinkParserTest, writeGroup_inputRecordRejected) {
+    linkInfo info = sessionLink(false);
+    parseLinkOptions(info, "ns=2;s=Demo.Var group=wgOptions");
+    EXPECT_THROW(checkLinkOptions(info), std::runtime_error) << "write group accepted for input record";
+}
+
+TEST(LinkParserTest, writeGroup_triggerWithoutGroupRejected) {
+    linkInfo info = sessionLink(true);
+    parseLinkOptions(info, "ns=2;s=Demo.Var trigger=y");
+    EXPECT_THROW(checkLinkOptions(info), std::runtime_error) << "trigger accepted without group";
+}
+
+TEST(LinkParserTest, burstTime_doubleArray) {
+    linkInfo info = sessionLink(false);
+    info.isDoubleArray = true;
+    parseLinkOptions(info, "ns=2;s=Demo.Var burst=10 bursttime=y");
+    EXPECT_EQ(info.burst, 10u) << "burst size not set";
+    EXPECT_TRUE(info.burstTime) << "bursttime not set";
+    EXPECT_NO_THROW(checkLinkOptions(info)) << "bursttime rejected for DOUBLE array";
+}
+
+TEST(LinkParserTest, burstTime_otherArrayRejected) {
+    linkInfo info = sessionLink(false);
+    parseLinkOptions(info, "ns=2;s=Demo.Var burst=10 bursttime=y");
+    EXPECT_THROW(checkLinkOptions(info), std::runtime_error) << "bursttime accepted for non-DOUBLE array";
+}
+
+TEST(LinkParserTest, burstTime_withoutBurstRejected) {
+    linkInfo info = sessionLink(false);
+    info.isDoubleArray = true;
+    parseLinkOptions(info, "ns=2;s=Demo.Var bursttime=y");
+    EXPECT_THROW(checkLinkOptions(info), std::runtime_error) << "bursttime accepted without burst";
+}
+
+TEST(LinkParserTest, burst_otherArray) {
+    linkInfo info = sessionLink(false);
+    parseLinkOptions(info, "ns=2;s=Demo.Var burst=10");
+    EXPECT_FALSE(info.burstTime) << "bursttime set without option";
+    EXPECT_NO_THROW(checkLinkOptions(info)) << "burst (values) rejected for non-DOUBLE array";
+}
+
 } // namespace
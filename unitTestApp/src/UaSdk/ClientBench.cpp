@@ -0,0 +1,22 @@
+/*************************************************************************\
+* Copyright (c) 2026 ITER Organization.
+* This module is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Author: Dirk Zimoch <dirk.zimoch@psi.ch>
+ */
+
+#include "bench.h"
+
+namespace DevOpcua {
+namespace Bench {
+
+// No client specific benchmarks for the UA SDK client
+void
+clientBenchmarks (const Options &)
+{}
+
+} // namespace Bench
+} // namespace DevOpcua
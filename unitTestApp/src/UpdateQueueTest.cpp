@@ -9,9 +9,13 @@
  */
 
 #include <memory>
+#include <thread>
+#include <chrono>
+#include <iostream>
 #include <gtest/gtest.h>
 
 #include <epicsTime.h>
+#include <epicsEvent.h>
 
 #include "UpdateQueue.h"
 #include "Update.h"
@@ -215,4 +219,136 @@ TEST_F(UpdateQueueTest, pushUpdate_EmptyQueue_wasFirstIsCorrect) {
     EXPECT_EQ(wasFirst, false) << "Second push does not set wasFirst = false";
 }
 
+TEST_F(UpdateQueueTest, discarded_FullQueues_CountsDiscardedUpdates) {
+    epicsTime ts0;
+    ts0.getCurrent();
+    EXPECT_EQ(q0.discarded(), 0ul) << "Empty queue reports discarded updates";
+    EXPECT_EQ(q1.discarded(), 0ul) << "Full queue (oldest) reports discarded updates before overflow";
+    for (int i = 0; i < 2; i++) {
+        q1.pushUpdate(std::shared_ptr<TestUpdate>(new TestUpdate(ts0, ProcessReason::incomingData, 10 + i, 110)));
+        q2.pushUpdate(std::shared_ptr<TestUpdate>(new TestUpdate(ts0, ProcessReason::incomingData, 10 + i, 110)));
+    }
+    EXPECT_EQ(q1.discarded(), 2ul) << "Discard oldest: discarded counter (" << q1.discarded() << ") not 2";
+    EXPECT_EQ(q2.discarded(), 2ul) << "Discard newest: discarded counter (" << q2.discarded() << ") not 2";
+    while (!q1.empty())
+        q1.popUpdate();
+    EXPECT_EQ(q1.discarded(), 2ul) << "Discarded counter changed by consuming the queue";
+}
+
+TEST_F(UpdateQueueTest, highWaterMark_PushPop_KeepsMaximum) {
+    epicsTime ts0;
+    ts0.getCurrent();
+    EXPECT_EQ(q0.highWaterMark(), 0lu) << "Empty queue reports a high-water mark";
+    for (int i = 0; i < 3; i++)
+        q0.pushUpdate(std::shared_ptr<TestUpdate>(new TestUpdate(ts0, ProcessReason::incomingData, i, 100)));
+    q0.popUpdate();
+    q0.popUpdate();
+    q0.pushUpdate(std::shared_ptr<TestUpdate>(new TestUpdate(ts0, ProcessReason::incomingData, 3, 100)));
+    EXPECT_EQ(q0.highWaterMark(), 3lu) << "High-water mark (" << q0.highWaterMark() << ") not 3";
+    q0.resetHighWaterMark();
+    EXPECT_EQ(q0.highWaterMark(), 2lu) << "Reset high-water mark (" << q0.highWaterMark() << ") not current size 2";
+    q1.pushUpdate(std::shared_ptr<TestUpdate>(new TestUpdate(ts0, ProcessReason::incomingData, 10, 110)));
+    EXPECT_EQ(q1.highWaterMark(), 3lu) << "Overflowing queue high-water mark (" << q1.highWaterMark() << ") not capacity 3";
+}
+
+// Writing RSTAT of an opcuaItem record resets the high-water mark of its queues
+TEST_F(UpdateQueueTest, resetHighWaterMark_AfterReset_TracksNewMaximum) {
+    epicsTime ts0;
+    ts0.getCurrent();
+    for (int i = 0; i < 4; i++)
+        q0.pushUpdate(std::shared_ptr<TestUpdate>(new TestUpdate(ts0, ProcessReason::incomingData, i, 100)));
+    for (int i = 0; i < 4; i++)
+        q0.popUpdate();
+    q0.resetHighWaterMark();
+    EXPECT_EQ(q0.highWaterMark(), 0lu) << "Reset high-water mark of empty queue (" << q0.highWaterMark() << ") not 0";
+    q0.pushUpdate(std::shared_ptr<TestUpdate>(new TestUpdate(ts0, ProcessReason::incomingData, 4, 100)));
+    q0.pushUpdate(std::shared_ptr<TestUpdate>(new TestUpdate(ts0, ProcessReason::incomingData, 5, 100)));
+    q0.popUpdate();
+    EXPECT_EQ(q0.highWaterMark(), 2lu) << "High-water mark after reset (" << q0.highWaterMark() << ") not 2";
+}
+
+// Multithreaded tests: one producer thread, the test thread consumes
+// like record processing does (started by wasFirst, continued while nextReason != none)
+
+static const int stressUpdates = 200000;
+
+static void
+produce(UpdateQueue<TestUpdate> *q, epicsEvent *ready, const int n)
+{
+    epicsTime ts;
+    ts.getCurrent();
+    for (int i = 0; i < n; i++) {
+        bool wasFirst = false;
+        q->pushUpdate(std::shared_ptr<TestUpdate>(new TestUpdate(ts, ProcessReason::incomingData, i, 0)), &wasFirst);
+        if (wasFirst)
+            ready->signal();
+    }
+}
+
+static void
+consumeAll(UpdateQueue<TestUpdate> &q, epicsEvent &ready, const int n, const bool slow)
+{
+    unsigned long received = 0;
+    unsigned long popped = 0;
+    int last = -1;
+    while (last < n - 1) {
+        ready.wait();
+        ProcessReason nextReason;
+        do {
+            std::shared_ptr<TestUpdate> u = q.popUpdate(&nextReason);
+            ASSERT_TRUE(bool(u)) << "Processing requested for empty queue (after update " << last << ")";
+            ASSERT_GT(u->getData(), last) << "Update " << u->getData() << " out of order (after " << last << ")";
+            last = u->getData();
+            received += u->getOverrides() + 1;
+            popped++;
+            EXPECT_LE(q.size(), q.capacity()) << "Queue size exceeds capacity";
+            if (slow && last % 64 == 0)
+                std::this_thread::yield();
+        } while (nextReason != ProcessReason::none);
+    }
+    EXPECT_EQ(last, n - 1) << "Latest update was not delivered";
+    EXPECT_EQ(received, static_cast<unsigned long>(n)) << "Updates plus overrides (" << received
+                                                       << ") differ from pushed updates (" << n << ")";
+    EXPECT_EQ(q.discarded(), n - popped) << "Discarded counter (" << q.discarded()
+                                         << ") differs from updates not delivered (" << n - popped << ")";
+    EXPECT_TRUE(q.empty()) << "Queue not empty after consuming all updates";
+}
+
+TEST(UpdateQueueThreadTest, stress_DiscardOldest_NoLossOfCountOrOrder) {
+    UpdateQueue<TestUpdate> q(3ul);
+    epicsEvent ready;
+    std::thread producer(produce, &q, &ready, stressUpdates);
+    consumeAll(q, ready, stressUpdates, true);
+    producer.join();
+}
+
+TEST(UpdateQueueThreadTest, stress_DiscardNewest_NoLossOfCountOrOrder) {
+    UpdateQueue<TestUpdate> q(3ul, false);
+    epicsEvent ready;
+    std::thread producer(produce, &q, &ready, stressUpdates);
+    consumeAll(q, ready, stressUpdates, true);
+    producer.join();
+}
+
+TEST(UpdateQueueThreadTest, stress_SizeOne_NoLossOfCountOrOrder) {
+    UpdateQueue<TestUpdate> q(1ul);
+    epicsEvent ready;
+    std::thread producer(produce, &q, &ready, stressUpdates);
+    consumeAll(q, ready, stressUpdates, false);
+    producer.join();
+}
+
+TEST(UpdateQueueThreadTest, benchmark_PushPop_Throughput) {
+    const int n = 1000000;
+    UpdateQueue<TestUpdate> q(1000ul);
+    epicsEvent ready;
+    auto start = std::chrono::steady_clock::now();
+    std::thread producer(produce, &q, &ready, n);
+    consumeAll(q, ready, n, false);
+    producer.join();
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "[ BENCH    ] UpdateQueue SPSC push/pop: " << n << " updates, "
+              << ns / n << " ns/update" << std::endl;
+}
+
 } // namespace
@@ -0,0 +1,83 @@
+/*************************************************************************\
+* Copyright (c) 2026 ITER Organization.
+* This module is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Author: Dirk Zimoch <dirk.zimoch@psi.ch>
+ */
+
+#include <thread>
+#include <gtest/gtest.h>
+
+#include <epicsTime.h>
+
+#include "UpdateRate.h"
+
+namespace {
+
+using namespace DevOpcua;
+
+class UpdateRateTest : public ::testing::Test {
+protected:
+    UpdateRateTest()
+        : t0(epicsTime::getCurrent())
+        , rate(t0)
+    {}
+
+    // Count n updates, evenly spread over [from, from + duration)
+    void count(const double from, const double duration, const unsigned int n) {
+        for (unsigned int i = 0; i < n; i++)
+            rate.count(t0 + (from + duration * i / n));
+    }
+
+    epicsTime t0;
+    UpdateRate rate;
+};
+
+TEST_F(UpdateRateTest, rate_NoUpdates_IsZero) {
+    EXPECT_EQ(rate.rate(t0), 0.0) << "Rate without updates not 0";
+    EXPECT_EQ(rate.rate(t0 + 5.0), 0.0) << "Rate without updates (after 5s) not 0";
+}
+
+TEST_F(UpdateRateTest, rate_OpenWindow_KeepsLastRate) {
+    count(0.0, 0.9, 9);
+    EXPECT_EQ(rate.rate(t0 + 0.95), 0.0) << "Rate set before the first window closed";
+    rate.count(t0 + 1.0);
+    EXPECT_DOUBLE_EQ(rate.rate(t0 + 1.0), 10.0) << "Rate of the first window (10 updates in 1s) wrong";
+    count(1.1, 0.5, 2);
+    EXPECT_DOUBLE_EQ(rate.rate(t0 + 1.8), 10.0) << "Rate changed while the window is open";
+}
+
+TEST_F(UpdateRateTest, rate_WindowLongerThanOneSecond_AveragesOverWindow) {
+    rate.count(t0 + 0.5);
+    rate.count(t0 + 1.5);
+    EXPECT_DOUBLE_EQ(rate.rate(t0 + 1.5), 2.0 / 1.5) << "Rate of a 1.5s window with 2 updates wrong";
+}
+
+TEST_F(UpdateRateTest, rate_UpdatesStopped_RateDrops) {
+    count(0.0, 1.0, 10);
+    rate.count(t0 + 1.0);
+    EXPECT_DOUBLE_EQ(rate.rate(t0 + 1.5), 11.0) << "Rate of the first window wrong";
+    EXPECT_DOUBLE_EQ(rate.rate(t0 + 3.0), 0.0) << "Rate not dropped after 2s without updates";
+    rate.count(t0 + 3.0);   // closes the window
+    EXPECT_DOUBLE_EQ(rate.rate(t0 + 3.0), 0.5) << "Rate of a 2s window with one update wrong";
+    rate.count(t0 + 3.5);
+    EXPECT_DOUBLE_EQ(rate.rate(t0 + 7.0), 0.25) << "Slowed-down rate (1 update in 4s) wrong";
+}
+
+// Counting and reading from different threads (as delivering data and record processing do)
+TEST_F(UpdateRateTest, rate_ConcurrentCountAndRead_StaysInRange) {
+    const unsigned int n = 100000;
+    std::thread producer([this]() { count(0.0, 10.0, n); });
+    for (unsigned int i = 0; i < 1000; i++) {
+        double r = rate.rate(t0 + 0.5);
+        ASSERT_GE(r, 0.0);
+        ASSERT_LE(r, 2.0 * n / 10.0) << "Rate out of range while counting";
+    }
+    producer.join();
+    EXPECT_NEAR(rate.rate(t0 + 9.999), n / 10.0, n / 100.0) << "Rate after concurrent counting wrong";
+}
+
+} // namespace
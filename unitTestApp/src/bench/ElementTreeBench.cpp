@@ -0,0 +1,134 @@
+/*************************************************************************\
+* Copyright (c) 2026 ITER Organization.
+* This module is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Author: Dirk Zimoch <dirk.zimoch@psi.ch>
+ */
+
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ElementTree.h"
+#include "linkParser.h"
+#include "bench.h"
+
+namespace DevOpcua {
+namespace Bench {
+
+namespace {
+
+class BenchItem;
+
+// Node class with the minimal interface required by ElementTree
+// (same structure as the data elements: children held as weak_ptr)
+class BenchNode
+{
+public:
+    BenchNode(const std::string &name, BenchItem *item)
+        : name(name)
+        , item(item)
+    {}
+
+    void addChild(std::weak_ptr<BenchNode> elem) { elements.push_back(elem); }
+
+    void setParent(std::shared_ptr<BenchNode> elem) { parent = elem; }
+
+    std::shared_ptr<BenchNode>
+    findChild(const std::string &name)
+    {
+        for (auto &it : elements)
+            if (auto pit = it.lock())
+                if (pit->name == name)
+                    return pit;
+        return std::shared_ptr<BenchNode>();
+    }
+
+    bool isLeaf() { return name[0] == 'l'; }
+
+    const std::string name;
+
+private:
+    std::vector<std::weak_ptr<BenchNode>> elements;
+    std::shared_ptr<BenchNode> parent;
+    BenchItem *item;
+};
+
+// Element paths of a structure with the given fan-out: "s<i>.m<j>.l<k>"
+std::vector<std::list<std::string>>
+makePaths (const unsigned long leaves, const unsigned int fanout)
+{
+    std::vector<std::list<std::string>> paths;
+    paths.reserve(leaves);
+    for (unsigned long i = 0; i < leaves; i++)
+        paths.push_back({"s" + std::to_string(i / fanout / fanout),
+                         "m" + std::to_string(i / fanout % fanout),
+                         "l" + std::to_string(i % fanout)});
+    return paths;
+}
+
+void
+elementTreeBuild (const Options &opt, const unsigned int fanout)
+{
+    const unsigned long n = opt.count(fanout * fanout * 64);
+    auto paths = makePaths(n, fanout);
+    std::vector<std::shared_ptr<BenchNode>> leaves;
+    leaves.reserve(n);
+    for (unsigned long i = 0; i < n; i++)
+        leaves.push_back(std::make_shared<BenchNode>(paths[i].back(), nullptr));
+    // The leaves keep the tree alive (references to parents)
+    ElementTree<BenchNode, BenchItem> tree(nullptr);
+
+    Result r("ElementTree.addLeaf.f" + std::to_string(fanout), n);
+    r.start();
+    for (unsigned long i = 0; i < n; i++)
+        tree.addLeaf(leaves[i], paths[i]);
+    r.stop();
+    r.print();
+}
+
+void
+elementTreeLookup (const Options &opt, const unsigned int fanout)
+{
+    const unsigned long leaves = fanout * fanout * 16;
+    const unsigned long n = opt.count(1000000);
+    auto paths = makePaths(leaves, fanout);
+    std::vector<std::shared_ptr<BenchNode>> nodes;
+    ElementTree<BenchNode, BenchItem> tree(nullptr);
+    for (unsigned long i = 0; i < leaves; i++) {
+        nodes.push_back(std::make_shared<BenchNode>(paths[i].back(), nullptr));
+        tree.addLeaf(nodes.back(), paths[i]);
+    }
+    unsigned long found = 0;
+
+    Result r("ElementTree.nearestNode.f" + std::to_string(fanout), n);
+    r.start();
+    for (unsigned long i = 0; i < n; i++) {
+        std::list<std::string> path(paths[(i * 7919) % leaves]);
+        if (tree.nearestNode(path) && path.empty())
+            found++;
+    }
+    r.stop();
+    r.extra("found", found);
+    r.print();
+}
+
+} // namespace
+
+void
+elementTreeBenchmarks (const Options &opt)
+{
+    for (unsigned int fanout : {4u, 32u}) {
+        if (opt.selected("ElementTree.addLeaf.f" + std::to_string(fanout)))
+            elementTreeBuild(opt, fanout);
+        if (opt.selected("ElementTree.nearestNode.f" + std::to_string(fanout)))
+            elementTreeLookup(opt, fanout);
+    }
+}
+
+} // namespace Bench
+} // namespace DevOpcua
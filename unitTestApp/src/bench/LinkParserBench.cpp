@@ -0,0 +1,61 @@
+/*************************************************************************\
+* Copyright (c) 2026 ITER Organization.
+* This module is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Author: Dirk Zimoch <dirk.zimoch@psi.ch>
+ */
+
+#include <list>
+#include <string>
+
+#include "linkParser.h"
+#include "bench.h"
+
+namespace DevOpcua {
+namespace Bench {
+
+namespace {
+
+// parseLink() needs a loaded database and configured sessions;
+// the benchmarks cover the string handling that it does for every link
+void
+splitStringRate (const Options &opt, const std::string &name, const std::string &str, const char delim)
+{
+    const unsigned long n = opt.count(1000000);
+    unsigned long tokens = 0;
+
+    Result r("linkParser.splitString." + name, n);
+    r.start();
+    for (unsigned long i = 0; i < n; i++)
+        tokens += splitString(str, delim).size();
+    r.stop();
+    r.extra("tokens", static_cast<double>(tokens) / n);
+    r.extra("bytes", str.length());
+    r.print();
+}
+
+} // namespace
+
+void
+linkParserBenchmarks (const Options &opt)
+{
+    static const struct {
+        const char *name;
+        const char *str;
+        char delim;
+    } cases[] = {
+        {"element", "value", '.'},
+        {"path", "status.motor.axis1.position", '.'},
+        {"escaped", "a\\.b.c\\.d\\.e.f", '.'},
+        {"options", "sec-mode=SignAndEncrypt:sec-policy=Basic256Sha256:batch-nodes=100:debug=1", ':'},
+    };
+    for (auto &c : cases)
+        if (opt.selected(std::string("linkParser.splitString.") + c.name))
+            splitStringRate(opt, c.name, c.str, c.delim);
+}
+
+} // namespace Bench
+} // namespace DevOpcua
@@ -0,0 +1,216 @@
+/*************************************************************************\
+* Copyright (c) 2026 ITER Organization.
+* This module is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Author: Dirk Zimoch <dirk.zimoch@psi.ch>
+ */
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <epicsTime.h>
+#include <epicsEvent.h>
+
+#include "UpdateQueue.h"
+#include "Update.h"
+#include "RequestQueueBatcher.h"
+#include "bench.h"
+
+namespace DevOpcua {
+namespace Bench {
+
+namespace {
+
+// Updates carry the time of their creation (steady clock ticks)
+typedef Update<Clock::rep, unsigned short> BenchUpdate;
+
+inline Clock::rep
+ticks ()
+{
+    return Clock::now().time_since_epoch().count();
+}
+
+inline double
+since (const Clock::rep start)
+{
+    return std::chrono::duration<double>(Clock::duration(ticks() - start)).count();
+}
+
+// Push/pop pairs on an otherwise idle queue, reusing the same update
+void
+updateQueuePushPop (const Options &opt)
+{
+    const unsigned long n = opt.count(2000000);
+    UpdateQueue<BenchUpdate> q(10);
+    auto u = std::make_shared<BenchUpdate>(epicsTime::getCurrent(), ProcessReason::incomingData, 0, 0);
+    bool wasFirst;
+    ProcessReason next;
+
+    Result r("UpdateQueue.pushPop", n);
+    r.start();
+    for (unsigned long i = 0; i < n; i++) {
+        q.pushUpdate(u, &wasFirst);
+        q.popUpdate(&next);
+    }
+    r.stop();
+    r.print();
+}
+
+// Creation and destruction of an update with data (what a data callback does)
+void
+updateCreate (const Options &opt)
+{
+    const unsigned long n = opt.count(1000000);
+    epicsTime now = epicsTime::getCurrent();
+
+    Result r("Update.create", n);
+    r.start();
+    for (unsigned long i = 0; i < n; i++) {
+        auto u = std::make_shared<BenchUpdate>(now, ProcessReason::incomingData, i, 0);
+    }
+    r.stop();
+    r.print();
+}
+
+// One producer (client library thread), one consumer (record processing)
+// throttle = producer waits while the queue is full (throughput, latency)
+// otherwise the producer overruns the consumer (overflow handling)
+void
+updateQueueProducerConsumer (const Options &opt, const std::string &name,
+                             const size_t size, const bool discardOldest, const bool throttle)
+{
+    const unsigned long n = opt.count(500000);
+    UpdateQueue<BenchUpdate> q(size, discardOldest);
+    epicsTime now = epicsTime::getCurrent();
+    unsigned long popped = 0, overrides = 0;
+    std::atomic<bool> done(false);
+
+    Result r(name, n);
+    r.latencies.reserve(n);
+    r.start();
+    std::thread producer([&q, &done, n, now, throttle] () {
+        for (unsigned long i = 0; i < n; i++) {
+            while (throttle && q.size() >= q.capacity())
+                std::this_thread::yield();
+            q.pushUpdate(std::make_shared<BenchUpdate>(now, ProcessReason::incomingData, ticks(), 0));
+        }
+        done = true;
+    });
+    for (;;) {
+        auto u = q.popUpdate();
+        if (u) {
+            r.latency(since(u->getData()));
+            overrides += u->getOverrides();
+            popped++;
+        } else if (done && q.empty()) {
+            break;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    r.stop();
+    r.extra("popped", popped);
+    r.extra("dropped", overrides);
+    r.print();
+}
+
+struct BenchRequest {
+    BenchRequest() : pushed(ticks()) {}
+    Clock::rep pushed;
+};
+
+// Consumer for the batcher benchmark: collects queueing latency and batch sizes
+class BenchConsumer : public RequestConsumer<BenchRequest>
+{
+public:
+    BenchConsumer(Result &result, const unsigned long expected)
+        : result(result)
+        , expected(expected)
+        , processed(0)
+        , batches(0)
+    {}
+
+    virtual void processRequests(std::vector<std::shared_ptr<BenchRequest>> &batch) override
+    {
+        for (auto &it : batch)
+            result.latency(since(it->pushed));
+        processed += batch.size();
+        batches++;
+        if (processed >= expected)
+            finished.signal();
+    }
+
+    Result &result;
+    const unsigned long expected;
+    unsigned long processed;
+    unsigned long batches;
+    epicsEvent finished;
+};
+
+// Producers (record processing threads) pushing into a batcher under contention
+void
+batcherContention (const Options &opt, const unsigned int producers, const unsigned int batchSize)
+{
+    const unsigned long perProducer = opt.count(200000) / producers;
+    const unsigned long n = perProducer * producers;
+
+    Result r("RequestQueueBatcher.push.p" + std::to_string(producers) + ".b" + std::to_string(batchSize),
+             n);
+    r.latencies.reserve(n);
+    BenchConsumer consumer(r, n);
+    RequestQueueBatcher<BenchRequest> b("bench", consumer, batchSize, 0, 0, false);
+    b.startWorker();
+
+    std::vector<std::thread> threads;
+    r.start();
+    for (unsigned int p = 0; p < producers; p++)
+        threads.emplace_back([&b, perProducer, p] () {
+            for (unsigned long i = 0; i < perProducer; i++)
+                b.pushRequest(std::make_shared<BenchRequest>(),
+                              static_cast<menuPriority>((i + p) % menuPriority_NUM_CHOICES));
+        });
+    for (auto &t : threads)
+        t.join();
+    consumer.finished.wait();
+    r.stop();
+    r.extra("batches", consumer.batches);
+    r.extra("avg_batch", static_cast<double>(consumer.processed) / consumer.batches);
+    r.print();
+}
+
+} // namespace
+
+void
+queueBenchmarks (const Options &opt)
+{
+    if (opt.selected("Update.create"))
+        updateCreate(opt);
+    if (opt.selected("UpdateQueue.pushPop"))
+        updateQueuePushPop(opt);
+    for (size_t size : {10u, 1000u}) {
+        std::string name = "UpdateQueue.spsc.q" + std::to_string(size);
+        if (opt.selected(name))
+            updateQueueProducerConsumer(opt, name, size, true, true);
+        for (bool discardOldest : {true, false}) {
+            name = "UpdateQueue.overflow.q" + std::to_string(size)
+                   + (discardOldest ? ".discardOldest" : ".discardNewest");
+            if (opt.selected(name))
+                updateQueueProducerConsumer(opt, name, size, discardOldest, false);
+        }
+    }
+    for (unsigned int producers : {1u, 4u}) {
+        for (unsigned int batchSize : {0u, 50u}) {
+            if (opt.selected("RequestQueueBatcher.push.p" + std::to_string(producers)
+                             + ".b" + std::to_string(batchSize)))
+                batcherContention(opt, producers, batchSize);
+        }
+    }
+}
+
+} // namespace Bench
+} // namespace DevOpcua
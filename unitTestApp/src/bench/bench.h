@@ -0,0 +1,99 @@
+/*************************************************************************\
+* Copyright (c) 2026 ITER Organization.
+* This module is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Author: Dirk Zimoch <dirk.zimoch@psi.ch>
+ */
+
+#ifndef DEVOPCUA_BENCH_H
+#define DEVOPCUA_BENCH_H
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace DevOpcua {
+namespace Bench {
+
+/**
+ * @brief Number of heap allocations (all threads) since program start.
+ *
+ * Counted by the replacement operator new of the benchmark executable.
+ */
+extern std::atomic<unsigned long> allocations;
+
+typedef std::chrono::steady_clock Clock;
+
+inline double
+seconds (const Clock::time_point &from, const Clock::time_point &to)
+{
+    return std::chrono::duration<double>(to - from).count();
+}
+
+/**
+ * @brief Command line options.
+ */
+struct Options {
+    double scale;                      /**< multiplier for the iteration counts */
+    std::vector<std::string> filters;  /**< run benchmarks whose name contains any of these */
+
+    bool selected(const std::string &name) const;
+    unsigned long count(const unsigned long n) const;
+};
+
+/**
+ * @brief Result of one benchmark, printed as one JSON object per line.
+ */
+class Result
+{
+public:
+    Result(const std::string &name, const unsigned long ops);
+
+    /**
+     * @brief Start the time and allocation measurement.
+     */
+    void start();
+
+    /**
+     * @brief Stop the time and allocation measurement.
+     */
+    void stop();
+
+    /**
+     * @brief Add a latency sample [s] (per-operation timing).
+     */
+    void latency(const double seconds) { latencies.push_back(seconds); }
+
+    /**
+     * @brief Add a benchmark specific value to the output.
+     */
+    void extra(const std::string &key, const double value);
+
+    /**
+     * @brief Print the result (JSON, one line) to stdout.
+     */
+    void print();
+
+    std::vector<double> latencies;
+
+private:
+    std::string name;
+    unsigned long ops;
+    Clock::time_point t0, t1;
+    unsigned long allocs0, allocs1;
+    std::vector<std::pair<std::string, double>> extras;
+};
+
+void queueBenchmarks(const Options &opt);
+void elementTreeBenchmarks(const Options &opt);
+void linkParserBenchmarks(const Options &opt);
+void clientBenchmarks(const Options &opt);   /**< in the client specific directory */
+
+} // namespace Bench
+} // namespace DevOpcua
+
+#endif // DEVOPCUA_BENCH_H
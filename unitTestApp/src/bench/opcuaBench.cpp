@@ -0,0 +1,184 @@
+/*************************************************************************\
+* Copyright (c) 2026 ITER Organization.
+* This module is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Author: Dirk Zimoch <dirk.zimoch@psi.ch>
+ */
+
+/*
+ * Microbenchmarks for the driver's core templates
+ *
+ * Usage: opcuaBench [-s <scale>] [<filter> ...]
+ *
+ * Runs all benchmarks whose name contains one of the filters (default: all),
+ * with the iteration counts multiplied by scale (default: 1).
+ * Prints one JSON object per benchmark to stdout:
+ *   {"bench":"<name>","ops":N,"seconds":S,"ops_per_s":R,"ns_per_op":T,
+ *    "allocs_per_op":A[,"lat_p50_ns":..,"lat_p90_ns":..,"lat_p99_ns":..,"lat_max_ns":..][,...]}
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <new>
+
+#include "bench.h"
+
+namespace DevOpcua {
+namespace Bench {
+
+std::atomic<unsigned long> allocations(0);
+
+bool
+Options::selected (const std::string &name) const
+{
+    if (filters.empty())
+        return true;
+    for (const auto &f : filters)
+        if (name.find(f) != std::string::npos)
+            return true;
+    return false;
+}
+
+unsigned long
+Options::count (const unsigned long n) const
+{
+    unsigned long c = static_cast<unsigned long>(n * scale);
+    return c ? c : 1;
+}
+
+Result::Result (const std::string &name, const unsigned long ops)
+    : name(name)
+    , ops(ops ? ops : 1)
+    , allocs0(0)
+    , allocs1(0)
+{}
+
+void
+Result::start ()
+{
+    allocs0 = allocations.load(std::memory_order_relaxed);
+    t0 = Clock::now();
+}
+
+void
+Result::stop ()
+{
+    t1 = Clock::now();
+    allocs1 = allocations.load(std::memory_order_relaxed);
+}
+
+void
+Result::extra (const std::string &key, const double value)
+{
+    extras.emplace_back(key, value);
+}
+
+void
+Result::print ()
+{
+    double s = seconds(t0, t1);
+    char buf[512];
+    snprintf(buf, sizeof(buf),
+             "{\"bench\":\"%s\",\"ops\":%lu,\"seconds\":%.6f,\"ops_per_s\":%.1f,"
+             "\"ns_per_op\":%.1f,\"allocs_per_op\":%.3f",
+             name.c_str(), ops, s, s > 0.0 ? ops / s : 0.0, s * 1e9 / ops,
+             static_cast<double>(allocs1 - allocs0) / ops);
+    std::cout << buf;
+
+    if (latencies.size()) {
+        std::sort(latencies.begin(), latencies.end());
+        auto pct = [this] (const double p) {
+            size_t i = static_cast<size_t>(p * (latencies.size() - 1) + 0.5);
+            return latencies[i] * 1e9;
+        };
+        snprintf(buf, sizeof(buf),
+                 ",\"lat_p50_ns\":%.0f,\"lat_p90_ns\":%.0f,\"lat_p99_ns\":%.0f,\"lat_max_ns\":%.0f",
+                 pct(0.5), pct(0.9), pct(0.99), latencies.back() * 1e9);
+        std::cout << buf;
+    }
+    for (const auto &e : extras) {
+        snprintf(buf, sizeof(buf), ",\"%s\":%.6g", e.first.c_str(), e.second);
+        std::cout << buf;
+    }
+    std::cout << "}" << std::endl;
+}
+
+} // namespace Bench
+} // namespace DevOpcua
+
+// Count all heap allocations of the benchmark executable
+
+void *
+operator new (std::size_t size)
+{
+    DevOpcua::Bench::allocations.fetch_add(1, std::memory_order_relaxed);
+    void *p = std::malloc(size ? size : 1);
+    if (!p)
+        throw std::bad_alloc();
+    return p;
+}
+
+void *
+operator new[] (std::size_t size)
+{
+    return operator new(size);
+}
+
+void
+operator delete (void *p) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete[] (void *p) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete (void *p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete[] (void *p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+int
+main (int argc, char *argv[])
+{
+    using namespace DevOpcua::Bench;
+
+    Options opt;
+    opt.scale = 1.0;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-s") && i + 1 < argc) {
+            opt.scale = atof(argv[++i]);
+            if (opt.scale <= 0.0) {
+                std::cerr << "invalid scale " << argv[i] << std::endl;
+                return EXIT_FAILURE;
+            }
+        } else if (!strcmp(argv[i], "-h")) {
+            std::cerr << "Usage: " << argv[0] << " [-s <scale>] [<filter> ...]" << std::endl;
+            return EXIT_SUCCESS;
+        } else {
+            opt.filters.emplace_back(argv[i]);
+        }
+    }
+
+    queueBenchmarks(opt);
+    elementTreeBenchmarks(opt);
+    linkParserBenchmarks(opt);
+    clientBenchmarks(opt);
+    return EXIT_SUCCESS;
+}
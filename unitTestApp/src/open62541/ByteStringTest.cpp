@@ -0,0 +1,135 @@
+/*************************************************************************\
+* Copyright (c) 2026 ITER Organization.
+* This module is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Author: Dirk Zimoch <dirk.zimoch@psi.ch>
+ */
+
+#include <vector>
+#include <chrono>
+#include <iostream>
+#include <gtest/gtest.h>
+
+#include "DataElementOpen62541.h"
+
+namespace {
+
+using namespace DevOpcua;
+
+TEST(ByteStringTest, isByteString_ScalarOnly) {
+    UA_ByteString bs = UA_BYTESTRING(const_cast<char *>("abc"));
+    UA_Byte arr[3] = {1, 2, 3};
+    UA_Variant v;
+
+    UA_Variant_setScalar(&v, &bs, &UA_TYPES[UA_TYPES_BYTESTRING]);
+    EXPECT_TRUE(isByteString(v));
+    UA_Variant_setArray(&v, arr, 3, &UA_TYPES[UA_TYPES_BYTE]);
+    EXPECT_FALSE(isByteString(v));
+    UA_Variant_init(&v);
+    EXPECT_FALSE(isByteString(v));
+}
+
+TEST(ByteStringTest, toBuffer_CopiesContent) {
+    UA_ByteString bs = UA_BYTESTRING(const_cast<char *>("\x01\x02\x03\x04"));
+    UA_Variant v;
+    UA_Variant_setScalar(&v, &bs, &UA_TYPES[UA_TYPES_BYTESTRING]);
+    epicsUInt8 buf[8] = {};
+
+    EXPECT_EQ(byteStringToBuffer(v, buf, sizeof(buf)), 4u) << "wrong number of bytes copied";
+    EXPECT_EQ(buf[0], 1);
+    EXPECT_EQ(buf[3], 4);
+    EXPECT_EQ(buf[4], 0) << "bytes written beyond content";
+}
+
+TEST(ByteStringTest, toBuffer_TruncatesToBufferSize) {
+    UA_ByteString bs = UA_BYTESTRING(const_cast<char *>("\x01\x02\x03\x04"));
+    UA_Variant v;
+    UA_Variant_setScalar(&v, &bs, &UA_TYPES[UA_TYPES_BYTESTRING]);
+    epicsUInt8 buf[3] = {};
+
+    EXPECT_EQ(byteStringToBuffer(v, buf, sizeof(buf)), 3u) << "copy not truncated to buffer size";
+    EXPECT_EQ(buf[2], 3);
+}
+
+TEST(ByteStringTest, fromBuffer_VariantOwnsCopy) {
+    epicsUInt8 buf[5] = {5, 4, 3, 2, 1};
+    UA_Variant v;
+    UA_Variant_init(&v);
+
+    ASSERT_EQ(byteStringFromBuffer(v, buf, sizeof(buf)), UA_STATUSCODE_GOOD);
+    ASSERT_TRUE(isByteString(v));
+    const UA_ByteString *bs = static_cast<const UA_ByteString *>(v.data);
+    EXPECT_EQ(bs->length, 5u);
+    EXPECT_NE(static_cast<const void *>(bs->data), static_cast<const void *>(buf)) << "buffer not copied";
+    buf[0] = 0;
+    EXPECT_EQ(bs->data[0], 5) << "ByteString shares the source buffer";
+    UA_Variant_clear(&v);
+}
+
+TEST(ByteStringTest, fromBuffer_EmptyAndReplace) {
+    epicsUInt8 buf[2] = {1, 2};
+    UA_Variant v;
+    UA_Variant_init(&v);
+
+    ASSERT_EQ(byteStringFromBuffer(v, buf, sizeof(buf)), UA_STATUSCODE_GOOD);
+    ASSERT_EQ(byteStringFromBuffer(v, buf, 0), UA_STATUSCODE_GOOD);
+    ASSERT_TRUE(isByteString(v));
+    EXPECT_EQ(static_cast<const UA_ByteString *>(v.data)->length, 0u);
+    UA_Variant_clear(&v);
+}
+
+// Throughput of the CHAR/UCHAR waveform <-> ByteString paths for multi-MB payloads
+TEST(ByteStringTest, benchmark_MultiMB_Throughput) {
+    const size_t size = 8 * 1024 * 1024;
+    const int n = 50;
+    std::vector<epicsUInt8> record(size, 0x5a);
+    UA_Variant v, wv;
+    UA_Variant_init(&v);
+    UA_Variant_init(&wv);
+
+    // Write path as before: copy into the outgoing data, then copy into the write request
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; i++) {
+        UA_ByteString bs;
+        bs.length = size;
+        bs.data = record.data();
+        UA_Variant_setScalarCopy(&v, &bs, &UA_TYPES[UA_TYPES_BYTESTRING]);
+        UA_Variant_copy(&v, &wv);
+        UA_Variant_clear(&v);
+        UA_Variant_clear(&wv);
+    }
+    double copyS = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // Write path now: one copy into an owned ByteString, moved into the write request
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; i++) {
+        byteStringFromBuffer(v, record.data(), size);
+        wv = v;
+        UA_Variant_init(&v);
+        UA_Variant_clear(&wv);
+    }
+    double moveS = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // Read path: ByteString into the record buffer
+    byteStringFromBuffer(v, record.data(), size);
+    start = std::chrono::steady_clock::now();
+    size_t total = 0;
+    for (int i = 0; i < n; i++)
+        total += byteStringToBuffer(v, record.data(), size);
+    double readS = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    UA_Variant_clear(&v);
+    EXPECT_EQ(total, n * size);
+
+    const double mb = static_cast<double>(n) * size / (1024.0 * 1024.0);
+    std::cout << "[ BENCH    ] ByteString " << size / (1024 * 1024) << " MB write (copy+copy): "
+              << mb / copyS << " MB/s" << std::endl;
+    std::cout << "[ BENCH    ] ByteString " << size / (1024 * 1024) << " MB write (copy+move): "
+              << mb / moveS << " MB/s" << std::endl;
+    std::cout << "[ BENCH    ] ByteString " << size / (1024 * 1024) << " MB read: "
+              << mb / readS << " MB/s" << std::endl;
+}
+
+} // namespace
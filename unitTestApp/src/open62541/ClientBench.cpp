@@ -0,0 +1,195 @@
+/*************************************************************************\
+* Copyright (c) 2026 ITER Organization.
+* This module is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Author: Dirk Zimoch <dirk.zimoch@psi.ch>
+ */
+
+/*
+ * Benchmarks of the open62541 write path: encoding the value of an output
+ * record into the outgoing variant, per record type.
+ *
+ * "switch": type switch and UA_Variant_setScalarCopy for every write
+ *           (the write path before the precompiled encoders)
+ * "encoder": encoder selected once, range check plus store
+ *
+ * ".hold": repeated writes into the same element (value not sent in between,
+ *          as for structure members)
+ * ".send": the outgoing buffer is handed over to the write request after
+ *          every write; the switch path frees it, the encoder path gets it
+ *          back for reuse (as the elements do after the request is encoded)
+ */
+
+#include <string>
+#include <vector>
+
+#include "DataElementOpen62541.h"
+#include "bench.h"
+
+namespace DevOpcua {
+namespace Bench {
+
+namespace {
+
+template<typename ET, typename UT>
+UA_StatusCode
+switchCase (UA_Variant &data, const ET &value, const int type)
+{
+    if (!isWithinRange<UT>(value))
+        return UA_STATUSCODE_BADOUTOFRANGE;
+    UT val = static_cast<UT>(value);
+    UA_Variant_clear(&data);
+    return UA_Variant_setScalarCopy(&data, &val, &UA_TYPES[type]);
+}
+
+template<typename ET>
+UA_StatusCode
+switchEncode (UA_Variant &data, const ET &value, const UA_DataType *type)
+{
+    switch (typeKindOf(type)) {
+    case UA_TYPES_BOOLEAN:
+    {
+        UA_Boolean val = (value != 0);
+        UA_Variant_clear(&data);
+        return UA_Variant_setScalarCopy(&data, &val, &UA_TYPES[UA_TYPES_BOOLEAN]);
+    }
+    case UA_TYPES_BYTE:   return switchCase<ET, UA_Byte>(data, value, UA_TYPES_BYTE);
+    case UA_TYPES_SBYTE:  return switchCase<ET, UA_SByte>(data, value, UA_TYPES_SBYTE);
+    case UA_TYPES_UINT16: return switchCase<ET, UA_UInt16>(data, value, UA_TYPES_UINT16);
+    case UA_TYPES_INT16:  return switchCase<ET, UA_Int16>(data, value, UA_TYPES_INT16);
+    case UA_TYPES_UINT32: return switchCase<ET, UA_UInt32>(data, value, UA_TYPES_UINT32);
+    case UA_TYPES_INT32:  return switchCase<ET, UA_Int32>(data, value, UA_TYPES_INT32);
+    case UA_TYPES_UINT64: return switchCase<ET, UA_UInt64>(data, value, UA_TYPES_UINT64);
+    case UA_TYPES_INT64:  return switchCase<ET, UA_Int64>(data, value, UA_TYPES_INT64);
+    case UA_TYPES_FLOAT:  return switchCase<ET, UA_Float>(data, value, UA_TYPES_FLOAT);
+    case UA_TYPES_DOUBLE: return switchCase<ET, UA_Double>(data, value, UA_TYPES_DOUBLE);
+    default:              return UA_STATUSCODE_BADTYPEMISMATCH;
+    }
+}
+
+// Hand the outgoing buffer over (as the write request does) and free it
+// or keep it as spare for the next write
+inline void
+send (UA_Variant &data, UA_Variant *spare = nullptr)
+{
+    UA_Variant sent = data;
+    UA_Variant_init(&data);
+    if (spare)
+        keepSpareBuffer(*spare, sent);
+    else
+        UA_Variant_clear(&sent);
+}
+
+template<typename ET>
+void
+scalarRate (const Options &opt, const std::string &record, const ET start, const int type)
+{
+    const unsigned long n = opt.count(2000000);
+    const UA_DataType *uaType = &UA_TYPES[type];
+
+    for (const char *mode : {"hold", "send"}) {
+        const bool sending = (mode[0] == 's');
+        for (const char *method : {"switch", "encoder"}) {
+            const std::string name = std::string("write.") + record + "." + method + "." + mode;
+            if (!opt.selected(name))
+                continue;
+            const bool useEncoder = (method[0] == 'e');
+            UA_Variant data, spare;
+            UA_Variant_init(&data);
+            UA_Variant_init(&spare);
+            unsigned long bad = 0;
+
+            Result r(name, n);
+            r.start();
+            ScalarEncoder<ET> encoder = useEncoder ? selectScalarEncoder<ET>(uaType) : nullptr;
+            ET value = start;
+            for (unsigned long i = 0; i < n; i++) {
+                UA_StatusCode status;
+                if (useEncoder) {
+                    takeSpareBuffer(data, spare);
+                    status = encoder(data, value);
+                } else {
+                    status = switchEncode(data, value, uaType);
+                }
+                if (status != UA_STATUSCODE_GOOD)
+                    bad++;
+                if (sending)
+                    send(data, useEncoder ? &spare : nullptr);
+                value = (value == start) ? static_cast<ET>(start + 1) : start;
+            }
+            r.stop();
+            UA_Variant_clear(&data);
+            UA_Variant_clear(&spare);
+            r.extra("failed", bad);
+            r.print();
+        }
+    }
+}
+
+template<typename ET>
+void
+arrayRate (const Options &opt, const std::string &record, const size_t elements, const int type)
+{
+    const unsigned long n = opt.count(200000);
+    const UA_DataType *uaType = &UA_TYPES[type];
+    std::vector<ET> values(elements);
+    for (size_t i = 0; i < elements; i++)
+        values[i] = static_cast<ET>(i);
+
+    for (const char *mode : {"hold", "send"}) {
+        const bool sending = (mode[0] == 's');
+        for (const char *method : {"switch", "encoder"}) {
+            const std::string name = std::string("write.") + record + std::to_string(elements)
+                    + "." + method + "." + mode;
+            if (!opt.selected(name))
+                continue;
+            const bool useEncoder = (method[0] == 'e');
+            UA_Variant data, spare;
+            UA_Variant_init(&data);
+            UA_Variant_init(&spare);
+
+            Result r(name, n);
+            r.start();
+            for (unsigned long i = 0; i < n; i++) {
+                values[0] = static_cast<ET>(i);
+                if (useEncoder) {
+                    takeSpareBuffer(data, spare);
+                    storeArray(data, values.data(), elements, uaType);
+                } else {
+                    UA_Variant_clear(&data);
+                    UA_Variant_setArrayCopy(&data, values.data(), elements, uaType);
+                }
+                if (sending)
+                    send(data, useEncoder ? &spare : nullptr);
+            }
+            r.stop();
+            UA_Variant_clear(&data);
+            UA_Variant_clear(&spare);
+            r.extra("bytes", static_cast<double>(elements * sizeof(ET)));
+            r.print();
+        }
+    }
+}
+
+} // namespace
+
+void
+clientBenchmarks (const Options &opt)
+{
+    // Record types with the EPICS type that their device support writes
+    scalarRate<epicsFloat64>(opt, "ao.Double", 1.5, UA_TYPES_DOUBLE);
+    scalarRate<epicsFloat64>(opt, "ao.Float", 1.5, UA_TYPES_FLOAT);
+    scalarRate<epicsInt32>(opt, "longout.Int32", 1000, UA_TYPES_INT32);
+    scalarRate<epicsInt32>(opt, "longout.Int16", 1000, UA_TYPES_INT16);
+    scalarRate<epicsInt64>(opt, "int64out.Int64", 1000, UA_TYPES_INT64);
+    scalarRate<epicsUInt32>(opt, "bo.Boolean", 0, UA_TYPES_BOOLEAN);
+    scalarRate<epicsUInt32>(opt, "mbbo.UInt32", 3, UA_TYPES_UINT32);
+    arrayRate<epicsFloat64>(opt, "aao.Double", 16, UA_TYPES_DOUBLE);
+    arrayRate<epicsFloat64>(opt, "aao.Double", 4096, UA_TYPES_DOUBLE);
+}
+
+} // namespace Bench
+} // namespace DevOpcua
@@ -0,0 +1,121 @@
+/*************************************************************************\
+* Copyright (c) 2026 ITER Organization.
+* This module is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Author: Dirk Zimoch <dirk.zimoch@psi.ch>
+ */
+
+#include <cstring>
+#include <sstream>
+#include <gtest/gtest.h>
+
+#include "CryptoStats.h"
+
+#if UA_OPEN62541_VER_MAJOR*100+UA_OPEN62541_VER_MINOR < 103
+#define POLICY_PARAM const UA_SecurityPolicy *,
+#define POLICY_ARG &policy,
+#else
+#define POLICY_PARAM
+#define POLICY_ARG
+#endif
+
+namespace {
+
+using namespace DevOpcua;
+
+int channel;
+int deleted;
+
+UA_StatusCode
+fakeNewContext (const UA_SecurityPolicy *, const UA_ByteString *, void **channelContext)
+{
+    *channelContext = &channel;
+    return UA_STATUSCODE_GOOD;
+}
+
+void
+fakeDeleteContext (void *)
+{
+    deleted++;
+}
+
+UA_StatusCode
+fakeSign (POLICY_PARAM void *, const UA_ByteString *, UA_ByteString *)
+{
+    return UA_STATUSCODE_GOOD;
+}
+
+UA_StatusCode
+fakeEncrypt (POLICY_PARAM void *, UA_ByteString *)
+{
+    return UA_STATUSCODE_BADSECURITYCHECKSFAILED;
+}
+
+class CryptoStatsTest : public ::testing::Test {
+protected:
+    CryptoStatsTest() {
+        memset(&policy, 0, sizeof(policy));
+        policy.policyUri = UA_STRING(const_cast<char *>("http://opcfoundation.org/UA/SecurityPolicy#Basic256Sha256"));
+        policy.channelModule.newContext = fakeNewContext;
+        policy.channelModule.deleteContext = fakeDeleteContext;
+        policy.symmetricModule.cryptoModule.signatureAlgorithm.sign = fakeSign;
+        policy.symmetricModule.cryptoModule.encryptionAlgorithm.encrypt = fakeEncrypt;
+        policy.asymmetricModule.cryptoModule.signatureAlgorithm.sign = fakeSign;
+        deleted = 0;
+    }
+    UA_SecurityPolicy policy;
+    CryptoStats stats;
+};
+
+TEST_F(CryptoStatsTest, instrument_PolicyNoneUnchanged) {
+    policy.policyUri = UA_STRING(const_cast<char *>("http://opcfoundation.org/UA/SecurityPolicy#None"));
+    stats.instrument(&policy, 1);
+    EXPECT_EQ(policy.channelModule.newContext, fakeNewContext);
+    EXPECT_EQ(policy.symmetricModule.cryptoModule.signatureAlgorithm.sign, fakeSign);
+}
+
+TEST_F(CryptoStatsTest, instrument_CountsOperationsAndKeepsStatus) {
+    stats.instrument(&policy, 1);
+    EXPECT_NE(policy.channelModule.newContext, fakeNewContext);
+    EXPECT_EQ(policy.symmetricModule.cryptoModule.signatureAlgorithm.verify, nullptr);
+
+    void *ctx = nullptr;
+    ASSERT_EQ(policy.channelModule.newContext(&policy, nullptr, &ctx), UA_STATUSCODE_GOOD);
+    EXPECT_EQ(ctx, &channel);
+
+    UA_Byte buf[100] = {};
+    UA_ByteString data = {sizeof(buf), buf};
+    UA_ByteString sig = UA_BYTESTRING_NULL;
+    EXPECT_EQ(policy.symmetricModule.cryptoModule.signatureAlgorithm.sign(POLICY_ARG ctx, &data, &sig),
+              UA_STATUSCODE_GOOD);
+    EXPECT_EQ(policy.symmetricModule.cryptoModule.signatureAlgorithm.sign(POLICY_ARG ctx, &data, &sig),
+              UA_STATUSCODE_GOOD);
+    EXPECT_EQ(policy.symmetricModule.cryptoModule.encryptionAlgorithm.encrypt(POLICY_ARG ctx, &data),
+              UA_STATUSCODE_BADSECURITYCHECKSFAILED);
+    EXPECT_EQ(policy.asymmetricModule.cryptoModule.signatureAlgorithm.sign(POLICY_ARG ctx, &data, &sig),
+              UA_STATUSCODE_GOOD);
+    EXPECT_EQ(stats.operations(), 4u);
+
+    std::ostringstream os;
+    stats.show(os, 1);
+    EXPECT_NE(os.str().find("sym-sign      n=2 bytes=200"), std::string::npos) << os.str();
+    EXPECT_NE(os.str().find("sym-encrypt   n=1 bytes=100"), std::string::npos) << os.str();
+    EXPECT_NE(os.str().find("asym-sign     n=1 bytes=100"), std::string::npos) << os.str();
+
+    // Channel is still usable after the policy was released
+    stats.release(&policy, 1);
+    EXPECT_EQ(policy.symmetricModule.cryptoModule.signatureAlgorithm.sign(POLICY_ARG ctx, &data, &sig),
+              UA_STATUSCODE_GOOD);
+    EXPECT_EQ(stats.operations(), 5u);
+
+    policy.channelModule.deleteContext(ctx);
+    EXPECT_EQ(deleted, 1);
+
+    stats.clear();
+    EXPECT_EQ(stats.operations(), 0u);
+}
+
+} // namespace
@@ -0,0 +1,117 @@
+/*************************************************************************\
+* Copyright (c) 2026 ITER Organization.
+* This module is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Author: Dirk Zimoch <dirk.zimoch@psi.ch>
+ */
+
+#include <map>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "SubscriptionDiagnostics.h"
+
+namespace {
+
+using namespace DevOpcua;
+
+// Binary encoded SubscriptionDiagnosticsDataType; counter i has the value base + i
+std::vector<UA_Byte>
+encodeDiagnostics (const std::string &sessionId, const UA_UInt32 subscriptionId, const UA_UInt32 base)
+{
+    std::vector<UA_Byte> body;
+    auto uint32 = [&body] (UA_UInt32 v) {
+        for (int i = 0; i < 4; i++)
+            body.push_back(static_cast<UA_Byte>(v >> (8 * i)));
+    };
+    body.push_back(0x03);                   // string NodeId
+    body.push_back(1);
+    body.push_back(0);
+    uint32(static_cast<UA_UInt32>(sessionId.size()));
+    body.insert(body.end(), sessionId.begin(), sessionId.end());
+    uint32(subscriptionId);
+    body.push_back(5);                      // priority
+    body.insert(body.end(), 8, 0);          // publishing interval
+    uint32(10);                             // max keepalive count
+    uint32(100);                            // max lifetime count
+    uint32(0);                              // max notifications per publish
+    body.push_back(1);                      // publishing enabled
+    for (UA_UInt32 i = 0; i < 23; i++)
+        uint32(base + i);
+    return body;
+}
+
+class SubscriptionDiagnosticsTest : public ::testing::Test {
+protected:
+    SubscriptionDiagnosticsTest() {
+        UA_Variant_init(&value);
+    }
+    ~SubscriptionDiagnosticsTest() {
+        UA_Variant_clear(&value);
+    }
+
+    void setArray(const std::vector<std::vector<UA_Byte>> &bodies,
+                  const UA_UInt32 typeId = UA_NS0ID_SUBSCRIPTIONDIAGNOSTICSDATATYPE_ENCODING_DEFAULTBINARY) {
+        UA_ExtensionObject *eo = static_cast<UA_ExtensionObject *>(
+                    UA_Array_new(bodies.size(), &UA_TYPES[UA_TYPES_EXTENSIONOBJECT]));
+        for (size_t i = 0; i < bodies.size(); i++) {
+            eo[i].encoding = UA_EXTENSIONOBJECT_ENCODED_BYTESTRING;
+            eo[i].content.encoded.typeId = UA_NODEID_NUMERIC(0, typeId);
+            UA_ByteString_allocBuffer(&eo[i].content.encoded.body, bodies[i].size());
+            std::copy(bodies[i].begin(), bodies[i].end(), eo[i].content.encoded.body.data);
+        }
+        UA_Variant_setArray(&value, eo, bodies.size(), &UA_TYPES[UA_TYPES_EXTENSIONOBJECT]);
+    }
+
+    UA_Variant value;
+    std::map<UA_UInt32, SubscriptionCounters> result;
+};
+
+TEST_F(SubscriptionDiagnosticsTest, decode_EncodedArray_CountersById)
+{
+    setArray({encodeDiagnostics("session-1", 7, 100), encodeDiagnostics("s2", 12, 1000)});
+    EXPECT_EQ(decodeSubscriptionDiagnostics(value, result), 2u) << "not all elements decoded";
+    ASSERT_EQ(result.count(7), 1u) << "subscription 7 missing";
+    ASSERT_EQ(result.count(12), 1u) << "subscription 12 missing";
+    const SubscriptionCounters &c = result[7];
+    EXPECT_TRUE(c.hasServerDiagnostics) << "server diagnostics not flagged";
+    EXPECT_EQ(c.dataChangeNotifications, 110u) << "wrong DataChangeNotificationsCount";
+    EXPECT_EQ(c.latePublishRequests, 113u) << "wrong LatePublishRequestCount";
+    EXPECT_EQ(c.unacknowledgedMessages, 116u) << "wrong UnacknowledgedMessageCount";
+    EXPECT_EQ(c.discardedMessages, 117u) << "wrong DiscardedMessageCount";
+    EXPECT_EQ(c.monitoringQueueOverflows, 120u) << "wrong MonitoringQueueOverflowCount";
+    EXPECT_EQ(result[12].monitoringQueueOverflows, 1020u) << "wrong counter of second element";
+    EXPECT_EQ(c.itemOverflows, 0u) << "item counter set from server diagnostics";
+}
+
+TEST_F(SubscriptionDiagnosticsTest, decode_TruncatedBody_Skipped)
+{
+    std::vector<UA_Byte> body = encodeDiagnostics("session-1", 7, 100);
+    body.resize(body.size() - 1);
+    setArray({body, encodeDiagnostics("s2", 12, 1000)});
+    EXPECT_EQ(decodeSubscriptionDiagnostics(value, result), 1u) << "truncated element decoded";
+    EXPECT_EQ(result.count(7), 0u) << "truncated element in result";
+    EXPECT_EQ(result.count(12), 1u) << "valid element after truncated one missing";
+}
+
+TEST_F(SubscriptionDiagnosticsTest, decode_OtherType_Skipped)
+{
+    setArray({encodeDiagnostics("session-1", 7, 100)}, UA_NS0ID_SESSIONDIAGNOSTICSDATATYPE_ENCODING_DEFAULTBINARY);
+    EXPECT_EQ(decodeSubscriptionDiagnostics(value, result), 0u) << "element of other type decoded";
+    EXPECT_TRUE(result.empty()) << "element of other type in result";
+}
+
+TEST_F(SubscriptionDiagnosticsTest, decode_NoArray_NothingDecoded)
+{
+    EXPECT_EQ(decodeSubscriptionDiagnostics(value, result), 0u) << "empty variant decoded";
+    UA_UInt32 n = 3;
+    UA_Variant_setScalarCopy(&value, &n, &UA_TYPES[UA_TYPES_UINT32]);
+    EXPECT_EQ(decodeSubscriptionDiagnostics(value, result), 0u) << "scalar decoded";
+    EXPECT_TRUE(result.empty()) << "result not empty";
+}
+
+} // namespace
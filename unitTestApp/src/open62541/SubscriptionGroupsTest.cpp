@@ -0,0 +1,42 @@
+/*************************************************************************\
+* Copyright (c) 2026 ITER Organization.
+* This module is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Author: Dirk Zimoch <dirk.zimoch@psi.ch>
+ */
+
+#include <gtest/gtest.h>
+
+#include "SubscriptionOpen62541.h"
+
+namespace {
+
+using namespace DevOpcua;
+
+TEST(SubscriptionGroupsTest, rateClass_Intervals_RoundedUpTo125Series)
+{
+    EXPECT_DOUBLE_EQ(SubscriptionOpen62541::rateClass(100.0), 100.0) << "class value not kept";
+    EXPECT_DOUBLE_EQ(SubscriptionOpen62541::rateClass(101.0), 200.0) << "not rounded up to 2";
+    EXPECT_DOUBLE_EQ(SubscriptionOpen62541::rateClass(250.0), 500.0) << "not rounded up to 5";
+    EXPECT_DOUBLE_EQ(SubscriptionOpen62541::rateClass(700.0), 1000.0) << "not rounded up to next decade";
+    EXPECT_DOUBLE_EQ(SubscriptionOpen62541::rateClass(0.3), 0.5) << "wrong class below 1 ms";
+}
+
+TEST(SubscriptionGroupsTest, rateClass_NoInterval_Zero)
+{
+    EXPECT_DOUBLE_EQ(SubscriptionOpen62541::rateClass(0.0), 0.0) << "wrong class for 0";
+    EXPECT_DOUBLE_EQ(SubscriptionOpen62541::rateClass(-1.0), 0.0) << "wrong class for negative interval";
+}
+
+TEST(SubscriptionGroupsTest, groupInterval_Bounds_Applied)
+{
+    EXPECT_DOUBLE_EQ(SubscriptionOpen62541::groupInterval(150.0, 100.0, 1000.0), 150.0) << "interval within bounds changed";
+    EXPECT_DOUBLE_EQ(SubscriptionOpen62541::groupInterval(10.0, 100.0, 1000.0), 100.0) << "lower bound not applied";
+    EXPECT_DOUBLE_EQ(SubscriptionOpen62541::groupInterval(5000.0, 100.0, 1000.0), 1000.0) << "upper bound not applied";
+    EXPECT_DOUBLE_EQ(SubscriptionOpen62541::groupInterval(5000.0, 100.0, 0.0), 5000.0) << "upper bound 0 applied";
+}
+
+} // namespace
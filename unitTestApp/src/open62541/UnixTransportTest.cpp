@@ -0,0 +1,52 @@
+/*************************************************************************\
+* Copyright (c) 2026 ITER Organization.
+* This module is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Author: Dirk Zimoch <dirk.zimoch@psi.ch>
+ */
+
+#include <string>
+#include <gtest/gtest.h>
+
+#include <open62541/client_config_default.h>
+
+#include "UnixTransport.h"
+
+namespace {
+
+using namespace DevOpcua;
+
+TEST(UnixTransportTest, isUnixTransportUrl_SchemeOnly) {
+    EXPECT_TRUE(isUnixTransportUrl("opc.unix:///run/plc.sock"));
+    EXPECT_TRUE(isUnixTransportUrl("opc.unix://"));
+    EXPECT_FALSE(isUnixTransportUrl("opc.tcp://localhost:4840"));
+    EXPECT_FALSE(isUnixTransportUrl("opc.unix:/run/plc.sock"));
+    EXPECT_FALSE(isUnixTransportUrl("OPC.UNIX:///run/plc.sock"));
+    EXPECT_FALSE(isUnixTransportUrl(""));
+}
+
+TEST(UnixTransportTest, unixTransportPath_AbsoluteAndRelative) {
+    EXPECT_EQ(unixTransportPath("opc.unix:///run/plc.sock"), "/run/plc.sock");
+    EXPECT_EQ(unixTransportPath("opc.unix://plc.sock"), "plc.sock");
+    EXPECT_EQ(unixTransportPath("opc.unix://"), "");
+    EXPECT_EQ(unixTransportPath("opc.tcp://localhost:4840"), "");
+}
+
+TEST(UnixTransportTest, setUnixTransport_ReplacesConnectionFunctions) {
+    UA_Client *client = UA_Client_new();
+    UA_ClientConfig *config = UA_Client_getConfig(client);
+    UA_ClientConfig_setDefault(config);
+#ifdef HAS_UNIX_TRANSPORT
+    auto init = config->initConnectionFunc;
+    EXPECT_TRUE(setUnixTransport(config));
+    EXPECT_NE(config->initConnectionFunc, init);
+#else
+    EXPECT_FALSE(setUnixTransport(config));
+#endif
+    UA_Client_delete(client);
+}
+
+} // namespace
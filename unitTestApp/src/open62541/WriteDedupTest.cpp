@@ -0,0 +1,68 @@
+/*************************************************************************\
+* Copyright (c) 2026 ITER Organization.
+* This module is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Author: Dirk Zimoch <dirk.zimoch@psi.ch>
+ */
+
+#include <gtest/gtest.h>
+
+#include "DataElementOpen62541.h"
+
+namespace {
+
+using namespace DevOpcua;
+
+// Write suppression (dedup=y, dedupmax=<s>)
+
+class WriteDedupTest : public ::testing::Test {
+protected:
+    WriteDedupTest()
+        : i1(1), i1b(1), i2(2), d1(1.0)
+    {
+        UA_Variant_setScalar(&vi1, &i1, &UA_TYPES[UA_TYPES_INT32]);
+        UA_Variant_setScalar(&vi1b, &i1b, &UA_TYPES[UA_TYPES_INT32]);
+        UA_Variant_setScalar(&vi2, &i2, &UA_TYPES[UA_TYPES_INT32]);
+        UA_Variant_setScalar(&vd1, &d1, &UA_TYPES[UA_TYPES_DOUBLE]);
+        UA_Variant_setArray(&va1, arr1, 3, &UA_TYPES[UA_TYPES_INT32]);
+        UA_Variant_setArray(&va2, arr2, 3, &UA_TYPES[UA_TYPES_INT32]);
+        UA_Variant_init(&empty);
+    }
+
+    UA_Int32 i1, i1b, i2;
+    UA_Double d1;
+    UA_Int32 arr1[3] = {1, 2, 3};
+    UA_Int32 arr2[3] = {1, 2, 4};
+    UA_Variant vi1, vi1b, vi2, vd1, va1, va2, empty;
+};
+
+TEST_F(WriteDedupTest, isUnchanged_SameValue_Suppressed) {
+    EXPECT_TRUE(DataElementOpen62541::isUnchanged(vi1b, vi1, 0.5, 0.0)) << "unchanged scalar not suppressed";
+    EXPECT_TRUE(DataElementOpen62541::isUnchanged(va1, va1, 0.5, 0.0)) << "unchanged array not suppressed";
+}
+
+TEST_F(WriteDedupTest, isUnchanged_ChangedValue_Written) {
+    EXPECT_FALSE(DataElementOpen62541::isUnchanged(vi2, vi1, 0.5, 0.0)) << "changed scalar suppressed";
+    EXPECT_FALSE(DataElementOpen62541::isUnchanged(va2, va1, 0.5, 0.0)) << "changed array element suppressed";
+    EXPECT_FALSE(DataElementOpen62541::isUnchanged(vd1, vi1, 0.5, 0.0)) << "changed data type suppressed";
+}
+
+TEST_F(WriteDedupTest, isUnchanged_NoConfirmedValue_Written) {
+    EXPECT_FALSE(DataElementOpen62541::isUnchanged(vi1, empty, 0.5, 0.0)) << "write suppressed without confirmed value";
+    EXPECT_FALSE(DataElementOpen62541::isUnchanged(empty, vi1, 0.5, 0.0)) << "empty write suppressed";
+}
+
+TEST_F(WriteDedupTest, isUnchanged_MaxAgeReached_ForcedWrite) {
+    EXPECT_TRUE(DataElementOpen62541::isUnchanged(vi1b, vi1, 4.9, 5.0)) << "write forced before dedupmax";
+    EXPECT_FALSE(DataElementOpen62541::isUnchanged(vi1b, vi1, 5.0, 5.0)) << "write not forced at dedupmax";
+    EXPECT_FALSE(DataElementOpen62541::isUnchanged(vi1b, vi1, 60.0, 5.0)) << "write not forced after dedupmax";
+}
+
+TEST_F(WriteDedupTest, isUnchanged_NoMaxAge_NeverForced) {
+    EXPECT_TRUE(DataElementOpen62541::isUnchanged(vi1b, vi1, 1e6, 0.0)) << "write forced without dedupmax";
+}
+
+} // namespace
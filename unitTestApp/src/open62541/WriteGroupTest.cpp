@@ -0,0 +1,89 @@
+/*************************************************************************\
+* Copyright (c) 2026 ITER Organization.
+* This module is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Author: Dirk Zimoch <dirk.zimoch@psi.ch>
+ */
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "devOpcua.h"
+#include "SessionOpen62541.h"
+#include "ItemOpen62541.h"
+
+namespace {
+
+using namespace DevOpcua;
+
+// Binding of write groups (group=<name>) to the session of their members
+
+class WriteGroupTest : public ::testing::Test {
+protected:
+    static void SetUpTestCase()
+    {
+        // Sessions are never deleted (registry), create them once
+        new SessionOpen62541("WGsession1", "opc.tcp://localhost:4840");
+        new SessionOpen62541("WGsession2", "opc.tcp://localhost:4840");
+    }
+
+    static linkInfo member(const std::string &session, const std::string &group)
+    {
+        linkInfo info;
+        info.session = session;
+        info.writeGroup = group;
+        info.monitor = false;
+        info.isOutput = true;
+        info.identifierString = "Demo.Var";
+        return info;
+    }
+};
+
+TEST_F(WriteGroupTest, sameSession_Accepted)
+{
+    linkInfo i1 = member("WGsession1", "wgSame");
+    linkInfo i2 = member("WGsession1", "wgSame");
+    std::unique_ptr<ItemOpen62541> m1(new ItemOpen62541(i1));
+    std::unique_ptr<ItemOpen62541> m2;
+    EXPECT_NO_THROW(m2.reset(new ItemOpen62541(i2))) << "member on the same session rejected";
+}
+
+TEST_F(WriteGroupTest, otherSession_Rejected)
+{
+    linkInfo i1 = member("WGsession1", "wgOther");
+    linkInfo i2 = member("WGsession2", "wgOther");
+    std::unique_ptr<ItemOpen62541> m1(new ItemOpen62541(i1));
+    EXPECT_THROW(new ItemOpen62541(i2), std::runtime_error) << "member on a different session accepted";
+}
+
+TEST_F(WriteGroupTest, lastMemberRemoved_BindingReleased)
+{
+    linkInfo i1 = member("WGsession1", "wgMove");
+    linkInfo i2 = member("WGsession1", "wgMove");
+    linkInfo i3 = member("WGsession2", "wgMove");
+    std::unique_ptr<ItemOpen62541> m1(new ItemOpen62541(i1));
+    std::unique_ptr<ItemOpen62541> m2(new ItemOpen62541(i2));
+    m1.reset();
+    EXPECT_THROW(new ItemOpen62541(i3), std::runtime_error) << "group released while a member is left";
+    m2.reset();
+    std::unique_ptr<ItemOpen62541> m3;
+    EXPECT_NO_THROW(m3.reset(new ItemOpen62541(i3))) << "group not released by its last member";
+}
+
+TEST_F(WriteGroupTest, detachedMember_BindingReleased)
+{
+    linkInfo i1 = member("WGsession1", "wgDetach");
+    linkInfo i2 = member("WGsession2", "wgDetach");
+    std::unique_ptr<ItemOpen62541> m1(new ItemOpen62541(i1));
+    m1->detach();
+    std::unique_ptr<ItemOpen62541> m2;
+    EXPECT_NO_THROW(m2.reset(new ItemOpen62541(i2))) << "group not released by detaching its last member";
+}
+
+} // namespace